@@ -0,0 +1,468 @@
+#ifndef NEXUS_VIRTUAL_HPP
+#define NEXUS_VIRTUAL_HPP
+//
+//  NeXus - Neutron & X-ray Common Data Format
+//
+//  Virtual datasets assembled from slabs of datasets in several files
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free
+//  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+//  MA  02111-1307  USA
+//
+//  For further information, see http://www.nexusformat.org/
+//
+
+/**
+ * \file NeXusVirtual.hpp
+ * Header for virtual datasets which map slabs of datasets stored in
+ * several files into one logical dataset, eg. a projection stack
+ * written as one file per block of frames.
+ *
+ * The mapping is held in memory only; nothing is written to the files.
+ * The underlying files are opened lazily on the first read which touches
+ * them, and at most a fixed number of them are kept open at any time.
+ *
+ * \code
+ * NeXus::VirtualDataset stack;
+ * for (size_t i = 0; i < filenames.size(); i++)
+ *   stack.appendStack(filenames[i], "/entry/data/data");
+ * std::vector<float> frame;
+ * stack.getSlab(frame, start, size);
+ * \endcode
+ * \ingroup cpp_main
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <string>
+#include <vector>
+#include "NeXusFile.hpp"
+#include "NeXusException.hpp"
+
+namespace NeXus
+{
+  /**
+   * Mapping of a slab of a dataset in another file into a virtual dataset.
+   * \ingroup cpp_core
+   */
+  struct VirtualSource
+  {
+    /** The file holding the dataset. */
+    std::string filename;
+    /** The path of the dataset within the file. */
+    std::string path;
+    /** The start of the slab within the source dataset. */
+    std::vector<int64_t> src_start;
+    /** The position of the slab within the virtual dataset. */
+    std::vector<int64_t> dst_start;
+    /** The size of the slab. */
+    std::vector<int64_t> size;
+  };
+
+  /**
+   * A logical dataset assembled from slabs of datasets in several files.
+   * Sources must not overlap; regions not covered by any source read as zero.
+   * \ingroup cpp_core
+   */
+  class VirtualDataset
+  {
+  private:
+    /** An open source file, together with the path of the open dataset. */
+    struct OpenFile
+    {
+      std::string filename;
+      std::string path;
+      File* file;
+    };
+
+    NXnumtype m_type;
+    std::vector<int64_t> m_dims;
+    std::vector<VirtualSource> m_sources;
+    /** Open files, most recently used first. */
+    std::list<OpenFile> m_open;
+    size_t m_max_open;
+    bool m_typed;
+
+    // the open files are owned by this object
+    VirtualDataset(const VirtualDataset&);
+    VirtualDataset& operator=(const VirtualDataset&);
+
+    static size_t typeSize(const NXnumtype type)
+    {
+      switch (type)
+      {
+        case INT8: case UINT8: case CHAR: return 1;
+        case INT16: case UINT16: return 2;
+        case INT32: case UINT32: case FLOAT32: return 4;
+        case INT64: case UINT64: case FLOAT64: return 8;
+        default: throw Exception("VirtualDataset: unsupported data type");
+      }
+    }
+
+    static int64_t volume(const std::vector<int64_t>& size)
+    {
+      int64_t n = 1;
+      for (size_t i = 0; i < size.size(); i++)
+        n *= size[i];
+      return n;
+    }
+
+    /**
+     * Return the source file with the dataset at the given path open,
+     * opening the file if required and closing the least recently used
+     * file if the limit on open files is reached.
+     */
+    File& openSource(const VirtualSource& src)
+    {
+      std::list<OpenFile>::iterator it = m_open.begin();
+      for (; it != m_open.end(); ++it)
+      {
+        if (it->filename == src.filename)
+          break;
+      }
+
+      if (it != m_open.end())
+      {
+        m_open.splice(m_open.begin(), m_open, it);
+      }
+      else
+      {
+        if (m_open.size() >= m_max_open)
+        {
+          delete m_open.back().file;
+          m_open.pop_back();
+        }
+        OpenFile entry;
+        entry.filename = src.filename;
+        entry.file = new File(src.filename, NXACC_READ);
+        m_open.push_front(entry);
+      }
+
+      OpenFile& entry = m_open.front();
+      if (entry.path != src.path)
+      {
+        entry.path.clear();
+        entry.file->openPath(src.path);
+        Info info = entry.file->getInfo();
+        if (info.type != m_type || info.dims.size() != m_dims.size())
+          throw Exception("VirtualDataset: type or rank of " + src.filename + ":" + src.path + " does not match the virtual dataset");
+        entry.path = src.path;
+      }
+      return *entry.file;
+    }
+
+    void checkRank(const std::vector<int64_t>& v, const char* what) const
+    {
+      if (v.size() != m_dims.size())
+        throw Exception(std::string("VirtualDataset: rank of ") + what + " does not match the virtual dataset");
+    }
+
+    /**
+     * Intersect the part of the virtual dataset covered by a source with a
+     * region, optionally returning the bounds of the intersection.
+     *
+     * \return The number of elements in the intersection.
+     */
+    static int64_t intersect(const VirtualSource& src, const std::vector<int64_t>& start, const std::vector<int64_t>& size,
+                             std::vector<int64_t>* lo, std::vector<int64_t>* hi)
+    {
+      int64_t n = 1;
+      for (size_t i = 0; i < start.size(); i++)
+      {
+        const int64_t a = std::max(start[i], src.dst_start[i]);
+        const int64_t b = std::min(start[i] + size[i], src.dst_start[i] + src.size[i]);
+        if (a >= b)
+          return 0;
+        if (lo != NULL)
+          (*lo)[i] = a;
+        if (hi != NULL)
+          (*hi)[i] = b;
+        n *= (b - a);
+      }
+      return n;
+    }
+
+  public:
+    /**
+     * Create an empty virtual dataset; its type and dimensions are taken
+     * from the first source added with appendStack().
+     *
+     * \param max_open_files The maximum number of source files kept open.
+     */
+    explicit VirtualDataset(const size_t max_open_files = 8) :
+      m_type(FLOAT32), m_max_open(max_open_files > 0 ? max_open_files : 1), m_typed(false)
+    {
+    }
+
+    /**
+     * Create a virtual dataset of the given type and dimensions.
+     *
+     * \param type The type of the data; all sources must have this type.
+     * \param dims The dimensions of the virtual dataset.
+     * \param max_open_files The maximum number of source files kept open.
+     */
+    VirtualDataset(const NXnumtype type, const std::vector<int64_t>& dims, const size_t max_open_files = 8) :
+      m_type(type), m_dims(dims), m_max_open(max_open_files > 0 ? max_open_files : 1), m_typed(true)
+    {
+      typeSize(type);
+      if (dims.empty())
+        throw Exception("VirtualDataset: a virtual dataset must have at least one dimension");
+    }
+
+    ~VirtualDataset()
+    {
+      closeFiles();
+    }
+
+    /**
+     * Map a slab of a dataset in another file into the virtual dataset.
+     * The file is not opened until a read touches the slab.
+     *
+     * \param filename The file holding the dataset.
+     * \param path The path of the dataset within the file.
+     * \param src_start The start of the slab within the source dataset.
+     * \param size The size of the slab.
+     * \param dst_start The position of the slab within the virtual dataset.
+     */
+    void addSource(const std::string& filename, const std::string& path,
+                   const std::vector<int64_t>& src_start, const std::vector<int64_t>& size,
+                   const std::vector<int64_t>& dst_start)
+    {
+      if (!m_typed)
+        throw Exception("VirtualDataset: type and dimensions must be set before adding sources");
+      checkRank(src_start, "source start");
+      checkRank(size, "source size");
+      checkRank(dst_start, "destination start");
+      for (size_t i = 0; i < m_dims.size(); i++)
+      {
+        if (src_start[i] < 0 || size[i] < 0 || dst_start[i] < 0 || dst_start[i] + size[i] > m_dims[i])
+          throw Exception("VirtualDataset: source " + filename + ":" + path + " is outside the virtual dataset");
+      }
+      for (size_t s = 0; s < m_sources.size(); s++)
+      {
+        if (intersect(m_sources[s], dst_start, size, NULL, NULL) > 0)
+          throw Exception("VirtualDataset: source " + filename + ":" + path + " overlaps " + m_sources[s].filename + ":" + m_sources[s].path);
+      }
+      VirtualSource src;
+      src.filename = filename;
+      src.path = path;
+      src.src_start = src_start;
+      src.dst_start = dst_start;
+      src.size = size;
+      m_sources.push_back(src);
+    }
+
+    /**
+     * Append a whole dataset along the first dimension, growing the virtual
+     * dataset. The file is opened once to read the dimensions of the
+     * dataset, and then closed again.
+     *
+     * \param filename The file holding the dataset.
+     * \param path The path of the dataset within the file.
+     */
+    void appendStack(const std::string& filename, const std::string& path)
+    {
+      Info info;
+      {
+        File file(filename, NXACC_READ);
+        file.openPath(path);
+        info = file.getInfo();
+      }
+      if (info.dims.empty())
+        throw Exception("VirtualDataset: " + filename + ":" + path + " is not an array");
+
+      if (!m_typed)
+      {
+        typeSize(info.type);
+        m_type = info.type;
+        m_dims = info.dims;
+        m_dims[0] = 0;
+        m_typed = true;
+      }
+      if (info.type != m_type || info.dims.size() != m_dims.size())
+        throw Exception("VirtualDataset: type or rank of " + filename + ":" + path + " does not match the virtual dataset");
+      for (size_t i = 1; i < m_dims.size(); i++)
+      {
+        if (info.dims[i] != m_dims[i])
+          throw Exception("VirtualDataset: dimensions of " + filename + ":" + path + " do not match the virtual dataset");
+      }
+
+      std::vector<int64_t> src_start(m_dims.size(), 0);
+      std::vector<int64_t> dst_start(m_dims.size(), 0);
+      dst_start[0] = m_dims[0];
+      m_dims[0] += info.dims[0];
+      addSource(filename, path, src_start, info.dims, dst_start);
+    }
+
+    /**
+     * \return The type and dimensions of the virtual dataset.
+     */
+    Info getInfo() const
+    {
+      Info info;
+      info.type = m_type;
+      info.dims = m_dims;
+      return info;
+    }
+
+    /**
+     * \return The sources mapped into the virtual dataset.
+     */
+    const std::vector<VirtualSource>& getSources() const
+    {
+      return m_sources;
+    }
+
+    /**
+     * \return The number of source files currently open.
+     */
+    size_t openFileCount() const
+    {
+      return m_open.size();
+    }
+
+    /**
+     * Close all open source files; they are reopened as required.
+     */
+    void closeFiles()
+    {
+      for (std::list<OpenFile>::iterator it = m_open.begin(); it != m_open.end(); ++it)
+        delete it->file;
+      m_open.clear();
+    }
+
+    /**
+     * Read a slab of the virtual dataset into a buffer laid out in C order.
+     * Each source is read with a single getSlab call; when the part of a
+     * source covers whole rows of the requested slab it is read directly
+     * into the buffer, otherwise through a temporary buffer.
+     *
+     * \param data The buffer to fill; it must hold the whole slab.
+     * \param start The start of the slab.
+     * \param size The size of the slab.
+     */
+    void getSlab(void* data, const std::vector<int64_t>& start, const std::vector<int64_t>& size)
+    {
+      checkRank(start, "slab start");
+      checkRank(size, "slab size");
+      const size_t rank = m_dims.size();
+      for (size_t i = 0; i < rank; i++)
+      {
+        if (start[i] < 0 || size[i] < 0 || start[i] + size[i] > m_dims[i])
+          throw Exception("VirtualDataset: slab is outside the virtual dataset");
+      }
+
+      const size_t elem_size = typeSize(m_type);
+      const int64_t n_elem = volume(size);
+      if (n_elem == 0)
+        return;
+
+      char* out = static_cast<char*>(data);
+
+      // strides of the requested slab, in elements
+      std::vector<int64_t> stride(rank, 1);
+      for (size_t i = rank - 1; i > 0; i--)
+        stride[i - 1] = stride[i] * size[i];
+
+      std::vector<int64_t> lo(rank), hi(rank), src_start(rank), part_size(rank);
+      std::vector<char> buffer;
+
+      // zero the output when parts of the slab are not covered by any source
+      int64_t n_covered = 0;
+      for (size_t s = 0; s < m_sources.size(); s++)
+        n_covered += intersect(m_sources[s], start, size, NULL, NULL);
+      if (n_covered < n_elem)
+        std::memset(out, 0, size_t(n_elem) * elem_size);
+
+      for (size_t s = 0; s < m_sources.size(); s++)
+      {
+        const VirtualSource& src = m_sources[s];
+
+        const int64_t part_n_elem = intersect(src, start, size, &lo, &hi);
+        if (part_n_elem == 0)
+          continue;
+
+        for (size_t i = 0; i < rank; i++)
+        {
+          part_size[i] = hi[i] - lo[i];
+          src_start[i] = src.src_start[i] + (lo[i] - src.dst_start[i]);
+        }
+
+        // the part is contiguous within the output when it spans all
+        // dimensions after its leading non-unit dimension
+        size_t lead = 0;
+        while (lead + 1 < rank && part_size[lead] == 1)
+          lead++;
+        bool contiguous = true;
+        for (size_t i = lead + 1; i < rank; i++)
+          contiguous = contiguous && (part_size[i] == size[i]);
+
+        int64_t offset = 0;
+        for (size_t i = 0; i < rank; i++)
+          offset += (lo[i] - start[i]) * stride[i];
+
+        File& file = openSource(src);
+
+        if (contiguous)
+        {
+          file.getSlab(out + offset * elem_size, src_start, part_size);
+          continue;
+        }
+
+        buffer.resize(size_t(part_n_elem) * elem_size);
+        file.getSlab(&buffer[0], src_start, part_size);
+
+        // copy the part row by row, where a row runs along the last dimension
+        const int64_t row_len = part_size[rank - 1];
+        const int64_t n_rows = part_n_elem / row_len;
+        std::vector<int64_t> idx(rank, 0);
+        for (int64_t r = 0; r < n_rows; r++)
+        {
+          int64_t dst = offset;
+          for (size_t i = 0; i + 1 < rank; i++)
+            dst += idx[i] * stride[i];
+          std::memcpy(out + dst * elem_size, &buffer[size_t(r * row_len) * elem_size], size_t(row_len) * elem_size);
+          for (size_t i = rank - 1; i > 0; i--)
+          {
+            if (++idx[i - 1] < part_size[i - 1])
+              break;
+            idx[i - 1] = 0;
+          }
+        }
+      }
+    }
+
+    /**
+     * Read a slab of the virtual dataset into a vector.
+     *
+     * \param data The vector to fill; it is resized to hold the slab.
+     * \param start The start of the slab.
+     * \param size The size of the slab.
+     * \tparam NumT The type of the data, which must match the type of the virtual dataset.
+     */
+    template <typename NumT>
+    void getSlab(std::vector<NumT>& data, const std::vector<int64_t>& start, const std::vector<int64_t>& size)
+    {
+      if (NeXus::getType<NumT>() != m_type)
+        throw Exception("VirtualDataset: type of the vector does not match the virtual dataset");
+      checkRank(size, "slab size");
+      data.resize(size_t(volume(size)));
+      if (!data.empty())
+        getSlab(&data[0], start, size);
+    }
+  };
+} // NeXus
+
+#endif /* NEXUS_VIRTUAL_HPP */
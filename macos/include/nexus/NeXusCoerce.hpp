@@ -0,0 +1,233 @@
+#ifndef NEXUS_COERCE_HPP
+#define NEXUS_COERCE_HPP
+//
+//  NeXus - Neutron & X-ray Common Data Format
+//
+//  Coercing reads of numeric data
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free
+//  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+//  MA  02111-1307  USA
+//
+//  For further information, see http://www.nexusformat.org/
+//
+
+/**
+ * \file NeXusCoerce.hpp
+ * Header for reading numeric data of any stored type into memory of
+ * another type, eg. uint16 projections read as float.
+ *
+ * Unlike File::getDataCoerce(), which reads the whole dataset in its
+ * stored type before converting it, the data is read in slabs of a
+ * bounded size into a reusable buffer and converted slab by slab, so
+ * the only full size allocation is the result. The conversion is a
+ * plain loop over contiguous arrays, which compilers vectorise.
+ *
+ * \code
+ * file.openData("data");
+ * std::vector<float> frame;
+ * NeXus::getSlabCoerce(file, frame, start, size);
+ * \endcode
+ * \ingroup cpp_main
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "NeXusFile.hpp"
+#include "NeXusException.hpp"
+
+namespace NeXus
+{
+  /**
+   * Default size in bytes of the buffer used to read data in its stored type.
+   * \ingroup cpp_core
+   */
+  static const size_t COERCE_BUFFER_BYTES = 1 << 20;
+
+  namespace CoerceImpl
+  {
+    /** Convert n contiguous values; kept free of aliasing and branches so that it vectorises. */
+    template <typename SrcT, typename DstT>
+    inline void convert(const SrcT* src, DstT* dst, const size_t n)
+    {
+      for (size_t i = 0; i < n; i++)
+        dst[i] = static_cast<DstT>(src[i]);
+    }
+
+    /**
+     * Read a slab of the open dataset stored as SrcT into dst. The slab is
+     * split into pieces along the outermost dimension whose inner block
+     * fits the buffer; each piece is read into the buffer and converted.
+     */
+    template <typename SrcT, typename DstT>
+    void readSlab(File& file, DstT* dst, const std::vector<int64_t>& start,
+                  const std::vector<int64_t>& size, const size_t buffer_bytes)
+    {
+      const size_t rank = size.size();
+      const int64_t max_count = std::max<int64_t>(1, int64_t(buffer_bytes / sizeof(SrcT)));
+
+      // find the outermost dimension k such that a block of the inner
+      // dimensions k+1.. fits the buffer, and how many indices of k to
+      // read at once
+      size_t k = rank - 1;
+      int64_t inner = 1;
+      while (k > 0 && inner * size[k] <= max_count)
+      {
+        inner *= size[k];
+        k--;
+      }
+      const int64_t step = std::max<int64_t>(1, std::min<int64_t>(size[k], max_count / inner));
+      std::vector<SrcT> buffer(size_t(step * inner));
+
+      std::vector<int64_t> pos(start);
+      std::vector<int64_t> count(rank, 1);
+      for (size_t i = k + 1; i < rank; i++)
+        count[i] = size[i];
+
+      while (true)
+      {
+        for (int64_t j = 0; j < size[k]; j += step)
+        {
+          pos[k] = start[k] + j;
+          count[k] = std::min(step, size[k] - j);
+          const size_t n = size_t(count[k] * inner);
+          file.getSlab(&buffer[0], pos, count);
+          convert(&buffer[0], dst, n);
+          dst += n;
+        }
+
+        // advance the indices of the dimensions outside k, last fastest
+        size_t d = k;
+        while (d > 0)
+        {
+          d--;
+          if (++pos[d] < start[d] + size[d])
+            break;
+          pos[d] = start[d];
+          if (d == 0)
+            return;
+        }
+        if (k == 0)
+          return;
+      }
+    }
+
+    /** Read a slab stored as SrcT; directly into dst if no conversion is needed. */
+    template <typename SrcT, typename DstT>
+    struct SlabReader
+    {
+      static void read(File& file, DstT* dst, const std::vector<int64_t>& start,
+                       const std::vector<int64_t>& size, const size_t buffer_bytes)
+      {
+        readSlab<SrcT, DstT>(file, dst, start, size, buffer_bytes);
+      }
+    };
+
+    template <typename T>
+    struct SlabReader<T, T>
+    {
+      static void read(File& file, T* dst, const std::vector<int64_t>& start,
+                       const std::vector<int64_t>& size, const size_t)
+      {
+        file.getSlab(dst, start, size);
+      }
+    };
+  }
+
+  /**
+   * Read a slab of the currently open dataset, converting it from its
+   * stored numeric type into NumT. Values are converted as by
+   * static_cast, so floating point data read as an integer type is
+   * truncated.
+   *
+   * \param file The file with the dataset open.
+   * \param data Where to put the data; must hold the volume of \a size.
+   * \param start The offset of the slab within the dataset.
+   * \param size The size of the slab.
+   * \param buffer_bytes Size of the buffer for data in its stored type.
+   * \tparam NumT numeric data type of \a data
+   * \throw Exception if the data is not numeric or the slab is invalid.
+   */
+  template <typename NumT>
+  void getSlabCoerce(File& file, NumT* data, const std::vector<int64_t>& start,
+                     const std::vector<int64_t>& size,
+                     const size_t buffer_bytes = COERCE_BUFFER_BYTES)
+  {
+    if (size.empty() || start.size() != size.size())
+      throw Exception("getSlabCoerce: start and size must have the rank of the data");
+    for (size_t i = 0; i < size.size(); i++)
+    {
+      if (size[i] <= 0)
+        return;
+    }
+
+    const NXnumtype type = file.getInfo().type;
+    switch (type)
+    {
+      case INT8:    CoerceImpl::SlabReader<int8_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case UINT8:   CoerceImpl::SlabReader<uint8_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case INT16:   CoerceImpl::SlabReader<int16_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case UINT16:  CoerceImpl::SlabReader<uint16_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case INT32:   CoerceImpl::SlabReader<int32_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case UINT32:  CoerceImpl::SlabReader<uint32_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case INT64:   CoerceImpl::SlabReader<int64_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case UINT64:  CoerceImpl::SlabReader<uint64_t, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case FLOAT32: CoerceImpl::SlabReader<float, NumT>::read(file, data, start, size, buffer_bytes); break;
+      case FLOAT64: CoerceImpl::SlabReader<double, NumT>::read(file, data, start, size, buffer_bytes); break;
+      default:
+        throw Exception("getSlabCoerce: data is not numeric");
+    }
+  }
+
+  /**
+   * Read a slab of the currently open dataset into a vector, converting
+   * it from its stored numeric type into NumT. The vector is resized to
+   * the volume of \a size.
+   *
+   * \tparam NumT numeric data type of \a data
+   */
+  template <typename NumT>
+  void getSlabCoerce(File& file, std::vector<NumT>& data, const std::vector<int64_t>& start,
+                     const std::vector<int64_t>& size,
+                     const size_t buffer_bytes = COERCE_BUFFER_BYTES)
+  {
+    int64_t n = 1;
+    for (size_t i = 0; i < size.size(); i++)
+      n *= std::max<int64_t>(size[i], 0);
+    data.resize(size_t(n));
+    if (n > 0)
+      getSlabCoerce(file, &data[0], start, size, buffer_bytes);
+  }
+
+  /**
+   * Read the whole of the currently open dataset into a vector,
+   * converting it from its stored numeric type into NumT. Works for any
+   * numeric NumT, unlike File::getDataCoerce(), and never holds a full
+   * copy of the data in its stored type.
+   *
+   * \tparam NumT numeric data type of \a data
+   */
+  template <typename NumT>
+  void getDataCoerce(File& file, std::vector<NumT>& data,
+                     const size_t buffer_bytes = COERCE_BUFFER_BYTES)
+  {
+    const Info info = file.getInfo();
+    const std::vector<int64_t> start(info.dims.size(), 0);
+    getSlabCoerce(file, data, start, info.dims, buffer_bytes);
+  }
+
+} // NeXus
+
+#endif /* NEXUS_COERCE_HPP */
@@ -0,0 +1,367 @@
+#ifndef NEXUS_LAYOUT_HPP
+#define NEXUS_LAYOUT_HPP
+//
+//  NeXus - Neutron & X-ray Common Data Format
+//
+//  Compile-time description of NeXus groups mapped to C++ structs
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free
+//  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+//  MA  02111-1307  USA
+//
+//  For further information, see http://www.nexusformat.org/
+//
+
+/**
+ * \file NeXusLayout.hpp
+ * Header for writing and reading C++ structs as NeXus groups, using a
+ * description of the struct given at compile time. This is an
+ * alternative to the IOStream like interface in NeXusStream.hpp for
+ * data written at high rates: a whole tree is written or read in one
+ * pass, without the per field heap objects of the stream interface.
+ *
+ * A struct is described by specialising NeXus::Layout::Group; the same
+ * description is used for writing and reading. Attributes given after
+ * a field are attached to that field while it is still open; attributes
+ * given before the first field are attached to the group. Attributes
+ * with constant values are written, and skipped when reading.
+ *
+ * \code
+ * struct Frame { double time; std::vector<float> counts; Monitor monitor; };
+ *
+ * namespace NeXus { namespace Layout {
+ *   template<> struct Group<Frame>
+ *   {
+ *     static const char* nxclass() { return "NXcollection"; }
+ *     template<typename V, typename T> static void fields(V& v, T& x)
+ *     {
+ *       v.field("time", x.time).attr("units", "s");
+ *       v.field("counts", x.counts);
+ *       v.group("monitor", x.monitor);
+ *     }
+ *   };
+ * } }
+ *
+ * NeXus::Layout::write(file, "frame_0", frame);
+ * NeXus::Layout::read(file, "frame_0", frame);
+ * \endcode
+ * \ingroup cpp_main
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "NeXusFile.hpp"
+#include "NeXusException.hpp"
+
+namespace NeXus
+{
+namespace Layout
+{
+  /**
+   * Description of a struct mapped to a NeXus group; specialise this for
+   * each struct. A specialisation provides
+   * \li static const char* nxclass(), the NeXus class of the group
+   * \li template<typename V, typename T> static void fields(V& v, T& x),
+   * which calls v.field(), v.attr() and v.group() for the members of x;
+   * T is const for writing.
+   * \ingroup cpp_core
+   */
+  template <typename T>
+  struct Group;
+
+  /**
+   * Writes structs described by Group into the currently open group of a
+   * file. The buffers used for names, dimensions and attribute
+   * descriptions are reused across fields, so that after the first
+   * write no heap allocation is made by this class.
+   * \ingroup cpp_core
+   */
+  class Writer
+  {
+  private:
+    File& m_file;
+    std::string m_name;
+    std::vector<int64_t> m_dims;
+    AttrInfo m_attr;
+    bool m_data_open;
+
+    Writer(const Writer&);
+    Writer& operator=(const Writer&);
+
+    void closeOpenData()
+    {
+      if (m_data_open)
+      {
+        m_data_open = false;
+        m_file.closeData();
+      }
+    }
+
+    void putData(const char* name, const NXnumtype type, const int64_t length, const void* data)
+    {
+      closeOpenData();
+      m_name.assign(name);
+      m_dims.resize(1);
+      m_dims[0] = length;
+      m_file.makeData(m_name, type, m_dims, true);
+      m_data_open = true;
+      m_file.putData(data);
+    }
+
+    void putAttr(const char* name, const NXnumtype type, const unsigned length, const void* data)
+    {
+      m_attr.name.assign(name);
+      m_attr.type = type;
+      m_attr.length = length;
+      m_file.putAttr(m_attr, data);
+    }
+
+  public:
+    explicit Writer(File& file) : m_file(file), m_data_open(false)
+    {
+    }
+
+    ~Writer()
+    {
+      // an exception may be propagating from a failed write
+      if (m_data_open)
+      {
+        try { m_file.closeData(); } catch (...) { }
+      }
+    }
+
+    /** Write a scalar as a dataset of length 1. */
+    template <typename NumT>
+    Writer& field(const char* name, const NumT& value)
+    {
+      putData(name, getType<NumT>(), 1, &value);
+      return *this;
+    }
+
+    /** Write a vector as a one dimensional dataset; the vector must not be empty. */
+    template <typename NumT>
+    Writer& field(const char* name, const std::vector<NumT>& value)
+    {
+      if (value.empty())
+        throw Exception(std::string("Layout::Writer: empty vector for ") + name);
+      putData(name, getType<NumT>(), int64_t(value.size()), &value[0]);
+      return *this;
+    }
+
+    /** Write a string as a CHAR dataset; an empty string is written as a space, as File::writeData does. */
+    Writer& field(const char* name, const std::string& value)
+    {
+      if (value.empty())
+        putData(name, CHAR, 1, " ");
+      else
+        putData(name, CHAR, int64_t(value.size()), value.data());
+      return *this;
+    }
+
+    /** Attach a scalar attribute to the last field, or to the group before the first field. */
+    template <typename NumT>
+    Writer& attr(const char* name, const NumT& value)
+    {
+      putAttr(name, getType<NumT>(), 1, &value);
+      return *this;
+    }
+
+    /** Attach a string attribute to the last field, or to the group before the first field. */
+    Writer& attr(const char* name, const char* value)
+    {
+      putAttr(name, CHAR, unsigned(std::strlen(value)), value);
+      return *this;
+    }
+
+    /** Attach a string attribute to the last field, or to the group before the first field. */
+    Writer& attr(const char* name, const std::string& value)
+    {
+      putAttr(name, CHAR, unsigned(value.size()), value.c_str());
+      return *this;
+    }
+
+    /** Write a struct described by Group as a subgroup. */
+    template <typename T>
+    Writer& group(const char* name, const T& value)
+    {
+      closeOpenData();
+      m_name.assign(name);
+      m_file.makeGroup(m_name, Group<T>::nxclass(), true);
+      Group<T>::fields(*this, value);
+      closeOpenData();
+      m_file.closeGroup();
+      return *this;
+    }
+  };
+
+  /**
+   * Reads structs described by Group from the currently open group of a
+   * file. Scalars and attributes are read directly into the struct;
+   * vectors and strings are resized to the size stored in the file.
+   * \ingroup cpp_core
+   */
+  class Reader
+  {
+  private:
+    File& m_file;
+    std::string m_name;
+    AttrInfo m_attr;
+    bool m_data_open;
+
+    Reader(const Reader&);
+    Reader& operator=(const Reader&);
+
+    void closeOpenData()
+    {
+      if (m_data_open)
+      {
+        m_data_open = false;
+        m_file.closeData();
+      }
+    }
+
+    /** Open a dataset, check its type and return its number of elements. */
+    int64_t openData(const char* name, const NXnumtype type)
+    {
+      closeOpenData();
+      m_name.assign(name);
+      m_file.openData(m_name);
+      m_data_open = true;
+      const Info info = m_file.getInfo();
+      if (info.type != type)
+        throw Exception(std::string("Layout::Reader: unexpected type for ") + name);
+      int64_t n = 1;
+      for (size_t i = 0; i < info.dims.size(); i++)
+        n *= info.dims[i];
+      return n;
+    }
+
+  public:
+    explicit Reader(File& file) : m_file(file), m_data_open(false)
+    {
+    }
+
+    ~Reader()
+    {
+      // an exception may be propagating from a failed read
+      if (m_data_open)
+      {
+        try { m_file.closeData(); } catch (...) { }
+      }
+    }
+
+    /** Read a scalar from a dataset of length 1. */
+    template <typename NumT>
+    Reader& field(const char* name, NumT& value)
+    {
+      if (openData(name, getType<NumT>()) != 1)
+        throw Exception(std::string("Layout::Reader: expected a scalar for ") + name);
+      m_file.getData(&value);
+      return *this;
+    }
+
+    /** Read a dataset into a vector. */
+    template <typename NumT>
+    Reader& field(const char* name, std::vector<NumT>& value)
+    {
+      value.resize(size_t(openData(name, getType<NumT>())));
+      if (!value.empty())
+        m_file.getData(&value[0]);
+      return *this;
+    }
+
+    /** Read a CHAR dataset into a string. */
+    Reader& field(const char* name, std::string& value)
+    {
+      value.resize(size_t(openData(name, CHAR)));
+      if (!value.empty())
+        m_file.getData(&value[0]);
+      return *this;
+    }
+
+    /** Read a scalar attribute of the last field, or of the group before the first field. */
+    template <typename NumT>
+    Reader& attr(const char* name, NumT& value)
+    {
+      m_attr.name.assign(name);
+      m_attr.type = getType<NumT>();
+      m_attr.length = 1;
+      m_file.getAttr(m_attr, &value);
+      return *this;
+    }
+
+    /** Read a string attribute of the last field, or of the group before the first field. */
+    Reader& attr(const char* name, std::string& value)
+    {
+      m_attr.name.assign(name);
+      m_file.getAttr(m_attr.name, value);
+      return *this;
+    }
+
+    /** Attributes with constant values are not read back. */
+    template <typename NumT>
+    Reader& attr(const char*, const NumT&)
+    {
+      return *this;
+    }
+
+    /** Attributes with constant values are not read back. */
+    Reader& attr(const char*, const char*)
+    {
+      return *this;
+    }
+
+    /** Read a subgroup into a struct described by Group. */
+    template <typename T>
+    Reader& group(const char* name, T& value)
+    {
+      closeOpenData();
+      m_name.assign(name);
+      m_file.openGroup(m_name, Group<T>::nxclass());
+      Group<T>::fields(*this, value);
+      closeOpenData();
+      m_file.closeGroup();
+      return *this;
+    }
+  };
+
+  /**
+   * Write a struct described by Group as a new group in the currently
+   * open group of a file.
+   * \ingroup cpp_core
+   */
+  template <typename T>
+  void write(File& file, const char* name, const T& value)
+  {
+    Writer writer(file);
+    writer.group(name, value);
+  }
+
+  /**
+   * Read a struct described by Group from a group in the currently open
+   * group of a file.
+   * \ingroup cpp_core
+   */
+  template <typename T>
+  void read(File& file, const char* name, T& value)
+  {
+    Reader reader(file);
+    reader.group(name, value);
+  }
+
+} // Layout
+} // NeXus
+
+#endif /* NEXUS_LAYOUT_HPP */
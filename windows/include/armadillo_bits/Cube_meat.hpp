@@ -1958,25 +1958,33 @@ Cube<eT>::each_slice(const std::function< void(Mat<eT>&) >& F, const bool use_mp
   {
   arma_extra_debug_sigprint();
   
-  if((use_mp == false) || (arma_config::openmp == false))
+  if( (use_mp == false) || (mp_thread_limit::in_parallel()) || (mp_hint::get() == 1) )
     {
     return (*this).each_slice(F);
     }
   
-  #if defined(ARMA_USE_OPENMP)
+  struct each_slice_task : public mp_task
     {
-    const uword local_n_slices = n_slices;
-    const int   n_threads      = mp_thread_limit::get();
+    const Cube<eT>& X;
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice_id=0; slice_id < local_n_slices; ++slice_id)
+    const std::function< void(Mat<eT>&) >& F;
+    
+    inline each_slice_task(const Cube<eT>& in_X, const std::function< void(Mat<eT>&) >& in_F) : X(in_X), F(in_F) {}
+    
+    inline
+    void
+    run(const uword start, const uword endp1) const
       {
-      Mat<eT> tmp('j', slice_memptr(slice_id), n_rows, n_cols);
-      
-      F(tmp);
+      for(uword slice_id=start; slice_id < endp1; ++slice_id)
+        {
+        Mat<eT> tmp('j', X.slice_memptr(slice_id), X.n_rows, X.n_cols);
+        
+        F(tmp);
+        }
       }
-    }
-  #endif
+    };
+  
+  mp_task_runner::run(n_slices, each_slice_task(*this, F));
   
   return *this;
   }
@@ -1990,25 +1998,33 @@ Cube<eT>::each_slice(const std::function< void(const Mat<eT>&) >& F, const bool
   {
   arma_extra_debug_sigprint();
   
-  if((use_mp == false) || (arma_config::openmp == false))
+  if( (use_mp == false) || (mp_thread_limit::in_parallel()) || (mp_hint::get() == 1) )
     {
     return (*this).each_slice(F);
     }
   
-  #if defined(ARMA_USE_OPENMP)
+  struct each_slice_task : public mp_task
     {
-    const uword local_n_slices = n_slices;
-    const int   n_threads      = mp_thread_limit::get();
+    const Cube<eT>& X;
+    
+    const std::function< void(const Mat<eT>&) >& F;
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice_id=0; slice_id < local_n_slices; ++slice_id)
+    inline each_slice_task(const Cube<eT>& in_X, const std::function< void(const Mat<eT>&) >& in_F) : X(in_X), F(in_F) {}
+    
+    inline
+    void
+    run(const uword start, const uword endp1) const
       {
-      Mat<eT> tmp('j', slice_memptr(slice_id), n_rows, n_cols);
-      
-      F(tmp);
+      for(uword slice_id=start; slice_id < endp1; ++slice_id)
+        {
+        Mat<eT> tmp('j', X.slice_memptr(slice_id), X.n_rows, X.n_cols);
+        
+        F(tmp);
+        }
       }
-    }
-  #endif
+    };
+  
+  mp_task_runner::run(n_slices, each_slice_task(*this, F));
   
   return *this;
   }
@@ -4480,6 +4496,10 @@ Cube<eT>::save(const std::string name, const file_type type) const
       save_okay = diskio::save_ppm_binary(*this, name);
       break;
     
+    case pfm_binary:
+      save_okay = diskio::save_pfm_binary(*this, name);
+      break;
+    
     case hdf5_binary:
       return (*this).save(hdf5_name(name));
       break;
@@ -4592,6 +4612,10 @@ Cube<eT>::save(std::ostream& os, const file_type type) const
       save_okay = diskio::save_ppm_binary(*this, os);
       break;
     
+    case pfm_binary:
+      save_okay = diskio::save_pfm_binary(*this, os);
+      break;
+    
     default:
       arma_debug_warn_level(1, "Cube::save(): unsupported file type");
       save_okay = false;
@@ -4642,6 +4666,10 @@ Cube<eT>::load(const std::string name, const file_type type)
       load_okay = diskio::load_ppm_binary(*this, name, err_msg);
       break;
     
+    case pfm_binary:
+      load_okay = diskio::load_pfm_binary(*this, name, err_msg);
+      break;
+    
     case hdf5_binary:
       return (*this).load(hdf5_name(name));
       break;
@@ -4764,6 +4792,10 @@ Cube<eT>::load(std::istream& is, const file_type type)
       load_okay = diskio::load_ppm_binary(*this, is, err_msg);
       break;
     
+    case pfm_binary:
+      load_okay = diskio::load_pfm_binary(*this, is, err_msg);
+      break;
+    
     default:
       arma_debug_warn_level(1, "Cube::load(): unsupported file type");
       load_okay = false;
@@ -159,6 +159,14 @@ class Mat : public Base< eT, Mat<eT> >
   template<typename T1> inline Mat& operator%=(const subview_elem1<eT,T1>& X);
   template<typename T1> inline Mat& operator/=(const subview_elem1<eT,T1>& X);
   
+  template<typename T1> inline             Mat(const subview_where<eT,T1>& X);
+  template<typename T1> inline Mat& operator= (const subview_where<eT,T1>& X);
+  template<typename T1> inline Mat& operator+=(const subview_where<eT,T1>& X);
+  template<typename T1> inline Mat& operator-=(const subview_where<eT,T1>& X);
+  template<typename T1> inline Mat& operator*=(const subview_where<eT,T1>& X);
+  template<typename T1> inline Mat& operator%=(const subview_where<eT,T1>& X);
+  template<typename T1> inline Mat& operator/=(const subview_where<eT,T1>& X);
+  
   template<typename T1, typename T2> inline             Mat(const subview_elem2<eT,T1,T2>& X);
   template<typename T1, typename T2> inline Mat& operator= (const subview_elem2<eT,T1,T2>& X);
   template<typename T1, typename T2> inline Mat& operator+=(const subview_elem2<eT,T1,T2>& X);
@@ -252,6 +260,9 @@ class Mat : public Base< eT, Mat<eT> >
   template<typename T1> arma_inline       subview_elem1<eT,T1> elem(const Base<uword,T1>& a);
   template<typename T1> arma_inline const subview_elem1<eT,T1> elem(const Base<uword,T1>& a) const;
   
+  template<typename T1> arma_inline       subview_where<eT,T1> elem_where(const Base<uword,T1>& mask);
+  template<typename T1> arma_inline const subview_where<eT,T1> elem_where(const Base<uword,T1>& mask) const;
+  
   template<typename T1> arma_inline       subview_elem1<eT,T1> operator()(const Base<uword,T1>& a);
   template<typename T1> arma_inline const subview_elem1<eT,T1> operator()(const Base<uword,T1>& a) const;
   
@@ -299,6 +310,8 @@ class Mat : public Base< eT, Mat<eT> >
   inline void swap_rows(const uword in_row1, const uword in_row2);
   inline void swap_cols(const uword in_col1, const uword in_col2);
   
+  inline void shift_inplace(const sword N, const uword dim = 0);
+  
   inline void shed_row(const uword row_num);
   inline void shed_col(const uword col_num);
   
@@ -535,6 +548,7 @@ class Mat : public Base< eT, Mat<eT> >
   inline arma_cold bool load(const std::string   name, const file_type type = auto_detect);
   inline arma_cold bool load(const hdf5_name&    spec, const file_type type = hdf5_binary);
   inline arma_cold bool load(const  csv_name&    spec, const file_type type =   csv_ascii);
+  inline arma_cold bool load(const  raw_name&    spec, const file_type type =  raw_binary);
   inline arma_cold bool load(      std::istream& is,   const file_type type = auto_detect);
   
   inline arma_cold bool quiet_save(const std::string   name, const file_type type = arma_binary) const;
@@ -545,6 +559,7 @@ class Mat : public Base< eT, Mat<eT> >
   inline arma_cold bool quiet_load(const std::string   name, const file_type type = auto_detect);
   inline arma_cold bool quiet_load(const hdf5_name&    spec, const file_type type = hdf5_binary);
   inline arma_cold bool quiet_load(const  csv_name&    spec, const file_type type =   csv_ascii);
+  inline arma_cold bool quiet_load(const  raw_name&    spec, const file_type type =  raw_binary);
   inline arma_cold bool quiet_load(      std::istream& is,   const file_type type = auto_detect);
   
   
@@ -2503,6 +2503,115 @@ Mat<eT>::operator/=(const subview_elem1<eT,T1>& X)
 
 
 
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>::Mat(const subview_where<eT,T1>& X)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_alloc(0)
+  , vec_state(0)
+  , mem_state(0)
+  , mem()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  this->operator=(X);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>&
+Mat<eT>::operator=(const subview_where<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  subview_where<eT,T1>::extract(*this, X);
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>&
+Mat<eT>::operator+=(const subview_where<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Mat<eT> tmp(X);
+  
+  return (*this).operator+=(tmp);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>&
+Mat<eT>::operator-=(const subview_where<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Mat<eT> tmp(X);
+  
+  return (*this).operator-=(tmp);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>&
+Mat<eT>::operator*=(const subview_where<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Mat<eT> tmp(X);
+  
+  return (*this).operator*=(tmp);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>&
+Mat<eT>::operator%=(const subview_where<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Mat<eT> tmp(X);
+  
+  return (*this).operator%=(tmp);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>&
+Mat<eT>::operator/=(const subview_where<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Mat<eT> tmp(X);
+  
+  return (*this).operator/=(tmp);
+  }
+
+
+
 template<typename eT>
 template<typename T1, typename T2>
 inline
@@ -3772,6 +3881,33 @@ Mat<eT>::elem(const Base<uword,T1>& a) const
 
 
 
+//! elements selected by the non-zero elements of a mask of the same size, in column-major order
+template<typename eT>
+template<typename T1>
+arma_inline
+subview_where<eT,T1>
+Mat<eT>::elem_where(const Base<uword,T1>& mask)
+  {
+  arma_extra_debug_sigprint();
+  
+  return subview_where<eT,T1>(*this, mask);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+arma_inline
+const subview_where<eT,T1>
+Mat<eT>::elem_where(const Base<uword,T1>& mask) const
+  {
+  arma_extra_debug_sigprint();
+  
+  return subview_where<eT,T1>(*this, mask);
+  }
+
+
+
 template<typename eT>
 template<typename T1>
 arma_inline
@@ -4289,6 +4425,27 @@ Mat<eT>::swap_cols(const uword in_colA, const uword in_colB)
 
 
 
+//! circular shift of rows (dim = 0) or columns (dim = 1), without allocating a new matrix
+template<typename eT>
+inline
+void
+Mat<eT>::shift_inplace(const sword N, const uword dim)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword len = (N < 0) ? uword(-N) : uword(N);
+  const uword neg = (N < 0) ? uword( 1) : uword(0);
+  
+  arma_debug_check( (dim > 1), "Mat::shift_inplace(): parameter 'dim' must be 0 or 1" );
+  
+  arma_debug_check_bounds( ((dim == 0) && (len >= n_rows)), "Mat::shift_inplace(): shift amount out of bounds" );
+  arma_debug_check_bounds( ((dim == 1) && (len >= n_cols)), "Mat::shift_inplace(): shift amount out of bounds" );
+  
+  op_shift::apply_alias(*this, len, neg, dim);
+  }
+
+
+
 //! remove specified row
 template<typename eT>
 inline
@@ -7517,6 +7674,10 @@ Mat<eT>::save(const std::string name, const file_type type) const
       save_okay = diskio::save_pgm_binary(*this, name);
       break;
     
+    case pfm_binary:
+      save_okay = diskio::save_pfm_binary(*this, name);
+      break;
+    
     case hdf5_binary:
       return (*this).save(hdf5_name(name));
       break;
@@ -7720,6 +7881,10 @@ Mat<eT>::save(std::ostream& os, const file_type type) const
       save_okay = diskio::save_pgm_binary(*this, os);
       break;
     
+    case pfm_binary:
+      save_okay = diskio::save_pfm_binary(*this, os);
+      break;
+    
     default:
       arma_debug_warn_level(1, "Mat::save(): unsupported file type");
       save_okay = false;
@@ -7782,6 +7947,10 @@ Mat<eT>::load(const std::string name, const file_type type)
       load_okay = diskio::load_pgm_binary(*this, name, err_msg);
       break;
     
+    case pfm_binary:
+      load_okay = diskio::load_pfm_binary(*this, name, err_msg);
+      break;
+    
     case hdf5_binary:
       return (*this).load(hdf5_name(name));
       break;
@@ -7954,6 +8123,44 @@ Mat<eT>::load(const csv_name& spec, const file_type type)
 
 
 
+//! load a matrix from raw binary data with a given size, element type, byte order and offset
+template<typename eT>
+inline
+arma_cold
+bool
+Mat<eT>::load(const raw_name& spec, const file_type type)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(type != raw_binary)
+    {
+    arma_stop_runtime_error("Mat::load(): unsupported file type for raw_name()");
+    return false;
+    }
+  
+  std::string err_msg;
+  
+  const bool load_okay = diskio::load_raw_binary(*this, spec, err_msg);
+  
+  if(load_okay == false)
+    {
+    if(err_msg.length() > 0)
+      {
+      arma_debug_warn_level(3, "Mat::load(): ", err_msg, "; file: ", spec.filename);
+      }
+    else
+      {
+      arma_debug_warn_level(3, "Mat::load(): couldn't read; file: ", spec.filename);
+      }
+    
+    (*this).soft_reset();
+    }
+  
+  return load_okay;
+  }
+
+
+
 //! load a matrix from a stream
 template<typename eT>
 inline
@@ -8004,6 +8211,10 @@ Mat<eT>::load(std::istream& is, const file_type type)
       load_okay = diskio::load_pgm_binary(*this, is, err_msg);
       break;
     
+    case pfm_binary:
+      load_okay = diskio::load_pfm_binary(*this, is, err_msg);
+      break;
+    
     default:
       arma_debug_warn_level(1, "Mat::load(): unsupported file type");
       load_okay = false;
@@ -8122,6 +8333,19 @@ Mat<eT>::quiet_load(const csv_name& spec, const file_type type)
 
 
 
+template<typename eT>
+inline
+arma_cold
+bool
+Mat<eT>::quiet_load(const raw_name& spec, const file_type type)
+  {
+  arma_extra_debug_sigprint();
+  
+  return (*this).load(spec, type);
+  }
+
+
+
 //! load a matrix from a stream, without printing any error messages
 template<typename eT>
 inline
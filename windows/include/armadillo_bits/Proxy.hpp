@@ -737,6 +737,309 @@ struct Proxy< mtGlue<out_eT, T1, T2, glue_type> >
 
 
 
+template<typename out_eT, typename T1>
+struct Proxy< mtOp<out_eT, T1, op_clamp> >
+  {
+  typedef        mtOp<out_eT, T1, op_clamp>   this_mtOp_type;
+  typedef Proxy< mtOp<out_eT, T1, op_clamp> > this_Proxy_type;
+  
+  typedef typename T1::elem_type                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtOp_type                           stored_type;
+  typedef const this_Proxy_type&                   ea_type;
+  typedef const this_Proxy_type&                   aligned_ea_type;
+  
+  static constexpr bool use_at      = Proxy<T1>::use_at;
+  static constexpr bool use_mp      = Proxy<T1>::use_mp;
+  static constexpr bool has_subview = Proxy<T1>::has_subview;
+  
+  static constexpr bool is_row  = this_mtOp_type::is_row;
+  static constexpr bool is_col  = this_mtOp_type::is_col;
+  static constexpr bool is_xvec = this_mtOp_type::is_xvec;
+  
+  arma_aligned const this_mtOp_type& Q;
+  arma_aligned const Proxy<T1>       P;
+  
+  arma_aligned const elem_type min_val;
+  arma_aligned const elem_type max_val;
+  
+  inline explicit Proxy(const this_mtOp_type& X)
+    : Q      (X           )
+    , P      (X.m         )
+    , min_val(X.aux       )
+    , max_val(X.aux_out_eT)
+    {
+    arma_extra_debug_sigprint();
+    
+    arma_debug_check( (min_val > max_val), "clamp(): min_val must be less than max_val" );
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : P.get_n_rows(); }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : P.get_n_cols(); }
+  arma_inline uword get_n_elem() const { return P.get_n_elem();              }
+  
+  arma_inline elem_type operator[] (const uword i)                const { const elem_type val = P[i];        return (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+  arma_inline elem_type at         (const uword r, const uword c) const { const elem_type val = P.at(r,c);   return (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+  arma_inline elem_type at_alt     (const uword i)                const { const elem_type val = P.at_alt(i); return (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT2>
+  arma_inline bool is_alias(const Mat<eT2>& X) const { return P.is_alias(X); }
+  
+  template<typename eT2>
+  arma_inline bool has_overlap(const subview<eT2>& X) const { return P.has_overlap(X); }
+  
+  arma_inline bool is_aligned() const { return P.is_aligned(); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct Proxy< mtGlue<out_eT, T1, T2, glue_mixed_plus> >
+  {
+  typedef        mtGlue<out_eT, T1, T2, glue_mixed_plus>   this_mtGlue_type;
+  typedef Proxy< mtGlue<out_eT, T1, T2, glue_mixed_plus> > this_Proxy_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlue_type                         stored_type;
+  typedef const this_Proxy_type&                   ea_type;
+  typedef const this_Proxy_type&                   aligned_ea_type;
+  
+  static constexpr bool use_at      = (Proxy<T1>::use_at      || Proxy<T2>::use_at     );
+  static constexpr bool use_mp      = (Proxy<T1>::use_mp      || Proxy<T2>::use_mp     );
+  static constexpr bool has_subview = (Proxy<T1>::has_subview || Proxy<T2>::has_subview);
+  
+  static constexpr bool is_row  = this_mtGlue_type::is_row;
+  static constexpr bool is_col  = this_mtGlue_type::is_col;
+  static constexpr bool is_xvec = this_mtGlue_type::is_xvec;
+  
+  arma_aligned const this_mtGlue_type& Q;
+  arma_aligned const Proxy<T1>         P1;
+  arma_aligned const Proxy<T2>         P2;
+  
+  inline explicit Proxy(const this_mtGlue_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "addition");
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : P1.get_n_rows(); }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : P1.get_n_cols(); }
+  arma_inline uword get_n_elem() const { return P1.get_n_elem();              }
+  
+  arma_inline elem_type operator[] (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1[i]       ) + upgrade_val<eT1,eT2>::apply(P2[i]       ); }
+  arma_inline elem_type at         (const uword r, const uword c) const { return upgrade_val<eT1,eT2>::apply(P1.at(r,c)  ) + upgrade_val<eT1,eT2>::apply(P2.at(r,c)  ); }
+  arma_inline elem_type at_alt     (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)) + upgrade_val<eT1,eT2>::apply(P2.at_alt(i)); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Mat<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct Proxy< mtGlue<out_eT, T1, T2, glue_mixed_minus> >
+  {
+  typedef        mtGlue<out_eT, T1, T2, glue_mixed_minus>   this_mtGlue_type;
+  typedef Proxy< mtGlue<out_eT, T1, T2, glue_mixed_minus> > this_Proxy_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlue_type                         stored_type;
+  typedef const this_Proxy_type&                   ea_type;
+  typedef const this_Proxy_type&                   aligned_ea_type;
+  
+  static constexpr bool use_at      = (Proxy<T1>::use_at      || Proxy<T2>::use_at     );
+  static constexpr bool use_mp      = (Proxy<T1>::use_mp      || Proxy<T2>::use_mp     );
+  static constexpr bool has_subview = (Proxy<T1>::has_subview || Proxy<T2>::has_subview);
+  
+  static constexpr bool is_row  = this_mtGlue_type::is_row;
+  static constexpr bool is_col  = this_mtGlue_type::is_col;
+  static constexpr bool is_xvec = this_mtGlue_type::is_xvec;
+  
+  arma_aligned const this_mtGlue_type& Q;
+  arma_aligned const Proxy<T1>         P1;
+  arma_aligned const Proxy<T2>         P2;
+  
+  inline explicit Proxy(const this_mtGlue_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "subtraction");
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : P1.get_n_rows(); }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : P1.get_n_cols(); }
+  arma_inline uword get_n_elem() const { return P1.get_n_elem();              }
+  
+  arma_inline elem_type operator[] (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1[i]       ) - upgrade_val<eT1,eT2>::apply(P2[i]       ); }
+  arma_inline elem_type at         (const uword r, const uword c) const { return upgrade_val<eT1,eT2>::apply(P1.at(r,c)  ) - upgrade_val<eT1,eT2>::apply(P2.at(r,c)  ); }
+  arma_inline elem_type at_alt     (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)) - upgrade_val<eT1,eT2>::apply(P2.at_alt(i)); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Mat<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct Proxy< mtGlue<out_eT, T1, T2, glue_mixed_div> >
+  {
+  typedef        mtGlue<out_eT, T1, T2, glue_mixed_div>   this_mtGlue_type;
+  typedef Proxy< mtGlue<out_eT, T1, T2, glue_mixed_div> > this_Proxy_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlue_type                         stored_type;
+  typedef const this_Proxy_type&                   ea_type;
+  typedef const this_Proxy_type&                   aligned_ea_type;
+  
+  static constexpr bool use_at      = (Proxy<T1>::use_at      || Proxy<T2>::use_at     );
+  static constexpr bool use_mp      = (Proxy<T1>::use_mp      || Proxy<T2>::use_mp     );
+  static constexpr bool has_subview = (Proxy<T1>::has_subview || Proxy<T2>::has_subview);
+  
+  static constexpr bool is_row  = this_mtGlue_type::is_row;
+  static constexpr bool is_col  = this_mtGlue_type::is_col;
+  static constexpr bool is_xvec = this_mtGlue_type::is_xvec;
+  
+  arma_aligned const this_mtGlue_type& Q;
+  arma_aligned const Proxy<T1>         P1;
+  arma_aligned const Proxy<T2>         P2;
+  
+  inline explicit Proxy(const this_mtGlue_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "element-wise division");
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : P1.get_n_rows(); }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : P1.get_n_cols(); }
+  arma_inline uword get_n_elem() const { return P1.get_n_elem();              }
+  
+  arma_inline elem_type operator[] (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1[i]       ) / upgrade_val<eT1,eT2>::apply(P2[i]       ); }
+  arma_inline elem_type at         (const uword r, const uword c) const { return upgrade_val<eT1,eT2>::apply(P1.at(r,c)  ) / upgrade_val<eT1,eT2>::apply(P2.at(r,c)  ); }
+  arma_inline elem_type at_alt     (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)) / upgrade_val<eT1,eT2>::apply(P2.at_alt(i)); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Mat<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct Proxy< mtGlue<out_eT, T1, T2, glue_mixed_schur> >
+  {
+  typedef        mtGlue<out_eT, T1, T2, glue_mixed_schur>   this_mtGlue_type;
+  typedef Proxy< mtGlue<out_eT, T1, T2, glue_mixed_schur> > this_Proxy_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlue_type                         stored_type;
+  typedef const this_Proxy_type&                   ea_type;
+  typedef const this_Proxy_type&                   aligned_ea_type;
+  
+  static constexpr bool use_at      = (Proxy<T1>::use_at      || Proxy<T2>::use_at     );
+  static constexpr bool use_mp      = (Proxy<T1>::use_mp      || Proxy<T2>::use_mp     );
+  static constexpr bool has_subview = (Proxy<T1>::has_subview || Proxy<T2>::has_subview);
+  
+  static constexpr bool is_row  = this_mtGlue_type::is_row;
+  static constexpr bool is_col  = this_mtGlue_type::is_col;
+  static constexpr bool is_xvec = this_mtGlue_type::is_xvec;
+  
+  arma_aligned const this_mtGlue_type& Q;
+  arma_aligned const Proxy<T1>         P1;
+  arma_aligned const Proxy<T2>         P2;
+  
+  inline explicit Proxy(const this_mtGlue_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "element-wise multiplication");
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : P1.get_n_rows(); }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : P1.get_n_cols(); }
+  arma_inline uword get_n_elem() const { return P1.get_n_elem();              }
+  
+  arma_inline elem_type operator[] (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1[i]       ) * upgrade_val<eT1,eT2>::apply(P2[i]       ); }
+  arma_inline elem_type at         (const uword r, const uword c) const { return upgrade_val<eT1,eT2>::apply(P1.at(r,c)  ) * upgrade_val<eT1,eT2>::apply(P2.at(r,c)  ); }
+  arma_inline elem_type at_alt     (const uword i)                const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)) * upgrade_val<eT1,eT2>::apply(P2.at_alt(i)); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Mat<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
 template<typename T1, typename op_type>
 struct Proxy< CubeToMatOp<T1, op_type> >
   {
@@ -1173,6 +1476,53 @@ struct Proxy< subview_elem1<eT,T1> >
 
 
 
+template<typename eT, typename T1>
+struct Proxy< subview_where<eT,T1> >
+  {
+  typedef eT                                       elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef Mat<eT>                                  stored_type;
+  typedef const eT*                                ea_type;
+  typedef const Mat<eT>&                           aligned_ea_type;
+  
+  static constexpr bool use_at      = false;
+  static constexpr bool use_mp      = false;
+  static constexpr bool has_subview = false;
+  
+  static constexpr bool is_row  = false;
+  static constexpr bool is_col  = true;
+  static constexpr bool is_xvec = false;
+  
+  arma_aligned const Mat<eT> Q;
+  
+  inline explicit Proxy(const subview_where<eT,T1>& A)
+    : Q(A)
+    {
+    arma_extra_debug_sigprint();
+    }
+  
+  arma_inline uword get_n_rows() const { return Q.n_rows; }
+  constexpr   uword get_n_cols() const { return 1;        }
+  arma_inline uword get_n_elem() const { return Q.n_elem; }
+  
+  arma_inline elem_type operator[] (const uword i)              const { return Q[i];           }
+  arma_inline elem_type at         (const uword r, const uword) const { return Q[r];           }
+  arma_inline elem_type at_alt     (const uword i)              const { return Q.at_alt(i);    }
+  
+  arma_inline         ea_type         get_ea() const { return Q.memptr(); }
+  arma_inline aligned_ea_type get_aligned_ea() const { return Q;          }
+  
+  template<typename eT2>
+  constexpr bool is_alias(const Mat<eT2>&) const { return false; }
+  
+  template<typename eT2>
+  constexpr bool has_overlap(const subview<eT2>&) const { return false; }
+  
+  arma_inline bool is_aligned() const { return memory::is_aligned(Q.memptr()); }
+  };
+
+
+
 template<typename eT, typename T1, typename T2>
 struct Proxy< subview_elem2<eT,T1,T2> >
   {
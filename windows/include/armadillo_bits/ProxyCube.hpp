@@ -485,4 +485,297 @@ struct ProxyCube< mtGlueCube<out_eT, T1, T2, glue_type > >
 
 
 
+template<typename out_eT, typename T1>
+struct ProxyCube< mtOpCube<out_eT, T1, op_clamp> >
+  {
+  typedef            mtOpCube<out_eT, T1, op_clamp>   this_mtOpCube_type;
+  typedef ProxyCube< mtOpCube<out_eT, T1, op_clamp> > this_ProxyCube_type;
+  
+  typedef typename T1::elem_type                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtOpCube_type                       stored_type;
+  typedef const this_ProxyCube_type&               ea_type;
+  typedef const this_ProxyCube_type&               aligned_ea_type;
+  
+  static constexpr bool use_at      = ProxyCube<T1>::use_at;
+  static constexpr bool use_mp      = ProxyCube<T1>::use_mp;
+  static constexpr bool has_subview = ProxyCube<T1>::has_subview;
+  
+  arma_aligned const this_mtOpCube_type& Q;
+  arma_aligned const ProxyCube<T1>       P;
+  
+  arma_aligned const elem_type min_val;
+  arma_aligned const elem_type max_val;
+  
+  inline explicit ProxyCube(const this_mtOpCube_type& X)
+    : Q      (X           )
+    , P      (X.m         )
+    , min_val(X.aux       )
+    , max_val(X.aux_out_eT)
+    {
+    arma_extra_debug_sigprint();
+    
+    arma_debug_check( (min_val > max_val), "clamp(): min_val must be less than max_val" );
+    }
+  
+  arma_inline uword get_n_rows()       const { return P.get_n_rows();       }
+  arma_inline uword get_n_cols()       const { return P.get_n_cols();       }
+  arma_inline uword get_n_elem_slice() const { return P.get_n_elem_slice(); }
+  arma_inline uword get_n_slices()     const { return P.get_n_slices();     }
+  arma_inline uword get_n_elem()       const { return P.get_n_elem();       }
+  
+  arma_inline elem_type operator[] (const uword i)                               const { const elem_type val = P[i];          return (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+  arma_inline elem_type at         (const uword r, const uword c, const uword s) const { const elem_type val = P.at(r, c, s); return (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+  arma_inline elem_type at_alt     (const uword i)                               const { const elem_type val = P.at_alt(i);   return (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT2>
+  arma_inline bool is_alias(const Cube<eT2>& X) const { return P.is_alias(X); }
+  
+  template<typename eT2>
+  arma_inline bool has_overlap(const subview_cube<eT2>& X) const { return P.has_overlap(X); }
+  
+  arma_inline bool is_aligned() const { return P.is_aligned(); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_plus> >
+  {
+  typedef            mtGlueCube<out_eT, T1, T2, glue_mixed_plus>   this_mtGlueCube_type;
+  typedef ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_plus> > this_ProxyCube_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlueCube_type                     stored_type;
+  typedef const this_ProxyCube_type&               ea_type;
+  typedef const this_ProxyCube_type&               aligned_ea_type;
+  
+  static constexpr bool use_at      = (ProxyCube<T1>::use_at      || ProxyCube<T2>::use_at     );
+  static constexpr bool use_mp      = (ProxyCube<T1>::use_mp      || ProxyCube<T2>::use_mp     );
+  static constexpr bool has_subview = (ProxyCube<T1>::has_subview || ProxyCube<T2>::has_subview);
+  
+  arma_aligned const this_mtGlueCube_type& Q;
+  arma_aligned const ProxyCube<T1>         P1;
+  arma_aligned const ProxyCube<T2>         P2;
+  
+  inline explicit ProxyCube(const this_mtGlueCube_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "addition");
+    }
+  
+  arma_inline uword get_n_rows()       const { return P1.get_n_rows();       }
+  arma_inline uword get_n_cols()       const { return P1.get_n_cols();       }
+  arma_inline uword get_n_elem_slice() const { return P1.get_n_elem_slice(); }
+  arma_inline uword get_n_slices()     const { return P1.get_n_slices();     }
+  arma_inline uword get_n_elem()       const { return P1.get_n_elem();       }
+  
+  arma_inline elem_type operator[] (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1[i]         ) + upgrade_val<eT1,eT2>::apply(P2[i]         ); }
+  arma_inline elem_type at         (const uword r, const uword c, const uword s) const { return upgrade_val<eT1,eT2>::apply(P1.at(r, c, s)) + upgrade_val<eT1,eT2>::apply(P2.at(r, c, s)); }
+  arma_inline elem_type at_alt     (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)  ) + upgrade_val<eT1,eT2>::apply(P2.at_alt(i)  ); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Cube<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview_cube<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_minus> >
+  {
+  typedef            mtGlueCube<out_eT, T1, T2, glue_mixed_minus>   this_mtGlueCube_type;
+  typedef ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_minus> > this_ProxyCube_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlueCube_type                     stored_type;
+  typedef const this_ProxyCube_type&               ea_type;
+  typedef const this_ProxyCube_type&               aligned_ea_type;
+  
+  static constexpr bool use_at      = (ProxyCube<T1>::use_at      || ProxyCube<T2>::use_at     );
+  static constexpr bool use_mp      = (ProxyCube<T1>::use_mp      || ProxyCube<T2>::use_mp     );
+  static constexpr bool has_subview = (ProxyCube<T1>::has_subview || ProxyCube<T2>::has_subview);
+  
+  arma_aligned const this_mtGlueCube_type& Q;
+  arma_aligned const ProxyCube<T1>         P1;
+  arma_aligned const ProxyCube<T2>         P2;
+  
+  inline explicit ProxyCube(const this_mtGlueCube_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "subtraction");
+    }
+  
+  arma_inline uword get_n_rows()       const { return P1.get_n_rows();       }
+  arma_inline uword get_n_cols()       const { return P1.get_n_cols();       }
+  arma_inline uword get_n_elem_slice() const { return P1.get_n_elem_slice(); }
+  arma_inline uword get_n_slices()     const { return P1.get_n_slices();     }
+  arma_inline uword get_n_elem()       const { return P1.get_n_elem();       }
+  
+  arma_inline elem_type operator[] (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1[i]         ) - upgrade_val<eT1,eT2>::apply(P2[i]         ); }
+  arma_inline elem_type at         (const uword r, const uword c, const uword s) const { return upgrade_val<eT1,eT2>::apply(P1.at(r, c, s)) - upgrade_val<eT1,eT2>::apply(P2.at(r, c, s)); }
+  arma_inline elem_type at_alt     (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)  ) - upgrade_val<eT1,eT2>::apply(P2.at_alt(i)  ); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Cube<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview_cube<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_div> >
+  {
+  typedef            mtGlueCube<out_eT, T1, T2, glue_mixed_div>   this_mtGlueCube_type;
+  typedef ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_div> > this_ProxyCube_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlueCube_type                     stored_type;
+  typedef const this_ProxyCube_type&               ea_type;
+  typedef const this_ProxyCube_type&               aligned_ea_type;
+  
+  static constexpr bool use_at      = (ProxyCube<T1>::use_at      || ProxyCube<T2>::use_at     );
+  static constexpr bool use_mp      = (ProxyCube<T1>::use_mp      || ProxyCube<T2>::use_mp     );
+  static constexpr bool has_subview = (ProxyCube<T1>::has_subview || ProxyCube<T2>::has_subview);
+  
+  arma_aligned const this_mtGlueCube_type& Q;
+  arma_aligned const ProxyCube<T1>         P1;
+  arma_aligned const ProxyCube<T2>         P2;
+  
+  inline explicit ProxyCube(const this_mtGlueCube_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "element-wise division");
+    }
+  
+  arma_inline uword get_n_rows()       const { return P1.get_n_rows();       }
+  arma_inline uword get_n_cols()       const { return P1.get_n_cols();       }
+  arma_inline uword get_n_elem_slice() const { return P1.get_n_elem_slice(); }
+  arma_inline uword get_n_slices()     const { return P1.get_n_slices();     }
+  arma_inline uword get_n_elem()       const { return P1.get_n_elem();       }
+  
+  arma_inline elem_type operator[] (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1[i]         ) / upgrade_val<eT1,eT2>::apply(P2[i]         ); }
+  arma_inline elem_type at         (const uword r, const uword c, const uword s) const { return upgrade_val<eT1,eT2>::apply(P1.at(r, c, s)) / upgrade_val<eT1,eT2>::apply(P2.at(r, c, s)); }
+  arma_inline elem_type at_alt     (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)  ) / upgrade_val<eT1,eT2>::apply(P2.at_alt(i)  ); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Cube<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview_cube<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2>
+struct ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_schur> >
+  {
+  typedef            mtGlueCube<out_eT, T1, T2, glue_mixed_schur>   this_mtGlueCube_type;
+  typedef ProxyCube< mtGlueCube<out_eT, T1, T2, glue_mixed_schur> > this_ProxyCube_type;
+  
+  typedef typename T1::elem_type eT1;
+  typedef typename T2::elem_type eT2;
+  
+  typedef out_eT                                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef this_mtGlueCube_type                     stored_type;
+  typedef const this_ProxyCube_type&               ea_type;
+  typedef const this_ProxyCube_type&               aligned_ea_type;
+  
+  static constexpr bool use_at      = (ProxyCube<T1>::use_at      || ProxyCube<T2>::use_at     );
+  static constexpr bool use_mp      = (ProxyCube<T1>::use_mp      || ProxyCube<T2>::use_mp     );
+  static constexpr bool has_subview = (ProxyCube<T1>::has_subview || ProxyCube<T2>::has_subview);
+  
+  arma_aligned const this_mtGlueCube_type& Q;
+  arma_aligned const ProxyCube<T1>         P1;
+  arma_aligned const ProxyCube<T2>         P2;
+  
+  inline explicit ProxyCube(const this_mtGlueCube_type& X)
+    : Q (X  )
+    , P1(X.A)
+    , P2(X.B)
+    {
+    arma_extra_debug_sigprint();
+    
+    promote_type<eT1,eT2>::check();
+    
+    arma_debug_assert_same_size(P1, P2, "element-wise multiplication");
+    }
+  
+  arma_inline uword get_n_rows()       const { return P1.get_n_rows();       }
+  arma_inline uword get_n_cols()       const { return P1.get_n_cols();       }
+  arma_inline uword get_n_elem_slice() const { return P1.get_n_elem_slice(); }
+  arma_inline uword get_n_slices()     const { return P1.get_n_slices();     }
+  arma_inline uword get_n_elem()       const { return P1.get_n_elem();       }
+  
+  arma_inline elem_type operator[] (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1[i]         ) * upgrade_val<eT1,eT2>::apply(P2[i]         ); }
+  arma_inline elem_type at         (const uword r, const uword c, const uword s) const { return upgrade_val<eT1,eT2>::apply(P1.at(r, c, s)) * upgrade_val<eT1,eT2>::apply(P2.at(r, c, s)); }
+  arma_inline elem_type at_alt     (const uword i)                               const { return upgrade_val<eT1,eT2>::apply(P1.at_alt(i)  ) * upgrade_val<eT1,eT2>::apply(P2.at_alt(i)  ); }
+  
+  arma_inline         ea_type         get_ea() const { return *this; }
+  arma_inline aligned_ea_type get_aligned_ea() const { return *this; }
+  
+  template<typename eT>
+  arma_inline bool is_alias(const Cube<eT>& X) const { return (P1.is_alias(X) || P2.is_alias(X)); }
+  
+  template<typename eT>
+  arma_inline bool has_overlap(const subview_cube<eT>& X) const { return (P1.has_overlap(X) || P2.has_overlap(X)); }
+  
+  arma_inline bool is_aligned() const { return (P1.is_aligned() && P2.is_aligned()); }
+  };
+
+
+
 //! @}
@@ -657,6 +657,7 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   
   inline void init_batch_std(const Mat<uword>& locations, const Mat<eT>& values, const bool sort_locations);
   inline void init_batch_add(const Mat<uword>& locations, const Mat<eT>& values, const bool sort_locations);
+  inline bool init_batch_mt (const Mat<uword>& locations, const Mat<eT>& values, const bool sort_locations, const bool add_values, const bool skip_zeros);
   
   inline SpMat(const arma_vec_indicator&, const uword in_vec_state);
   inline SpMat(const arma_vec_indicator&, const uword in_n_rows, const uword in_n_cols, const uword in_vec_state);
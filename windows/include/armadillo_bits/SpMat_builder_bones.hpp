@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_builder
+//! @{
+
+
+
+//! Incremental construction of a sparse matrix from coordinate lists supplied in chunks,
+//! possibly by several threads at the same time.
+//! Each chunk is given as a 2 x N matrix of locations (row indices in the first row, column indices in the second)
+//! and a vector of N values, as for the batch insertion constructors of SpMat.
+//! The chunks are combined by finalize(), which groups the entries by column in parallel when OpenMP is enabled.
+//! Chunks are processed in order of their order_key, and in order of arrival for equal keys;
+//! when values at identical locations are summed, give each chunk a distinct key (eg. the index of the block of work
+//! which generated it) to obtain identical results regardless of thread scheduling.
+template<typename eT>
+class SpMat_builder
+  {
+  public:
+  
+  typedef eT elem_type;
+  
+  const uword n_rows;
+  const uword n_cols;
+  
+  inline ~SpMat_builder();
+  inline  SpMat_builder(const uword in_n_rows, const uword in_n_cols);
+  inline  SpMat_builder(const SizeMat& s);
+  
+  SpMat_builder(const SpMat_builder&)            = delete;
+  SpMat_builder& operator=(const SpMat_builder&) = delete;
+  
+  template<typename T1, typename T2> inline void append(const Base<uword,T1>& locations, const Base<eT,T2>& values, const uword order_key = 0);
+  
+  inline uword n_entries() const;
+  
+  inline void reset();
+  
+  inline void      finalize(SpMat<eT>& out, const bool add_values = false, const bool check_for_zeros = true);
+  inline SpMat<eT> finalize(                const bool add_values = false, const bool check_for_zeros = true);
+  
+  
+  private:
+  
+  struct chunk_type
+    {
+    Mat<uword> locs;
+    Col<eT>    vals;
+    uword      order_key;
+    };
+  
+  struct chunk_order
+    {
+    inline bool operator() (const chunk_type& A, const chunk_type& B) const { return (A.order_key < B.order_key); }
+    };
+  
+  std::vector<chunk_type> chunks;
+  
+  #if (!defined(ARMA_USE_OPENMP) && !defined(ARMA_DONT_USE_STD_MUTEX))
+    mutable std::mutex chunks_mutex;
+  #endif
+  };
+
+
+
+//! @}
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_builder
+//! @{
+
+
+
+template<typename eT>
+inline
+SpMat_builder<eT>::~SpMat_builder()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_builder<eT>::SpMat_builder(const uword in_n_rows, const uword in_n_cols)
+  : n_rows(in_n_rows)
+  , n_cols(in_n_cols)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_builder<eT>::SpMat_builder(const SizeMat& s)
+  : n_rows(s.n_rows)
+  , n_cols(s.n_cols)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+//! add a chunk of entries; may be called by several threads at the same time
+template<typename eT>
+template<typename T1, typename T2>
+inline
+void
+SpMat_builder<eT>::append(const Base<uword,T1>& locations_expr, const Base<eT,T2>& vals_expr, const uword order_key)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> locs_tmp( locations_expr.get_ref() );
+  const quasi_unwrap<T2> vals_tmp(      vals_expr.get_ref() );
+  
+  const Mat<uword>& locs = locs_tmp.M;
+  const Mat<eT>&    vals = vals_tmp.M;
+  
+  if( (locs.n_elem == 0) && (vals.n_elem == 0) )  { return; }
+  
+  arma_debug_check( (vals.is_vec() == false),     "SpMat_builder::append(): given 'values' object must be a vector"                 );
+  arma_debug_check( (locs.n_rows != 2),           "SpMat_builder::append(): locations matrix must have two rows"                    );
+  arma_debug_check( (locs.n_cols != vals.n_elem), "SpMat_builder::append(): number of locations is different than number of values" );
+  
+  // copy the entries before taking the lock, so that only the insertion into the list is serialised
+  
+  chunk_type chunk;
+  
+  chunk.locs = locs;
+  
+  chunk.vals.set_size(vals.n_elem);
+  
+  arrayops::copy(chunk.vals.memptr(), vals.memptr(), vals.n_elem);
+  
+  chunk.order_key = order_key;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp critical (arma_SpMat_builder)
+      {
+      chunks.push_back(std::move(chunk));
+      }
+    }
+  #elif (!defined(ARMA_DONT_USE_STD_MUTEX))
+    {
+    const std::lock_guard<std::mutex> lock(chunks_mutex);
+    
+    chunks.push_back(std::move(chunk));
+    }
+  #else
+    {
+    chunks.push_back(std::move(chunk));
+    }
+  #endif
+  }
+
+
+
+//! total number of entries appended so far, including entries with zero values
+template<typename eT>
+inline
+uword
+SpMat_builder<eT>::n_entries() const
+  {
+  arma_extra_debug_sigprint();
+  
+  uword count = 0;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp critical (arma_SpMat_builder)
+      {
+      for(size_t k=0; k < chunks.size(); ++k)  { count += chunks[k].vals.n_elem; }
+      }
+    }
+  #elif (!defined(ARMA_DONT_USE_STD_MUTEX))
+    {
+    const std::lock_guard<std::mutex> lock(chunks_mutex);
+    
+    for(size_t k=0; k < chunks.size(); ++k)  { count += chunks[k].vals.n_elem; }
+    }
+  #else
+    {
+    for(size_t k=0; k < chunks.size(); ++k)  { count += chunks[k].vals.n_elem; }
+    }
+  #endif
+  
+  return count;
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_builder<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  std::vector<chunk_type> tmp;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp critical (arma_SpMat_builder)
+      {
+      chunks.swap(tmp);
+      }
+    }
+  #elif (!defined(ARMA_DONT_USE_STD_MUTEX))
+    {
+    const std::lock_guard<std::mutex> lock(chunks_mutex);
+    
+    chunks.swap(tmp);
+    }
+  #else
+    {
+    chunks.swap(tmp);
+    }
+  #endif
+  }
+
+
+
+//! Combine all appended chunks into a sparse matrix; the builder is empty afterwards.
+//! If add_values is true, values at identical locations are summed; otherwise identical locations are not allowed.
+//! Must not be called while other threads are still appending chunks.
+template<typename eT>
+inline
+void
+SpMat_builder<eT>::finalize(SpMat<eT>& out, const bool add_values, const bool check_for_zeros)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::vector<chunk_type> local_chunks;
+  
+  local_chunks.swap(chunks);
+  
+  std::stable_sort( local_chunks.begin(), local_chunks.end(), chunk_order() );
+  
+  const uword N_chunks = uword(local_chunks.size());
+  
+  std::vector< sp_batch_chunk<eT> > batch(N_chunks);
+  
+  for(uword k=0; k < N_chunks; ++k)
+    {
+    batch[k].locs = local_chunks[k].locs.memptr();
+    batch[k].vals = local_chunks[k].vals.memptr();
+    batch[k].n    = local_chunks[k].vals.n_elem;
+    }
+  
+  SpMat<eT> tmp(n_rows, n_cols);
+  
+  sp_batch::apply(tmp, batch.data(), N_chunks, add_values, true, check_for_zeros);
+  
+  out.steal_mem(tmp);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat<eT>
+SpMat_builder<eT>::finalize(const bool add_values, const bool check_for_zeros)
+  {
+  arma_extra_debug_sigprint();
+  
+  SpMat<eT> out;
+  
+  (*this).finalize(out, add_values, check_for_zeros);
+  
+  return out;
+  }
+
+
+
+//! @}
@@ -337,6 +337,8 @@ SpMat<eT>::SpMat(const Base<uword,T1>& locations_expr, const Base<eT,T2>& vals_e
   uvec bounds = arma::max(locs, 1);
   init_cold(bounds[0] + 1, bounds[1] + 1);
   
+  if(init_batch_mt(locs, vals, sort_locations, false, true))  { return; }
+  
   // Ensure that there are no zeros
   const uword N_old = vals.n_elem;
         uword N_new = 0;
@@ -405,6 +407,8 @@ SpMat<eT>::SpMat(const Base<uword,T1>& locations_expr, const Base<eT,T2>& vals_e
   
   init_cold(in_n_rows, in_n_cols);
   
+  if(init_batch_mt(locs, vals, sort_locations, false, check_for_zeros))  { return; }
+  
   // Ensure that there are no zeros, unless the user asked not to.
   if(check_for_zeros)
     {
@@ -474,6 +478,8 @@ SpMat<eT>::SpMat(const bool add_values, const Base<uword,T1>& locations_expr, co
   
   init_cold(in_n_rows, in_n_cols);
   
+  if(init_batch_mt(locs, vals, sort_locations, add_values, check_for_zeros))  { return; }
+  
   // Ensure that there are no zeros, unless the user asked not to.
   if(check_for_zeros)
     {
@@ -5641,6 +5647,41 @@ SpMat<eT>::init_batch_add(const Mat<uword>& locs, const Mat<eT>& vals, const boo
 
 
 
+//! Multi-threaded counterpart of init_batch_std() and init_batch_add(), used for large coordinate lists when OpenMP is enabled;
+//! the entries are grouped by column in parallel instead of being sorted as a whole.
+//! When values at identical locations are summed, it is used regardless of size and number of threads,
+//! so that the sums are formed in input order and the result does not depend on the number of threads.
+//! Returns false if the serial versions should be used instead.
+template<typename eT>
+inline
+bool
+SpMat<eT>::init_batch_mt(const Mat<uword>& locs, const Mat<eT>& vals, const bool sort_locations, const bool add_values, const bool skip_zeros)
+  {
+  arma_extra_debug_sigprint();
+  
+  bool use_batch = add_values;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    use_batch = use_batch || ( mp_gate<eT>::eval(vals.n_elem) && (mp_thread_limit::get() > 1) );
+    }
+  #endif
+  
+  if(use_batch == false)  { return false; }
+  
+  sp_batch_chunk<eT> chunk;
+  
+  chunk.locs = locs.memptr();
+  chunk.vals = vals.memptr();
+  chunk.n    = vals.n_elem;
+  
+  sp_batch::apply(*this, &chunk, uword(1), add_values, sort_locations, skip_zeros);
+  
+  return true;
+  }
+
+
+
 //! constructor used by SpRow and SpCol classes
 template<typename eT>
 inline
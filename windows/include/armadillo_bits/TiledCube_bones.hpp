@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup TiledCube
+//! @{
+
+
+
+struct TiledCube_prealloc
+  {
+  static constexpr uword brick_n_rows   = 64;
+  static constexpr uword brick_n_cols   = 64;
+  static constexpr uword brick_n_slices = 64;
+  static constexpr uword cache_n_bricks = 64;
+  };
+
+
+
+//! Disk-backed cube for volumes larger than available memory.
+//! The elements are stored on disk as fixed-size bricks;
+//! bricks are paged in on demand and kept in a least-recently-used cache.
+//! Modified bricks are written back on eviction, flush() and destruction.
+//! NOTE: a TiledCube object is not thread-safe.
+template<typename eT>
+class TiledCube
+  {
+  public:
+  
+  typedef eT                                elem_type;
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  const uword n_rows;          //!< number of rows   (read-only)
+  const uword n_cols;          //!< number of columns  (read-only)
+  const uword n_slices;        //!< number of slices (read-only)
+  const uword n_elem;          //!< number of elements (read-only)
+  
+  const uword brick_n_rows;    //!< number of rows in each brick (read-only)
+  const uword brick_n_cols;    //!< number of columns in each brick (read-only)
+  const uword brick_n_slices;  //!< number of slices in each brick (read-only)
+  
+  
+  private:
+  
+  struct brick_entry
+    {
+    podarray<eT> mem;
+    uword        brick_id  = 0;
+    u64          last_use  = 0;
+    bool         dirty     = false;
+    };
+  
+  const uword brick_n_elem;
+  const uword n_bricks_rows;
+  const uword n_bricks_cols;
+  const uword n_bricks_slices;
+  const uword cache_max_bricks;
+  
+  std::string          filename;
+  mutable std::fstream f;
+  std::streamoff       data_offset = 0;
+  
+  mutable std::vector<brick_entry> cache;
+  mutable std::map<uword, uword>   cache_index;  //!< brick_id -> position in cache
+  mutable u64                      cache_clock = 0;
+  
+  
+  public:
+  
+  inline ~TiledCube();
+  
+  inline TiledCube(const std::string& in_filename, const uword in_n_rows, const uword in_n_cols, const uword in_n_slices, const SizeCube& brick_size = SizeCube(TiledCube_prealloc::brick_n_rows, TiledCube_prealloc::brick_n_cols, TiledCube_prealloc::brick_n_slices), const uword in_cache_max_bricks = TiledCube_prealloc::cache_n_bricks);
+  inline TiledCube(const std::string& in_filename, const SizeCube& s,                                                   const SizeCube& brick_size = SizeCube(TiledCube_prealloc::brick_n_rows, TiledCube_prealloc::brick_n_cols, TiledCube_prealloc::brick_n_slices), const uword in_cache_max_bricks = TiledCube_prealloc::cache_n_bricks);
+  
+  inline explicit TiledCube(const std::string& in_filename, const uword in_cache_max_bricks = TiledCube_prealloc::cache_n_bricks);
+  
+  TiledCube(const TiledCube&)            = delete;
+  TiledCube& operator=(const TiledCube&) = delete;
+  
+  arma_warn_unused inline eT at(const uword in_row, const uword in_col, const uword in_slice) const;
+  arma_warn_unused inline eT operator()(const uword in_row, const uword in_col, const uword in_slice) const;
+  
+  inline       TiledCube_view<eT> slice(const uword in_slice);
+  inline const TiledCube_view<eT> slice(const uword in_slice) const;
+  
+  inline       TiledCube_view<eT> slices(const uword in_slice1, const uword in_slice2);
+  inline const TiledCube_view<eT> slices(const uword in_slice1, const uword in_slice2) const;
+  
+  inline       TiledCube_view<eT> subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const uword in_row2, const uword in_col2, const uword in_slice2);
+  inline const TiledCube_view<eT> subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const uword in_row2, const uword in_col2, const uword in_slice2) const;
+  
+  inline       TiledCube_view<eT> subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const SizeCube& s);
+  inline const TiledCube_view<eT> subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const SizeCube& s) const;
+  
+  inline       TiledCube_view<eT> subcube(const span& row_span, const span& col_span, const span& slice_span);
+  inline const TiledCube_view<eT> subcube(const span& row_span, const span& col_span, const span& slice_span) const;
+  
+  inline const TiledCube& each_slice(const std::function< void(      Mat<eT>&) >& F);
+  inline const TiledCube& each_slice(const std::function< void(const Mat<eT>&) >& F) const;
+  
+  inline void flush() const;
+  inline void clear_cache() const;
+  
+  
+  private:
+  
+  inline void init_file();
+  inline void load_header();
+  
+  inline uword brick_id(const uword brick_row, const uword brick_col, const uword brick_slice) const;
+  
+  inline void read_brick (const uword id,       eT* mem) const;
+  inline void write_brick(const uword id, const eT* mem) const;
+  
+  inline brick_entry& get_brick(const uword id, const bool for_overwrite) const;
+  
+  inline void read_region (      eT* out_mem, const uword row1, const uword col1, const uword slice1, const uword region_n_rows, const uword region_n_cols, const uword region_n_slices) const;
+  inline void write_region(const eT*  in_mem, const uword row1, const uword col1, const uword slice1, const uword region_n_rows, const uword region_n_cols, const uword region_n_slices);
+  inline void fill_region (const eT      val, const uword row1, const uword col1, const uword slice1, const uword region_n_rows, const uword region_n_cols, const uword region_n_slices);
+  
+  inline void read_slab (      Cube<eT>& out, const uword slab) const;
+  inline void write_slab(const Cube<eT>&  in, const uword slab) const;
+  
+  template<typename functor, typename slab_type>
+  inline void each_slice_slab(const functor& F, slab_type& current, Cube<eT>& next, const uword slab, const bool has_next) const;
+  
+  
+  friend class TiledCube_view<eT>;
+  };
+
+
+
+//! Rectangular region of a TiledCube.
+//! Reading converts the region into an in-memory Mat or Cube;
+//! assigning writes through the brick cache of the parent TiledCube.
+template<typename eT>
+class TiledCube_view
+  {
+  public:
+  
+  typedef eT elem_type;
+  
+  TiledCube<eT>& m;
+  
+  const uword aux_row1;
+  const uword aux_col1;
+  const uword aux_slice1;
+  
+  const uword n_rows;
+  const uword n_cols;
+  const uword n_slices;
+  const uword n_elem;
+  
+  
+  protected:
+  
+  arma_inline TiledCube_view(const TiledCube<eT>& in_m, const uword in_row1, const uword in_col1, const uword in_slice1, const uword in_n_rows, const uword in_n_cols, const uword in_n_slices);
+  
+  
+  public:
+  
+  inline void operator= (const eT val);
+  inline void operator= (const TiledCube_view& x);
+  
+  template<typename T1> inline void operator= (const BaseCube<eT,T1>& X);
+  template<typename T1> inline void operator= (const Base<eT,T1>&     X);
+  
+  inline void fill(const eT val);
+  inline void zeros();
+  inline void ones();
+  
+  inline void extract(Cube<eT>& out) const;
+  inline void extract(Mat<eT>&  out) const;
+  
+  inline operator Cube<eT>() const;
+  inline operator  Mat<eT>() const;
+  
+  
+  friend class TiledCube<eT>;
+  };
+
+
+
+//! @}
@@ -0,0 +1,1028 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup TiledCube
+//! @{
+
+
+
+template<typename eT>
+inline
+TiledCube<eT>::~TiledCube()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  if(f.is_open())
+    {
+    try { (*this).flush(); } catch(...) {}
+    
+    f.close();
+    }
+  }
+
+
+
+//! create a new disk-backed cube; the file is overwritten if it exists.
+//! the elements are initialised to zero.
+template<typename eT>
+inline
+TiledCube<eT>::TiledCube(const std::string& in_filename, const uword in_n_rows, const uword in_n_cols, const uword in_n_slices, const SizeCube& brick_size, const uword in_cache_max_bricks)
+  : n_rows          (in_n_rows)
+  , n_cols          (in_n_cols)
+  , n_slices        (in_n_slices)
+  , n_elem          (in_n_rows*in_n_cols*in_n_slices)
+  , brick_n_rows    ( (std::max)(uword(1), (std::min)(brick_size.n_rows,   in_n_rows  )) )
+  , brick_n_cols    ( (std::max)(uword(1), (std::min)(brick_size.n_cols,   in_n_cols  )) )
+  , brick_n_slices  ( (std::max)(uword(1), (std::min)(brick_size.n_slices, in_n_slices)) )
+  , brick_n_elem    ( brick_n_rows*brick_n_cols*brick_n_slices )
+  , n_bricks_rows   ( (in_n_rows   + brick_n_rows   - 1) / brick_n_rows   )
+  , n_bricks_cols   ( (in_n_cols   + brick_n_cols   - 1) / brick_n_cols   )
+  , n_bricks_slices ( (in_n_slices + brick_n_slices - 1) / brick_n_slices )
+  , cache_max_bricks( (std::max)(uword(1), in_cache_max_bricks) )
+  , filename        (in_filename)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  (*this).init_file();
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube<eT>::TiledCube(const std::string& in_filename, const SizeCube& s, const SizeCube& brick_size, const uword in_cache_max_bricks)
+  : TiledCube(in_filename, s.n_rows, s.n_cols, s.n_slices, brick_size, in_cache_max_bricks)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+//! open an existing disk-backed cube
+template<typename eT>
+inline
+TiledCube<eT>::TiledCube(const std::string& in_filename, const uword in_cache_max_bricks)
+  : n_rows          (0)
+  , n_cols          (0)
+  , n_slices        (0)
+  , n_elem          (0)
+  , brick_n_rows    (0)
+  , brick_n_cols    (0)
+  , brick_n_slices  (0)
+  , brick_n_elem    (0)
+  , n_bricks_rows   (0)
+  , n_bricks_cols   (0)
+  , n_bricks_slices (0)
+  , cache_max_bricks( (std::max)(uword(1), in_cache_max_bricks) )
+  , filename        (in_filename)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  (*this).load_header();
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::init_file()
+  {
+  arma_extra_debug_sigprint();
+  
+  f.open(filename.c_str(), std::fstream::in | std::fstream::out | std::fstream::binary | std::fstream::trunc);
+  
+  if(f.is_open() == false)  { arma_stop_runtime_error("TiledCube(): couldn't create file"); return; }
+  
+  std::string header = diskio::gen_bin_header(Cube<eT>());
+  
+  header.replace(5, 3, "TCB");
+  
+  f << header << '\n';
+  f << n_rows << ' ' << n_cols << ' ' << n_slices << '\n';
+  f << brick_n_rows << ' ' << brick_n_cols << ' ' << brick_n_slices << '\n';
+  
+  data_offset = std::streamoff(f.tellp());
+  
+  // extend the file to its full size;
+  // on most filesystems this creates a sparse file, and unwritten bricks read back as zeros
+  
+  const u64 n_bytes = u64(n_bricks_rows) * u64(n_bricks_cols) * u64(n_bricks_slices) * u64(brick_n_elem) * u64(sizeof(eT));
+  
+  if(n_bytes > 0)
+    {
+    f.seekp(data_offset + std::streamoff(n_bytes - 1));
+    f.put(char(0));
+    }
+  
+  f.flush();
+  
+  if(f.good() == false)  { arma_stop_runtime_error("TiledCube(): couldn't allocate file"); }
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::load_header()
+  {
+  arma_extra_debug_sigprint();
+  
+  f.open(filename.c_str(), std::fstream::in | std::fstream::out | std::fstream::binary);
+  
+  if(f.is_open() == false)  { arma_stop_runtime_error("TiledCube(): couldn't open file"); return; }
+  
+  std::string header = diskio::gen_bin_header(Cube<eT>());
+  
+  header.replace(5, 3, "TCB");
+  
+  std::string f_header;
+  
+  uword f_n_rows   = 0;
+  uword f_n_cols   = 0;
+  uword f_n_slices = 0;
+  
+  uword f_brick_n_rows   = 0;
+  uword f_brick_n_cols   = 0;
+  uword f_brick_n_slices = 0;
+  
+  f >> f_header;
+  f >> f_n_rows       >> f_n_cols       >> f_n_slices;
+  f >> f_brick_n_rows >> f_brick_n_cols >> f_brick_n_slices;
+  
+  if( (f.good() == false) || (f_header != header) || (f_brick_n_rows == 0) || (f_brick_n_cols == 0) || (f_brick_n_slices == 0) )
+    {
+    arma_stop_runtime_error("TiledCube(): incorrect header or element type in file");
+    return;
+    }
+  
+  f.get();
+  
+  data_offset = std::streamoff(f.tellg());
+  
+  access::rw(n_rows)   = f_n_rows;
+  access::rw(n_cols)   = f_n_cols;
+  access::rw(n_slices) = f_n_slices;
+  access::rw(n_elem)   = f_n_rows*f_n_cols*f_n_slices;
+  
+  access::rw(brick_n_rows)   = f_brick_n_rows;
+  access::rw(brick_n_cols)   = f_brick_n_cols;
+  access::rw(brick_n_slices) = f_brick_n_slices;
+  access::rw(brick_n_elem)   = f_brick_n_rows*f_brick_n_cols*f_brick_n_slices;
+  
+  access::rw(n_bricks_rows)   = (f_n_rows   + f_brick_n_rows   - 1) / f_brick_n_rows;
+  access::rw(n_bricks_cols)   = (f_n_cols   + f_brick_n_cols   - 1) / f_brick_n_cols;
+  access::rw(n_bricks_slices) = (f_n_slices + f_brick_n_slices - 1) / f_brick_n_slices;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+TiledCube<eT>::brick_id(const uword brick_row, const uword brick_col, const uword brick_slice) const
+  {
+  return brick_row + n_bricks_rows*(brick_col + n_bricks_cols*brick_slice);
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::read_brick(const uword id, eT* mem) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::streamoff n_bytes = std::streamoff(brick_n_elem) * std::streamoff(sizeof(eT));
+  
+  f.clear();
+  f.seekg(data_offset + std::streamoff(id) * n_bytes);
+  f.read(reinterpret_cast<char*>(mem), n_bytes);
+  
+  if(f.good() == false)  { arma_stop_runtime_error("TiledCube: couldn't read brick from file"); }
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::write_brick(const uword id, const eT* mem) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::streamoff n_bytes = std::streamoff(brick_n_elem) * std::streamoff(sizeof(eT));
+  
+  f.clear();
+  f.seekp(data_offset + std::streamoff(id) * n_bytes);
+  f.write(reinterpret_cast<const char*>(mem), n_bytes);
+  
+  if(f.good() == false)  { arma_stop_runtime_error("TiledCube: couldn't write brick to file"); }
+  }
+
+
+
+//! return the cached copy of a brick, paging it in if required.
+//! if the caller is about to overwrite the entire brick, reading it from disk is skipped.
+template<typename eT>
+inline
+typename TiledCube<eT>::brick_entry&
+TiledCube<eT>::get_brick(const uword id, const bool for_overwrite) const
+  {
+  ++cache_clock;
+  
+  typename std::map<uword, uword>::const_iterator it = cache_index.find(id);
+  
+  if(it != cache_index.end())
+    {
+    brick_entry& entry = cache[it->second];
+    
+    entry.last_use = cache_clock;
+    
+    return entry;
+    }
+  
+  uword pos = 0;
+  
+  if(cache.size() < cache_max_bricks)
+    {
+    pos = uword(cache.size());
+    
+    cache.push_back(brick_entry());
+    
+    cache[pos].mem.set_size(brick_n_elem);
+    }
+  else
+    {
+    // evict the least recently used brick
+    
+    for(uword i=1; i < uword(cache.size()); ++i)  { if(cache[i].last_use < cache[pos].last_use)  { pos = i; } }
+    
+    brick_entry& victim = cache[pos];
+    
+    if(victim.dirty)  { (*this).write_brick(victim.brick_id, victim.mem.memptr()); }
+    
+    cache_index.erase(victim.brick_id);
+    }
+  
+  brick_entry& entry = cache[pos];
+  
+  if(for_overwrite == false)  { (*this).read_brick(id, entry.mem.memptr()); }
+  
+  entry.brick_id = id;
+  entry.last_use = cache_clock;
+  entry.dirty    = false;
+  
+  cache_index[id] = pos;
+  
+  return entry;
+  }
+
+
+
+//! write all modified bricks to disk
+template<typename eT>
+inline
+void
+TiledCube<eT>::flush() const
+  {
+  arma_extra_debug_sigprint();
+  
+  for(uword i=0; i < uword(cache.size()); ++i)
+    {
+    brick_entry& entry = cache[i];
+    
+    if(entry.dirty)  { (*this).write_brick(entry.brick_id, entry.mem.memptr()); entry.dirty = false; }
+    }
+  
+  f.flush();
+  }
+
+
+
+//! write all modified bricks to disk and release the memory used by the cache
+template<typename eT>
+inline
+void
+TiledCube<eT>::clear_cache() const
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).flush();
+  
+  cache.clear();
+  cache_index.clear();
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::read_region(eT* out_mem, const uword row1, const uword col1, const uword slice1, const uword region_n_rows, const uword region_n_cols, const uword region_n_slices) const
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (region_n_rows == 0) || (region_n_cols == 0) || (region_n_slices == 0) )  { return; }
+  
+  const uword row2   = row1   + region_n_rows   - 1;
+  const uword col2   = col1   + region_n_cols   - 1;
+  const uword slice2 = slice1 + region_n_slices - 1;
+  
+  for(uword bs = slice1/brick_n_slices; bs <= slice2/brick_n_slices; ++bs)
+  for(uword bc = col1  /brick_n_cols;   bc <= col2  /brick_n_cols;   ++bc)
+  for(uword br = row1  /brick_n_rows;   br <= row2  /brick_n_rows;   ++br)
+    {
+    const eT* brick_mem = (*this).get_brick( (*this).brick_id(br, bc, bs), false ).mem.memptr();
+    
+    // overlap of the region with the brick, in cube coordinates
+    
+    const uword r_start = (std::max)(row1,   br*brick_n_rows  );
+    const uword c_start = (std::max)(col1,   bc*brick_n_cols  );
+    const uword s_start = (std::max)(slice1, bs*brick_n_slices);
+    
+    const uword r_endp1 = (std::min)(row2+1,   (br+1)*brick_n_rows  );
+    const uword c_endp1 = (std::min)(col2+1,   (bc+1)*brick_n_cols  );
+    const uword s_endp1 = (std::min)(slice2+1, (bs+1)*brick_n_slices);
+    
+    const uword len = r_endp1 - r_start;
+    
+    for(uword s=s_start; s < s_endp1; ++s)
+    for(uword c=c_start; c < c_endp1; ++c)
+      {
+      const eT* src = &brick_mem[ (r_start - br*brick_n_rows) + brick_n_rows*((c - bc*brick_n_cols) + brick_n_cols*(s - bs*brick_n_slices)) ];
+            eT* dst = &out_mem[ (r_start - row1) + region_n_rows*((c - col1) + region_n_cols*(s - slice1)) ];
+      
+      arrayops::copy(dst, src, len);
+      }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::write_region(const eT* in_mem, const uword row1, const uword col1, const uword slice1, const uword region_n_rows, const uword region_n_cols, const uword region_n_slices)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (region_n_rows == 0) || (region_n_cols == 0) || (region_n_slices == 0) )  { return; }
+  
+  const uword row2   = row1   + region_n_rows   - 1;
+  const uword col2   = col1   + region_n_cols   - 1;
+  const uword slice2 = slice1 + region_n_slices - 1;
+  
+  for(uword bs = slice1/brick_n_slices; bs <= slice2/brick_n_slices; ++bs)
+  for(uword bc = col1  /brick_n_cols;   bc <= col2  /brick_n_cols;   ++bc)
+  for(uword br = row1  /brick_n_rows;   br <= row2  /brick_n_rows;   ++br)
+    {
+    const uword r_start = (std::max)(row1,   br*brick_n_rows  );
+    const uword c_start = (std::max)(col1,   bc*brick_n_cols  );
+    const uword s_start = (std::max)(slice1, bs*brick_n_slices);
+    
+    const uword r_endp1 = (std::min)(row2+1,   (br+1)*brick_n_rows  );
+    const uword c_endp1 = (std::min)(col2+1,   (bc+1)*brick_n_cols  );
+    const uword s_endp1 = (std::min)(slice2+1, (bs+1)*brick_n_slices);
+    
+    // bricks covered entirely by the region don't need to be read from disk
+    
+    const bool covered = (r_start == br*brick_n_rows) && (r_endp1 == (br+1)*brick_n_rows)
+                      && (c_start == bc*brick_n_cols) && (c_endp1 == (bc+1)*brick_n_cols)
+                      && (s_start == bs*brick_n_slices) && (s_endp1 == (bs+1)*brick_n_slices);
+    
+    brick_entry& entry = (*this).get_brick( (*this).brick_id(br, bc, bs), covered );
+    
+    eT* brick_mem = entry.mem.memptr();
+    
+    const uword len = r_endp1 - r_start;
+    
+    for(uword s=s_start; s < s_endp1; ++s)
+    for(uword c=c_start; c < c_endp1; ++c)
+      {
+      const eT* src = &in_mem[ (r_start - row1) + region_n_rows*((c - col1) + region_n_cols*(s - slice1)) ];
+            eT* dst = &brick_mem[ (r_start - br*brick_n_rows) + brick_n_rows*((c - bc*brick_n_cols) + brick_n_cols*(s - bs*brick_n_slices)) ];
+      
+      arrayops::copy(dst, src, len);
+      }
+    
+    entry.dirty = true;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube<eT>::fill_region(const eT val, const uword row1, const uword col1, const uword slice1, const uword region_n_rows, const uword region_n_cols, const uword region_n_slices)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (region_n_rows == 0) || (region_n_cols == 0) || (region_n_slices == 0) )  { return; }
+  
+  // fill one brick-sized block and write it repeatedly,
+  // so that memory use is bounded by the brick size rather than the region size
+  
+  const uword block_n_slices = (std::min)(region_n_slices, brick_n_slices);
+  
+  Cube<eT> block(region_n_rows, region_n_cols, block_n_slices, arma_nozeros_indicator());
+  
+  block.fill(val);
+  
+  for(uword s=0; s < region_n_slices; s += block_n_slices)
+    {
+    const uword n = (std::min)(block_n_slices, region_n_slices - s);
+    
+    (*this).write_region(block.memptr(), row1, col1, slice1 + s, region_n_rows, region_n_cols, n);
+    }
+  }
+
+
+
+//! read one slab of brick_n_slices slices directly from disk, bypassing the cache
+template<typename eT>
+inline
+void
+TiledCube<eT>::read_slab(Cube<eT>& out, const uword slab) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword slice1   = slab * brick_n_slices;
+  const uword n_local  = (std::min)(brick_n_slices, n_slices - slice1);
+  
+  out.set_size(n_rows, n_cols, n_local);
+  
+  podarray<eT> brick_mem(brick_n_elem);
+  
+  for(uword bc=0; bc < n_bricks_cols; ++bc)
+  for(uword br=0; br < n_bricks_rows; ++br)
+    {
+    (*this).read_brick( (*this).brick_id(br, bc, slab), brick_mem.memptr() );
+    
+    const uword r_start = br*brick_n_rows;
+    const uword c_start = bc*brick_n_cols;
+    const uword len     = (std::min)(brick_n_rows, n_rows - r_start);
+    const uword c_endp1 = (std::min)(c_start + brick_n_cols, n_cols);
+    
+    for(uword s=0; s < n_local; ++s)
+    for(uword c=c_start; c < c_endp1; ++c)
+      {
+      arrayops::copy( out.slice_colptr(s, c) + r_start, &brick_mem[ brick_n_rows*((c - c_start) + brick_n_cols*s) ], len );
+      }
+    }
+  }
+
+
+
+//! write one slab of brick_n_slices slices directly to disk, bypassing the cache
+template<typename eT>
+inline
+void
+TiledCube<eT>::write_slab(const Cube<eT>& in, const uword slab) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_local = in.n_slices;
+  
+  podarray<eT> brick_mem(brick_n_elem);
+  
+  brick_mem.zeros();
+  
+  for(uword bc=0; bc < n_bricks_cols; ++bc)
+  for(uword br=0; br < n_bricks_rows; ++br)
+    {
+    const uword r_start = br*brick_n_rows;
+    const uword c_start = bc*brick_n_cols;
+    const uword len     = (std::min)(brick_n_rows, n_rows - r_start);
+    const uword c_endp1 = (std::min)(c_start + brick_n_cols, n_cols);
+    
+    for(uword s=0; s < n_local; ++s)
+    for(uword c=c_start; c < c_endp1; ++c)
+      {
+      arrayops::copy( &brick_mem[ brick_n_rows*((c - c_start) + brick_n_cols*s) ], in.slice_colptr(s, c) + r_start, len );
+      }
+    
+    (*this).write_brick( (*this).brick_id(br, bc, slab), brick_mem.memptr() );
+    }
+  }
+
+
+
+template<typename eT>
+inline
+eT
+TiledCube<eT>::at(const uword in_row, const uword in_col, const uword in_slice) const
+  {
+  const uword br = in_row   / brick_n_rows;
+  const uword bc = in_col   / brick_n_cols;
+  const uword bs = in_slice / brick_n_slices;
+  
+  const eT* brick_mem = (*this).get_brick( (*this).brick_id(br, bc, bs), false ).mem.memptr();
+  
+  return brick_mem[ (in_row - br*brick_n_rows) + brick_n_rows*((in_col - bc*brick_n_cols) + brick_n_cols*(in_slice - bs*brick_n_slices)) ];
+  }
+
+
+
+template<typename eT>
+inline
+eT
+TiledCube<eT>::operator()(const uword in_row, const uword in_col, const uword in_slice) const
+  {
+  arma_debug_check_bounds
+    (
+    (in_row >= n_rows) || (in_col >= n_cols) || (in_slice >= n_slices),
+    "TiledCube::operator(): index out of bounds"
+    );
+  
+  return (*this).at(in_row, in_col, in_slice);
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>
+TiledCube<eT>::slice(const uword in_slice)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds( (in_slice >= n_slices), "TiledCube::slice(): index out of bounds" );
+  
+  return TiledCube_view<eT>(*this, 0, 0, in_slice, n_rows, n_cols, 1);
+  }
+
+
+
+template<typename eT>
+inline
+const TiledCube_view<eT>
+TiledCube<eT>::slice(const uword in_slice) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds( (in_slice >= n_slices), "TiledCube::slice(): index out of bounds" );
+  
+  return TiledCube_view<eT>(*this, 0, 0, in_slice, n_rows, n_cols, 1);
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>
+TiledCube<eT>::slices(const uword in_slice1, const uword in_slice2)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    (in_slice1 > in_slice2) || (in_slice2 >= n_slices),
+    "TiledCube::slices(): indices out of bounds or incorrectly used"
+    );
+  
+  return TiledCube_view<eT>(*this, 0, 0, in_slice1, n_rows, n_cols, in_slice2 - in_slice1 + 1);
+  }
+
+
+
+template<typename eT>
+inline
+const TiledCube_view<eT>
+TiledCube<eT>::slices(const uword in_slice1, const uword in_slice2) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    (in_slice1 > in_slice2) || (in_slice2 >= n_slices),
+    "TiledCube::slices(): indices out of bounds or incorrectly used"
+    );
+  
+  return TiledCube_view<eT>(*this, 0, 0, in_slice1, n_rows, n_cols, in_slice2 - in_slice1 + 1);
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>
+TiledCube<eT>::subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const uword in_row2, const uword in_col2, const uword in_slice2)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    (in_row1 >  in_row2) || (in_col1 >  in_col2) || (in_slice1 >  in_slice2) ||
+    (in_row2 >= n_rows)  || (in_col2 >= n_cols)  || (in_slice2 >= n_slices),
+    "TiledCube::subcube(): indices out of bounds or incorrectly used"
+    );
+  
+  return TiledCube_view<eT>(*this, in_row1, in_col1, in_slice1, in_row2 - in_row1 + 1, in_col2 - in_col1 + 1, in_slice2 - in_slice1 + 1);
+  }
+
+
+
+template<typename eT>
+inline
+const TiledCube_view<eT>
+TiledCube<eT>::subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const uword in_row2, const uword in_col2, const uword in_slice2) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    (in_row1 >  in_row2) || (in_col1 >  in_col2) || (in_slice1 >  in_slice2) ||
+    (in_row2 >= n_rows)  || (in_col2 >= n_cols)  || (in_slice2 >= n_slices),
+    "TiledCube::subcube(): indices out of bounds or incorrectly used"
+    );
+  
+  return TiledCube_view<eT>(*this, in_row1, in_col1, in_slice1, in_row2 - in_row1 + 1, in_col2 - in_col1 + 1, in_slice2 - in_slice1 + 1);
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>
+TiledCube<eT>::subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const SizeCube& s)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    ((in_row1 + s.n_rows) > n_rows) || ((in_col1 + s.n_cols) > n_cols) || ((in_slice1 + s.n_slices) > n_slices),
+    "TiledCube::subcube(): indices or size out of bounds"
+    );
+  
+  return TiledCube_view<eT>(*this, in_row1, in_col1, in_slice1, s.n_rows, s.n_cols, s.n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+const TiledCube_view<eT>
+TiledCube<eT>::subcube(const uword in_row1, const uword in_col1, const uword in_slice1, const SizeCube& s) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    ((in_row1 + s.n_rows) > n_rows) || ((in_col1 + s.n_cols) > n_cols) || ((in_slice1 + s.n_slices) > n_slices),
+    "TiledCube::subcube(): indices or size out of bounds"
+    );
+  
+  return TiledCube_view<eT>(*this, in_row1, in_col1, in_slice1, s.n_rows, s.n_cols, s.n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>
+TiledCube<eT>::subcube(const span& row_span, const span& col_span, const span& slice_span)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword in_row1   = row_span.whole   ? 0 : row_span.a;
+  const uword in_col1   = col_span.whole   ? 0 : col_span.a;
+  const uword in_slice1 = slice_span.whole ? 0 : slice_span.a;
+  
+  const uword in_row2   = row_span.whole   ? (n_rows   - 1) : row_span.b;
+  const uword in_col2   = col_span.whole   ? (n_cols   - 1) : col_span.b;
+  const uword in_slice2 = slice_span.whole ? (n_slices - 1) : slice_span.b;
+  
+  return (*this).subcube(in_row1, in_col1, in_slice1, in_row2, in_col2, in_slice2);
+  }
+
+
+
+template<typename eT>
+inline
+const TiledCube_view<eT>
+TiledCube<eT>::subcube(const span& row_span, const span& col_span, const span& slice_span) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword in_row1   = row_span.whole   ? 0 : row_span.a;
+  const uword in_col1   = col_span.whole   ? 0 : col_span.a;
+  const uword in_slice1 = slice_span.whole ? 0 : slice_span.a;
+  
+  const uword in_row2   = row_span.whole   ? (n_rows   - 1) : row_span.b;
+  const uword in_col2   = col_span.whole   ? (n_cols   - 1) : col_span.b;
+  const uword in_slice2 = slice_span.whole ? (n_slices - 1) : slice_span.b;
+  
+  return (*this).subcube(in_row1, in_col1, in_slice1, in_row2, in_col2, in_slice2);
+  }
+
+
+
+//! apply a functor to each slice of the current slab and read the next slab;
+//! when OpenMP is enabled and more than one thread may be used, the next slab is read on a separate thread while the functor runs on the calling thread,
+//! so that the functor is not confined to a parallel region and exceptions from either side reach the caller
+template<typename eT>
+template<typename functor, typename slab_type>
+inline
+void
+TiledCube<eT>::each_slice_slab(const functor& F, slab_type& current, Cube<eT>& next, const uword slab, const bool has_next) const
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+  // the reader thread is only started when OpenMP threads could be used at this point:
+  // not while a user-provided executor is set (its pool owns the threads), not within mp_hint(1), and not when nested
+  const bool use_reader = has_next && (mp_executor_state::get() == nullptr) && (mp_thread_limit::in_parallel() == false) && (mp_thread_limit::get() > 1);
+  
+  if(use_reader)
+    {
+    std::exception_ptr read_err;
+    
+    std::thread reader( [&]() { try { (*this).read_slab(next, slab + 1); } catch(...) { read_err = std::current_exception(); } } );
+    
+    try
+      {
+      for(uword s=0; s < current.n_slices; ++s)  { F(current.slice(s)); }
+      }
+    catch(...)
+      {
+      reader.join();
+      throw;
+      }
+    
+    reader.join();
+    
+    if(read_err)  { std::rethrow_exception(read_err); }
+    
+    return;
+    }
+  #endif
+  
+  for(uword s=0; s < current.n_slices; ++s)  { F(current.slice(s)); }
+  
+  if(has_next)  { (*this).read_slab(next, slab + 1); }
+  }
+
+
+
+//! apply a functor to each slice, streaming through the file one slab of bricks at a time;
+//! when OpenMP is enabled, the next slab is read from disk while the functor processes the current slab
+template<typename eT>
+inline
+const TiledCube<eT>&
+TiledCube<eT>::each_slice(const std::function< void(Mat<eT>&) >& F)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).clear_cache();
+  
+  Cube<eT> slab_buf[2];
+  
+  if(n_bricks_slices > 0)  { (*this).read_slab(slab_buf[0], 0); }
+  
+  for(uword slab=0; slab < n_bricks_slices; ++slab)
+    {
+    Cube<eT>& current = slab_buf[ slab      % 2];
+    Cube<eT>& next    = slab_buf[(slab + 1) % 2];
+    
+    const bool has_next = ((slab + 1) < n_bricks_slices);
+    
+    (*this).each_slice_slab(F, current, next, slab, has_next);
+    
+    (*this).write_slab(current, slab);
+    }
+  
+  f.flush();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+const TiledCube<eT>&
+TiledCube<eT>::each_slice(const std::function< void(const Mat<eT>&) >& F) const
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).clear_cache();
+  
+  Cube<eT> slab_buf[2];
+  
+  if(n_bricks_slices > 0)  { (*this).read_slab(slab_buf[0], 0); }
+  
+  for(uword slab=0; slab < n_bricks_slices; ++slab)
+    {
+    const Cube<eT>& current = slab_buf[ slab      % 2];
+          Cube<eT>& next    = slab_buf[(slab + 1) % 2];
+    
+    const bool has_next = ((slab + 1) < n_bricks_slices);
+    
+    (*this).each_slice_slab(F, current, next, slab, has_next);
+    }
+  
+  return *this;
+  }
+
+
+
+//
+// TiledCube_view
+
+
+
+template<typename eT>
+arma_inline
+TiledCube_view<eT>::TiledCube_view(const TiledCube<eT>& in_m, const uword in_row1, const uword in_col1, const uword in_slice1, const uword in_n_rows, const uword in_n_cols, const uword in_n_slices)
+  : m         (const_cast< TiledCube<eT>& >(in_m))
+  , aux_row1  (in_row1)
+  , aux_col1  (in_col1)
+  , aux_slice1(in_slice1)
+  , n_rows    (in_n_rows)
+  , n_cols    (in_n_cols)
+  , n_slices  (in_n_slices)
+  , n_elem    (in_n_rows*in_n_cols*in_n_slices)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::operator= (const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).fill(val);
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::operator= (const TiledCube_view<eT>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Cube<eT> tmp(x);
+  
+  (*this).operator=(tmp);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+void
+TiledCube_view<eT>::operator= (const BaseCube<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const unwrap_cube<T1> tmp(X.get_ref());
+  const Cube<eT>& A   = tmp.M;
+  
+  arma_debug_assert_same_size(n_rows, n_cols, n_slices, A.n_rows, A.n_cols, A.n_slices, "copy into TiledCube view");
+  
+  m.write_region(A.memptr(), aux_row1, aux_col1, aux_slice1, n_rows, n_cols, n_slices);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+void
+TiledCube_view<eT>::operator= (const Base<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(X.get_ref());
+  const Mat<eT>& A     = tmp.M;
+  
+  arma_debug_assert_same_size(n_rows, n_cols, n_slices, A.n_rows, A.n_cols, uword(1), "copy into TiledCube view");
+  
+  m.write_region(A.memptr(), aux_row1, aux_col1, aux_slice1, n_rows, n_cols, n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::fill(const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  m.fill_region(val, aux_row1, aux_col1, aux_slice1, n_rows, n_cols, n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::zeros()
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).fill(eT(0));
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::ones()
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).fill(eT(1));
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::extract(Cube<eT>& out) const
+  {
+  arma_extra_debug_sigprint();
+  
+  out.set_size(n_rows, n_cols, n_slices);
+  
+  m.read_region(out.memptr(), aux_row1, aux_col1, aux_slice1, n_rows, n_cols, n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+void
+TiledCube_view<eT>::extract(Mat<eT>& out) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (n_slices != 1), "TiledCube_view: can't convert to matrix, as the number of slices is not one" );
+  
+  out.set_size(n_rows, n_cols);
+  
+  m.read_region(out.memptr(), aux_row1, aux_col1, aux_slice1, n_rows, n_cols, n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>::operator Cube<eT>() const
+  {
+  arma_extra_debug_sigprint();
+  
+  Cube<eT> out;
+  
+  (*this).extract(out);
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+TiledCube_view<eT>::operator Mat<eT>() const
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> out;
+  
+  (*this).extract(out);
+  
+  return out;
+  }
+
+
+
+//! @}
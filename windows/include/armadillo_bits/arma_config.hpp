@@ -135,6 +135,13 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_PROFILE)
+    static constexpr bool profile = true;
+  #else
+    static constexpr bool profile = false;
+  #endif
+  
+  
   #if defined(ARMA_GOOD_COMPILER)
     static constexpr bool good_comp = true;
   #else
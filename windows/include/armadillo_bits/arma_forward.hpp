@@ -32,6 +32,9 @@ template<typename eT> class Cube;
 template<typename eT> class xvec_htrans;
 template<typename oT> class field;
 
+template<typename eT> class TiledCube;
+template<typename eT> class TiledCube_view;
+
 template<typename eT, bool do_conj> class xtrans_mat;
 
 
@@ -62,6 +65,7 @@ template<typename eT> class SpSubview_MapMat_val;
 
 template<typename eT, typename T1>              class subview_elem1;
 template<typename eT, typename T1, typename T2> class subview_elem2;
+template<typename eT, typename T1>              class subview_where;
 
 template<typename parent, unsigned int mode>              class subview_each1;
 template<typename parent, unsigned int mode, typename TB> class subview_each2;
@@ -373,6 +377,8 @@ enum struct file_type : unsigned int
   hdf5_binary_trans,  //!< [NOTE: DO NOT USE - deprecated] as per hdf5_binary, but save/load the data with columns transposed to rows
   coord_ascii,        //!< simple co-ordinate format for sparse matrices (indices start at zero)
   ssv_ascii,          //!< similar to csv_ascii; uses semicolon (;) instead of comma (,) as the separator
+  pfm_binary,         //!< Portable Float Map (32 bit floating point image); greyscale for matrices, greyscale or colour for cubes
+  arma_binary_indexed, //!< Armadillo binary format for fields, with an offset table allowing parallel and per-element access
   };
 
 
@@ -389,10 +395,14 @@ static constexpr file_type hdf5_binary        = file_type::hdf5_binary;
 static constexpr file_type hdf5_binary_trans  = file_type::hdf5_binary_trans;
 static constexpr file_type coord_ascii        = file_type::coord_ascii;
 static constexpr file_type ssv_ascii          = file_type::ssv_ascii;
+static constexpr file_type pfm_binary         = file_type::pfm_binary;
+static constexpr file_type arma_binary_indexed = file_type::arma_binary_indexed;
 
 
 struct hdf5_name;
 struct  csv_name;
+struct  raw_name;
+struct file_probe;
 
 
 //! @}
@@ -453,17 +463,28 @@ struct superlu_opts : public spsolve_opts_base
 
 struct eigs_opts
   {
-  double       tol;     // tolerance
-  unsigned int maxiter; // max iterations
-  unsigned int subdim;  // subspace dimension
+  double       tol;        // tolerance
+  unsigned int maxiter;    // max iterations
+  unsigned int subdim;     // subspace dimension
+  bool         warm_start; // start from the subspace spanned by the eigenvectors given as input (NEWARP only)
   
   inline eigs_opts()
     {
-    tol     = 0.0;
-    maxiter = 1000;
-    subdim  = 0;
+    tol        = 0.0;
+    maxiter    = 1000;
+    subdim     = 0;
+    warm_start = false;
     }
   };
 
 
+//! type of the user function for eigs_sym() and eigs_gen() with a matrix-free operator;
+//! the function must compute y = A*x, where y has already been set to the correct size
+template<typename eT>
+struct eigs_fn
+  {
+  typedef std::function< void(Col<eT>& y, const Col<eT>& x) > type;
+  };
+
+
 //! @}
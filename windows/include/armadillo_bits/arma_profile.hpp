@@ -0,0 +1,532 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup arma_profile
+//! @{
+
+
+// When ARMA_PROFILE is defined, arma_extra_debug_sigprint() creates an arma_profile_scope object
+// instead of printing the function signature.
+// arma_extra_debug_sigprint_this() is not profiled, so that memory allocated by constructors
+// is attributed to the function which created the object.
+// Each thread accumulates statistics in its own arma_profile_thread object, so no locking is done while profiling;
+// the objects are merged when arma_profile::print() or arma_profile::save_trace() is called.
+// These functions should only be called while no other thread is running Armadillo functions.
+// 
+// Time is wall time measured with std::chrono::steady_clock.
+// Inclusive time of recursive functions is counted once per level of recursion.
+
+
+
+#if defined(ARMA_PROFILE)
+
+struct arma_profile_entry
+  {
+  const char* name       = nullptr;
+  u64         n_calls    = 0;  //!< number of calls
+  u64         n_calls_mp = 0;  //!< number of calls made from within an OpenMP parallel region
+  u64         n_regions  = 0;  //!< number of OpenMP parallel regions started directly by this function
+  u64         n_threads  = 0;  //!< sum of thread counts requested for those regions
+  u64         n_allocs   = 0;  //!< number of allocations via memory::acquire() made directly by this function
+  u64         n_bytes    = 0;  //!< number of bytes allocated via memory::acquire() made directly by this function
+  double      t_incl     = 0;  //!< wall time in seconds, including called functions
+  double      t_excl     = 0;  //!< wall time in seconds, excluding called Armadillo functions
+  };
+
+
+
+struct arma_profile_event
+  {
+  const char* name;
+  double      t_start;
+  double      t_dur;
+  };
+
+
+
+class arma_profile_thread
+  {
+  public:
+  
+  struct frame
+    {
+    arma_profile_entry*                   entry;
+    std::chrono::steady_clock::time_point t_start;
+    double                                t_children;
+    };
+  
+  uword                                     id = 0;
+  std::map<const char*, arma_profile_entry> entries;
+  std::vector<frame>                        stack;
+  std::vector<arma_profile_event>           events;
+  u64                                       n_events_dropped = 0;
+  
+  inline static arma_profile_thread& get();
+  
+  inline static std::mutex&                             get_mutex();
+  inline static std::vector<arma_profile_thread*>&      get_all();
+  inline static std::atomic<bool>&                      get_trace_flag();
+  inline static std::chrono::steady_clock::time_point   get_epoch();
+  
+  static constexpr uword max_events = uword(1) << 20;  //!< maximum number of trace events stored by each thread
+  };
+
+
+
+inline
+arma_profile_thread&
+arma_profile_thread::get()
+  {
+  // the per-thread objects are intentionally never deleted,
+  // so that their statistics remain available after the thread has finished
+  
+  thread_local arma_profile_thread* local_ptr = nullptr;
+  
+  if(local_ptr == nullptr)
+    {
+    arma_profile_thread* tmp = new arma_profile_thread;
+    
+    std::lock_guard<std::mutex> lock(get_mutex());
+    
+    std::vector<arma_profile_thread*>& all = get_all();
+    
+    tmp->id = uword(all.size());
+    
+    all.push_back(tmp);
+    
+    local_ptr = tmp;
+    }
+  
+  return (*local_ptr);
+  }
+
+
+
+inline
+std::mutex&
+arma_profile_thread::get_mutex()
+  {
+  static std::mutex* m = new std::mutex;
+  
+  return (*m);
+  }
+
+
+
+inline
+std::vector<arma_profile_thread*>&
+arma_profile_thread::get_all()
+  {
+  static std::vector<arma_profile_thread*>* all = new std::vector<arma_profile_thread*>;
+  
+  return (*all);
+  }
+
+
+
+inline
+std::atomic<bool>&
+arma_profile_thread::get_trace_flag()
+  {
+  static std::atomic<bool>* flag = new std::atomic<bool>(false);
+  
+  return (*flag);
+  }
+
+
+
+inline
+std::chrono::steady_clock::time_point
+arma_profile_thread::get_epoch()
+  {
+  static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+  
+  return epoch;
+  }
+
+
+
+class arma_profile_scope
+  {
+  public:
+  
+  inline explicit arma_profile_scope(const char* name);
+  inline         ~arma_profile_scope();
+  
+  arma_profile_scope(const arma_profile_scope&)            = delete;
+  arma_profile_scope& operator=(const arma_profile_scope&) = delete;
+  
+  inline static void add_alloc(const uword n_bytes);
+  inline static void add_region(const int n_threads);
+  
+  
+  private:
+  
+  arma_profile_thread& T;
+  };
+
+
+
+inline
+arma_profile_scope::arma_profile_scope(const char* name)
+  : T(arma_profile_thread::get())
+  {
+  arma_profile_entry& entry = T.entries[name];
+  
+  entry.name = name;
+  entry.n_calls++;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(omp_in_parallel())  { entry.n_calls_mp++; }
+    }
+  #endif
+  
+  T.stack.push_back( arma_profile_thread::frame{ &entry, std::chrono::steady_clock::now(), double(0) } );
+  }
+
+
+
+inline
+arma_profile_scope::~arma_profile_scope()
+  {
+  const std::chrono::steady_clock::time_point t_end = std::chrono::steady_clock::now();
+  
+  const arma_profile_thread::frame& f = T.stack.back();
+  
+  const double t_dur = std::chrono::duration<double>(t_end - f.t_start).count();
+  
+  f.entry->t_incl += t_dur;
+  f.entry->t_excl += t_dur - f.t_children;
+  
+  if(arma_profile_thread::get_trace_flag().load(std::memory_order_relaxed))
+    {
+    if(T.events.size() < arma_profile_thread::max_events)
+      {
+      const double t_start = std::chrono::duration<double>(f.t_start - arma_profile_thread::get_epoch()).count();
+      
+      T.events.push_back( arma_profile_event{ f.entry->name, t_start, t_dur } );
+      }
+    else
+      {
+      T.n_events_dropped++;
+      }
+    }
+  
+  T.stack.pop_back();
+  
+  if(T.stack.empty() == false)  { T.stack.back().t_children += t_dur; }
+  }
+
+
+
+inline
+void
+arma_profile_scope::add_alloc(const uword n_bytes)
+  {
+  arma_profile_thread& T = arma_profile_thread::get();
+  
+  if(T.stack.empty())  { return; }
+  
+  arma_profile_entry& entry = *(T.stack.back().entry);
+  
+  entry.n_allocs++;
+  entry.n_bytes += u64(n_bytes);
+  }
+
+
+
+inline
+void
+arma_profile_scope::add_region(const int n_threads)
+  {
+  arma_profile_thread& T = arma_profile_thread::get();
+  
+  if(T.stack.empty())  { return; }
+  
+  arma_profile_entry& entry = *(T.stack.back().entry);
+  
+  entry.n_regions++;
+  entry.n_threads += u64(n_threads);
+  }
+
+
+
+#define arma_profile_alloc(n_bytes)    arma_profile_scope::add_alloc(n_bytes)
+#define arma_profile_region(n_threads) arma_profile_scope::add_region(n_threads)
+
+#else
+
+#define arma_profile_alloc(n_bytes)    (void)0
+#define arma_profile_region(n_threads) (void)0
+
+#endif
+
+
+
+class arma_profile
+  {
+  public:
+  
+  inline static void print(std::ostream& out = ARMA_COUT_STREAM, const bool per_thread = false);
+  
+  inline static bool save_trace(const std::string& name);
+  
+  inline static void trace(const bool state);
+  
+  inline static void reset();
+  
+  
+  private:
+  
+  inline static std::string clean_name(const char* name);
+  };
+
+
+
+inline
+std::string
+arma_profile::clean_name(const char* name)
+  {
+  std::string out(name);
+  
+  std::string::size_type pos = 0;
+  
+  while( (pos = out.find("arma::", pos)) != std::string::npos )  { out.erase(pos, 6); }
+  
+  return out;
+  }
+
+
+
+//! print a flat profile sorted by exclusive time;
+//! if per_thread is true, a separate profile is printed for each thread
+inline
+void
+arma_profile::print(std::ostream& out, const bool per_thread)
+  {
+  #if defined(ARMA_PROFILE)
+    {
+    std::lock_guard<std::mutex> lock(arma_profile_thread::get_mutex());
+    
+    const std::vector<arma_profile_thread*>& all = arma_profile_thread::get_all();
+    
+    const uword n_tables = (per_thread) ? uword(all.size()) : uword(1);
+    
+    const std::ios::fmtflags orig_flags     = out.flags();
+    const std::streamsize    orig_precision = out.precision();
+    
+    for(uword table=0; table < n_tables; ++table)
+      {
+      // merge by name, as the same function may have several copies of its signature string
+      
+      std::map<std::string, arma_profile_entry> merged;
+      
+      for(uword t=0; t < all.size(); ++t)
+        {
+        if( per_thread && (t != table) )  { continue; }
+        
+        for(const auto& kv : all[t]->entries)
+          {
+          const arma_profile_entry& in = kv.second;
+          
+          arma_profile_entry& acc = merged[ arma_profile::clean_name(in.name) ];
+          
+          acc.n_calls    += in.n_calls;
+          acc.n_calls_mp += in.n_calls_mp;
+          acc.n_regions  += in.n_regions;
+          acc.n_threads  += in.n_threads;
+          acc.n_allocs   += in.n_allocs;
+          acc.n_bytes    += in.n_bytes;
+          acc.t_incl     += in.t_incl;
+          acc.t_excl     += in.t_excl;
+          }
+        }
+      
+      std::vector< std::pair<std::string, arma_profile_entry> > sorted(merged.begin(), merged.end());
+      
+      std::sort
+        (
+        sorted.begin(), sorted.end(),
+        [](const std::pair<std::string, arma_profile_entry>& a, const std::pair<std::string, arma_profile_entry>& b) { return (a.second.t_excl > b.second.t_excl); }
+        );
+      
+      if(per_thread)  { out << "thread " << table << '\n'; }
+      
+      out << "    excl_ms     incl_ms       calls    calls_mp   regions  avg_thrds    allocs     alloc_MB  function\n";
+      
+      for(const auto& kv : sorted)
+        {
+        const arma_profile_entry& e = kv.second;
+        
+        const double avg_threads = (e.n_regions > 0) ? (double(e.n_threads) / double(e.n_regions)) : double(0);
+        
+        out.setf(std::ios::fixed);
+        
+        out.precision(3);  out.width(11);  out << (e.t_excl * double(1000)) << ' ';
+        out.precision(3);  out.width(11);  out << (e.t_incl * double(1000)) << ' ';
+                           out.width(11);  out << e.n_calls                 << ' ';
+                           out.width(11);  out << e.n_calls_mp              << ' ';
+                           out.width(9);   out << e.n_regions               << ' ';
+        out.precision(1);  out.width(10);  out << avg_threads               << ' ';
+                           out.width(9);   out << e.n_allocs                << ' ';
+        out.precision(3);  out.width(12);  out << (double(e.n_bytes) / double(1024*1024)) << "  ";
+        
+        out << kv.first << '\n';
+        }
+      
+      out << '\n';
+      }
+    
+    out.flags(orig_flags);
+    out.precision(orig_precision);
+    out.flush();
+    }
+  #else
+    {
+    arma_ignore(per_thread);
+    
+    out << "arma_profile::print(): profiling not enabled; define ARMA_PROFILE before including the armadillo header\n";
+    }
+  #endif
+  }
+
+
+
+//! save the recorded events in the Chrome trace event format (JSON),
+//! viewable with chrome://tracing or Perfetto;
+//! events are only recorded while tracing is enabled via trace(true)
+inline
+bool
+arma_profile::save_trace(const std::string& name)
+  {
+  #if defined(ARMA_PROFILE)
+    {
+    std::ofstream f(name.c_str(), std::fstream::binary);
+    
+    if(f.is_open() == false)  { return false; }
+    
+    std::lock_guard<std::mutex> lock(arma_profile_thread::get_mutex());
+    
+    const std::vector<arma_profile_thread*>& all = arma_profile_thread::get_all();
+    
+    f.setf(std::ios::fixed);
+    f.precision(3);
+    
+    f << "{\"traceEvents\":[\n";
+    
+    u64 n_events_dropped = 0;
+    
+    bool first = true;
+    
+    for(uword t=0; t < all.size(); ++t)
+      {
+      n_events_dropped += all[t]->n_events_dropped;
+      
+      for(const arma_profile_event& ev : all[t]->events)
+        {
+        std::string ev_name = arma_profile::clean_name(ev.name);
+        
+        std::string esc_name;
+        
+        for(const char c : ev_name)
+          {
+               if( (c == '"') || (c == '\\') )  { esc_name += '\\'; esc_name += c; }
+          else if( (unsigned char)(c) >= 0x20 ) { esc_name += c; }
+          }
+        
+        if(first == false)  { f << ",\n"; }
+        
+        first = false;
+        
+        f << "{\"name\":\"" << esc_name << "\",\"cat\":\"arma\",\"ph\":\"X\",\"pid\":0,\"tid\":" << t
+          << ",\"ts\":"  << (ev.t_start * double(1e6))
+          << ",\"dur\":" << (ev.t_dur   * double(1e6)) << '}';
+        }
+      }
+    
+    f << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"events_dropped\":" << n_events_dropped << "}}\n";
+    
+    f.flush();
+    
+    return f.good();
+    }
+  #else
+    {
+    arma_ignore(name);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! enable or disable recording of trace events
+inline
+void
+arma_profile::trace(const bool state)
+  {
+  #if defined(ARMA_PROFILE)
+    {
+    arma_profile_thread::get_epoch();
+    
+    arma_profile_thread::get_trace_flag().store(state);
+    }
+  #else
+    {
+    arma_ignore(state);
+    }
+  #endif
+  }
+
+
+
+//! discard all collected statistics and trace events
+inline
+void
+arma_profile::reset()
+  {
+  #if defined(ARMA_PROFILE)
+    {
+    std::lock_guard<std::mutex> lock(arma_profile_thread::get_mutex());
+    
+    for(arma_profile_thread* T : arma_profile_thread::get_all())
+      {
+      // entries referenced by active scopes are kept, but zeroed
+      
+      for(auto& kv : T->entries)
+        {
+        const char* entry_name = kv.second.name;
+        
+        kv.second = arma_profile_entry();
+        
+        kv.second.name = entry_name;
+        }
+      
+      T->events.clear();
+      
+      T->n_events_dropped = 0;
+      }
+    }
+  #endif
+  }
+
+
+
+//! @}
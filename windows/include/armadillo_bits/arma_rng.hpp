@@ -94,6 +94,8 @@ class arma_rng
   inline static void set_seed(const seed_type val);
   inline static void set_seed_random();
   
+  inline static u64 philox_key();
+  
   template<typename eT> struct randi;
   template<typename eT> struct randu;
   template<typename eT> struct randn;
@@ -287,6 +289,21 @@ struct arma_rng::randi
 
 
 
+//! draw a key for arma_rng_philox from the serial generator,
+//! so that set_seed() also determines the output of large fills
+inline
+u64
+arma_rng::philox_key()
+  {
+  u64 key = u64(0);
+  
+  for(uword i=0; i < 3; ++i)  { key = (key << 31) ^ u64( u32( int(arma_rng::randi<int>()) ) ); }
+  
+  return key;
+  }
+
+
+
 //
 
 
@@ -320,6 +337,10 @@ struct arma_rng::randu
   void
   fill(eT* mem, const uword N)
     {
+    #if !defined(ARMA_RNG_ALT)
+      if(N >= arma_rng_philox::threshold)  { arma_rng_philox::randu_fill(mem, N, double(0), double(1), arma_rng::philox_key(), u64(0)); return; }
+    #endif
+    
     #if defined(ARMA_RNG_ALT)
       {
       for(uword i=0; i < N; ++i)  { mem[i] = eT( arma_rng_alt::randu_val() ); }
@@ -352,6 +373,10 @@ struct arma_rng::randu
   void
   fill(eT* mem, const uword N, const double a, const double b)
     {
+    #if !defined(ARMA_RNG_ALT)
+      if(N >= arma_rng_philox::threshold)  { arma_rng_philox::randu_fill(mem, N, a, b, arma_rng::philox_key(), u64(0)); return; }
+    #endif
+    
     #if defined(ARMA_RNG_ALT)
       {
       const double r = b - a;
@@ -421,6 +446,10 @@ struct arma_rng::randu< std::complex<T> >
   void
   fill(std::complex<T>* mem, const uword N)
     {
+    #if !defined(ARMA_RNG_ALT)
+      if(N >= (arma_rng_philox::threshold/2))  { arma_rng_philox::randu_fill(reinterpret_cast<T*>(mem), 2*N, double(0), double(1), arma_rng::philox_key(), u64(0)); return; }
+    #endif
+    
     #if defined(ARMA_RNG_ALT)
       {
       for(uword i=0; i < N; ++i)
@@ -479,6 +508,10 @@ struct arma_rng::randu< std::complex<T> >
   void
   fill(std::complex<T>* mem, const uword N, const double a, const double b)
     {
+    #if !defined(ARMA_RNG_ALT)
+      if(N >= (arma_rng_philox::threshold/2))  { arma_rng_philox::randu_fill(reinterpret_cast<T*>(mem), 2*N, a, b, arma_rng::philox_key(), u64(0)); return; }
+    #endif
+    
     #if defined(ARMA_RNG_ALT)
       {
       const double r = b - a;
@@ -633,48 +666,11 @@ struct arma_rng::randn
   void
   fill(eT* mem, const uword N)
     {
-    #if defined(ARMA_USE_OPENMP)
-      {
-      if((N < 1024) || omp_in_parallel())  { arma_rng::randn<eT>::fill_simple(mem, N); return; }
-      
-      typedef typename std::mt19937_64::result_type local_seed_type;
-      
-      const uword n_threads = uword( mp_thread_limit::get() );
-      
-      std::vector< std::mt19937_64                  > engine(n_threads);
-      std::vector< std::normal_distribution<double> >  distr(n_threads);
-      
-      for(uword t=0; t < n_threads; ++t)
-        {
-        std::mt19937_64& t_engine = engine[t];
-        
-        t_engine.seed( local_seed_type(t) + local_seed_type(arma_rng::randi<local_seed_type>()) );
-        }
-      
-      const uword chunk_size = N / n_threads;
-      
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
-      for(uword t=0; t < n_threads; ++t)
-        {
-        const uword start = (t+0) * chunk_size;
-        const uword endp1 = (t+1) * chunk_size;
-        
-        std::mt19937_64&                  t_engine = engine[t];
-        std::normal_distribution<double>& t_distr  =  distr[t];
-        
-        for(uword i=start; i < endp1; ++i)  { mem[i] = eT( t_distr(t_engine)); }
-        }
-      
-      std::mt19937_64&                  t0_engine = engine[0];
-      std::normal_distribution<double>& t0_distr  =  distr[0];
-      
-      for(uword i=(n_threads*chunk_size); i < N; ++i)  { mem[i] = eT( t0_distr(t0_engine)); }
-      }
-    #else
-      {
-      arma_rng::randn<eT>::fill_simple(mem, N);
-      }
+    #if !defined(ARMA_RNG_ALT)
+      if(N >= arma_rng_philox::threshold)  { arma_rng_philox::randn_fill(mem, N, arma_rng::philox_key(), u64(0)); return; }
     #endif
+    
+    arma_rng::randn<eT>::fill_simple(mem, N);
     }
   
   
@@ -799,60 +795,11 @@ struct arma_rng::randn< std::complex<T> >
   void
   fill(std::complex<T>* mem, const uword N)
     {
-    #if defined(ARMA_USE_OPENMP)
-      {
-      if((N < 512) || omp_in_parallel())  { arma_rng::randn< std::complex<T> >::fill_simple(mem, N); return; }
-      
-      typedef typename std::mt19937_64::result_type local_seed_type;
-      
-      const uword n_threads = uword( mp_thread_limit::get() );
-      
-      std::vector< std::mt19937_64                  > engine(n_threads);
-      std::vector< std::normal_distribution<double> >  distr(n_threads);
-      
-      for(uword t=0; t < n_threads; ++t)
-        {
-        std::mt19937_64& t_engine = engine[t];
-        
-        t_engine.seed( local_seed_type(t) + local_seed_type(arma_rng::randi<local_seed_type>()) );
-        }
-      
-      const uword chunk_size = N / n_threads;
-      
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
-      for(uword t=0; t < n_threads; ++t)
-        {
-        const uword start = (t+0) * chunk_size;
-        const uword endp1 = (t+1) * chunk_size;
-        
-        std::mt19937_64&                  t_engine = engine[t];
-        std::normal_distribution<double>& t_distr  =  distr[t];
-        
-        for(uword i=start; i < endp1; ++i)
-          {
-          const T val1 = T( t_distr(t_engine) );
-          const T val2 = T( t_distr(t_engine) );
-          
-          mem[i] = std::complex<T>(val1, val2);
-          }
-        }
-      
-      std::mt19937_64&                  t0_engine = engine[0];
-      std::normal_distribution<double>& t0_distr  =  distr[0];
-      
-      for(uword i=(n_threads*chunk_size); i < N; ++i)
-        {
-        const T val1 = T( t0_distr(t0_engine) );
-        const T val2 = T( t0_distr(t0_engine) );
-        
-        mem[i] = std::complex<T>(val1, val2);
-        }
-      }
-    #else
-      {
-      arma_rng::randn< std::complex<T> >::fill_simple(mem, N);
-      }
+    #if !defined(ARMA_RNG_ALT)
+      if(N >= (arma_rng_philox::threshold/2))  { arma_rng_philox::randn_fill(reinterpret_cast<T*>(mem), 2*N, arma_rng::philox_key(), u64(0)); return; }
     #endif
+    
+    arma_rng::randn< std::complex<T> >::fill_simple(mem, N);
     }
   
   
@@ -914,7 +861,7 @@ struct arma_rng::randg
     {
     #if defined(ARMA_USE_OPENMP)
       {
-      if((N < 512) || omp_in_parallel())  { arma_rng::randg<eT>::fill_simple(mem, N, a, b); return; }
+      if((N < 512) || omp_in_parallel() || (mp_executor_state::get() != nullptr) || (mp_hint::get() == 1))  { arma_rng::randg<eT>::fill_simple(mem, N, a, b); return; }
       
       typedef std::mt19937_64                  motor_type;
       typedef std::mt19937_64::result_type      ovum_type;
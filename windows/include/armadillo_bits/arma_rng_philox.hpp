@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup arma_rng_philox
+//! @{
+
+
+// Philox4x32-10 counter-based generator, as described in:
+// John K. Salmon, Mark A. Moraes, Ron O. Dror, David E. Shaw.
+// Parallel random numbers: as easy as 1, 2, 3.
+// Proceedings of the International Conference for High Performance Computing (SC), 2011.
+//
+// Each 128 bit output block is a pure function of (key, counter, stream),
+// so element i of a fill can be generated without generating elements 0 to i-1.
+// This allows a fill to be split across any number of threads
+// while producing bit-identical results regardless of the thread count.
+
+
+class arma_rng_philox
+  {
+  public:
+  
+  static constexpr uword threshold  = 1024;  //!< minimum number of elements for which arma_rng uses this generator (not used when ARMA_RNG_ALT is defined)
+  static constexpr uword block_size =  512;  //!< number of elements generated by one work unit; must be even
+  
+  arma_inline static void bijection(u32* ctr, u32 k0, u32 k1);
+  arma_inline static void gen_pair(u64& out1, u64& out2, const u64 key, const u64 stream, const u64 index);
+  
+  template<typename eT> inline static void randu_fill(eT* mem, const uword N, const double a, const double b, const u64 key, const u64 stream);
+  
+  template<typename eT> inline static void randn_fill(eT* mem, const uword N, const u64 key, const u64 stream);
+  
+  
+  private:
+  
+  template<typename eT> inline static void randu_block(eT* mem, const uword start, const uword endp1, const double a, const double b, const u64 key, const u64 stream);
+  template<typename eT> inline static void randn_block(eT* mem, const uword start, const uword endp1, const u64 key, const u64 stream);
+  
+  template<typename eT> struct randu_task;
+  template<typename eT> struct randn_task;
+  };
+
+
+
+//! fills blocks [start, endp1) via randu_block(); run via mp_task_runner, so that the blocks are
+//! distributed over a user-provided executor if one is set, otherwise over OpenMP threads
+template<typename eT>
+struct arma_rng_philox::randu_task : public mp_task
+  {
+        eT*    mem;
+  const uword  N;
+  const double a;
+  const double b;
+  const u64    key;
+  const u64    stream;
+  
+  inline randu_task(eT* in_mem, const uword in_N, const double in_a, const double in_b, const u64 in_key, const u64 in_stream)
+    : mem(in_mem), N(in_N), a(in_a), b(in_b), key(in_key), stream(in_stream) {}
+  
+  inline
+  void
+  run(const uword start, const uword endp1) const
+    {
+    for(uword blk=start; blk < endp1; ++blk)
+      {
+      const uword i_start = blk * block_size;
+      const uword i_endp1 = (std::min)(N, i_start + block_size);
+      
+      arma_rng_philox::randu_block(mem, i_start, i_endp1, a, b, key, stream);
+      }
+    }
+  };
+
+
+
+//! as per randu_task, but via randn_block()
+template<typename eT>
+struct arma_rng_philox::randn_task : public mp_task
+  {
+        eT*   mem;
+  const uword N;
+  const u64   key;
+  const u64   stream;
+  
+  inline randn_task(eT* in_mem, const uword in_N, const u64 in_key, const u64 in_stream)
+    : mem(in_mem), N(in_N), key(in_key), stream(in_stream) {}
+  
+  inline
+  void
+  run(const uword start, const uword endp1) const
+    {
+    for(uword blk=start; blk < endp1; ++blk)
+      {
+      const uword i_start = blk * block_size;
+      const uword i_endp1 = (std::min)(N, i_start + block_size);
+      
+      arma_rng_philox::randn_block(mem, i_start, i_endp1, key, stream);
+      }
+    }
+  };
+
+
+
+arma_inline
+void
+arma_rng_philox::bijection(u32* ctr, u32 k0, u32 k1)
+  {
+  constexpr u64 M0 = u64(0xD2511F53);
+  constexpr u64 M1 = u64(0xCD9E8D57);
+  constexpr u32 W0 = u32(0x9E3779B9);
+  constexpr u32 W1 = u32(0xBB67AE85);
+  
+  u32 c0 = ctr[0];
+  u32 c1 = ctr[1];
+  u32 c2 = ctr[2];
+  u32 c3 = ctr[3];
+  
+  for(uword r=0; r < 10; ++r)
+    {
+    const u64 p0 = M0 * u64(c0);
+    const u64 p1 = M1 * u64(c2);
+    
+    const u32 n0 = u32(p1 >> 32) ^ c1 ^ k0;
+    const u32 n1 = u32(p1);
+    const u32 n2 = u32(p0 >> 32) ^ c3 ^ k1;
+    const u32 n3 = u32(p0);
+    
+    c0 = n0;  c1 = n1;  c2 = n2;  c3 = n3;
+    
+    k0 += W0;
+    k1 += W1;
+    }
+  
+  ctr[0] = c0;
+  ctr[1] = c1;
+  ctr[2] = c2;
+  ctr[3] = c3;
+  }
+
+
+
+//! generate two 64 bit values at position 'index' of sub-stream 'stream'
+arma_inline
+void
+arma_rng_philox::gen_pair(u64& out1, u64& out2, const u64 key, const u64 stream, const u64 index)
+  {
+  u32 ctr[4];
+  
+  ctr[0] = u32(index);
+  ctr[1] = u32(index  >> 32);
+  ctr[2] = u32(stream);
+  ctr[3] = u32(stream >> 32);
+  
+  arma_rng_philox::bijection(ctr, u32(key), u32(key >> 32));
+  
+  out1 = (u64(ctr[0]) << 32) | u64(ctr[1]);
+  out2 = (u64(ctr[2]) << 32) | u64(ctr[3]);
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randu_block(eT* mem, const uword start, const uword endp1, const double a, const double b, const u64 key, const u64 stream)
+  {
+  constexpr double scale = double(1.0) / double(u64(1) << 53);
+  
+  const double r = b - a;
+  
+  for(uword i=start; i < endp1; i+=2)
+    {
+    u64 x1, x2;
+    
+    arma_rng_philox::gen_pair(x1, x2, key, stream, u64(i/2));
+    
+    mem[i] = eT( (double(x1 >> 11) * scale) * r + a );
+    
+    if((i+1) < endp1)  { mem[i+1] = eT( (double(x2 >> 11) * scale) * r + a ); }
+    }
+  }
+
+
+
+//! Box-Muller transform; uniforms are generated first so that the transcendental loop can be vectorised
+template<typename eT>
+inline
+void
+arma_rng_philox::randn_block(eT* mem, const uword start, const uword endp1, const u64 key, const u64 stream)
+  {
+  constexpr double scale = double(1.0) / double(u64(1) << 53);
+  constexpr double tau   = double(6.2831853071795864769252867665590057683943387987502116419498891846156328125724179972560696506842341360);
+  
+  constexpr uword n_pairs_max = block_size / 2;
+  
+  double buf_r[n_pairs_max];
+  double buf_t[n_pairs_max];
+  
+  const uword n_pairs = (endp1 - start + 1) / 2;
+  const u64   index0  = u64(start / 2);
+  
+  for(uword p=0; p < n_pairs; ++p)
+    {
+    u64 x1, x2;
+    
+    arma_rng_philox::gen_pair(x1, x2, key, stream, index0 + u64(p));
+    
+    buf_r[p] = double((x1 >> 11) + u64(1)) * scale;  // (0,1] to avoid log(0)
+    buf_t[p] = double( x2 >> 11          ) * scale;  // [0,1)
+    }
+  
+  for(uword p=0; p < n_pairs; ++p)
+    {
+    const double rad = std::sqrt( double(-2) * std::log(buf_r[p]) );
+    const double ang = tau * buf_t[p];
+    
+    buf_r[p] = rad * std::cos(ang);
+    buf_t[p] = rad * std::sin(ang);
+    }
+  
+  for(uword p=0; p < n_pairs; ++p)
+    {
+    const uword i = start + 2*p;
+    
+    mem[i] = eT(buf_r[p]);
+    
+    if((i+1) < endp1)  { mem[i+1] = eT(buf_t[p]); }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randu_fill(eT* mem, const uword N, const double a, const double b, const u64 key, const u64 stream)
+  {
+  const uword n_blocks = (N + block_size - 1) / block_size;
+  
+  if( (n_blocks > 1) && mp_gate<eT>::eval_task(N) )
+    {
+    mp_task_runner::run(n_blocks, randu_task<eT>(mem, N, a, b, key, stream));
+    
+    return;
+    }
+  
+  randu_task<eT>(mem, N, a, b, key, stream).run(0, n_blocks);
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randn_fill(eT* mem, const uword N, const u64 key, const u64 stream)
+  {
+  const uword n_blocks = (N + block_size - 1) / block_size;
+  
+  if( (n_blocks > 1) && mp_gate<eT>::eval_task(N) )
+    {
+    mp_task_runner::run(n_blocks, randn_task<eT>(mem, N, key, stream));
+    
+    return;
+    }
+  
+  randn_task<eT>(mem, N, key, stream).run(0, n_blocks);
+  }
+
+
+
+//! @}
@@ -348,6 +348,9 @@ class auxlib
   template<typename T1>
   inline static bool solve_tridiag_fast_common(Mat<typename T1::elem_type>& out, const Mat<typename T1::elem_type>& A, const Base<typename T1::elem_type,T1>& B_expr);
   
+  template<typename eT>
+  inline static bool solve_tridiag_extracted(Mat<eT>& out, Mat<eT>& tridiag);
+  
   
   //
   // Schur decomposition
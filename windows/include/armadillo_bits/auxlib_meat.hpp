@@ -39,7 +39,7 @@ auxlib::inv(Mat<eT>& A)
     blas_int lwork = (std::max)(blas_int(podarray_prealloc_n_elem::val), n);
     blas_int info  = 0;
     
-    podarray<blas_int> ipiv(A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv> ipiv(A.n_rows);
     
     arma_extra_debug_print("lapack::getrf()");
     lapack::getrf(&n, &n, A.memptr(), &lda, ipiv.memptr(), &info);
@@ -48,20 +48,27 @@ auxlib::inv(Mat<eT>& A)
     
     if(n > 16)
       {
-      eT        work_query[2] = {};
-      blas_int lwork_query    = -1;
-      
-      arma_extra_debug_print("lapack::getri()");
-      lapack::getri(&n, A.memptr(), &lda, ipiv.memptr(), &work_query[0], &lwork_query, &info);
-      
-      if(info != 0)  { return false; }
+      blas_int lwork_proposed = 0;
       
-      blas_int lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+      if(auxlib_lwork::get<eT>(lwork_proposed, "getri", n) == false)
+        {
+        eT        work_query[2] = {};
+        blas_int lwork_query    = -1;
+        
+        arma_extra_debug_print("lapack::getri()");
+        lapack::getri(&n, A.memptr(), &lda, ipiv.memptr(), &work_query[0], &lwork_query, &info);
+        
+        if(info != 0)  { return false; }
+        
+        lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+        
+        auxlib_lwork::set<eT>(lwork_proposed, "getri", n);
+        }
       
       lwork = (std::max)(lwork_proposed, lwork);
       }
     
-    podarray<eT> work( static_cast<uword>(lwork) );
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork) );
     
     arma_extra_debug_print("lapack::getri()");
     lapack::getri(&n, A.memptr(), &lda, ipiv.memptr(), work.memptr(), &lwork, &info);
@@ -118,7 +125,7 @@ auxlib::inv_rcond(Mat<eT>& A, typename get_pod_type<eT>::result& out_rcond)
     T        norm_val = T(0);
     
     podarray<T>        junk(1);
-    podarray<blas_int> ipiv(A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv> ipiv(A.n_rows);
     
     arma_extra_debug_print("lapack::lange()");
     norm_val = lapack::lange<eT>(&norm_id, &n, &n, A.memptr(), &lda, junk.memptr());
@@ -132,20 +139,27 @@ auxlib::inv_rcond(Mat<eT>& A, typename get_pod_type<eT>::result& out_rcond)
     
     if(n > 16)
       {
-      eT        work_query[2] = {};
-      blas_int lwork_query    = -1;
-      
-      arma_extra_debug_print("lapack::getri()");
-      lapack::getri(&n, A.memptr(), &lda, ipiv.memptr(), &work_query[0], &lwork_query, &info);
+      blas_int lwork_proposed = 0;
       
-      if(info != 0)  { return false; }
-      
-      blas_int lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+      if(auxlib_lwork::get<eT>(lwork_proposed, "getri", n) == false)
+        {
+        eT        work_query[2] = {};
+        blas_int lwork_query    = -1;
+        
+        arma_extra_debug_print("lapack::getri()");
+        lapack::getri(&n, A.memptr(), &lda, ipiv.memptr(), &work_query[0], &lwork_query, &info);
+        
+        if(info != 0)  { return false; }
+        
+        lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+        
+        auxlib_lwork::set<eT>(lwork_proposed, "getri", n);
+        }
       
       lwork = (std::max)(lwork_proposed, lwork);
       }
     
-    podarray<eT> work( static_cast<uword>(lwork) );
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork) );
     
     arma_extra_debug_print("lapack::getri()");
     lapack::getri(&n, A.memptr(), &lda, ipiv.memptr(), work.memptr(), &lwork, &info);
@@ -330,10 +344,12 @@ auxlib::inv_sympd_rcond(Mat<eT>& A, bool& out_sympd_state, eT& out_rcond, const
     blas_int info     = 0;
     T        norm_val = T(0);
     
-    podarray<T> work(A.n_rows);
+    {
+    auxlib_workspace<T, auxlib_workspace_slot::work> work(A.n_rows);
     
     arma_extra_debug_print("lapack::lansy()");
     norm_val = lapack::lansy(&norm_id, &uplo, &n, A.memptr(), &n, work.memptr());
+    }
     
     arma_extra_debug_print("lapack::potrf()");
     lapack::potrf(&uplo, &n, A.memptr(), &n, &info);
@@ -398,10 +414,12 @@ auxlib::inv_sympd_rcond(Mat< std::complex<T> >& A, bool& out_sympd_state, T& out
     blas_int info     = 0;
     T        norm_val = T(0);
     
-    podarray<T> work(A.n_rows);
+    {
+    auxlib_workspace<T, auxlib_workspace_slot::work> work(A.n_rows);
     
     arma_extra_debug_print("lapack::lanhe()");
     norm_val = lapack::lanhe(&norm_id, &uplo, &n, A.memptr(), &n, work.memptr());
+    }
     
     arma_extra_debug_print("lapack::potrf()");
     lapack::potrf(&uplo, &n, A.memptr(), &n, &info);
@@ -2005,11 +2023,30 @@ auxlib::eig_sym(Col<eT>& eigval, Mat<eT>& A)
     char jobz  = 'N';
     char uplo  = 'U';
     
-    blas_int N     = blas_int(A.n_rows);
-    blas_int lwork = (64+2)*N;  // lwork_min = (std::max)(blas_int(1), 3*N-1)
-    blas_int info  = 0;
+    blas_int N         = blas_int(A.n_rows);
+    blas_int lwork_min = (std::max)(blas_int(1), 3*N-1);
+    blas_int info      = 0;
     
-    podarray<eT> work( static_cast<uword>(lwork) );
+    blas_int lwork_proposed = 0;
+    
+    if(auxlib_lwork::get<eT>(lwork_proposed, "syev", N) == false)
+      {
+      eT        work_query[2] = {};
+      blas_int lwork_query    = -1;
+      
+      arma_extra_debug_print("lapack::syev()");
+      lapack::syev(&jobz, &uplo, &N, A.memptr(), &N, eigval.memptr(), &work_query[0], &lwork_query, &info);
+      
+      if(info != 0)  { return false; }
+      
+      lwork_proposed = static_cast<blas_int>( work_query[0] );
+      
+      auxlib_lwork::set<eT>(lwork_proposed, "syev", N);
+      }
+    
+    blas_int lwork = (std::max)(lwork_proposed, lwork_min);
+    
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork) );
     
     arma_extra_debug_print("lapack::syev()");
     lapack::syev(&jobz, &uplo, &N, A.memptr(), &N, eigval.memptr(), work.memptr(), &lwork, &info);
@@ -2058,12 +2095,32 @@ auxlib::eig_sym(Col<T>& eigval, Mat< std::complex<T> >& A)
     char jobz  = 'N'; 
     char uplo  = 'U';
     
-    blas_int N     = blas_int(A.n_rows);
-    blas_int lwork = (64+1)*N;  // lwork_min = (std::max)(blas_int(1), 2*N-1)
-    blas_int info  = 0;
+    blas_int N         = blas_int(A.n_rows);
+    blas_int lwork_min = (std::max)(blas_int(1), 2*N-1);
+    blas_int info      = 0;
     
-    podarray<eT>  work( static_cast<uword>(lwork) );
-    podarray<T>  rwork( static_cast<uword>( (std::max)(blas_int(1), 3*N) ) );
+    auxlib_workspace<T, auxlib_workspace_slot::rwork> rwork( static_cast<uword>( (std::max)(blas_int(1), 3*N) ) );
+    
+    blas_int lwork_proposed = 0;
+    
+    if(auxlib_lwork::get<eT>(lwork_proposed, "heev", N) == false)
+      {
+      eT        work_query[2] = {};
+      blas_int lwork_query    = -1;
+      
+      arma_extra_debug_print("lapack::heev()");
+      lapack::heev(&jobz, &uplo, &N, A.memptr(), &N, eigval.memptr(), &work_query[0], &lwork_query, rwork.memptr(), &info);
+      
+      if(info != 0)  { return false; }
+      
+      lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+      
+      auxlib_lwork::set<eT>(lwork_proposed, "heev", N);
+      }
+    
+    blas_int lwork = (std::max)(lwork_proposed, lwork_min);
+    
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork) );
     
     arma_extra_debug_print("lapack::heev()");
     lapack::heev(&jobz, &uplo, &N, A.memptr(), &N, eigval.memptr(), work.memptr(), &lwork, rwork.memptr(), &info);
@@ -2107,11 +2164,30 @@ auxlib::eig_sym(Col<eT>& eigval, Mat<eT>& eigvec, const Mat<eT>& X)
     char jobz  = 'V';
     char uplo  = 'U';
     
-    blas_int N     = blas_int(eigvec.n_rows);
-    blas_int lwork = (64+2)*N;  // lwork_min = (std::max)(blas_int(1), 3*N-1)
-    blas_int info  = 0;
+    blas_int N         = blas_int(eigvec.n_rows);
+    blas_int lwork_min = (std::max)(blas_int(1), 3*N-1);
+    blas_int info      = 0;
+    
+    blas_int lwork_proposed = 0;
+    
+    if(auxlib_lwork::get<eT>(lwork_proposed, "syev", N) == false)
+      {
+      eT        work_query[2] = {};
+      blas_int lwork_query    = -1;
+      
+      arma_extra_debug_print("lapack::syev()");
+      lapack::syev(&jobz, &uplo, &N, eigvec.memptr(), &N, eigval.memptr(), &work_query[0], &lwork_query, &info);
+      
+      if(info != 0)  { return false; }
+      
+      lwork_proposed = static_cast<blas_int>( work_query[0] );
+      
+      auxlib_lwork::set<eT>(lwork_proposed, "syev", N);
+      }
     
-    podarray<eT> work( static_cast<uword>(lwork) );
+    blas_int lwork = (std::max)(lwork_proposed, lwork_min);
+    
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork) );
     
     arma_extra_debug_print("lapack::syev()");
     lapack::syev(&jobz, &uplo, &N, eigvec.memptr(), &N, eigval.memptr(), work.memptr(), &lwork, &info);
@@ -2158,12 +2234,32 @@ auxlib::eig_sym(Col<T>& eigval, Mat< std::complex<T> >& eigvec, const Mat< std::
     char jobz  = 'V';
     char uplo  = 'U';
     
-    blas_int N     = blas_int(eigvec.n_rows);
-    blas_int lwork = (64+1)*N;  // lwork_min = (std::max)(blas_int(1), 2*N-1)
-    blas_int info  = 0;
+    blas_int N         = blas_int(eigvec.n_rows);
+    blas_int lwork_min = (std::max)(blas_int(1), 2*N-1);
+    blas_int info      = 0;
     
-    podarray<eT>  work( static_cast<uword>(lwork) );
-    podarray<T>  rwork( static_cast<uword>((std::max)(blas_int(1), 3*N)) );
+    auxlib_workspace<T, auxlib_workspace_slot::rwork> rwork( static_cast<uword>( (std::max)(blas_int(1), 3*N) ) );
+    
+    blas_int lwork_proposed = 0;
+    
+    if(auxlib_lwork::get<eT>(lwork_proposed, "heev", N) == false)
+      {
+      eT        work_query[2] = {};
+      blas_int lwork_query    = -1;
+      
+      arma_extra_debug_print("lapack::heev()");
+      lapack::heev(&jobz, &uplo, &N, eigvec.memptr(), &N, eigval.memptr(), &work_query[0], &lwork_query, rwork.memptr(), &info);
+      
+      if(info != 0)  { return false; }
+      
+      lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+      
+      auxlib_lwork::set<eT>(lwork_proposed, "heev", N);
+      }
+    
+    blas_int lwork = (std::max)(lwork_proposed, lwork_min);
+    
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork) );
     
     arma_extra_debug_print("lapack::heev()");
     lapack::heev(&jobz, &uplo, &N, eigvec.memptr(), &N, eigval.memptr(), work.memptr(), &lwork, rwork.memptr(), &info);
@@ -2216,7 +2312,7 @@ auxlib::eig_sym_dc(Col<eT>& eigval, Mat<eT>& eigvec, const Mat<eT>& X)
     blas_int  lwork_proposed = 0;
     blas_int liwork_proposed = 0;
     
-    if(N >= 32)
+    if( (N >= 32) && ( (auxlib_lwork::get<eT>(lwork_proposed, "syevd", N) == false) || (auxlib_lwork::get<eT>(liwork_proposed, "syevd_iwork", N) == false) ) )
       {
       eT        work_query[2] = {};
       blas_int iwork_query[2] = {};
@@ -2231,13 +2327,16 @@ auxlib::eig_sym_dc(Col<eT>& eigval, Mat<eT>& eigvec, const Mat<eT>& X)
       
        lwork_proposed = static_cast<blas_int>( work_query[0] );
       liwork_proposed = iwork_query[0];
+      
+      auxlib_lwork::set<eT>( lwork_proposed, "syevd",       N);
+      auxlib_lwork::set<eT>(liwork_proposed, "syevd_iwork", N);
       }
     
     blas_int  lwork_final = (std::max)( lwork_proposed,  lwork_min);
     blas_int liwork_final = (std::max)(liwork_proposed, liwork_min);
     
-    podarray<eT>        work( static_cast<uword>( lwork_final) );
-    podarray<blas_int> iwork( static_cast<uword>(liwork_final) ); 
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  work( static_cast<uword>( lwork_final) );
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> iwork( static_cast<uword>(liwork_final) );
     
     arma_extra_debug_print("lapack::syevd()");
     lapack::syevd(&jobz, &uplo, &N, eigvec.memptr(), &N, eigval.memptr(), work.memptr(), &lwork_final, iwork.memptr(), &liwork_final, &info);
@@ -2294,7 +2393,9 @@ auxlib::eig_sym_dc(Col<T>& eigval, Mat< std::complex<T> >& eigvec, const Mat< st
     blas_int lrwork_proposed = 0;
     blas_int liwork_proposed = 0;
     
-    if(N >= 32)
+    const bool have_proposed = (auxlib_lwork::get<eT>(lwork_proposed, "heevd", N) && auxlib_lwork::get<eT>(lrwork_proposed, "heevd_rwork", N) && auxlib_lwork::get<eT>(liwork_proposed, "heevd_iwork", N));
+    
+    if( (N >= 32) && (have_proposed == false) )
       {
       eT        work_query[2] = {};
       T        rwork_query[2] = {};
@@ -2312,15 +2413,19 @@ auxlib::eig_sym_dc(Col<T>& eigval, Mat< std::complex<T> >& eigvec, const Mat< st
        lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
       lrwork_proposed = static_cast<blas_int>( rwork_query[0] );
       liwork_proposed = iwork_query[0];
+      
+      auxlib_lwork::set<eT>( lwork_proposed, "heevd",       N);
+      auxlib_lwork::set<eT>(lrwork_proposed, "heevd_rwork", N);
+      auxlib_lwork::set<eT>(liwork_proposed, "heevd_iwork", N);
       }
     
     blas_int  lwork_final = (std::max)( lwork_proposed,  lwork_min);
     blas_int lrwork_final = (std::max)(lrwork_proposed, lrwork_min);
     blas_int liwork_final = (std::max)(liwork_proposed, liwork_min);
     
-    podarray<eT>        work( static_cast<uword>( lwork_final) );
-    podarray< T>       rwork( static_cast<uword>(lrwork_final) );
-    podarray<blas_int> iwork( static_cast<uword>(liwork_final) ); 
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  work( static_cast<uword>( lwork_final) );
+    auxlib_workspace< T,       auxlib_workspace_slot::rwork> rwork( static_cast<uword>(lrwork_final) );
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> iwork( static_cast<uword>(liwork_final) );
     
     arma_extra_debug_print("lapack::heevd()");
     lapack::heevd(&jobz, &uplo, &N, eigvec.memptr(), &N, eigval.memptr(), work.memptr(), &lwork_final, rwork.memptr(), &lrwork_final, iwork.memptr(), &liwork_final, &info);
@@ -3988,7 +4093,7 @@ auxlib::solve_square_fast(Mat<typename T1::elem_type>& out, Mat<typename T1::ele
     blas_int nrhs = blas_int(B_n_cols);
     blas_int info = blas_int(0);
     
-    podarray<blas_int> ipiv(A_n_rows + 2);  // +2 for paranoia: some versions of Lapack might be trashing memory
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv> ipiv(A_n_rows + 2);  // +2 for paranoia: some versions of Lapack might be trashing memory
     
     arma_extra_debug_print("lapack::gesv()");
     lapack::gesv<eT>(&n, &nrhs, A.memptr(), &lda, ipiv.memptr(), out.memptr(), &ldb, &info);
@@ -4040,11 +4145,12 @@ auxlib::solve_square_rcond(Mat<typename T1::elem_type>& out, typename T1::pod_ty
     blas_int info     = blas_int(0);
     T        norm_val = T(0);
     
-    podarray<T>        junk(1);
-    podarray<blas_int> ipiv(A.n_rows + 2);  // +2 for paranoia
+    T junk[2] = {};
+    
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv> ipiv(A.n_rows + 2);  // +2 for paranoia
     
     arma_extra_debug_print("lapack::lange()");
-    norm_val = lapack::lange<eT>(&norm_id, &n, &n, A.memptr(), &lda, junk.memptr());
+    norm_val = lapack::lange<eT>(&norm_id, &n, &n, A.memptr(), &lda, &junk[0]);
     
     arma_extra_debug_print("lapack::getrf()");
     lapack::getrf<eT>(&n, &n, A.memptr(), &n, ipiv.memptr(), &info);
@@ -4120,13 +4226,17 @@ auxlib::solve_square_refine(Mat<typename T1::pod_type>& out, typename T1::pod_ty
     
     Mat<eT> AF(A.n_rows, A.n_rows, arma_nozeros_indicator());
     
-    podarray<blas_int>  IPIV(  A.n_rows);
-    podarray<eT>           R(  A.n_rows);
-    podarray<eT>           C(  A.n_rows);
-    podarray<eT>        FERR(  B.n_cols);
-    podarray<eT>        BERR(  B.n_cols);
-    podarray<eT>        WORK(4*A.n_rows);
-    podarray<blas_int> IWORK(  A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv >  IPIV(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  WORK(4*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> IWORK(  A.n_rows);
+    
+    // R, C, FERR and BERR share one array
+    auxlib_workspace<eT, auxlib_workspace_slot::rwork> RCFB(2*A.n_rows + 2*B.n_cols);
+    
+    eT*    R = RCFB.memptr();
+    eT*    C =    R + A.n_rows;
+    eT* FERR =    C + A.n_rows;
+    eT* BERR = FERR + B.n_cols;
     
     arma_extra_debug_print("lapack::gesvx()");
     lapack::gesvx
@@ -4136,13 +4246,13 @@ auxlib::solve_square_refine(Mat<typename T1::pod_type>& out, typename T1::pod_ty
       AF.memptr(), &ldaf,
       IPIV.memptr(),
       &equed,
-      R.memptr(),
-      C.memptr(),
+      R,
+      C,
       const_cast<eT*>(B.memptr()), &ldb,
       out.memptr(), &ldx,
       &rcond,
-      FERR.memptr(),
-      BERR.memptr(),
+      FERR,
+      BERR,
       WORK.memptr(),
       IWORK.memptr(),
       &info
@@ -4217,13 +4327,17 @@ auxlib::solve_square_refine(Mat< std::complex<typename T1::pod_type> >& out, typ
     
     Mat<eT> AF(A.n_rows, A.n_rows, arma_nozeros_indicator());
     
-    podarray<blas_int>  IPIV(  A.n_rows);
-    podarray< T>           R(  A.n_rows);
-    podarray< T>           C(  A.n_rows);
-    podarray< T>        FERR(  B.n_cols);
-    podarray< T>        BERR(  B.n_cols);
-    podarray<eT>        WORK(2*A.n_rows);
-    podarray< T>       RWORK(2*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv> IPIV(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work> WORK(2*A.n_rows);
+    
+    // R, C, FERR, BERR and RWORK share one array
+    auxlib_workspace<T, auxlib_workspace_slot::rwork> RCFBW(4*A.n_rows + 2*B.n_cols);
+    
+    T*     R = RCFBW.memptr();
+    T*     C =    R + A.n_rows;
+    T*  FERR =    C + A.n_rows;
+    T*  BERR = FERR + B.n_cols;
+    T* RWORK = BERR + B.n_cols;
     
     arma_extra_debug_print("lapack::cx_gesvx()");
     lapack::cx_gesvx
@@ -4233,15 +4347,15 @@ auxlib::solve_square_refine(Mat< std::complex<typename T1::pod_type> >& out, typ
       AF.memptr(), &ldaf,
       IPIV.memptr(),
       &equed,
-      R.memptr(),
-      C.memptr(),
+      R,
+      C,
       const_cast<eT*>(B.memptr()), &ldb,
       out.memptr(), &ldx,
       &rcond,
-      FERR.memptr(),
-      BERR.memptr(),
+      FERR,
+      BERR,
       WORK.memptr(),
-      RWORK.memptr(),
+      RWORK,
       &info
       );
     
@@ -4372,10 +4486,12 @@ auxlib::solve_sympd_rcond(Mat<typename T1::pod_type>& out, bool& out_sympd_state
     blas_int info     = blas_int(0);
     T        norm_val = T(0);
     
-    podarray<T> work(A.n_rows);
+    {
+    auxlib_workspace<T, auxlib_workspace_slot::work> work(A.n_rows);
     
     arma_extra_debug_print("lapack::lansy()");
     norm_val = lapack::lansy(&norm_id, &uplo, &n, A.memptr(), &n, work.memptr());
+    }
     
     arma_extra_debug_print("lapack::potrf()");
     lapack::potrf<eT>(&uplo, &n, A.memptr(), &n, &info);
@@ -4450,10 +4566,12 @@ auxlib::solve_sympd_rcond(Mat< std::complex<typename T1::pod_type> >& out, bool&
     blas_int info     = blas_int(0);
     T        norm_val = T(0);
     
-    podarray<T> work(A.n_rows);
+    {
+    auxlib_workspace<T, auxlib_workspace_slot::work> work(A.n_rows);
     
     arma_extra_debug_print("lapack::lanhe()");
     norm_val = lapack::lanhe(&norm_id, &uplo, &n, A.memptr(), &n, work.memptr());
+    }
     
     arma_extra_debug_print("lapack::potrf()");
     lapack::potrf<eT>(&uplo, &n, A.memptr(), &n, &info);
@@ -4532,14 +4650,18 @@ auxlib::solve_sympd_refine(Mat<typename T1::pod_type>& out, typename T1::pod_typ
     
     Mat<eT> AF(A.n_rows, A.n_rows, arma_nozeros_indicator());
     
-    podarray<eT>           S(  A.n_rows);
-    podarray<eT>        FERR(  B.n_cols);
-    podarray<eT>        BERR(  B.n_cols);
-    podarray<eT>        WORK(3*A.n_rows);
-    podarray<blas_int> IWORK(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  WORK(3*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> IWORK(  A.n_rows);
+    
+    // S, FERR and BERR share one array
+    auxlib_workspace<eT, auxlib_workspace_slot::rwork> SFB(A.n_rows + 2*B.n_cols);
+    
+    eT*    S = SFB.memptr();
+    eT* FERR =    S + A.n_rows;
+    eT* BERR = FERR + B.n_cols;
     
     arma_extra_debug_print("lapack::posvx()");
-    lapack::posvx(&fact, &uplo, &n, &nrhs, A.memptr(), &lda, AF.memptr(), &ldaf, &equed, S.memptr(), const_cast<eT*>(B.memptr()), &ldb, out.memptr(), &ldx, &rcond, FERR.memptr(), BERR.memptr(), WORK.memptr(), IWORK.memptr(), &info);
+    lapack::posvx(&fact, &uplo, &n, &nrhs, A.memptr(), &lda, AF.memptr(), &ldaf, &equed, S, const_cast<eT*>(B.memptr()), &ldb, out.memptr(), &ldx, &rcond, FERR, BERR, WORK.memptr(), IWORK.memptr(), &info);
     
     // NOTE: using const_cast<eT*>(B.memptr()) to allow B to be overwritten for equilibration;
     // NOTE: B is created as a copy of B_expr if equilibration is enabled; otherwise B is a reference to B_expr
@@ -4617,14 +4739,18 @@ auxlib::solve_sympd_refine(Mat< std::complex<typename T1::pod_type> >& out, type
     
     Mat<eT> AF(A.n_rows, A.n_rows, arma_nozeros_indicator());
     
-    podarray< T>           S(  A.n_rows);
-    podarray< T>        FERR(  B.n_cols);
-    podarray< T>        BERR(  B.n_cols);
-    podarray<eT>        WORK(2*A.n_rows);
-    podarray< T>       RWORK(  A.n_rows);
+    auxlib_workspace<eT, auxlib_workspace_slot::work> WORK(2*A.n_rows);
+    
+    // S, FERR, BERR and RWORK share one array
+    auxlib_workspace<T, auxlib_workspace_slot::rwork> SFBW(2*A.n_rows + 2*B.n_cols);
+    
+    T*     S = SFBW.memptr();
+    T*  FERR =    S + A.n_rows;
+    T*  BERR = FERR + B.n_cols;
+    T* RWORK = BERR + B.n_cols;
     
     arma_extra_debug_print("lapack::cx_posvx()");
-    lapack::cx_posvx(&fact, &uplo, &n, &nrhs, A.memptr(), &lda, AF.memptr(), &ldaf, &equed, S.memptr(), const_cast<eT*>(B.memptr()), &ldb, out.memptr(), &ldx, &rcond, FERR.memptr(), BERR.memptr(), WORK.memptr(), RWORK.memptr(), &info);
+    lapack::cx_posvx(&fact, &uplo, &n, &nrhs, A.memptr(), &lda, AF.memptr(), &ldaf, &equed, S, const_cast<eT*>(B.memptr()), &ldb, out.memptr(), &ldx, &rcond, FERR, BERR, WORK.memptr(), RWORK, &info);
     
     // NOTE: using const_cast<eT*>(B.memptr()) to allow B to be overwritten for equilibration;
     // NOTE: B is created as a copy of B_expr if equilibration is enabled; otherwise B is a reference to B_expr
@@ -4694,7 +4820,7 @@ auxlib::solve_rect_fast(Mat<typename T1::elem_type>& out, Mat<typename T1::elem_
     
     blas_int lwork_proposed = 0;
     
-    if(A.n_elem >= ((is_cx<eT>::yes) ? uword(256) : uword(1024)))
+    if( (A.n_elem >= ((is_cx<eT>::yes) ? uword(256) : uword(1024))) && (auxlib_lwork::get<eT>(lwork_proposed, "gels", m, n, nrhs) == false) )
       {
       eT        work_query[2] = {};
       blas_int lwork_query    = -1;
@@ -4705,11 +4831,13 @@ auxlib::solve_rect_fast(Mat<typename T1::elem_type>& out, Mat<typename T1::elem_
       if(info != 0)  { return false; }
       
       lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+      
+      auxlib_lwork::set<eT>(lwork_proposed, "gels", m, n, nrhs);
       }
     
     blas_int lwork_final = (std::max)(lwork_proposed, lwork_min);
     
-    podarray<eT> work( static_cast<uword>(lwork_final) );
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork_final) );
     
     arma_extra_debug_print("lapack::gels()");
     lapack::gels<eT>( &trans, &m, &n, &nrhs, A.memptr(), &lda, tmp.memptr(), &ldb, work.memptr(), &lwork_final, &info );
@@ -4788,7 +4916,7 @@ auxlib::solve_rect_rcond(Mat<typename T1::elem_type>& out, typename T1::pod_type
     
     blas_int lwork_proposed = 0;
     
-    if(A.n_elem >= ((is_cx<eT>::yes) ? uword(256) : uword(1024)))
+    if( (A.n_elem >= ((is_cx<eT>::yes) ? uword(256) : uword(1024))) && (auxlib_lwork::get<eT>(lwork_proposed, "gels", m, n, nrhs) == false) )
       {
       eT        work_query[2] = {};
       blas_int lwork_query    = -1;
@@ -4799,14 +4927,18 @@ auxlib::solve_rect_rcond(Mat<typename T1::elem_type>& out, typename T1::pod_type
       if(info != 0)  { return false; }
       
       lwork_proposed = static_cast<blas_int>( access::tmp_real(work_query[0]) );
+      
+      auxlib_lwork::set<eT>(lwork_proposed, "gels", m, n, nrhs);
       }
     
     blas_int lwork_final = (std::max)(lwork_proposed, lwork_min);
     
-    podarray<eT> work( static_cast<uword>(lwork_final) );
+    {
+    auxlib_workspace<eT, auxlib_workspace_slot::work> work( static_cast<uword>(lwork_final) );
     
     arma_extra_debug_print("lapack::gels()");
     lapack::gels<eT>( &trans, &m, &n, &nrhs, A.memptr(), &lda, tmp.memptr(), &ldb, work.memptr(), &lwork_final, &info );
+    }
     
     if(info != 0)  { return false; }
     
@@ -5486,13 +5618,17 @@ auxlib::solve_band_refine(Mat<typename T1::pod_type>& out, typename T1::pod_type
     blas_int info  = blas_int(0);
     eT       rcond = eT(0);
     
-    podarray<blas_int>  IPIV(  N);
-    podarray<eT>           R(  N);
-    podarray<eT>           C(  N);
-    podarray<eT>        FERR(  B.n_cols);
-    podarray<eT>        BERR(  B.n_cols);
-    podarray<eT>        WORK(3*N);
-    podarray<blas_int> IWORK(  N);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv >  IPIV(  N);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  WORK(3*N);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> IWORK(  N);
+    
+    // R, C, FERR and BERR share one array
+    auxlib_workspace<eT, auxlib_workspace_slot::rwork> RCFB(2*N + 2*B.n_cols);
+    
+    eT*    R = RCFB.memptr();
+    eT*    C =    R + N;
+    eT* FERR =    C + N;
+    eT* BERR = FERR + B.n_cols;
     
     arma_extra_debug_print("lapack::gbsvx()");
     lapack::gbsvx
@@ -5502,13 +5638,13 @@ auxlib::solve_band_refine(Mat<typename T1::pod_type>& out, typename T1::pod_type
       AFB.memptr(), &ldafb,
       IPIV.memptr(),
       &equed,
-      R.memptr(),
-      C.memptr(),
+      R,
+      C,
       B.memptr(), &ldb,
       out.memptr(), &ldx,
       &rcond,
-      FERR.memptr(),
-      BERR.memptr(),
+      FERR,
+      BERR,
       WORK.memptr(),
       IWORK.memptr(),
       &info
@@ -5590,13 +5726,18 @@ auxlib::solve_band_refine(Mat< std::complex<typename T1::pod_type> >& out, typen
     blas_int info  = blas_int(0);
     T        rcond = T(0);
     
-    podarray<blas_int>  IPIV(  N);
-    podarray< T>           R(  N);
-    podarray< T>           C(  N);
-    podarray< T>        FERR(  B.n_cols);
-    podarray< T>        BERR(  B.n_cols);
-    podarray<eT>        WORK(2*N);
-    podarray< T>       RWORK(  N);  // NOTE: according to lapack 3.6.1 docs, the size of RWORK in zgbsvx is different to RWORK in dgesvx 
+    auxlib_workspace<blas_int, auxlib_workspace_slot::ipiv> IPIV(  N);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work> WORK(2*N);
+    
+    // R, C, FERR, BERR and RWORK share one array
+    // NOTE: according to lapack 3.6.1 docs, the size of RWORK in zgbsvx is different to RWORK in dgesvx 
+    auxlib_workspace<T, auxlib_workspace_slot::rwork> RCFBW(3*N + 2*B.n_cols);
+    
+    T*     R = RCFBW.memptr();
+    T*     C =    R + N;
+    T*  FERR =    C + N;
+    T*  BERR = FERR + B.n_cols;
+    T* RWORK = BERR + B.n_cols;
     
     arma_extra_debug_print("lapack::cx_gbsvx()");
     lapack::cx_gbsvx
@@ -5606,15 +5747,15 @@ auxlib::solve_band_refine(Mat< std::complex<typename T1::pod_type> >& out, typen
       AFB.memptr(), &ldafb,
       IPIV.memptr(),
       &equed,
-      R.memptr(),
-      C.memptr(),
+      R,
+      C,
       B.memptr(), &ldb,
       out.memptr(), &ldx,
       &rcond,
-      FERR.memptr(),
-      BERR.memptr(),
+      FERR,
+      BERR,
       WORK.memptr(),
-      RWORK.memptr(),
+      RWORK,
       &info
       );
     
@@ -5699,11 +5840,37 @@ auxlib::solve_tridiag_fast_common(Mat<typename T1::elem_type>& out, const Mat<ty
     Mat<eT> tridiag;
     band_helper::extract_tridiag(tridiag, A);
     
+    return auxlib::solve_tridiag_extracted(out, tridiag);
+    }
+  #else
+    {
+    arma_ignore(out);
+    arma_ignore(A);
+    arma_ignore(B_expr);
+    arma_stop_logic_error("solve(): use of LAPACK must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! solve a tridiagonal system given by its diagonals, stored as by band_helper::extract_tridiag();
+//! 'out' holds the right hand side on entry; 'tridiag' is overwritten
+template<typename eT>
+inline
+bool
+auxlib::solve_tridiag_extracted(Mat<eT>& out, Mat<eT>& tridiag)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
     arma_debug_assert_blas_size(tridiag, out);
     
-    blas_int n    = blas_int(A.n_rows);
-    blas_int nrhs = blas_int(B_n_cols);
-    blas_int ldb  = blas_int(B_n_rows);
+    blas_int n    = blas_int(tridiag.n_rows);
+    blas_int nrhs = blas_int(out.n_cols);
+    blas_int ldb  = blas_int(out.n_rows);
     blas_int info = blas_int(0);
     
     arma_extra_debug_print("lapack::gtsv()");
@@ -5714,8 +5881,7 @@ auxlib::solve_tridiag_fast_common(Mat<typename T1::elem_type>& out, const Mat<ty
   #else
     {
     arma_ignore(out);
-    arma_ignore(A);
-    arma_ignore(B_expr);
+    arma_ignore(tridiag);
     arma_stop_logic_error("solve(): use of LAPACK must be enabled");
     return false;
     }
@@ -6199,8 +6365,8 @@ auxlib::rcond_sympd(Mat<eT>& A, bool& calc_ok)
     eT       rcond    = eT(0);
     blas_int info     = blas_int(0);
     
-    podarray<eT>        work(3*A.n_rows);
-    podarray<blas_int> iwork(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  work(3*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> iwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::lansy()");
     norm_val = lapack::lansy(&norm_id, &uplo, &n, A.memptr(), &lda, work.memptr());
@@ -6260,8 +6426,8 @@ auxlib::rcond_sympd(Mat< std::complex<T> >& A, bool& calc_ok)
     T        rcond    = T(0);
     blas_int info     = blas_int(0);
     
-    podarray<eT>  work(2*A.n_rows);
-    podarray< T> rwork(  A.n_rows);
+    auxlib_workspace<eT, auxlib_workspace_slot::work >  work(2*A.n_rows);
+    auxlib_workspace< T, auxlib_workspace_slot::rwork> rwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::lanhe()");
     norm_val = lapack::lanhe(&norm_id, &uplo, &n, A.memptr(), &lda, rwork.memptr());
@@ -6308,8 +6474,8 @@ auxlib::rcond_trimat(const Mat<eT>& A, const uword layout)
     eT       rcond   = eT(0);
     blas_int info    = blas_int(0);
     
-    podarray<eT>        work(3*A.n_rows);
-    podarray<blas_int> iwork(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  work(3*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> iwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::trcon()");
     lapack::trcon(&norm_id, &uplo, &diag, &n, A.memptr(), &n, &rcond, work.memptr(), iwork.memptr(), &info);
@@ -6348,8 +6514,8 @@ auxlib::rcond_trimat(const Mat< std::complex<T> >& A, const uword layout)
     T        rcond   = T(0);
     blas_int info    = blas_int(0);
     
-    podarray<eT>  work(2*A.n_rows);
-    podarray< T> rwork(  A.n_rows);
+    auxlib_workspace<eT, auxlib_workspace_slot::work >  work(2*A.n_rows);
+    auxlib_workspace< T, auxlib_workspace_slot::rwork> rwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::cx_trcon()");
     lapack::cx_trcon(&norm_id, &uplo, &diag, &n, A.memptr(), &n, &rcond, work.memptr(), rwork.memptr(), &info);
@@ -6383,8 +6549,8 @@ auxlib::lu_rcond(const Mat<eT>& A, const eT norm_val)
     eT       rcond   = eT(0);
     blas_int info    = blas_int(0);
     
-    podarray<eT>        work(4*A.n_rows);
-    podarray<blas_int> iwork(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  work(4*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> iwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::gecon()");
     lapack::gecon(&norm_id, &n, A.memptr(), &lda, &norm_val, &rcond, work.memptr(), iwork.memptr(), &info);
@@ -6419,8 +6585,8 @@ auxlib::lu_rcond(const Mat< std::complex<T> >& A, const T norm_val)
     T        rcond   = T(0);
     blas_int info    = blas_int(0);
     
-    podarray<eT>  work(2*A.n_rows);
-    podarray< T> rwork(2*A.n_rows);
+    auxlib_workspace<eT, auxlib_workspace_slot::work >  work(2*A.n_rows);
+    auxlib_workspace< T, auxlib_workspace_slot::rwork> rwork(2*A.n_rows);
     
     arma_extra_debug_print("lapack::cx_gecon()");
     lapack::cx_gecon(&norm_id, &n, A.memptr(), &lda, &norm_val, &rcond, work.memptr(), rwork.memptr(), &info);
@@ -6452,8 +6618,8 @@ auxlib::lu_rcond_sympd(const Mat<eT>& A, const eT norm_val)
     eT       rcond = eT(0);
     blas_int info  = blas_int(0);
     
-    podarray<eT>        work(3*A.n_rows);
-    podarray<blas_int> iwork(  A.n_rows);
+    auxlib_workspace<eT,       auxlib_workspace_slot::work >  work(3*A.n_rows);
+    auxlib_workspace<blas_int, auxlib_workspace_slot::iwork> iwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::pocon()");
     lapack::pocon(&uplo, &n, A.memptr(), &n, &norm_val, &rcond, work.memptr(), iwork.memptr(), &info);
@@ -6493,8 +6659,8 @@ auxlib::lu_rcond_sympd(const Mat< std::complex<T> >& A, const T norm_val)
     T        rcond = T(0);
     blas_int info  = blas_int(0);
     
-    podarray<eT>  work(2*A.n_rows);
-    podarray< T> rwork(  A.n_rows);
+    auxlib_workspace<eT, auxlib_workspace_slot::work >  work(2*A.n_rows);
+    auxlib_workspace< T, auxlib_workspace_slot::rwork> rwork(  A.n_rows);
     
     arma_extra_debug_print("lapack::cx_pocon()");
     lapack::cx_pocon(&uplo, &n, A.memptr(), &n, &norm_val, &rcond, work.memptr(), rwork.memptr(), &info);
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup auxlib_workspace
+//! @{
+
+
+
+struct auxlib_workspace_slot
+  {
+  static constexpr uword work  = 0;
+  static constexpr uword rwork = 1;
+  static constexpr uword iwork = 2;
+  static constexpr uword ipiv  = 3;
+  };
+
+
+
+//! Scratch array for LAPACK routines, taken from a per-thread cache which only grows.
+//! Repeated auxlib calls on identically sized matrices then do not allocate memory.
+//! If the cached array for the given type and slot is already in use (eg. by a calling function),
+//! or the requested size exceeds max_n_bytes, a separate array is allocated instead.
+//! For internal use only!
+template<typename eT, uword slot>
+class auxlib_workspace
+  {
+  public:
+  
+  static constexpr uword max_n_bytes = uword(64) * uword(1024) * uword(1024);  //!< largest array kept in the cache
+  
+  inline ~auxlib_workspace();
+  inline explicit auxlib_workspace(const uword n_elem);
+  
+  auxlib_workspace(const auxlib_workspace&)            = delete;
+  auxlib_workspace& operator=(const auxlib_workspace&) = delete;
+  
+  arma_inline eT* memptr();
+  
+  
+  private:
+  
+  struct cache_type
+    {
+    podarray<eT> mem;
+    bool         in_use = false;
+    };
+  
+  inline static cache_type& get_cache();
+  
+  cache_type*  cache = nullptr;  //!< nullptr if the cache is not used by this object
+  podarray<eT> local;
+  eT*          mem   = nullptr;
+  };
+
+
+
+//! Per-thread memo of optimal workspace sizes returned by LAPACK workspace queries (lwork = -1),
+//! keyed by element type, routine name and problem dimensions.
+//! For internal use only!
+class auxlib_lwork
+  {
+  public:
+  
+  template<typename eT> inline static bool get(blas_int& out_lwork, const char* routine, const blas_int n1, const blas_int n2 = blas_int(0), const blas_int n3 = blas_int(0));
+  template<typename eT> inline static void set(const blas_int lwork, const char* routine, const blas_int n1, const blas_int n2 = blas_int(0), const blas_int n3 = blas_int(0));
+  
+  
+  private:
+  
+  struct key_type
+    {
+    const char* routine;
+    blas_int    n1;
+    blas_int    n2;
+    blas_int    n3;
+    
+    inline bool operator<(const key_type& x) const
+      {
+      if(routine != x.routine)  { return std::less<const char*>()(routine, x.routine); }
+      if(n1      != x.n1     )  { return (n1      < x.n1     ); }
+      if(n2      != x.n2     )  { return (n2      < x.n2     ); }
+      
+      return (n3 < x.n3);
+      }
+    };
+  
+  template<typename eT> inline static std::map<key_type, blas_int>& get_map();
+  };
+
+
+
+//! @}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup auxlib_workspace
+//! @{
+
+
+
+template<typename eT, uword slot>
+inline
+auxlib_workspace<eT,slot>::~auxlib_workspace()
+  {
+  if(cache != nullptr)  { cache->in_use = false; }
+  }
+
+
+
+template<typename eT, uword slot>
+inline
+auxlib_workspace<eT,slot>::auxlib_workspace(const uword n_elem)
+  {
+  cache_type& c = auxlib_workspace<eT,slot>::get_cache();
+  
+  if( (c.in_use == false) && (n_elem <= (max_n_bytes / sizeof(eT))) )
+    {
+    c.mem.set_min_size(n_elem);
+    
+    c.in_use = true;
+    
+    cache = &c;
+    mem   = c.mem.memptr();
+    }
+  else
+    {
+    local.set_size(n_elem);
+    
+    mem = local.memptr();
+    }
+  }
+
+
+
+template<typename eT, uword slot>
+arma_inline
+eT*
+auxlib_workspace<eT,slot>::memptr()
+  {
+  return mem;
+  }
+
+
+
+template<typename eT, uword slot>
+inline
+typename auxlib_workspace<eT,slot>::cache_type&
+auxlib_workspace<eT,slot>::get_cache()
+  {
+  thread_local cache_type c;
+  
+  return c;
+  }
+
+
+
+//
+
+
+
+template<typename eT>
+inline
+bool
+auxlib_lwork::get(blas_int& out_lwork, const char* routine, const blas_int n1, const blas_int n2, const blas_int n3)
+  {
+  const std::map<key_type, blas_int>& m = auxlib_lwork::get_map<eT>();
+  
+  const auto it = m.find( key_type{routine, n1, n2, n3} );
+  
+  if(it == m.end())  { return false; }
+  
+  out_lwork = it->second;
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+auxlib_lwork::set(const blas_int lwork, const char* routine, const blas_int n1, const blas_int n2, const blas_int n3)
+  {
+  auxlib_lwork::get_map<eT>()[ key_type{routine, n1, n2, n3} ] = lwork;
+  }
+
+
+
+template<typename eT>
+inline
+std::map<auxlib_lwork::key_type, blas_int>&
+auxlib_lwork::get_map()
+  {
+  thread_local std::map<key_type, blas_int> m;
+  
+  return m;
+  }
+
+
+
+//! @}
@@ -198,6 +198,11 @@
 //// Uncomment the above line if you want to see the function traces of how Armadillo evaluates expressions.
 //// This is mainly useful for debugging of the library.
 
+// #define ARMA_PROFILE
+//// Uncomment the above line to collect per-function call counts, wall time, allocated memory and OpenMP usage
+//// for Armadillo functions; see arma_profile::print() and arma_profile::save_trace().
+//// ARMA_PROFILE is ignored if ARMA_EXTRA_DEBUG or ARMA_DONT_USE_STD_MUTEX is defined.
+
 
 #if defined(ARMA_DEFAULT_OSTREAM)
   #pragma message ("WARNING: support for ARMA_DEFAULT_OSTREAM is deprecated and will be removed;")
@@ -351,6 +356,10 @@
   #undef ARMA_CRIPPLED_LAPACK
 #endif
 
+#if defined(ARMA_PROFILE) && (defined(ARMA_EXTRA_DEBUG) || defined(ARMA_DONT_USE_STD_MUTEX))
+  #undef ARMA_PROFILE
+#endif
+
 
 // if Armadillo was installed on this system via CMake and ARMA_USE_WRAPPER is not defined,
 // ARMA_AUX_LIBS lists the libraries required by Armadillo on this system, and
@@ -1377,12 +1377,21 @@ arma_assert_atlas_size(const T1& A, const T2& B)
   #define arma_extra_debug_sigprint       arma_sigprint(ARMA_FNSIG); arma_bktprint
   #define arma_extra_debug_sigprint_this  arma_sigprint(ARMA_FNSIG); arma_thisprint
   #define arma_extra_debug_print          arma_print
+  #define arma_extra_debug_plan(...)      expr_plan< __VA_ARGS__ >::print(get_cerr_stream())
+  
+#elif defined(ARMA_PROFILE)
+  
+  #define arma_extra_debug_sigprint        arma_profile_scope arma_profile_scope_obj(ARMA_FNSIG); true ? (void)0 : arma_bktprint
+  #define arma_extra_debug_sigprint_this   true ? (void)0 : arma_thisprint
+  #define arma_extra_debug_print           true ? (void)0 : arma_print
+  #define arma_extra_debug_plan(...)       (void)0
   
 #else
   
   #define arma_extra_debug_sigprint        true ? (void)0 : arma_bktprint
   #define arma_extra_debug_sigprint_this   true ? (void)0 : arma_thisprint
   #define arma_extra_debug_print           true ? (void)0 : arma_print
+  #define arma_extra_debug_plan(...)       (void)0
   
 #endif
 
@@ -40,6 +40,13 @@
   #define arma_H5Sget_simple_extent_dims    H5Sget_simple_extent_dims
   #define arma_H5Sclose                     H5Sclose
   #define arma_H5Screate_simple             H5Screate_simple
+  #define arma_H5Sselect_hyperslab          H5Sselect_hyperslab
+  
+  #define arma_H5Pcreate       H5Pcreate
+  #define arma_H5Pclose        H5Pclose
+  #define arma_H5Pset_chunk    H5Pset_chunk
+  #define arma_H5Pset_deflate  H5Pset_deflate
+  #define arma_H5Pset_shuffle  H5Pset_shuffle
 
   #define arma_H5Ovisit     H5Ovisit
 
@@ -70,6 +77,8 @@
   #define arma_H5T_NATIVE_ULLONG  H5T_NATIVE_ULLONG
   #define arma_H5T_NATIVE_FLOAT   H5T_NATIVE_FLOAT
   #define arma_H5T_NATIVE_DOUBLE  H5T_NATIVE_DOUBLE
+  
+  #define arma_H5P_DATASET_CREATE  H5P_DATASET_CREATE
 
 #else
 
@@ -96,6 +105,13 @@ extern "C"
   int    arma_H5Sget_simple_extent_dims(hid_t space_id, hsize_t* dims, hsize_t* maxdims);
   herr_t arma_H5Sclose(hid_t space_id);
   hid_t  arma_H5Screate_simple(int rank, const hsize_t* current_dims, const hsize_t* maximum_dims);
+  herr_t arma_H5Sselect_hyperslab(hid_t space_id, H5S_seloper_t op, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block);
+  
+  hid_t  arma_H5Pcreate(hid_t cls_id);
+  herr_t arma_H5Pclose(hid_t plist_id);
+  herr_t arma_H5Pset_chunk(hid_t plist_id, int ndims, const hsize_t* dim);
+  herr_t arma_H5Pset_deflate(hid_t plist_id, unsigned level);
+  herr_t arma_H5Pset_shuffle(hid_t plist_id);
   
   herr_t arma_H5Ovisit(hid_t object_id, H5_index_t index_type, H5_iter_order_t order, H5O_iterate_t op, void* op_data);
   
@@ -131,6 +147,9 @@ extern "C"
   extern hid_t arma_H5T_NATIVE_FLOAT;
   extern hid_t arma_H5T_NATIVE_DOUBLE;
   
+  // property list class used for chunked and compressed datasets
+  extern hid_t arma_H5P_DATASET_CREATE;
+  
   }
   
   // Lastly, we have to hijack H5open() and H5check_version(), which are called
@@ -27,6 +27,9 @@ class diskio
   
   inline arma_deprecated static file_type guess_file_type(std::istream& f);
   
+  inline arma_cold static bool probe(file_probe& info, const std::string& name, std::string& err_msg);
+  inline arma_cold static bool probe(file_probe& info, std::istream&      f,    std::string& err_msg);
+  
   
   private:
   
@@ -34,6 +37,7 @@ class diskio
   template<typename eT> friend class  Cube;
   template<typename eT> friend class SpMat;
   template<typename oT> friend class field;
+  template<typename eT> friend class TiledCube;
   
   friend class   Mat_aux;
   friend class  Cube_aux;
@@ -50,6 +54,12 @@ class diskio
   
   inline arma_cold static file_type guess_file_type_internal(std::istream& f);
   
+  inline arma_cold static bool probe_arma_header(file_probe& info, std::istream& f, std::string& err_msg);
+  inline arma_cold static bool probe_pnm_header (file_probe& info, std::istream& f, std::string& err_msg);
+  inline arma_cold static bool probe_text       (file_probe& info, std::istream& f, std::string& err_msg);
+  inline arma_cold static bool probe_hdf5       (file_probe& info, const std::string& name, std::string& err_msg);
+  inline arma_cold static bool probe_elem_type  (file_probe& info, const std::string& code);
+  
   inline arma_cold static std::string gen_tmp_name(const std::string& x);
   
   inline arma_cold static bool safe_rename(const std::string& old_name, const std::string& new_name);
@@ -187,6 +197,24 @@ class diskio
   template<typename T1> inline static bool load_auto_detect(      field<T1>& x, const std::string&  name, std::string& err_msg);
   template<typename T1> inline static bool load_auto_detect(      field<T1>& x,       std::istream& f,    std::string& err_msg);
   
+  template<typename T1> inline static bool save_arma_binary_indexed(const field<T1>& x, const std::string&  final_name);
+  template<typename T1> inline static bool save_arma_binary_indexed(const field<T1>& x,       std::ostream& f);
+  
+  template<typename T1> inline static bool load_arma_binary_indexed(      field<T1>& x, const std::string&  name, std::string& err_msg);
+  template<typename T1> inline static bool load_arma_binary_indexed(      field<T1>& x,       std::istream& f,    std::string& err_msg);
+  
+  template<typename T1> inline static bool load_arma_binary_indexed_elem(field<T1>& x, const uword index, const std::string& name, std::string& err_msg);
+  
+  template<typename T1> inline static u64  gen_index_table (podarray<u64>& table, std::string& header, const field<T1>& x);
+  template<typename T1> inline static bool load_index_table(podarray<u64>& table, uword& n_rows, uword& n_cols, uword& n_slices, u64& n_bytes_read, std::istream& f, std::string& err_msg);
+  
+  template<typename eT> inline static void index_get_dims(u64* dims, const  Mat<eT>& X);
+  template<typename eT> inline static void index_get_dims(u64* dims, const Cube<eT>& X);
+  template<typename eT> inline static bool index_set_size( Mat<eT>& X, const u64* dims);
+  template<typename eT> inline static bool index_set_size(Cube<eT>& X, const u64* dims);
+  
+  inline static bool is_arma_binary_indexed(std::istream& f);
+  
   inline static bool save_std_string(const field<std::string>& x, const std::string&  name);
   inline static bool save_std_string(const field<std::string>& x,       std::ostream& f);
   
@@ -214,8 +242,40 @@ class diskio
   template<typename T1> inline static bool load_ppm_binary(      field<T1>& x, const std::string&  final_name, std::string& err_msg);
   template<typename T1> inline static bool load_ppm_binary(      field<T1>& x,       std::istream& f,          std::string& err_msg);
   
-
-
+  
+  //
+  // handling of PFM images by matrices and cubes
+  
+  template<typename T1> inline static bool save_pfm_binary(const Mat<T1>&  x, const std::string&  final_name);
+  template<typename T1> inline static bool save_pfm_binary(const Mat<T1>&  x,       std::ostream& f);
+  template<typename T1> inline static bool save_pfm_binary(const Cube<T1>& x, const std::string&  final_name);
+  template<typename T1> inline static bool save_pfm_binary(const Cube<T1>& x,       std::ostream& f);
+  
+  template<typename T1> inline static bool load_pfm_binary(      Mat<T1>&  x, const std::string&  name, std::string& err_msg);
+  template<typename T1> inline static bool load_pfm_binary(      Mat<T1>&  x,       std::istream& f,    std::string& err_msg);
+  template<typename T1> inline static bool load_pfm_binary(      Cube<T1>& x, const std::string&  name, std::string& err_msg);
+  template<typename T1> inline static bool load_pfm_binary(      Cube<T1>& x,       std::istream& f,    std::string& err_msg);
+  
+  inline static bool load_pfm_header(std::istream& f, uword& n_rows, uword& n_cols, uword& n_channels, bool& swap, std::string& err_msg);
+  
+  
+  //
+  // raw binary data with a known layout
+  
+  template<typename eT> inline static bool load_raw_binary(Mat<eT>& x, const raw_name& spec, std::string& err_msg);
+  
+  template<typename eT, typename in_eT> inline static bool load_raw_typed(Mat<eT>& x, std::istream& f, const uword n_rows, const uword n_cols, const bool swap, const bool row_major, std::string& err_msg);
+  
+  
+  //
+  // bulk conversion of binary data
+  
+  inline static bool is_big_endian();
+  
+  template<typename T> arma_inline static T swap_bytes(const T val);
+  
+  template<typename eT, typename in_eT> inline static void convert_linear     (eT* out_mem, const in_eT* in_mem, const uword N, const bool swap);
+  template<typename eT, typename in_eT> inline static void convert_interleaved(eT* out_mem, const in_eT* in_mem, const uword n_rows, const uword n_cols, const uword n_channels, const uword channel, const bool swap, const bool bottom_up);
   };
 
 
@@ -354,577 +354,789 @@ diskio::guess_file_type_internal(std::istream& f)
 
 
 
-//! Append a quasi-random string to the given filename.
-//! Avoiding use of rand() to preserve its state. 
+//! Obtain the type and size of the object stored in the given file, without reading the data.
 inline
 arma_cold
-std::string
-diskio::gen_tmp_name(const std::string& x)
+bool
+diskio::probe(file_probe& info, const std::string& name, std::string& err_msg)
   {
-  union { uword val; void* ptr; } u;
-  
-  u.val = uword(0);
-  u.ptr = const_cast<std::string*>(&x);
-  
-  const u16 a = u16( (u.val >> 8)   & 0xFFFF );
-  const u16 b = u16( (std::clock()) & 0xFFFF );
+  arma_extra_debug_sigprint();
   
-  std::ostringstream ss;
+  info = file_probe();
   
-  ss << x << ".tmp_";
+  #if defined(ARMA_USE_HDF5)
+    {
+    // We're currently using the C bindings for the HDF5 library, which don't support C++ streams
+    bool is_hdf5 = false;
+    
+      {
+      hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
+      
+      is_hdf5 = (arma_H5Fis_hdf5(name.c_str()) > 0);
+      }
+    
+    if(is_hdf5)  { return probe_hdf5(info, name, err_msg); }
+    }
+  #endif
   
-  ss.setf(std::ios_base::hex, std::ios_base::basefield);
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
-  ss.width(4);
-  ss.fill('0');
-  ss << a;
+  bool probe_okay = f.is_open();
   
-  ss.width(4);
-  ss.fill('0');
-  ss << b;
+  if(probe_okay)
+    {
+    probe_okay = diskio::probe(info, f, err_msg);
+    f.close();
+    }
   
-  return ss.str();
+  return probe_okay;
   }
 
 
 
-//! Safely rename a file.
-//! Before renaming, test if we can write to the final file.
-//! This should prevent:
-//! (i)  overwriting files that are write protected,
-//! (ii) overwriting directories.
+//! Obtain the type and size of the object stored in the given stream, without reading the data.
+//! The position of the stream is not changed.
+//! Only the header is read for arma_binary, arma_ascii, PGM and PPM data;
+//! text data without a header is characterised from a bounded sample.
 inline
 arma_cold
 bool
-diskio::safe_rename(const std::string& old_name, const std::string& new_name)
+diskio::probe(file_probe& info, std::istream& f, std::string& err_msg)
   {
-  const char* new_name_c_str = new_name.c_str();
+  arma_extra_debug_sigprint();
   
-  std::fstream f(new_name_c_str, std::fstream::out | std::fstream::app);
-  f.put(' ');
+  info = file_probe();
   
-  if(f.good()) { f.close(); } else { return false; }
+  f.clear();
+  const std::fstream::pos_type pos1 = f.tellg();
   
-  if(std::remove(                  new_name_c_str) != 0)  { return false; }
-  if(std::rename(old_name.c_str(), new_name_c_str) != 0)  { return false; }
+  f.clear();
+  f.seekg(0, ios::end);
   
-  return true;
-  }
-
-
-
-template<typename eT>
-inline
-bool
-diskio::convert_token(eT& val, const std::string& token)
-  {
-  const size_t N = size_t(token.length());
+  f.clear();
+  const std::fstream::pos_type pos2 = f.tellg();
   
-  if(N == 0)  { val = eT(0); return true; }
+  f.clear();
+  f.seekg(pos1);
   
-  const char* str = token.c_str();
+  info.file_size = ( (pos1 >= 0) && (pos2 >= 0) && (pos2 > pos1) ) ? u64(pos2 - pos1) : u64(0);
   
-  if( (N == 3) || (N == 4) )
+  if(info.file_size == 0)  { err_msg = "no data"; return false; }
+  
+  const uword N_use = uword( (std::min)(info.file_size, u64(8)) );
+  
+  char sig[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  
+  f.read(sig, std::streamsize(N_use));
+  f.clear();
+  f.seekg(pos1);
+  
+  bool probe_okay = false;
+  
+  const char* hdf5_sig = "\211HDF\r\n\032\n";
+  
+  if( (N_use >= 5) && (std::strncmp(sig, "ARMA_", 5) == 0) )
     {
-    const bool neg = (str[0] == '-');
-    const bool pos = (str[0] == '+');
+    probe_okay = diskio::probe_arma_header(info, f, err_msg);
+    }
+  else
+  if( (N_use >= 2) && ( (std::strncmp(sig, "P5", 2) == 0) || (std::strncmp(sig, "P6", 2) == 0) ) )
+    {
+    probe_okay = diskio::probe_pnm_header(info, f, err_msg);
+    }
+  else
+  if( (N_use >= 3) && ( (std::strncmp(sig, "Pf\n", 3) == 0) || (std::strncmp(sig, "PF\n", 3) == 0) ) )
+    {
+    const std::fstream::pos_type pos_pfm = f.tellg();
     
-    const size_t offset = ( (neg || pos) && (N == 4) ) ? 1 : 0;
+    uword f_n_rows     = 0;
+    uword f_n_cols     = 0;
+    uword f_n_channels = 0;
+    bool  swap         = false;
     
-    const char sig_a = str[offset  ];
-    const char sig_b = str[offset+1];
-    const char sig_c = str[offset+2];
+    probe_okay = diskio::load_pfm_header(f, f_n_rows, f_n_cols, f_n_channels, swap, err_msg);
     
-    if( ((sig_a == 'i') || (sig_a == 'I')) && ((sig_b == 'n') || (sig_b == 'N')) && ((sig_c == 'f') || (sig_c == 'F')) )
-      {
-      val = neg ? cond_rel< is_signed<eT>::value >::make_neg(Datum<eT>::inf) : Datum<eT>::inf;
-      
-      return true;
-      }
-    else
-    if( ((sig_a == 'n') || (sig_a == 'N')) && ((sig_b == 'a') || (sig_b == 'A')) && ((sig_c == 'n') || (sig_c == 'N')) )
+    if(probe_okay)
       {
-      val = Datum<eT>::nan;
-      
-      return true;
+      info.type       = pfm_binary;
+      info.elem_type  = "float";
+      info.elem_size  = uword(4);
+      info.n_rows     = f_n_rows;
+      info.n_cols     = f_n_cols;
+      info.n_slices   = f_n_channels;
+      info.size_exact = true;
+      info.offset     = u64(f.tellg() - pos_pfm);
       }
     }
-  
-  
-  char* endptr = nullptr;
-  
-  if(is_real<eT>::value)
+  else
+  if( (N_use == 8) && (std::memcmp(sig, hdf5_sig, 8) == 0) )
     {
-    val = eT( std::strtod(str, &endptr) );
+    // without HDF5 support the dataset can't be examined; only the file type is reported
+    info.type = hdf5_binary;
+    
+    probe_okay = true;
     }
   else
     {
-    if(is_signed<eT>::value)
-      {
-      // signed integer
-      
-      val = eT( std::strtoll(str, &endptr, 10) );
-      }
-    else
-      {
-      // unsigned integer
-      
-      if((str[0] == '-') && (N >= 2))
-        {
-        val = eT(0);  
-        
-        if((str[1] == '-') || (str[1] == '+')) { return false; }
-        
-        const char* str_offset1 = &(str[1]);
-        
-        std::strtoull(str_offset1, &endptr, 10);
-        
-        if(str_offset1 == endptr)  { return false; }
-        
-        return true;
-        }
-      
-      val = eT( std::strtoull(str, &endptr, 10) );
-      }
+    probe_okay = diskio::probe_text(info, f, err_msg);
     }
   
-  if(str == endptr)  { return false; }
+  f.clear();
+  f.seekg(pos1);
+  
+  return probe_okay;
+  }
+
+
+
+//! Interpret the element type code used in the headers of Armadillo files (eg. "FN008").
+inline
+arma_cold
+bool
+diskio::probe_elem_type(file_probe& info, const std::string& code)
+  {
+       if(code == "IU001")  { info.elem_type = "u8";        info.elem_size =  1; }
+  else if(code == "IS001")  { info.elem_type = "s8";        info.elem_size =  1; }
+  else if(code == "IU002")  { info.elem_type = "u16";       info.elem_size =  2; }
+  else if(code == "IS002")  { info.elem_type = "s16";       info.elem_size =  2; }
+  else if(code == "IU004")  { info.elem_type = "u32";       info.elem_size =  4; }
+  else if(code == "IS004")  { info.elem_type = "s32";       info.elem_size =  4; }
+  else if(code == "IU008")  { info.elem_type = "u64";       info.elem_size =  8; }
+  else if(code == "IS008")  { info.elem_type = "s64";       info.elem_size =  8; }
+  else if(code == "FN004")  { info.elem_type = "float";     info.elem_size =  4; }
+  else if(code == "FN008")  { info.elem_type = "double";    info.elem_size =  8; }
+  else if(code == "FC008")  { info.elem_type = "cx_float";  info.elem_size =  8; }
+  else if(code == "FC016")  { info.elem_type = "cx_double"; info.elem_size = 16; }
+  else  { return false; }
   
   return true;
   }
 
 
 
-template<typename T>
+//! Read the header of a file saved in arma_binary or arma_ascii format.
+//! Format: "ARMA_XXX_YYY_ABXYZ", followed by the dimensions on the next line.
 inline
+arma_cold
 bool
-diskio::convert_token(std::complex<T>& val, const std::string& token)
+diskio::probe_arma_header(file_probe& info, std::istream& f, std::string& err_msg)
   {
-  const size_t N   = size_t(token.length());
-  const size_t Nm1 = N-1;
+  arma_extra_debug_sigprint();
   
-  if(N == 0)  { val = std::complex<T>(0); return true; }
+  const std::fstream::pos_type pos1 = f.tellg();
   
-  const char* str = token.c_str();
+  std::string f_header;
   
-  // valid complex number formats:
-  // (real,imag)
-  // (real)
-  // ()
+  // limit the token length, in case the file merely happens to start with "ARMA_"
+  f.width(32);
+  f >> f_header;
+  f.width(0);
   
-  if( (token[0] != '(') || (token[Nm1] != ')') )
+  if( (f_header == "ARMA_FLD_BIN") || (f_header == "ARMA_FL3_BIN") )
     {
-    // no brackets, so treat the token as a non-complex number
+    const bool is_fl3 = (f_header == "ARMA_FL3_BIN");
     
-    T val_real;
+    f >> info.n_rows;
+    f >> info.n_cols;
     
-    const bool state = diskio::convert_token(val_real, token);  // use the non-complex version of this function
+    if(is_fl3)  { f >> info.n_slices; } else { info.n_slices = 1; }
     
-    val = std::complex<T>(val_real);
+    f.get();
     
-    return state;
+    info.type       = arma_binary;
+    info.elem_type  = "field";
+    info.size_exact = true;
     }
-  
-  // does the token contain only the () brackets?
-  if(N <= 2)  { val = std::complex<T>(0); return true; }
-  
-  size_t comma_loc   = 0;
-  bool   comma_found = false;
-  
-  for(size_t i=0; i<N; ++i)  { if(str[i] == ',')  { comma_loc = i; comma_found = true; break; } }
-  
-  bool state = false;
-  
-  if(comma_found == false)
+  else
+  if( (f_header.length() == 18) && (f_header.substr(0,13) == "ARMA_FLX_BIN_") )
     {
-    // only the real part is available
-    
-    const std::string token_real( &(str[1]), (Nm1 - 1) );
+    if(diskio::probe_elem_type(info, f_header.substr(13,5)) == false)  { err_msg = "incorrect header"; return false; }
     
-    T val_real;
+    f >> info.n_rows;
+    f >> info.n_cols;
+    f >> info.n_slices;
     
-    state = diskio::convert_token(val_real, token_real);  // use the non-complex version of this function
+    f.get();
     
-    val = std::complex<T>(val_real);
+    info.type       = arma_binary_indexed;
+    info.size_exact = true;
     }
   else
     {
-    const std::string token_real( &(str[1]),           (comma_loc - 1      ) );
-    const std::string token_imag( &(str[comma_loc+1]), (Nm1 - 1 - comma_loc) );
+    if(f_header.length() != 18)  { err_msg = "incorrect header"; return false; }
     
-    T val_real;
-    T val_imag;
+    const std::string f_kind   = f_header.substr( 5, 3);
+    const std::string f_format = f_header.substr( 9, 3);
+    const std::string f_code   = f_header.substr(13, 5);
     
-    const bool state_real = diskio::convert_token(val_real, token_real);
-    const bool state_imag = diskio::convert_token(val_imag, token_imag);
+    const bool kind_okay   = (f_kind   == "MAT") || (f_kind == "CUB") || (f_kind == "SPM");
+    const bool format_okay = (f_format == "BIN") || ( (f_format == "TXT") && (f_kind != "SPM") );
     
-    state = (state_real && state_imag);
+    if( (kind_okay == false) || (format_okay == false) || (diskio::probe_elem_type(info, f_code) == false) )
+      {
+      err_msg = "incorrect header";
+      return false;
+      }
     
-    val = std::complex<T>(val_real, val_imag);
-    }
-  
-  return state;
-  }
-
-
-
-template<typename eT>
-inline
-std::streamsize
-diskio::prepare_stream(std::ostream& f)
-  {
-  std::streamsize cell_width = f.width();
-  
-  if(is_real<eT>::value)
-    {
-    f.unsetf(ios::fixed);
-    f.setf(ios::scientific);
-    f.fill(' ');
+    f >> info.n_rows;
+    f >> info.n_cols;
     
-    f.precision(16);
-    cell_width = 24;
+    info.n_slices = 1;
     
-    // NOTE: for 'float' the optimum settings are f.precision(8) and cell_width = 15
-    // NOTE: however, to avoid introducing errors in case single precision data is loaded as double precision,
-    // NOTE: the same settings must be used for both 'float' and 'double'
-    }
-  else
-  if(is_cx<eT>::value)
-    {
-    f.unsetf(ios::fixed);
-    f.setf(ios::scientific);
+    if(f_kind == "CUB")  { f >> info.n_slices;  }
+    if(f_kind == "SPM")  { f >> info.n_nonzero; info.is_sparse = true; }
     
-    f.precision(16);
+    f.get();
+    
+    info.type       = (f_format == "BIN") ? arma_binary : arma_ascii;
+    info.size_exact = true;
     }
   
-  return cell_width;
-  }
+  if(f.good() == false)  { err_msg = "incorrect header"; return false; }
   
+  info.offset = u64(f.tellg() - pos1);
+  
+  return true;
+  }
 
 
 
-//! Save a matrix as raw text (no header, human readable).
-//! Matrices can be loaded in Matlab and Octave, as long as they don't have complex elements.
-template<typename eT>
+//! Read the header of a PGM (P5) or PPM (P6) image.
 inline
+arma_cold
 bool
-diskio::save_raw_ascii(const Mat<eT>& x, const std::string& final_name)
+diskio::probe_pnm_header(file_probe& info, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  const std::fstream::pos_type pos1 = f.tellg();
   
-  std::fstream f(tmp_name.c_str(), std::fstream::out);
+  std::string f_header;
   
-  bool save_okay = f.is_open();
+  f.width(2);
+  f >> f_header;
+  f.width(0);
   
-  if(save_okay)
-    {
-    save_okay = diskio::save_raw_ascii(x, f);
-    
-    f.flush();
-    f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+  int f_maxval = 0;
+  
+  diskio::pnm_skip_comments(f);
+  
+  f >> info.n_cols;
+  diskio::pnm_skip_comments(f);
+  
+  f >> info.n_rows;
+  diskio::pnm_skip_comments(f);
+  
+  f >> f_maxval;
+  f.get();
+  
+  if( (f.good() == false) || (f_maxval <= 0) || (f_maxval > 65535) )
+    {
+    err_msg = "unsupported header";
+    return false;
     }
   
-  return save_okay;
+  info.type       = (f_header == "P5") ? pgm_binary : ppm_binary;
+  info.n_slices   = (f_header == "P5") ? uword(1)   : uword(3);
+  info.elem_type  = (f_maxval <= 255)  ? "u8"       : "u16";
+  info.elem_size  = (f_maxval <= 255)  ? uword(1)   : uword(2);
+  info.size_exact = true;
+  info.offset     = u64(f.tellg() - pos1);
+  
+  return true;
   }
 
 
 
-//! Save a matrix as raw text (no header, human readable).
-//! Matrices can be loaded in Matlab and Octave, as long as they don't have complex elements.
-template<typename eT>
+//! Characterise text data without a header (CSV, SSV or raw ASCII) from a bounded sample.
+//! The number of columns is taken from the first line;
+//! the number of rows is exact only if the sample covers all of the data,
+//! and is otherwise estimated from the mean length of the lines in the sample.
 inline
+arma_cold
 bool
-diskio::save_raw_ascii(const Mat<eT>& x, std::ostream& f)
+diskio::probe_text(file_probe& info, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const arma_ostream_state stream_state(f);
+  const file_type ft = diskio::guess_file_type_internal(f);
   
-  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
+  if(ft == file_type_unknown)  { err_msg = "unknown data"; return false; }
   
-  for(uword row=0; row < x.n_rows; ++row)
+  info.type = ft;
+  
+  // the size of data without a header can only be found by the user providing the element type
+  if(ft == raw_binary)  { return true; }
+  
+  const std::fstream::pos_type pos1 = f.tellg();
+  
+  const uword N_use = uword( (std::min)(info.file_size, u64(65536)) );
+  
+  podarray<char> data(N_use);
+  
+  char* data_mem = data.memptr();
+  
+  f.clear();
+  f.read(data_mem, std::streamsize(N_use));
+  
+  const bool load_okay = (f.gcount() == std::streamsize(N_use));
+  
+  f.clear();
+  f.seekg(pos1);
+  
+  if(load_okay == false)  { err_msg = "couldn't read sample"; return false; }
+  
+  const char separator = (ft == csv_ascii) ? ',' : ( (ft == ssv_ascii) ? ';' : ' ' );
+  
+  uword n_lines        = 0;  // lines with content
+  uword n_cols         = 0;
+  uword line_n_tokens  = 0;
+  bool  in_token       = false;
+  bool  line_has_data  = false;
+  uword last_line_end  = 0;
+  
+  for(uword i=0; i < N_use; ++i)
     {
-    for(uword col=0; col < x.n_cols; ++col)
+    const char c = data_mem[i];
+    
+    if( (c == '\n') || (c == '\r') )
       {
-      f.put(' ');
+      if(line_has_data)
+        {
+        if(n_lines == 0)  { n_cols = line_n_tokens; }
+        
+        ++n_lines;
+        }
       
-      if(is_real<eT>::value)  { f.width(cell_width); }
+      line_n_tokens = 0;
+      in_token      = false;
+      line_has_data = false;
+      last_line_end = i+1;
       
-      arma_ostream::raw_print_elem(f, x.at(row,col));
+      continue;
       }
     
-    f.put('\n');
+    if(separator == ' ')
+      {
+      const bool is_space = (c == ' ') || (c == '\t');
+      
+      if( (is_space == false) && (in_token == false) )  { ++line_n_tokens; }
+      
+      in_token = (is_space == false);
+      
+      if(is_space == false)  { line_has_data = true; }
+      }
+    else
+      {
+      if(line_has_data == false)  { line_n_tokens = 1; }
+      
+      if(c == separator)  { ++line_n_tokens; }
+      
+      line_has_data = true;
+      }
     }
   
-  const bool save_okay = f.good();
-  
-  stream_state.restore(f);
-  
-  return save_okay;
-  }
-
-
-
-//! Save a matrix as raw binary (no header)
-template<typename eT>
-inline
-bool
-diskio::save_raw_binary(const Mat<eT>& x, const std::string& final_name)
-  {
-  arma_extra_debug_sigprint();
+  const bool sample_is_complete = (u64(N_use) == info.file_size);
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  if(line_has_data && sample_is_complete)
+    {
+    // last line without a line terminator
+    if(n_lines == 0)  { n_cols = line_n_tokens; }
+    
+    ++n_lines;
+    
+    last_line_end = N_use;
+    }
   
-  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  if(n_lines == 0)
+    {
+    // the first line is longer than the sample
+    info.n_cols = line_n_tokens;
+    info.n_rows = (line_n_tokens > 0) ? uword(1) : uword(0);
+    
+    return true;
+    }
   
-  bool save_okay = f.is_open();
+  info.n_cols   = n_cols;
+  info.n_slices = 1;
   
-  if(save_okay)
+  if(sample_is_complete)
     {
-    save_okay = diskio::save_raw_binary(x, f);
-    
-    f.flush();
-    f.close();
+    info.n_rows     = n_lines;
+    info.size_exact = true;
+    }
+  else
+    {
+    const double bytes_per_line = double(last_line_end) / double(n_lines);
     
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    info.n_rows = uword( double(info.file_size) / bytes_per_line + 0.5 );
     }
   
-  return save_okay;
+  return true;
   }
 
 
 
-template<typename eT>
+//! Obtain the size and element type of the dataset that would be loaded by default from a HDF5 file.
 inline
+arma_cold
 bool
-diskio::save_raw_binary(const Mat<eT>& x, std::ostream& f)
+diskio::probe_hdf5(file_probe& info, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
-  
-  return f.good();
+  #if defined(ARMA_USE_HDF5)
+    {
+    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
+    
+    info.type = hdf5_binary;
+    
+    hid_t fid = arma_H5Fopen(name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    
+    if(fid < 0)  { err_msg = "cannot open file"; return false; }
+    
+    // same search rules as used by load_hdf5_binary()
+    std::vector<std::string> searchNames;
+    
+    searchNames.push_back("dataset");
+    searchNames.push_back("value"  );
+    
+    hid_t dataset = hdf5_misc::search_hdf5_file(searchNames, fid, 3, false);
+    
+    if(dataset < 0)  { err_msg = "no dataset found"; arma_H5Fclose(fid); return false; }
+    
+    hid_t filespace = arma_H5Dget_space(dataset);
+    
+    const int ndims = arma_H5Sget_simple_extent_ndims(filespace);
+    
+    hsize_t dims[3] = { 1, 1, 1 };
+    
+    const herr_t query_status = ( (ndims >= 1) && (ndims <= 3) ) ? arma_H5Sget_simple_extent_dims(filespace, dims, NULL) : herr_t(-1);
+    
+    bool probe_okay = (query_status >= 0);
+    
+    if(probe_okay)
+      {
+      // HDF5 stores the data in row-major order, so the dimensions are reversed
+      if(ndims == 1)  { info.n_rows = uword(dims[0]); info.n_cols = 1;              info.n_slices = 1;              }
+      if(ndims == 2)  { info.n_rows = uword(dims[1]); info.n_cols = uword(dims[0]); info.n_slices = 1;              }
+      if(ndims == 3)  { info.n_rows = uword(dims[2]); info.n_cols = uword(dims[1]); info.n_slices = uword(dims[0]); }
+      
+      info.size_exact = true;
+      
+      hid_t datatype = arma_H5Dget_type(dataset);
+      
+           if(hdf5_misc::is_hdf5_type<unsigned char       >(datatype))  { info.elem_type = "u8";        info.elem_size =  1; }
+      else if(hdf5_misc::is_hdf5_type<char                >(datatype))  { info.elem_type = "s8";        info.elem_size =  1; }
+      else if(hdf5_misc::is_hdf5_type<unsigned short      >(datatype))  { info.elem_type = "u16";       info.elem_size =  2; }
+      else if(hdf5_misc::is_hdf5_type<short               >(datatype))  { info.elem_type = "s16";       info.elem_size =  2; }
+      else if(hdf5_misc::is_hdf5_type<unsigned int        >(datatype))  { info.elem_type = "u32";       info.elem_size =  4; }
+      else if(hdf5_misc::is_hdf5_type<int                 >(datatype))  { info.elem_type = "s32";       info.elem_size =  4; }
+      else if(hdf5_misc::is_hdf5_type<unsigned long long  >(datatype))  { info.elem_type = "u64";       info.elem_size =  8; }
+      else if(hdf5_misc::is_hdf5_type<long long           >(datatype))  { info.elem_type = "s64";       info.elem_size =  8; }
+      else if(hdf5_misc::is_hdf5_type<float               >(datatype))  { info.elem_type = "float";     info.elem_size =  4; }
+      else if(hdf5_misc::is_hdf5_type<double              >(datatype))  { info.elem_type = "double";    info.elem_size =  8; }
+      else if(hdf5_misc::is_hdf5_type<std::complex<float> >(datatype))  { info.elem_type = "cx_float";  info.elem_size =  8; }
+      else if(hdf5_misc::is_hdf5_type<std::complex<double>>(datatype))  { info.elem_type = "cx_double"; info.elem_size = 16; }
+      
+      arma_H5Tclose(datatype);
+      }
+    else
+      {
+      err_msg = "cannot get size of HDF5 dataset";
+      }
+    
+    arma_H5Sclose(filespace);
+    arma_H5Dclose(dataset);
+    arma_H5Fclose(fid);
+    
+    std::ifstream f(name.c_str(), std::fstream::binary | std::fstream::ate);
+    
+    if(f.is_open())  { const std::fstream::pos_type pos = f.tellg(); info.file_size = (pos >= 0) ? u64(pos) : u64(0); }
+    
+    return probe_okay;
+    }
+  #else
+    {
+    arma_ignore(info);
+    arma_ignore(name);
+    arma_ignore(err_msg);
+    
+    return false;
+    }
+  #endif
   }
 
 
 
-//! Save a matrix in text format (human readable),
-//! with a header that indicates the matrix type as well as its dimensions
-template<typename eT>
+//! Append a quasi-random string to the given filename.
+//! Avoiding use of rand() to preserve its state. 
 inline
-bool
-diskio::save_arma_ascii(const Mat<eT>& x, const std::string& final_name)
+arma_cold
+std::string
+diskio::gen_tmp_name(const std::string& x)
   {
-  arma_extra_debug_sigprint();
+  union { uword val; void* ptr; } u;
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  u.val = uword(0);
+  u.ptr = const_cast<std::string*>(&x);
   
-  std::ofstream f(tmp_name.c_str());
+  const u16 a = u16( (u.val >> 8)   & 0xFFFF );
+  const u16 b = u16( (std::clock()) & 0xFFFF );
   
-  bool save_okay = f.is_open();
+  std::ostringstream ss;
   
-  if(save_okay)
-    {
-    save_okay = diskio::save_arma_ascii(x, f);
-    
-    f.flush();
-    f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
-    }
+  ss << x << ".tmp_";
   
-  return save_okay;
+  ss.setf(std::ios_base::hex, std::ios_base::basefield);
+  
+  ss.width(4);
+  ss.fill('0');
+  ss << a;
+  
+  ss.width(4);
+  ss.fill('0');
+  ss << b;
+  
+  return ss.str();
   }
 
 
 
-//! Save a matrix in text format (human readable),
-//! with a header that indicates the matrix type as well as its dimensions
-template<typename eT>
+//! Safely rename a file.
+//! Before renaming, test if we can write to the final file.
+//! This should prevent:
+//! (i)  overwriting files that are write protected,
+//! (ii) overwriting directories.
 inline
+arma_cold
 bool
-diskio::save_arma_ascii(const Mat<eT>& x, std::ostream& f)
+diskio::safe_rename(const std::string& old_name, const std::string& new_name)
   {
-  arma_extra_debug_sigprint();
-  
-  const arma_ostream_state stream_state(f);
-  
-  f << diskio::gen_txt_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << '\n';
-  
-  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
+  const char* new_name_c_str = new_name.c_str();
   
-  for(uword row=0; row < x.n_rows; ++row)
-    {
-    for(uword col=0; col < x.n_cols; ++col)
-      {
-      f.put(' ');
-      
-      if(is_real<eT>::value)  { f.width(cell_width); }
-      
-      arma_ostream::raw_print_elem(f, x.at(row,col));
-      }
-    
-    f.put('\n');
-    }
+  std::fstream f(new_name_c_str, std::fstream::out | std::fstream::app);
+  f.put(' ');
   
-  const bool save_okay = f.good();
+  if(f.good()) { f.close(); } else { return false; }
   
-  stream_state.restore(f);
+  if(std::remove(                  new_name_c_str) != 0)  { return false; }
+  if(std::rename(old_name.c_str(), new_name_c_str) != 0)  { return false; }
   
-  return save_okay;
+  return true;
   }
 
 
 
-//! Save a matrix in CSV text format (human readable)
 template<typename eT>
 inline
 bool
-diskio::save_csv_ascii(const Mat<eT>& x, const std::string& final_name, const field<std::string>& header, const bool with_header, const char separator)
+diskio::convert_token(eT& val, const std::string& token)
   {
-  arma_extra_debug_sigprint();
-  
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
-  
-  std::ofstream f(tmp_name.c_str());
+  const size_t N = size_t(token.length());
   
-  bool save_okay = f.is_open();
+  if(N == 0)  { val = eT(0); return true; }
   
-  if(save_okay == false)  { return false; }
+  const char* str = token.c_str();
   
-  if(with_header)
+  if( (N == 3) || (N == 4) )
     {
-    arma_extra_debug_print("diskio::save_csv_ascii(): writing header");
+    const bool neg = (str[0] == '-');
+    const bool pos = (str[0] == '+');
     
-    for(uword i=0; i < header.n_elem; ++i)
+    const size_t offset = ( (neg || pos) && (N == 4) ) ? 1 : 0;
+    
+    const char sig_a = str[offset  ];
+    const char sig_b = str[offset+1];
+    const char sig_c = str[offset+2];
+    
+    if( ((sig_a == 'i') || (sig_a == 'I')) && ((sig_b == 'n') || (sig_b == 'N')) && ((sig_c == 'f') || (sig_c == 'F')) )
       {
-      f << header.at(i);
+      val = neg ? cond_rel< is_signed<eT>::value >::make_neg(Datum<eT>::inf) : Datum<eT>::inf;
       
-      if(i != (header.n_elem-1))  { f.put(separator); }
+      return true;
       }
-    
-    f.put('\n');
-    
-    save_okay = f.good();
-    }
-  
-  if(save_okay)  { save_okay = diskio::save_csv_ascii(x, f, separator); }
-  
-  f.flush();
-  f.close();
+    else
+    if( ((sig_a == 'n') || (sig_a == 'N')) && ((sig_b == 'a') || (sig_b == 'A')) && ((sig_c == 'n') || (sig_c == 'N')) )
+      {
+      val = Datum<eT>::nan;
+      
+      return true;
+      }
+    }
   
-  if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
   
-  return save_okay;
+  char* endptr = nullptr;
+  
+  if(is_real<eT>::value)
+    {
+    val = eT( std::strtod(str, &endptr) );
+    }
+  else
+    {
+    if(is_signed<eT>::value)
+      {
+      // signed integer
+      
+      val = eT( std::strtoll(str, &endptr, 10) );
+      }
+    else
+      {
+      // unsigned integer
+      
+      if((str[0] == '-') && (N >= 2))
+        {
+        val = eT(0);  
+        
+        if((str[1] == '-') || (str[1] == '+')) { return false; }
+        
+        const char* str_offset1 = &(str[1]);
+        
+        std::strtoull(str_offset1, &endptr, 10);
+        
+        if(str_offset1 == endptr)  { return false; }
+        
+        return true;
+        }
+      
+      val = eT( std::strtoull(str, &endptr, 10) );
+      }
+    }
+  
+  if(str == endptr)  { return false; }
+  
+  return true;
   }
 
 
 
-//! Save a matrix in CSV text format (human readable)
-template<typename eT>
+template<typename T>
 inline
 bool
-diskio::save_csv_ascii(const Mat<eT>& x, std::ostream& f, const char separator)
+diskio::convert_token(std::complex<T>& val, const std::string& token)
   {
-  arma_extra_debug_sigprint();
+  const size_t N   = size_t(token.length());
+  const size_t Nm1 = N-1;
   
-  const arma_ostream_state stream_state(f);
+  if(N == 0)  { val = std::complex<T>(0); return true; }
   
-  diskio::prepare_stream<eT>(f);
+  const char* str = token.c_str();
   
-  uword x_n_rows = x.n_rows;
-  uword x_n_cols = x.n_cols;
+  // valid complex number formats:
+  // (real,imag)
+  // (real)
+  // ()
   
-  for(uword row=0; row < x_n_rows; ++row)
+  if( (token[0] != '(') || (token[Nm1] != ')') )
     {
-    for(uword col=0; col < x_n_cols; ++col)
-      {
-      arma_ostream::raw_print_elem(f, x.at(row,col));
-      
-      if( col < (x_n_cols-1) )  { f.put(separator); }
-      }
+    // no brackets, so treat the token as a non-complex number
     
-    f.put('\n');
+    T val_real;
+    
+    const bool state = diskio::convert_token(val_real, token);  // use the non-complex version of this function
+    
+    val = std::complex<T>(val_real);
+    
+    return state;
     }
   
-  const bool save_okay = f.good();
+  // does the token contain only the () brackets?
+  if(N <= 2)  { val = std::complex<T>(0); return true; }
   
-  stream_state.restore(f);
+  size_t comma_loc   = 0;
+  bool   comma_found = false;
   
-  return save_okay;
+  for(size_t i=0; i<N; ++i)  { if(str[i] == ',')  { comma_loc = i; comma_found = true; break; } }
+  
+  bool state = false;
+  
+  if(comma_found == false)
+    {
+    // only the real part is available
+    
+    const std::string token_real( &(str[1]), (Nm1 - 1) );
+    
+    T val_real;
+    
+    state = diskio::convert_token(val_real, token_real);  // use the non-complex version of this function
+    
+    val = std::complex<T>(val_real);
+    }
+  else
+    {
+    const std::string token_real( &(str[1]),           (comma_loc - 1      ) );
+    const std::string token_imag( &(str[comma_loc+1]), (Nm1 - 1 - comma_loc) );
+    
+    T val_real;
+    T val_imag;
+    
+    const bool state_real = diskio::convert_token(val_real, token_real);
+    const bool state_imag = diskio::convert_token(val_imag, token_imag);
+    
+    state = (state_real && state_imag);
+    
+    val = std::complex<T>(val_real, val_imag);
+    }
+  
+  return state;
   }
 
 
 
-//! Save a matrix in CSV text format (human readable); complex numbers stored in "a+bi" format
-template<typename T>
+template<typename eT>
 inline
-bool
-diskio::save_csv_ascii(const Mat< std::complex<T> >& x, std::ostream& f, const char separator)
+std::streamsize
+diskio::prepare_stream(std::ostream& f)
   {
-  arma_extra_debug_sigprint();
-  
-  typedef typename std::complex<T> eT;
-  
-  const arma_ostream_state stream_state(f);
-  
-  diskio::prepare_stream<eT>(f);
-  
-  uword x_n_rows = x.n_rows;
-  uword x_n_cols = x.n_cols;
+  std::streamsize cell_width = f.width();
   
-  for(uword row=0; row < x_n_rows; ++row)
+  if(is_real<eT>::value)
     {
-    for(uword col=0; col < x_n_cols; ++col)
-      {
-      const eT& val = x.at(row,col);
-      
-      const T    tmp_r     = std::real(val);
-      const T    tmp_i     = std::imag(val);
-      const T    tmp_i_abs = (tmp_i < T(0)) ? T(-tmp_i) : T(tmp_i);
-      const char tmp_sign  = (tmp_i < T(0)) ? char('-') : char('+');
-      
-      arma_ostream::raw_print_elem(f, tmp_r    );
-      f.put(tmp_sign);
-      arma_ostream::raw_print_elem(f, tmp_i_abs);
-      f.put('i');
-      
-      if( col < (x_n_cols-1) )  { f.put(separator); }
-      }
+    f.unsetf(ios::fixed);
+    f.setf(ios::scientific);
+    f.fill(' ');
     
-    f.put('\n');
+    f.precision(16);
+    cell_width = 24;
+    
+    // NOTE: for 'float' the optimum settings are f.precision(8) and cell_width = 15
+    // NOTE: however, to avoid introducing errors in case single precision data is loaded as double precision,
+    // NOTE: the same settings must be used for both 'float' and 'double'
+    }
+  else
+  if(is_cx<eT>::value)
+    {
+    f.unsetf(ios::fixed);
+    f.setf(ios::scientific);
+    
+    f.precision(16);
     }
   
-  const bool save_okay = f.good();
-  
-  stream_state.restore(f);
-  
-  return save_okay;
+  return cell_width;
   }
+  
 
 
 
+//! Save a matrix as raw text (no header, human readable).
+//! Matrices can be loaded in Matlab and Octave, as long as they don't have complex elements.
 template<typename eT>
 inline
 bool
-diskio::save_coord_ascii(const Mat<eT>& x, const std::string& final_name)
+diskio::save_raw_ascii(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
   const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::ofstream f(tmp_name.c_str());
+  std::fstream f(tmp_name.c_str(), std::fstream::out);
   
   bool save_okay = f.is_open();
   
   if(save_okay)
     {
-    save_okay = diskio::save_coord_ascii(x, f);
+    save_okay = diskio::save_raw_ascii(x, f);
     
     f.flush();
     f.close();
@@ -937,38 +1149,31 @@ diskio::save_coord_ascii(const Mat<eT>& x, const std::string& final_name)
 
 
 
+//! Save a matrix as raw text (no header, human readable).
+//! Matrices can be loaded in Matlab and Octave, as long as they don't have complex elements.
 template<typename eT>
 inline
 bool
-diskio::save_coord_ascii(const Mat<eT>& x, std::ostream& f)
+diskio::save_raw_ascii(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
   const arma_ostream_state stream_state(f);
   
-  diskio::prepare_stream<eT>(f);
+  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
   
-  for(uword col=0; col < x.n_cols; ++col)
   for(uword row=0; row < x.n_rows; ++row)
     {
-    const eT val = x.at(row,col);
-    
-    if(val != eT(0))
+    for(uword col=0; col < x.n_cols; ++col)
       {
-      f << row << ' ' << col << ' ' << val << '\n';
+      f.put(' ');
+      
+      if(is_real<eT>::value)  { f.width(cell_width); }
+      
+      arma_ostream::raw_print_elem(f, x.at(row,col));
       }
-    }
-  
-  // make sure it's possible to figure out the matrix size later
-  if( (x.n_rows > 0) && (x.n_cols > 0) )
-    {
-    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
-    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
     
-    if( x.at(max_row, max_col) == eT(0) )
-      {
-      f << max_row << ' ' << max_col << " 0\n";
-      }
+    f.put('\n');
     }
   
   const bool save_okay = f.good();
@@ -980,71 +1185,67 @@ diskio::save_coord_ascii(const Mat<eT>& x, std::ostream& f)
 
 
 
-template<typename T>
+//! Save a matrix as raw binary (no header)
+template<typename eT>
 inline
 bool
-diskio::save_coord_ascii(const Mat< std::complex<T> >& x, std::ostream& f)
+diskio::save_raw_binary(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  typedef typename std::complex<T> eT;
-  
-  const arma_ostream_state stream_state(f);
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  diskio::prepare_stream<eT>(f);
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
   
-  const eT eT_zero = eT(0);
+  bool save_okay = f.is_open();
   
-  for(uword col=0; col < x.n_cols; ++col)
-  for(uword row=0; row < x.n_rows; ++row)
+  if(save_okay)
     {
-    const eT val = x.at(row,col);
+    save_okay = diskio::save_raw_binary(x, f);
     
-    if(val != eT_zero)
-      {
-      f << row << ' ' << col << ' ' << val.real() << ' ' << val.imag() << '\n';
-      }
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  // make sure it's possible to figure out the matrix size later
-  if( (x.n_rows > 0) && (x.n_cols > 0) )
-    {
-    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
-    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
-    
-    if( x.at(max_row, max_col) == eT_zero )
-      {
-      f << max_row << ' ' << max_col << " 0 0\n";
-      }
-    }
-  
-  const bool save_okay = f.good();
+  return save_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::save_raw_binary(const Mat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
   
-  stream_state.restore(f);
+  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
-  return save_okay;
+  return f.good();
   }
 
 
 
-//! Save a matrix in binary format,
-//! with a header that stores the matrix type as well as its dimensions
+//! Save a matrix in text format (human readable),
+//! with a header that indicates the matrix type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const Mat<eT>& x, const std::string& final_name)
+diskio::save_arma_ascii(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
   const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  std::ofstream f(tmp_name.c_str());
   
   bool save_okay = f.is_open();
   
   if(save_okay)
     {
-    save_okay = diskio::save_arma_binary(x, f);
+    save_okay = diskio::save_arma_ascii(x, f);
     
     f.flush();
     f.close();
@@ -1057,590 +1258,618 @@ diskio::save_arma_binary(const Mat<eT>& x, const std::string& final_name)
 
 
 
-//! Save a matrix in binary format,
-//! with a header that stores the matrix type as well as its dimensions
+//! Save a matrix in text format (human readable),
+//! with a header that indicates the matrix type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const Mat<eT>& x, std::ostream& f)
+diskio::save_arma_ascii(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
+  const arma_ostream_state stream_state(f);
+  
+  f << diskio::gen_txt_header(x) << '\n';
   f << x.n_rows << ' ' << x.n_cols << '\n';
   
-  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
+  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
   
-  return f.good();
+  for(uword row=0; row < x.n_rows; ++row)
+    {
+    for(uword col=0; col < x.n_cols; ++col)
+      {
+      f.put(' ');
+      
+      if(is_real<eT>::value)  { f.width(cell_width); }
+      
+      arma_ostream::raw_print_elem(f, x.at(row,col));
+      }
+    
+    f.put('\n');
+    }
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
   }
 
 
 
-//! Save a matrix as a PGM greyscale image
+//! Save a matrix in CSV text format (human readable)
 template<typename eT>
 inline
 bool
-diskio::save_pgm_binary(const Mat<eT>& x, const std::string& final_name)
+diskio::save_csv_ascii(const Mat<eT>& x, const std::string& final_name, const field<std::string>& header, const bool with_header, const char separator)
   {
   arma_extra_debug_sigprint();
   
   const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::fstream f(tmp_name.c_str(), std::fstream::out | std::fstream::binary);
+  std::ofstream f(tmp_name.c_str());
   
   bool save_okay = f.is_open();
   
-  if(save_okay)
+  if(save_okay == false)  { return false; }
+  
+  if(with_header)
     {
-    save_okay = diskio::save_pgm_binary(x, f);
+    arma_extra_debug_print("diskio::save_csv_ascii(): writing header");
     
-    f.flush();
-    f.close();
+    for(uword i=0; i < header.n_elem; ++i)
+      {
+      f << header.at(i);
+      
+      if(i != (header.n_elem-1))  { f.put(separator); }
+      }
     
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    f.put('\n');
+    
+    save_okay = f.good();
     }
   
+  if(save_okay)  { save_okay = diskio::save_csv_ascii(x, f, separator); }
+  
+  f.flush();
+  f.close();
+  
+  if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+  
   return save_okay;
   }
 
 
 
-//
-// TODO:
-// add functionality to save the image in a normalised format,
-// ie. scaled so that every value falls in the [0,255] range.
-
-//! Save a matrix as a PGM greyscale image
+//! Save a matrix in CSV text format (human readable)
 template<typename eT>
 inline
 bool
-diskio::save_pgm_binary(const Mat<eT>& x, std::ostream& f)
+diskio::save_csv_ascii(const Mat<eT>& x, std::ostream& f, const char separator)
   {
   arma_extra_debug_sigprint();
   
-  f << "P5" << '\n';
-  f << x.n_cols << ' ' << x.n_rows << '\n';
-  f << 255 << '\n';
+  const arma_ostream_state stream_state(f);
   
-  const uword n_elem = x.n_rows * x.n_cols;
-  podarray<u8> tmp(n_elem);
+  diskio::prepare_stream<eT>(f);
   
-  uword i = 0;
+  uword x_n_rows = x.n_rows;
+  uword x_n_cols = x.n_cols;
   
-  for(uword row=0; row < x.n_rows; ++row)
-  for(uword col=0; col < x.n_cols; ++col)
+  for(uword row=0; row < x_n_rows; ++row)
     {
-    tmp[i] = u8( x.at(row,col) );  // TODO: add round() ?
-    ++i;
+    for(uword col=0; col < x_n_cols; ++col)
+      {
+      arma_ostream::raw_print_elem(f, x.at(row,col));
+      
+      if( col < (x_n_cols-1) )  { f.put(separator); }
+      }
+    
+    f.put('\n');
     }
   
-  f.write(reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem) );
+  const bool save_okay = f.good();
   
-  return f.good();
+  stream_state.restore(f);
+  
+  return save_okay;
   }
 
 
 
-//! Save a matrix as a PGM greyscale image
+//! Save a matrix in CSV text format (human readable); complex numbers stored in "a+bi" format
 template<typename T>
 inline
 bool
-diskio::save_pgm_binary(const Mat< std::complex<T> >& x, const std::string& final_name)
+diskio::save_csv_ascii(const Mat< std::complex<T> >& x, std::ostream& f, const char separator)
   {
   arma_extra_debug_sigprint();
   
-  const uchar_mat tmp = conv_to<uchar_mat>::from(x);
+  typedef typename std::complex<T> eT;
   
-  return diskio::save_pgm_binary(tmp, final_name);
+  const arma_ostream_state stream_state(f);
+  
+  diskio::prepare_stream<eT>(f);
+  
+  uword x_n_rows = x.n_rows;
+  uword x_n_cols = x.n_cols;
+  
+  for(uword row=0; row < x_n_rows; ++row)
+    {
+    for(uword col=0; col < x_n_cols; ++col)
+      {
+      const eT& val = x.at(row,col);
+      
+      const T    tmp_r     = std::real(val);
+      const T    tmp_i     = std::imag(val);
+      const T    tmp_i_abs = (tmp_i < T(0)) ? T(-tmp_i) : T(tmp_i);
+      const char tmp_sign  = (tmp_i < T(0)) ? char('-') : char('+');
+      
+      arma_ostream::raw_print_elem(f, tmp_r    );
+      f.put(tmp_sign);
+      arma_ostream::raw_print_elem(f, tmp_i_abs);
+      f.put('i');
+      
+      if( col < (x_n_cols-1) )  { f.put(separator); }
+      }
+    
+    f.put('\n');
+    }
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
   }
 
 
 
-//! Save a matrix as a PGM greyscale image
-template<typename T>
+template<typename eT>
 inline
 bool
-diskio::save_pgm_binary(const Mat< std::complex<T> >& x, std::ostream& f)
+diskio::save_coord_ascii(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  const uchar_mat tmp = conv_to<uchar_mat>::from(x);
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  return diskio::save_pgm_binary(tmp, f);
+  std::ofstream f(tmp_name.c_str());
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_coord_ascii(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
   }
 
 
 
-//! Save a matrix as part of a HDF5 file
 template<typename eT>
-inline 
-bool 
-diskio::save_hdf5_binary(const Mat<eT>& x, const hdf5_name& spec, std::string& err_msg)
+inline
+bool
+diskio::save_coord_ascii(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_HDF5)
+  const arma_ostream_state stream_state(f);
+  
+  diskio::prepare_stream<eT>(f);
+  
+  for(uword col=0; col < x.n_cols; ++col)
+  for(uword row=0; row < x.n_rows; ++row)
     {
-    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
-    
-    bool save_okay = false;
-    
-    const bool append  = bool(spec.opts.flags & hdf5_opts::flag_append);
-    const bool replace = bool(spec.opts.flags & hdf5_opts::flag_replace);
-    
-    const bool use_existing_file = ((append || replace) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
-    
-    const std::string tmp_name = (use_existing_file) ? std::string() : diskio::gen_tmp_name(spec.filename);
-    
-    // Set up the file according to HDF5's preferences
-    hid_t file = (use_existing_file) ? arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT) : arma_H5Fcreate(tmp_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-    
-    if(file < 0)  { return false; }
-    
-    // We need to create a dataset, datatype, and dataspace
-    hsize_t dims[2];
-    dims[1] = x.n_rows;
-    dims[0] = x.n_cols;
-    
-    hid_t dataspace = arma_H5Screate_simple(2, dims, NULL);   // treat the matrix as a 2d array dataspace
-    hid_t datatype  = hdf5_misc::get_hdf5_type<eT>();
-    
-    // If this returned something invalid, well, it's time to crash.
-    arma_check(datatype == -1, "Mat::save(): unknown datatype for HDF5");
+    const eT val = x.at(row,col);
     
-    // MATLAB forces the users to specify a name at save time for HDF5;
-    // Octave will use the default of 'dataset' unless otherwise specified.
-    // If the user hasn't specified a dataset name, we will use 'dataset'
-    // We may have to split out the group name from the dataset name.
-    std::vector<hid_t> groups;
-    std::string full_name = spec.dsname;
-    size_t loc;
-    while((loc = full_name.find("/")) != std::string::npos)
+    if(val != eT(0))
       {
-      // Create another group...
-      if(loc != 0) // Ignore the first /, if there is a leading /.
-        {
-        hid_t gid = arma_H5Gcreate((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-        
-        if((gid < 0) && use_existing_file)
-          {
-          gid = arma_H5Gopen((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT);
-          }
-        
-        groups.push_back(gid);
-        }
-      
-      full_name = full_name.substr(loc + 1);
-      }
-    
-    const std::string dataset_name = full_name.empty() ? std::string("dataset") : full_name;
-    
-    const hid_t last_group = (groups.size() == 0) ? file : groups[groups.size() - 1];
-    
-    if(use_existing_file && replace)
-      {
-      arma_H5Ldelete(last_group, dataset_name.c_str(), H5P_DEFAULT);
-      // NOTE: H5Ldelete() in HDF5 v1.8 doesn't reclaim the deleted space; use h5repack to reclaim space: h5repack oldfile.h5 newfile.h5
-      // NOTE: has this behaviour changed in HDF5 1.10 ?
-      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010482.html
-      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010486.html
-      }
-    
-    hid_t dataset = arma_H5Dcreate(last_group, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-    
-    if(dataset < 0)
-      {
-      save_okay = false;
-      
-      err_msg = "couldn't create dataset";
-      }
-    else
-      {
-      save_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.mem) >= 0);
-      
-      arma_H5Dclose(dataset);
+      f << row << ' ' << col << ' ' << val << '\n';
       }
-    
-    arma_H5Tclose(datatype);
-    arma_H5Sclose(dataspace);
-    for(size_t i = 0; i < groups.size(); ++i)  { arma_H5Gclose(groups[i]); }
-    arma_H5Fclose(file);
-    
-    if((use_existing_file == false) && (save_okay == true))  { save_okay = diskio::safe_rename(tmp_name, spec.filename); }
-    
-    return save_okay;
     }
-  #else
+  
+  // make sure it's possible to figure out the matrix size later
+  if( (x.n_rows > 0) && (x.n_cols > 0) )
     {
-    arma_ignore(x);
-    arma_ignore(spec);
-    arma_ignore(err_msg);
-    
-    arma_stop_logic_error("Mat::save(): use of HDF5 must be enabled");
+    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
+    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
     
-    return false;
+    if( x.at(max_row, max_col) == eT(0) )
+      {
+      f << max_row << ' ' << max_col << " 0\n";
+      }
     }
-  #endif
-  }
-
-
-
-//! Load a matrix as raw text (no header, human readable).
-//! Can read matrices saved as text in Matlab and Octave.
-//! NOTE: this is much slower than reading a file with a header.
-template<typename eT>
-inline
-bool
-diskio::load_raw_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg)
-  {
-  arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in);
-  
-  bool load_okay = f.is_open();
+  const bool save_okay = f.good();
   
-  if(load_okay)
-    {
-    load_okay = diskio::load_raw_ascii(x, f, err_msg);
-    f.close();
-    }
+  stream_state.restore(f);
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
-//! Load a matrix as raw text (no header, human readable).
-//! Can read matrices saved as text in Matlab and Octave.
-//! NOTE: this is much slower than reading a file with a header.
-template<typename eT>
+template<typename T>
 inline
 bool
-diskio::load_raw_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::save_coord_ascii(const Mat< std::complex<T> >& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  bool load_okay = f.good();
-  
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
-  
-  //
-  // work out the size
-  
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
+  typedef typename std::complex<T> eT;
   
-  bool f_n_cols_found = false;
+  const arma_ostream_state stream_state(f);
   
-  std::string       line_string;
-  std::stringstream line_stream;
+  diskio::prepare_stream<eT>(f);
   
-  std::string token;
+  const eT eT_zero = eT(0);
   
-  while( f.good() && load_okay )
+  for(uword col=0; col < x.n_cols; ++col)
+  for(uword row=0; row < x.n_rows; ++row)
     {
-    std::getline(f, line_string);
-    
-    // TODO: does it make sense to stop processing the file if an empty line is found ?
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
-    
-    uword line_n_cols = 0;
-    
-    while(line_stream >> token)  { ++line_n_cols; }
+    const eT val = x.at(row,col);
     
-    if(f_n_cols_found == false)
-      {
-      f_n_cols       = line_n_cols;
-      f_n_cols_found = true;
-      }
-    else
+    if(val != eT_zero)
       {
-      if(line_n_cols != f_n_cols)
-        {
-        load_okay = false;
-        err_msg = "inconsistent number of columns";
-        }
+      f << row << ' ' << col << ' ' << val.real() << ' ' << val.imag() << '\n';
       }
-    
-    ++f_n_rows;
     }
   
-  
-  if(load_okay)
+  // make sure it's possible to figure out the matrix size later
+  if( (x.n_rows > 0) && (x.n_cols > 0) )
     {
-    f.clear();
-    f.seekg(pos1);
-    
-    try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
+    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
     
-    for(uword row=0; ((row < x.n_rows) && load_okay); ++row)
-    for(uword col=0; ((col < x.n_cols) && load_okay); ++col)
+    if( x.at(max_row, max_col) == eT_zero )
       {
-      f >> token;
-      
-      if(diskio::convert_token(x.at(row,col), token) == false)
-        {
-        load_okay = false;
-        err_msg = "couldn't interpret data";
-        }
+      f << max_row << ' ' << max_col << " 0 0\n";
       }
     }
   
+  const bool save_okay = f.good();
   
-  // an empty file indicates an empty matrix
-  if( (f_n_cols_found == false) && (load_okay == true) )  { x.reset(); }
-  
+  stream_state.restore(f);
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
-//! Load a matrix in binary format (no header);
-//! the matrix is assumed to have one column
+//! Save a matrix in binary format,
+//! with a header that stores the matrix type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::load_raw_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::save_arma_binary(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f;
-  f.open(name.c_str(), std::fstream::binary);
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  bool load_okay = f.is_open();
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
   
-  if(load_okay)
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
     {
-    load_okay = diskio::load_raw_binary(x, f, err_msg);
+    save_okay = diskio::save_arma_binary(x, f);
+    
+    f.flush();
     f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
+//! Save a matrix in binary format,
+//! with a header that stores the matrix type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::load_raw_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::save_arma_binary(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f.clear();
-  const std::streampos pos1 = f.tellg();
-  
-  f.clear();
-  f.seekg(0, ios::end);
-
-  f.clear();
-  const std::streampos pos2 = f.tellg();
-  
-  const uword N = ( (pos1 >= 0) && (pos2 >= 0) ) ? uword(pos2 - pos1) : 0;
-  
-  f.clear();
-  //f.seekg(0, ios::beg);
-  f.seekg(pos1);
-  
-  try { x.set_size(N / uword(sizeof(eT)), 1); } catch(...) { err_msg = "not enough memory"; return false; }
+  f << diskio::gen_bin_header(x) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << '\n';
   
-  f.clear();
-  f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem * uword(sizeof(eT))) );
+  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
   return f.good();
   }
 
 
 
-//! Load a matrix in text format (human readable),
-//! with a header that indicates the matrix type as well as its dimensions
+//! Save a matrix as a PGM greyscale image
 template<typename eT>
 inline
 bool
-diskio::load_arma_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::save_pgm_binary(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f(name.c_str());
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  bool load_okay = f.is_open();
+  std::fstream f(tmp_name.c_str(), std::fstream::out | std::fstream::binary);
   
-  if(load_okay)
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
     {
-    load_okay = diskio::load_arma_ascii(x, f, err_msg);
+    save_okay = diskio::save_pgm_binary(x, f);
+    
+    f.flush();
     f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
-//! Load a matrix in text format (human readable),
-//! with a header that indicates the matrix type as well as its dimensions
+//
+// TODO:
+// add functionality to save the image in a normalised format,
+// ie. scaled so that every value falls in the [0,255] range.
+
+//! Save a matrix as a PGM greyscale image
 template<typename eT>
 inline
 bool
-diskio::load_arma_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::save_pgm_binary(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  std::streampos pos = f.tellg();
-  
-  bool load_okay = true;
-  
-  std::string f_header;
-  uword       f_n_rows;
-  uword       f_n_cols;
+  const uword n_elem = x.n_rows * x.n_cols;
   
-  f >> f_header;
-  f >> f_n_rows;
-  f >> f_n_cols;
-  
-  if(f_header == diskio::gen_txt_header(x))
+  if(is_u16<eT>::value)
     {
-    try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    // 16 bit data is stored in big-endian byte order
+    f << "P5" << '\n';
+    f << x.n_cols << ' ' << x.n_rows << '\n';
+    f << 65535 << '\n';
     
-    std::string token;
+    const bool swap = (diskio::is_big_endian() == false);
+    
+    podarray<u16> tmp(n_elem);
+    
+    uword i = 0;
     
     for(uword row=0; row < x.n_rows; ++row)
     for(uword col=0; col < x.n_cols; ++col)
       {
-      f >> token;
+      const u16 val = u16( x.at(row,col) );
       
-      diskio::convert_token( x.at(row,col), token );
+      tmp[i] = (swap) ? diskio::swap_bytes(val) : val;
+      ++i;
       }
     
-    load_okay = f.good();
-    }
-  else
-    {
-    load_okay = false;
-    err_msg = "incorrect header";
+    f.write(reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem*2) );
+    
+    return f.good();
     }
   
+  f << "P5" << '\n';
+  f << x.n_cols << ' ' << x.n_rows << '\n';
+  f << 255 << '\n';
   
-  // allow automatic conversion of u32/s32 matrices into u64/s64 matrices
+  podarray<u8> tmp(n_elem);
   
-  if(load_okay == false)
+  uword i = 0;
+  
+  for(uword row=0; row < x.n_rows; ++row)
+  for(uword col=0; col < x.n_cols; ++col)
     {
-    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
-      {
-      Mat<u32>    tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_ascii(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
-      }
-    else
-    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
-      {
-      Mat<s32>    tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_ascii(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
-      }
+    tmp[i] = u8( x.at(row,col) );  // TODO: add round() ?
+    ++i;
     }
   
-  return load_okay;
+  f.write(reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem) );
+  
+  return f.good();
   }
 
 
 
-//! Load a matrix in CSV text format (human readable)
-template<typename eT>
+//! Save a matrix as a PGM greyscale image
+template<typename T>
 inline
 bool
-diskio::load_csv_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header, const char separator)
+diskio::save_pgm_binary(const Mat< std::complex<T> >& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in);
+  const uchar_mat tmp = conv_to<uchar_mat>::from(x);
   
-  bool load_okay = f.is_open();
+  return diskio::save_pgm_binary(tmp, final_name);
+  }
+
+
+
+//! Save a matrix as a PGM greyscale image
+template<typename T>
+inline
+bool
+diskio::save_pgm_binary(const Mat< std::complex<T> >& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
   
-  if(load_okay == false)  { return false; }
+  const uchar_mat tmp = conv_to<uchar_mat>::from(x);
   
-  if(with_header)
+  return diskio::save_pgm_binary(tmp, f);
+  }
+
+
+
+//! Save a matrix as part of a HDF5 file
+template<typename eT>
+inline 
+bool 
+diskio::save_hdf5_binary(const Mat<eT>& x, const hdf5_name& spec, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_HDF5)
     {
-    arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
+    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
-    std::string              header_line;
-    std::stringstream        header_stream;
-    std::vector<std::string> header_tokens;
+    bool save_okay = false;
     
-    std::getline(f, header_line);
+    const bool append  = bool(spec.opts.flags & hdf5_opts::flag_append);
+    const bool replace = bool(spec.opts.flags & hdf5_opts::flag_replace);
     
-    load_okay = f.good();
+    const bool use_existing_file = ((append || replace) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
     
-    if(load_okay)
+    const std::string tmp_name = (use_existing_file) ? std::string() : diskio::gen_tmp_name(spec.filename);
+    
+    // Set up the file according to HDF5's preferences
+    hid_t file = (use_existing_file) ? arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT) : arma_H5Fcreate(tmp_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    
+    if(file < 0)  { return false; }
+    
+    // We need to create a dataset, datatype, and dataspace
+    hsize_t dims[2];
+    dims[1] = x.n_rows;
+    dims[0] = x.n_cols;
+    
+    hid_t dataspace = arma_H5Screate_simple(2, dims, NULL);   // treat the matrix as a 2d array dataspace
+    hid_t datatype  = hdf5_misc::get_hdf5_type<eT>();
+    
+    // If this returned something invalid, well, it's time to crash.
+    arma_check(datatype == -1, "Mat::save(): unknown datatype for HDF5");
+    
+    // MATLAB forces the users to specify a name at save time for HDF5;
+    // Octave will use the default of 'dataset' unless otherwise specified.
+    // If the user hasn't specified a dataset name, we will use 'dataset'
+    // We may have to split out the group name from the dataset name.
+    std::vector<hid_t> groups;
+    std::string full_name = spec.dsname;
+    size_t loc;
+    while((loc = full_name.find("/")) != std::string::npos)
       {
-      std::string token;
-      
-      header_stream.clear();
-      header_stream.str(header_line);
-      
-      uword header_n_tokens = 0;
-      
-      while(header_stream.good())
-        {
-        std::getline(header_stream, token, separator);
-        ++header_n_tokens;
-        header_tokens.push_back(token);
-        }
-      
-      if(header_n_tokens == uword(0))
-        {
-        header.reset();
-        }
-      else
+      // Create another group...
+      if(loc != 0) // Ignore the first /, if there is a leading /.
         {
-        header.set_size(1,header_n_tokens);
+        hid_t gid = arma_H5Gcreate((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
         
-        for(uword i=0; i < header_n_tokens; ++i)  { header.at(i) = header_tokens[i]; }
+        if((gid < 0) && use_existing_file)
+          {
+          gid = arma_H5Gopen((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT);
+          }
+        
+        groups.push_back(gid);
         }
+      
+      full_name = full_name.substr(loc + 1);
+      }
+    
+    const std::string dataset_name = full_name.empty() ? std::string("dataset") : full_name;
+    
+    const hid_t last_group = (groups.size() == 0) ? file : groups[groups.size() - 1];
+    
+    if(use_existing_file && replace)
+      {
+      arma_H5Ldelete(last_group, dataset_name.c_str(), H5P_DEFAULT);
+      // NOTE: H5Ldelete() in HDF5 v1.8 doesn't reclaim the deleted space; use h5repack to reclaim space: h5repack oldfile.h5 newfile.h5
+      // NOTE: has this behaviour changed in HDF5 1.10 ?
+      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010482.html
+      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010486.html
+      }
+    
+    const hid_t dcpl = hdf5_misc::create_dcpl<eT>(spec.opts, 2, dims);
+    
+    hid_t dataset = (dcpl >= 0) ? arma_H5Dcreate(last_group, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, dcpl, H5P_DEFAULT) : hid_t(-1);
+    
+    if( (dcpl >= 0) && (dcpl != H5P_DEFAULT) )  { arma_H5Pclose(dcpl); }
+    
+    if(dataset < 0)
+      {
+      save_okay = false;
+      
+      err_msg = (dcpl >= 0) ? "couldn't create dataset" : "couldn't set up chunked or compressed storage";
+      }
+    else
+      {
+      save_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.mem) >= 0);
+      
+      arma_H5Dclose(dataset);
       }
+    
+    arma_H5Tclose(datatype);
+    arma_H5Sclose(dataspace);
+    for(size_t i = 0; i < groups.size(); ++i)  { arma_H5Gclose(groups[i]); }
+    arma_H5Fclose(file);
+    
+    if((use_existing_file == false) && (save_okay == true))  { save_okay = diskio::safe_rename(tmp_name, spec.filename); }
+    
+    return save_okay;
+    }
+  #else
+    {
+    arma_ignore(x);
+    arma_ignore(spec);
+    arma_ignore(err_msg);
+    
+    arma_stop_logic_error("Mat::save(): use of HDF5 must be enabled");
+    
+    return false;
     }
+  #endif
+  }
+
+
+
+//! Load a matrix as raw text (no header, human readable).
+//! Can read matrices saved as text in Matlab and Octave.
+//! NOTE: this is much slower than reading a file with a header.
+template<typename eT>
+inline
+bool
+diskio::load_raw_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in);
+  
+  bool load_okay = f.is_open();
   
   if(load_okay)
     {
-    load_okay = diskio::load_csv_ascii(x, f, err_msg, separator);
+    load_okay = diskio::load_raw_ascii(x, f, err_msg);
+    f.close();
     }
   
-  f.close();
-  
   return load_okay;
   }
 
 
 
-//! Load a matrix in CSV text format (human readable)
+//! Load a matrix as raw text (no header, human readable).
+//! Can read matrices saved as text in Matlab and Octave.
+//! NOTE: this is much slower than reading a file with a header.
 template<typename eT>
 inline
 bool
-diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const char separator)
+diskio::load_raw_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  // TODO: replace with more efficient implementation
-  
-  if(f.good() == false)  { return false; }
+  bool load_okay = f.good();
   
   f.clear();
   const std::fstream::pos_type pos1 = f.tellg();
@@ -1651,15 +1880,18 @@ diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const
   uword f_n_rows = 0;
   uword f_n_cols = 0;
   
+  bool f_n_cols_found = false;
+  
   std::string       line_string;
   std::stringstream line_stream;
   
   std::string token;
   
-  while(f.good())
+  while( f.good() && load_okay )
     {
     std::getline(f, line_string);
     
+    // TODO: does it make sense to stop processing the file if an empty line is found ?
     if(line_string.size() == 0)  { break; }
     
     line_stream.clear();
@@ -1667,55 +1899,371 @@ diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const
     
     uword line_n_cols = 0;
     
-    while(line_stream.good())
-      {
-      std::getline(line_stream, token, separator);
-      ++line_n_cols;
-      }
+    while(line_stream >> token)  { ++line_n_cols; }
     
-    if(f_n_cols < line_n_cols)  { f_n_cols = line_n_cols; }
+    if(f_n_cols_found == false)
+      {
+      f_n_cols       = line_n_cols;
+      f_n_cols_found = true;
+      }
+    else
+      {
+      if(line_n_cols != f_n_cols)
+        {
+        load_okay = false;
+        err_msg = "inconsistent number of columns";
+        }
+      }
     
     ++f_n_rows;
     }
   
+  
+  if(load_okay)
+    {
+    f.clear();
+    f.seekg(pos1);
+    
+    try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    for(uword row=0; ((row < x.n_rows) && load_okay); ++row)
+    for(uword col=0; ((col < x.n_cols) && load_okay); ++col)
+      {
+      f >> token;
+      
+      if(diskio::convert_token(x.at(row,col), token) == false)
+        {
+        load_okay = false;
+        err_msg = "couldn't interpret data";
+        }
+      }
+    }
+  
+  
+  // an empty file indicates an empty matrix
+  if( (f_n_cols_found == false) && (load_okay == true) )  { x.reset(); }
+  
+  
+  return load_okay;
+  }
+
+
+
+//! Load a matrix in binary format (no header);
+//! the matrix is assumed to have one column
+template<typename eT>
+inline
+bool
+diskio::load_raw_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_raw_binary(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_raw_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
   f.clear();
+  const std::streampos pos1 = f.tellg();
+  
+  f.clear();
+  f.seekg(0, ios::end);
+
+  f.clear();
+  const std::streampos pos2 = f.tellg();
+  
+  const uword N = ( (pos1 >= 0) && (pos2 >= 0) ) ? uword(pos2 - pos1) : 0;
+  
+  f.clear();
+  //f.seekg(0, ios::beg);
   f.seekg(pos1);
   
-  try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+  try { x.set_size(N / uword(sizeof(eT)), 1); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  f.clear();
+  f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem * uword(sizeof(eT))) );
   
-  const bool use_mp = (arma_config::openmp) && (f_n_rows >= 2) && (f_n_cols >= 64);
+  return f.good();
+  }
+
+
+
+//! Load a matrix in text format (human readable),
+//! with a header that indicates the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::load_arma_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
   
-  field<std::string> token_array;
+  std::ifstream f(name.c_str());
   
-  bool token_array_ok = false;
+  bool load_okay = f.is_open();
   
-  if(use_mp)
+  if(load_okay)
     {
-    try
+    load_okay = diskio::load_arma_ascii(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Load a matrix in text format (human readable),
+//! with a header that indicates the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::load_arma_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::streampos pos = f.tellg();
+  
+  bool load_okay = true;
+  
+  std::string f_header;
+  uword       f_n_rows;
+  uword       f_n_cols;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  
+  if(f_header == diskio::gen_txt_header(x))
+    {
+    try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    std::string token;
+    
+    for(uword row=0; row < x.n_rows; ++row)
+    for(uword col=0; col < x.n_cols; ++col)
       {
-      token_array.set_size(f_n_cols);
+      f >> token;
       
-      for(uword i=0; i < f_n_cols; ++i)  { token_array(i).reserve(32); }
+      diskio::convert_token( x.at(row,col), token );
+      }
+    
+    load_okay = f.good();
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "incorrect header";
+    }
+  
+  
+  // allow automatic conversion of u32/s32 matrices into u64/s64 matrices
+  
+  if(load_okay == false)
+    {
+    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
+      {
+      Mat<u32>    tmp;
+      std::string junk;
       
-      token_array_ok = true;
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_ascii(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
       }
-    catch(...)
+    else
+    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
       {
-      token_array.reset();
+      Mat<s32>    tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_ascii(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
       }
     }
   
-  if(use_mp && token_array_ok)
+  return load_okay;
+  }
+
+
+
+//! Load a matrix in CSV text format (human readable)
+template<typename eT>
+inline
+bool
+diskio::load_csv_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay == false)  { return false; }
+  
+  if(with_header)
     {
-    #if defined(ARMA_USE_OPENMP)
+    arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
+    
+    std::string              header_line;
+    std::stringstream        header_stream;
+    std::vector<std::string> header_tokens;
+    
+    std::getline(f, header_line);
+    
+    load_okay = f.good();
+    
+    if(load_okay)
       {
-      uword row = 0;
+      std::string token;
       
-      while(f.good())
+      header_stream.clear();
+      header_stream.str(header_line);
+      
+      uword header_n_tokens = 0;
+      
+      while(header_stream.good())
         {
-        std::getline(f, line_string);
-        
-        if(line_string.size() == 0)  { break; }
+        std::getline(header_stream, token, separator);
+        ++header_n_tokens;
+        header_tokens.push_back(token);
+        }
+      
+      if(header_n_tokens == uword(0))
+        {
+        header.reset();
+        }
+      else
+        {
+        header.set_size(1,header_n_tokens);
+        
+        for(uword i=0; i < header_n_tokens; ++i)  { header.at(i) = header_tokens[i]; }
+        }
+      }
+    }
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_csv_ascii(x, f, err_msg, separator);
+    }
+  
+  f.close();
+  
+  return load_okay;
+  }
+
+
+
+//! Load a matrix in CSV text format (human readable)
+template<typename eT>
+inline
+bool
+diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  // TODO: replace with more efficient implementation
+  
+  if(f.good() == false)  { return false; }
+  
+  f.clear();
+  const std::fstream::pos_type pos1 = f.tellg();
+  
+  //
+  // work out the size
+  
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  
+  std::string       line_string;
+  std::stringstream line_stream;
+  
+  std::string token;
+  
+  while(f.good())
+    {
+    std::getline(f, line_string);
+    
+    if(line_string.size() == 0)  { break; }
+    
+    line_stream.clear();
+    line_stream.str(line_string);
+    
+    uword line_n_cols = 0;
+    
+    while(line_stream.good())
+      {
+      std::getline(line_stream, token, separator);
+      ++line_n_cols;
+      }
+    
+    if(f_n_cols < line_n_cols)  { f_n_cols = line_n_cols; }
+    
+    ++f_n_rows;
+    }
+  
+  f.clear();
+  f.seekg(pos1);
+  
+  try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  const bool use_mp = (arma_config::openmp) && (mp_executor_state::get() == nullptr) && (mp_hint::get() != 1) && (f_n_rows >= 2) && (f_n_cols >= 64);
+  
+  field<std::string> token_array;
+  
+  bool token_array_ok = false;
+  
+  if(use_mp)
+    {
+    try
+      {
+      token_array.set_size(f_n_cols);
+      
+      for(uword i=0; i < f_n_cols; ++i)  { token_array(i).reserve(32); }
+      
+      token_array_ok = true;
+      }
+    catch(...)
+      {
+      token_array.reset();
+      }
+    }
+  
+  if(use_mp && token_array_ok)
+    {
+    #if defined(ARMA_USE_OPENMP)
+      {
+      uword row = 0;
+      
+      while(f.good())
+        {
+        std::getline(f, line_string);
+        
+        if(line_string.size() == 0)  { break; }
         
         line_stream.clear();
         line_stream.str(line_string);
@@ -1746,42 +2294,1374 @@ diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const
     }
   else  // serial implementation
     {
-    uword row = 0;
+    uword row = 0;
+    
+    while(f.good())
+      {
+      std::getline(f, line_string);
+      
+      if(line_string.size() == 0)  { break; }
+      
+      line_stream.clear();
+      line_stream.str(line_string);
+      
+      uword col = 0;
+      
+      while(line_stream.good())
+        {
+        std::getline(line_stream, token, separator);
+        
+        diskio::convert_token( x.at(row,col), token );
+        
+        ++col;
+        }
+      
+      ++row;
+      }
+    }
+  
+  return true;
+  }
+
+
+
+//! Load a matrix in CSV text format (human readable); complex numbers stored in "a+bi" format
+template<typename T>
+inline
+bool
+diskio::load_csv_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string& err_msg, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  // TODO: replace with more efficient implementation
+  
+  if(f.good() == false)  { return false; }
+  
+  f.clear();
+  const std::fstream::pos_type pos1 = f.tellg();
+  
+  //
+  // work out the size
+  
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  
+  std::string       line_string;
+  std::stringstream line_stream;
+  
+  std::string token;
+  
+  while(f.good())
+    {
+    std::getline(f, line_string);
+    
+    if(line_string.size() == 0)  { break; }
+    
+    line_stream.clear();
+    line_stream.str(line_string);
+    
+    uword line_n_cols = 0;
+    
+    while(line_stream.good())
+      {
+      std::getline(line_stream, token, separator);
+      ++line_n_cols;
+      }
+    
+    if(f_n_cols < line_n_cols)  { f_n_cols = line_n_cols; }
+    
+    ++f_n_rows;
+    }
+  
+  f.clear();
+  f.seekg(pos1);
+  
+  try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  uword row = 0;
+  
+  std::string str_real;
+  std::string str_imag;
+  
+  while(f.good())
+    {
+    std::getline(f, line_string);
+    
+    if(line_string.size() == 0)  { break; }
+    
+    line_stream.clear();
+    line_stream.str(line_string);
+    
+    uword col = 0;
+    
+    while(line_stream.good())
+      {
+      std::getline(line_stream, token, separator);
+      
+      // remove spaces and tabs
+      if(token.length() > 0)
+        {
+        const char c_front = token.front();
+        const char c_back  = token.back();
+        
+        if( (c_front == ' ') || (c_front == '\t') || (c_back == ' ') || (c_back == '\t') )
+          {
+          token.erase(std::remove_if(token.begin(), token.end(), [](char c) { return ((c == ' ') || (c == '\t')); }), token.end());
+          }
+        }
+      
+      const size_t token_len = size_t( token.length() );
+      
+      if(token_len == 0)  { col++; continue; }
+      
+      // handle special cases: inf and nan, without the imaginary part
+      if( (token_len == 3) || (token_len == 4) )
+        {
+        const char* str = token.c_str();
+        
+        const bool neg = (str[0] == '-');
+        const bool pos = (str[0] == '+');
+        
+        const size_t offset = ( (neg || pos) && (token_len == 4) ) ? 1 : 0;
+        
+        const char sig_a = str[offset  ];
+        const char sig_b = str[offset+1];
+        const char sig_c = str[offset+2];
+        
+        bool found_val_real = false;
+        T          val_real = T(0);
+        
+        if( ((sig_a == 'i') || (sig_a == 'I')) && ((sig_b == 'n') || (sig_b == 'N')) && ((sig_c == 'f') || (sig_c == 'F')) )
+          {
+          val_real = (neg) ? -(Datum<T>::inf) : Datum<T>::inf;
+          
+          found_val_real = true;
+          }
+        else
+        if( ((sig_a == 'n') || (sig_a == 'N')) && ((sig_b == 'a') || (sig_b == 'A')) && ((sig_c == 'n') || (sig_c == 'N')) )
+          {
+          val_real = Datum<T>::nan;
+          
+          found_val_real = true;
+          }
+        
+        if(found_val_real)
+          {
+          x.at(row,col) = std::complex<T>(val_real, T(0));
+          
+          col++; continue;  // get next token
+          }
+        }
+      
+      bool found_x = false;
+      std::string::size_type loc_x = 0;  // location of the separator (+ or -) between the real and imaginary part
+      
+      std::string::size_type loc_i = token.find_last_of('i');  // location of the imaginary part indicator
+      
+      if(loc_i == std::string::npos)
+        {
+        str_real = token;
+        str_imag.clear();
+        }
+      else
+        {
+        bool found_plus  = false;
+        bool found_minus = false;
+        
+        std::string::size_type loc_plus = token.find_last_of('+');
+        
+        if(loc_plus != std::string::npos)
+          {
+          if(loc_plus >= 1)
+            {
+            const char prev_char = token.at(loc_plus-1);
+            
+            // make sure we're not looking at the sign of the exponent
+            if( (prev_char != 'e') && (prev_char != 'E') )
+              {
+              found_plus = true;
+              }
+            else
+              {
+              // search again, omitting the exponent
+              loc_plus = token.find_last_of('+', loc_plus-1);
+              
+              if(loc_plus != std::string::npos)  { found_plus = true; }
+              }
+            }
+          else
+            {
+            // loc_plus == 0, meaning we're at the start of the string
+            found_plus = true;
+            }
+          }
+        
+        std::string::size_type loc_minus = token.find_last_of('-');
+        
+        if(loc_minus != std::string::npos)
+          {
+          if(loc_minus >= 1)
+            {
+            const char prev_char = token.at(loc_minus-1);
+            
+            // make sure we're not looking at the sign of the exponent
+            if( (prev_char != 'e') && (prev_char != 'E') )
+              {
+              found_minus = true;
+              }
+            else
+              {
+              // search again, omitting the exponent
+              loc_minus = token.find_last_of('-', loc_minus-1);
+              
+              if(loc_minus != std::string::npos)  { found_minus = true; }
+              }
+            }
+          else
+            {
+            // loc_minus == 0, meaning we're at the start of the string
+            found_minus = true;
+            }
+          }
+        
+        if(found_plus && found_minus)
+          {
+          if( (loc_i > loc_plus) && (loc_i > loc_minus) )
+            {
+            // choose the sign closest to the "i" to be the separator between the real and imaginary part
+            loc_x = ( (loc_i - loc_plus) < (loc_i - loc_minus) ) ? loc_plus : loc_minus;
+            found_x = true;
+            }
+          }
+        else if(found_plus )  { loc_x = loc_plus;  found_x = true; }
+        else if(found_minus)  { loc_x = loc_minus; found_x = true; }
+        
+        if(found_x)
+          {
+          if( loc_x    > 0           ) { str_real = token.substr(0,loc_x);                     } else { str_real.clear(); }
+          if((loc_x+1) < token.size()) { str_imag = token.substr(loc_x, token.size()-loc_x-1); } else { str_imag.clear(); }
+          }
+        else
+          {
+          str_real.clear();
+          str_imag.clear();
+          }
+        }
+      
+      T val_real = T(0);
+      T val_imag = T(0);
+      
+      diskio::convert_token(val_real, str_real);
+      diskio::convert_token(val_imag, str_imag);
+      
+      x.at(row,col) = std::complex<T>(val_real, val_imag);
+      
+      ++col;
+      }
+    
+    ++row;
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_coord_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay == false)  { return false; }
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_coord_ascii(x, f, err_msg);
+    }
+  
+  f.close();
+  
+  return load_okay;
+  }
+
+
+
+//! Load a matrix in CSV text format (human readable)
+template<typename eT>
+inline
+bool
+diskio::load_coord_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(f.good() == false)  { return false; }
+  
+  f.clear();
+  const std::fstream::pos_type pos1 = f.tellg();
+  
+  // work out the size
+  
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  
+  bool size_found = false;
+  
+  std::string       line_string;
+  std::stringstream line_stream;
+  
+  std::string token;
+  
+  while(f.good())
+    {
+    std::getline(f, line_string);
+    
+    if(line_string.size() == 0)  { break; }
+    
+    line_stream.clear();
+    line_stream.str(line_string);
+    
+    uword line_row = 0;
+    uword line_col = 0;
+    
+    // a valid line in co-ord format has at least 2 entries
+    
+    line_stream >> line_row;
+    
+    if(line_stream.good() == false)  { err_msg = "incorrect format"; return false; }
+    
+    line_stream >> line_col;
+    
+    size_found = true;
+    
+    if(f_n_rows < line_row)  { f_n_rows = line_row; }
+    if(f_n_cols < line_col)  { f_n_cols = line_col; }
+    }
+  
+  // take into account that indices start at 0
+  if(size_found)  { ++f_n_rows;  ++f_n_cols; }
+  
+  f.clear();
+  f.seekg(pos1);
+  
+  try
+    {
+    Mat<eT> tmp(f_n_rows, f_n_cols, arma_zeros_indicator());
+    
+    while(f.good())
+      {
+      std::getline(f, line_string);
+      
+      if(line_string.size() == 0)  { break; }
+      
+      line_stream.clear();
+      line_stream.str(line_string);
+      
+      uword line_row = 0;
+      uword line_col = 0;
+      
+      line_stream >> line_row;
+      line_stream >> line_col;
+      
+      eT val = eT(0);
+      
+      line_stream >> token;
+      
+      if(line_stream.fail() == false)
+        {
+        diskio::convert_token( val, token );
+        }
+      
+      if(val != eT(0))  { tmp(line_row,line_col) = val; }
+      }
+    
+    x.steal_mem(tmp);
+    }
+  catch(...)
+    {
+    err_msg = "not enough memory";
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+template<typename T>
+inline
+bool
+diskio::load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(f.good() == false)  { return false; }
+  
+  f.clear();
+  const std::fstream::pos_type pos1 = f.tellg();
+  
+  // work out the size
+  
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  
+  bool size_found = false;
+  
+  std::string       line_string;
+  std::stringstream line_stream;
+  
+  std::string token_real;
+  std::string token_imag;
+  
+  while(f.good())
+    {
+    std::getline(f, line_string);
+    
+    if(line_string.size() == 0)  { break; }
+    
+    line_stream.clear();
+    line_stream.str(line_string);
+    
+    uword line_row = 0;
+    uword line_col = 0;
+    
+    // a valid line in co-ord format has at least 2 entries
+    
+    line_stream >> line_row;
+    
+    if(line_stream.good() == false)  { err_msg = "incorrect format"; return false; }
+    
+    line_stream >> line_col;
+    
+    size_found = true;
+    
+    if(f_n_rows < line_row)  f_n_rows = line_row;
+    if(f_n_cols < line_col)  f_n_cols = line_col;
+    }
+  
+  // take into account that indices start at 0
+  if(size_found)  { ++f_n_rows;  ++f_n_cols; }
+  
+  f.clear();
+  f.seekg(pos1);
+  
+  try
+    {
+    Mat< std::complex<T> > tmp(f_n_rows, f_n_cols, arma_zeros_indicator());
+    
+    while(f.good())
+      {
+      std::getline(f, line_string);
+      
+      if(line_string.size() == 0)  { break; }
+      
+      line_stream.clear();
+      line_stream.str(line_string);
+      
+      uword line_row = 0;
+      uword line_col = 0;
+      
+      line_stream >> line_row;
+      line_stream >> line_col;
+      
+      T val_real = T(0);
+      T val_imag = T(0);
+      
+      line_stream >> token_real;
+      
+      if(line_stream.fail() == false)
+        {
+        diskio::convert_token( val_real, token_real );
+        }
+      
+      
+      line_stream >> token_imag;
+      
+      if(line_stream.fail() == false)
+        {
+        diskio::convert_token( val_imag, token_imag );
+        }
+      
+      if( (val_real != T(0)) || (val_imag != T(0)) )
+        {
+        tmp(line_row,line_col) = std::complex<T>(val_real, val_imag);
+        }
+      }
+    
+    x.steal_mem(tmp);
+    }
+  catch(...)
+    {
+    err_msg = "not enough memory";
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+//! Load a matrix in binary format,
+//! with a header that indicates the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_arma_binary(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::streampos pos = f.tellg();
+  
+  bool load_okay = true;
+  
+  std::string f_header;
+  uword       f_n_rows;
+  uword       f_n_cols;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  
+  if(f_header == diskio::gen_bin_header(x))
+    {
+    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
+    f.get();
+    
+    try { x.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem*sizeof(eT)) );
+    
+    load_okay = f.good();
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "incorrect header";
+    }
+  
+  
+  // allow automatic conversion of u32/s32 matrices into u64/s64 matrices
+  
+  if(load_okay == false)
+    {
+    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
+      {
+      Mat<u32>    tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_binary(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
+      }
+    else
+    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
+      {
+      Mat<s32>    tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_binary(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
+      }
+    }
+  
+  return load_okay;
+  }
+
+
+
+inline
+void
+diskio::pnm_skip_comments(std::istream& f)
+  {
+  while( isspace(f.peek()) )
+    {
+    while( isspace(f.peek()) )  { f.get(); }
+    
+    if(f.peek() == '#')
+      {
+      while( (f.peek() != '\r') && (f.peek() != '\n') )  { f.get(); }
+      }
+    }
+  }
+
+
+
+//! Load a PGM greyscale image as a matrix
+template<typename eT>
+inline
+bool
+diskio::load_pgm_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_pgm_binary(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Load a PGM greyscale image as a matrix
+template<typename eT>
+inline
+bool
+diskio::load_pgm_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  bool load_okay = true;
+  
+  std::string f_header;
+  
+  f >> f_header;
+  
+  if(f_header == "P5")
+    {
+    uword f_n_rows = 0;
+    uword f_n_cols = 0;
+    int f_maxval = 0;
+    
+    diskio::pnm_skip_comments(f);
+    
+    f >> f_n_cols;
+    diskio::pnm_skip_comments(f);
+    
+    f >> f_n_rows;
+    diskio::pnm_skip_comments(f);
+    
+    f >> f_maxval;
+    f.get();
+    
+    if( (f_maxval > 0) && (f_maxval <= 65535) )
+      {
+      try { x.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+      
+      const uword n_elem = f_n_cols*f_n_rows;
+      
+      if(f_maxval <= 255)
+        {
+        podarray<u8> tmp(n_elem);
+        
+        f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem) );
+        
+        if(f.good())  { diskio::convert_interleaved(x.memptr(), tmp.memptr(), f_n_rows, f_n_cols, 1, 0, false, false); }
+        }
+      else
+        {
+        // 16 bit data is stored in big-endian byte order
+        podarray<u16> tmp(n_elem);
+        
+        f.read( reinterpret_cast<char *>(tmp.memptr()), std::streamsize(n_elem*2) );
+        
+        if(f.good())  { diskio::convert_interleaved(x.memptr(), tmp.memptr(), f_n_rows, f_n_cols, 1, 0, (diskio::is_big_endian() == false), false); }
+        }
+      }
+    else
+      {
+      load_okay = false;
+      err_msg = "functionality unimplemented";
+      }
+    
+    if(f.good() == false)  { load_okay = false; }
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "unsupported header";
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Load a PGM greyscale image as a matrix
+template<typename T>
+inline
+bool
+diskio::load_pgm_binary(Mat< std::complex<T> >& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  uchar_mat tmp;
+  const bool load_okay = diskio::load_pgm_binary(tmp, name, err_msg);
+  
+  x = conv_to< Mat< std::complex<T> > >::from(tmp);
+  
+  return load_okay;
+  }
+
+
+
+//! Load a PGM greyscale image as a matrix
+template<typename T>
+inline
+bool
+diskio::load_pgm_binary(Mat< std::complex<T> >& x, std::istream& is, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  uchar_mat tmp;
+  const bool load_okay = diskio::load_pgm_binary(tmp, is, err_msg);
+  
+  x = conv_to< Mat< std::complex<T> > >::from(tmp);
+  
+  return load_okay;
+  }
+
+
+
+//! Load a HDF5 file as a matrix
+template<typename eT>
+inline
+bool
+diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_HDF5)
+    {
+    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
+    
+    bool load_okay = false;
+    
+    hid_t fid = arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    
+    if(fid >= 0)
+      {
+      // MATLAB HDF5 dataset names are user-specified;
+      // Octave tends to store the datasets in a group, with the actual dataset being referred to as "value".
+      // If the user hasn't specified a dataset, we will search for "dataset" and "value",
+      // and if those are not found we will take the first dataset we do find.
+      
+      std::vector<std::string> searchNames;
+      
+      const bool exact = (spec.dsname.empty() == false);
+      
+      if(exact)
+        {
+        searchNames.push_back(spec.dsname);
+        }
+      else
+        {
+        searchNames.push_back("dataset");
+        searchNames.push_back("value"  );
+        }
+      
+      hid_t dataset = hdf5_misc::search_hdf5_file(searchNames, fid, 2, exact);
+      
+      if(dataset >= 0)
+        {
+        hid_t filespace = arma_H5Dget_space(dataset);
+        
+        // This must be <= 2 due to our search rules.
+        const int ndims = arma_H5Sget_simple_extent_ndims(filespace);
+        
+        hsize_t dims[2];
+        const herr_t query_status = arma_H5Sget_simple_extent_dims(filespace, dims, NULL);
+        
+        // arma_check(query_status < 0, "Mat::load(): cannot get size of HDF5 dataset");
+        if(query_status < 0)
+          {
+          err_msg = "cannot get size of HDF5 dataset";
+          
+          arma_H5Sclose(filespace);
+          arma_H5Dclose(dataset);
+          arma_H5Fclose(fid);
+          
+          return false;
+          }
+        
+        hid_t memspace = H5S_ALL;
+        
+        if(spec.opts.flags & hdf5_opts::flag_subset)
+          {
+          const bool select_okay = hdf5_misc::select_subset(filespace, spec.opts, ndims, 2, dims, err_msg);
+          
+          if(select_okay)  { memspace = arma_H5Screate_simple(ndims, dims, NULL); }
+          
+          if( (select_okay == false) || (memspace < 0) )
+            {
+            if(select_okay)  { err_msg = "cannot create HDF5 dataspace"; }
+            
+            arma_H5Sclose(filespace);
+            arma_H5Dclose(dataset);
+            arma_H5Fclose(fid);
+            
+            return false;
+            }
+          }
+        
+        // read the whole dataset unless a subset was selected
+        const hid_t readspace = (memspace == H5S_ALL) ? hid_t(H5S_ALL) : filespace;
+        
+        if(ndims == 1) { dims[1] = 1; }  // Vector case; fake second dimension (one column).
+        
+        try { x.set_size(dims[1], dims[0]); } catch(...) { err_msg = "not enough memory"; return false; }
+        
+        // Now we have to see what type is stored to figure out how to load it.
+        hid_t datatype = arma_H5Dget_type(dataset);
+        hid_t mat_type = hdf5_misc::get_hdf5_type<eT>();
+        
+        // If these are the same type, it is simple.
+        if(arma_H5Tequal(datatype, mat_type) > 0)
+          {
+          // Load directly; H5S_ALL used so that we load the entire dataset.
+          hid_t read_status = arma_H5Dread(dataset, datatype, memspace, readspace, H5P_DEFAULT, void_ptr(x.memptr()));
+          
+          if(read_status >= 0) { load_okay = true; }
+          }
+        else
+          {
+          // Load into another array and convert its type accordingly.
+          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem, memspace, readspace);
+          
+          if(read_status >= 0) { load_okay = true; }
+          }
+        
+        // Now clean up.
+        arma_H5Tclose(datatype);
+        arma_H5Tclose(mat_type);
+        arma_H5Sclose(filespace);
+        
+        if(memspace != H5S_ALL)  { arma_H5Sclose(memspace); }
+        }
+      
+      arma_H5Dclose(dataset);
+      
+      arma_H5Fclose(fid);
+      
+      if(load_okay == false)
+        {
+        err_msg = "unsupported or missing HDF5 data";
+        }
+      }
+    else
+      {
+      err_msg = "cannot open";
+      }
+    
+    return load_okay;
+    }
+  #else
+    {
+    arma_ignore(x);
+    arma_ignore(spec);
+    arma_ignore(err_msg);
+    
+    arma_stop_logic_error("Mat::load(): use of HDF5 must be enabled");
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! Try to load a matrix by automatically determining its type
+template<typename eT>
+inline
+bool
+diskio::load_auto_detect(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_HDF5)
+    // We're currently using the C bindings for the HDF5 library, which don't support C++ streams
+    if( arma_H5Fis_hdf5(name.c_str()) ) { return load_hdf5_binary(x, name, err_msg); }
+  #endif
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_auto_detect(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Try to load a matrix by automatically determining its type
+template<typename eT>
+inline
+bool
+diskio::load_auto_detect(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  const char* ARMA_MAT_TXT_str = "ARMA_MAT_TXT";
+  const char* ARMA_MAT_BIN_str = "ARMA_MAT_BIN";
+  const char*           P5_str = "P5";
+  const char*           PF_str = "PF\n";
+  const char*           Pf_str = "Pf\n";
+  
+  const uword ARMA_MAT_TXT_len = uword(12);
+  const uword ARMA_MAT_BIN_len = uword(12);
+  const uword           P5_len = uword(2);
+  const uword           PF_len = uword(3);
+  
+  podarray<char> header(ARMA_MAT_TXT_len + 1);
+  
+  char* header_mem = header.memptr();
+  
+  std::streampos pos = f.tellg();
+    
+  f.read( header_mem, std::streamsize(ARMA_MAT_TXT_len) );
+  f.clear();
+  f.seekg(pos);
+  
+  header_mem[ARMA_MAT_TXT_len] = '\0';
+  
+  if( std::strncmp(ARMA_MAT_TXT_str, header_mem, size_t(ARMA_MAT_TXT_len)) == 0 )
+    {
+    return load_arma_ascii(x, f, err_msg);
+    }
+  else
+  if( std::strncmp(ARMA_MAT_BIN_str, header_mem, size_t(ARMA_MAT_BIN_len)) == 0 )
+    {
+    return load_arma_binary(x, f, err_msg);
+    }
+  else
+  if( std::strncmp(P5_str, header_mem, size_t(P5_len)) == 0 )
+    {
+    return load_pgm_binary(x, f, err_msg);
+    }
+  else
+  if( (std::strncmp(PF_str, header_mem, size_t(PF_len)) == 0) || (std::strncmp(Pf_str, header_mem, size_t(PF_len)) == 0) )
+    {
+    return load_pfm_binary(x, f, err_msg);
+    }
+  else
+    {
+    const file_type ft = guess_file_type_internal(f);
+    
+    switch(ft)
+      {
+      case csv_ascii:
+        return load_csv_ascii(x, f, err_msg, char(','));
+        break;
+      
+      case ssv_ascii:
+        return load_csv_ascii(x, f, err_msg, char(';'));
+        break;
+      
+      case raw_binary:
+        return load_raw_binary(x, f, err_msg);
+        break;
+        
+      case raw_ascii:
+        return load_raw_ascii(x, f, err_msg);
+        break;
+      
+      default:
+        err_msg = "unknown data";
+        return false;
+      }
+    }
+  
+  return false;
+  }
+
+
+
+//
+// sparse matrices
+//
+
+
+
+//! Save a sparse matrix in CSV format
+template<typename eT>
+inline
+bool
+diskio::save_csv_ascii(const SpMat<eT>& x, const std::string& final_name, const field<std::string>& header, const bool with_header, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str());
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay == false)  { return false; }
+  
+  if(with_header)
+    {
+    arma_extra_debug_print("diskio::save_csv_ascii(): writing header");
+    
+    for(uword i=0; i < header.n_elem; ++i)
+      {
+      f << header(i);
+      
+      if(i != (header.n_elem-1))  { f.put(separator); }
+      }
+    
+    f.put('\n');
+    
+    save_okay = f.good();
+    }
+  
+  if(save_okay)  { save_okay = diskio::save_csv_ascii(x, f, separator); }
+  
+  f.flush();
+  f.close();
+  
+  if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+  
+  return save_okay;
+  }
+
+
+
+//! Save a sparse matrix in CSV format
+template<typename eT>
+inline
+bool
+diskio::save_csv_ascii(const SpMat<eT>& x, std::ostream& f, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  const arma_ostream_state stream_state(f);
+  
+  diskio::prepare_stream<eT>(f);
+  
+  x.sync();
+  
+  uword x_n_rows = x.n_rows;
+  uword x_n_cols = x.n_cols;
+  
+  for(uword row=0; row < x_n_rows; ++row)
+    {
+    for(uword col=0; col < x_n_cols; ++col)
+      {
+      const eT val = x.at(row,col);
+      
+      if(val != eT(0))  { arma_ostream::raw_print_elem(f, val); }
+      
+      if( col < (x_n_cols-1) )  { f.put(separator); }
+      }
+    
+    f.put('\n');
+    }
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
+  }
+
+
+
+//! Save a sparse matrix in CSV format (complex numbers)
+template<typename T>
+inline
+bool
+diskio::save_csv_ascii(const SpMat< std::complex<T> >& x, std::ostream& f, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_ignore(x);
+  arma_ignore(f);
+  arma_ignore(separator);
+  
+  arma_debug_warn_level(1, "saving complex sparse matrices as csv_ascii not yet implemented");
+  
+  return false;
+  }
+
+
+
+//! Save a matrix in ASCII coord format
+template<typename eT>
+inline
+bool
+diskio::save_coord_ascii(const SpMat<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str());
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_coord_ascii(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+//! Save a matrix in ASCII coord format
+template<typename eT>
+inline
+bool
+diskio::save_coord_ascii(const SpMat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  const arma_ostream_state stream_state(f);
+  
+  diskio::prepare_stream<eT>(f);
+  
+  typename SpMat<eT>::const_iterator iter     = x.begin();
+  typename SpMat<eT>::const_iterator iter_end = x.end();
+  
+  for(; iter != iter_end; ++iter)
+    {
+    const eT val = (*iter);
+    
+    f << iter.row() << ' ' << iter.col() << ' ' << val << '\n';
+    }
+  
+  
+  // make sure it's possible to figure out the matrix size later
+  if( (x.n_rows > 0) && (x.n_cols > 0) )
+    {
+    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
+    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
+    
+    if( x.at(max_row, max_col) == eT(0) )
+      {
+      f << max_row << ' ' << max_col << " 0\n";
+      }
+    }
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
+  }
+
+
+
+//! Save a matrix in ASCII coord format (complex numbers)
+template<typename T>
+inline
+bool
+diskio::save_coord_ascii(const SpMat< std::complex<T> >& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename std::complex<T> eT;
+  
+  const arma_ostream_state stream_state(f);
+  
+  diskio::prepare_stream<eT>(f);
+  
+  typename SpMat<eT>::const_iterator iter     = x.begin();
+  typename SpMat<eT>::const_iterator iter_end = x.end();
+  
+  for(; iter != iter_end; ++iter)
+    {
+    const eT val = (*iter);
+    
+    f << iter.row() << ' ' << iter.col() << ' ' << val.real() << ' ' << val.imag() << '\n';
+    }
+  
+  // make sure it's possible to figure out the matrix size later
+  if( (x.n_rows > 0) && (x.n_cols > 0) )
+    {
+    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
+    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
+    
+    if( x.at(max_row, max_col) == eT(0) )
+      {
+      f << max_row << ' ' << max_col << " 0 0\n";
+      }
+    }
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
+  }
+
+
+
+//! Save a matrix in binary format,
+//! with a header that stores the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary(const SpMat<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_binary(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+//! Save a matrix in binary format,
+//! with a header that stores the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary(const SpMat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  f << diskio::gen_bin_header(x) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_nonzero << '\n';
+  
+  f.write( reinterpret_cast<const char*>(x.values),      std::streamsize(x.n_nonzero*sizeof(eT))     );
+  f.write( reinterpret_cast<const char*>(x.row_indices), std::streamsize(x.n_nonzero*sizeof(uword))  );
+  f.write( reinterpret_cast<const char*>(x.col_ptrs),    std::streamsize((x.n_cols+1)*sizeof(uword)) );
+  
+  return f.good();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_csv_ascii(SpMat<eT>& x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay == false)  { return false; }
+  
+  if(with_header)
+    {
+    arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
     
-    while(f.good())
+    std::string              header_line;
+    std::stringstream        header_stream;
+    std::vector<std::string> header_tokens;
+    
+    std::getline(f, header_line);
+    
+    load_okay = f.good();
+    
+    if(load_okay)
       {
-      std::getline(f, line_string);
+      std::string token;
       
-      if(line_string.size() == 0)  { break; }
+      header_stream.clear();
+      header_stream.str(header_line);
       
-      line_stream.clear();
-      line_stream.str(line_string);
+      uword header_n_tokens = 0;
       
-      uword col = 0;
+      while(header_stream.good())
+        {
+        std::getline(header_stream, token, separator);
+        ++header_n_tokens;
+        header_tokens.push_back(token);
+        }
       
-      while(line_stream.good())
+      if(header_n_tokens == uword(0))
         {
-        std::getline(line_stream, token, separator);
-        
-        diskio::convert_token( x.at(row,col), token );
+        header.reset();
+        }
+      else
+        {
+        header.set_size(1,header_n_tokens);
         
-        ++col;
+        for(uword i=0; i < header_n_tokens; ++i)  { header.at(i) = header_tokens[i]; }
         }
-      
-      ++row;
       }
     }
   
-  return true;
+  if(load_okay)
+    {
+    load_okay = diskio::load_csv_ascii(x, f, err_msg, separator);
+    }
+  
+  f.close();
+  
+  return load_okay;
   }
 
 
 
-//! Load a matrix in CSV text format (human readable); complex numbers stored in "a+bi" format
-template<typename T>
+template<typename eT>
 inline
 bool
-diskio::load_csv_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string& err_msg, const char separator)
+diskio::load_csv_ascii(SpMat<eT>& x, std::istream& f, std::string& err_msg, const char separator)
   {
   arma_extra_debug_sigprint();
   
@@ -1828,190 +3708,45 @@ diskio::load_csv_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string&
   f.clear();
   f.seekg(pos1);
   
-  try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-  
-  uword row = 0;
-  
-  std::string str_real;
-  std::string str_imag;
-  
-  while(f.good())
+  try
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
+    MapMat<eT> tmp(f_n_rows, f_n_cols);
     
-    uword col = 0;
+    uword row = 0;
     
-    while(line_stream.good())
+    while(f.good())
       {
-      std::getline(line_stream, token, separator);
-      
-      // remove spaces and tabs
-      if(token.length() > 0)
-        {
-        const char c_front = token.front();
-        const char c_back  = token.back();
-        
-        if( (c_front == ' ') || (c_front == '\t') || (c_back == ' ') || (c_back == '\t') )
-          {
-          token.erase(std::remove_if(token.begin(), token.end(), [](char c) { return ((c == ' ') || (c == '\t')); }), token.end());
-          }
-        }
-      
-      const size_t token_len = size_t( token.length() );
-      
-      if(token_len == 0)  { col++; continue; }
-      
-      // handle special cases: inf and nan, without the imaginary part
-      if( (token_len == 3) || (token_len == 4) )
-        {
-        const char* str = token.c_str();
-        
-        const bool neg = (str[0] == '-');
-        const bool pos = (str[0] == '+');
-        
-        const size_t offset = ( (neg || pos) && (token_len == 4) ) ? 1 : 0;
-        
-        const char sig_a = str[offset  ];
-        const char sig_b = str[offset+1];
-        const char sig_c = str[offset+2];
-        
-        bool found_val_real = false;
-        T          val_real = T(0);
-        
-        if( ((sig_a == 'i') || (sig_a == 'I')) && ((sig_b == 'n') || (sig_b == 'N')) && ((sig_c == 'f') || (sig_c == 'F')) )
-          {
-          val_real = (neg) ? -(Datum<T>::inf) : Datum<T>::inf;
-          
-          found_val_real = true;
-          }
-        else
-        if( ((sig_a == 'n') || (sig_a == 'N')) && ((sig_b == 'a') || (sig_b == 'A')) && ((sig_c == 'n') || (sig_c == 'N')) )
-          {
-          val_real = Datum<T>::nan;
-          
-          found_val_real = true;
-          }
-        
-        if(found_val_real)
-          {
-          x.at(row,col) = std::complex<T>(val_real, T(0));
-          
-          col++; continue;  // get next token
-          }
-        }
-      
-      bool found_x = false;
-      std::string::size_type loc_x = 0;  // location of the separator (+ or -) between the real and imaginary part
-      
-      std::string::size_type loc_i = token.find_last_of('i');  // location of the imaginary part indicator
-      
-      if(loc_i == std::string::npos)
-        {
-        str_real = token;
-        str_imag.clear();
-        }
-      else
-        {
-        bool found_plus  = false;
-        bool found_minus = false;
-        
-        std::string::size_type loc_plus = token.find_last_of('+');
-        
-        if(loc_plus != std::string::npos)
-          {
-          if(loc_plus >= 1)
-            {
-            const char prev_char = token.at(loc_plus-1);
-            
-            // make sure we're not looking at the sign of the exponent
-            if( (prev_char != 'e') && (prev_char != 'E') )
-              {
-              found_plus = true;
-              }
-            else
-              {
-              // search again, omitting the exponent
-              loc_plus = token.find_last_of('+', loc_plus-1);
-              
-              if(loc_plus != std::string::npos)  { found_plus = true; }
-              }
-            }
-          else
-            {
-            // loc_plus == 0, meaning we're at the start of the string
-            found_plus = true;
-            }
-          }
-        
-        std::string::size_type loc_minus = token.find_last_of('-');
-        
-        if(loc_minus != std::string::npos)
-          {
-          if(loc_minus >= 1)
-            {
-            const char prev_char = token.at(loc_minus-1);
-            
-            // make sure we're not looking at the sign of the exponent
-            if( (prev_char != 'e') && (prev_char != 'E') )
-              {
-              found_minus = true;
-              }
-            else
-              {
-              // search again, omitting the exponent
-              loc_minus = token.find_last_of('-', loc_minus-1);
-              
-              if(loc_minus != std::string::npos)  { found_minus = true; }
-              }
-            }
-          else
-            {
-            // loc_minus == 0, meaning we're at the start of the string
-            found_minus = true;
-            }
-          }
-        
-        if(found_plus && found_minus)
-          {
-          if( (loc_i > loc_plus) && (loc_i > loc_minus) )
-            {
-            // choose the sign closest to the "i" to be the separator between the real and imaginary part
-            loc_x = ( (loc_i - loc_plus) < (loc_i - loc_minus) ) ? loc_plus : loc_minus;
-            found_x = true;
-            }
-          }
-        else if(found_plus )  { loc_x = loc_plus;  found_x = true; }
-        else if(found_minus)  { loc_x = loc_minus; found_x = true; }
-        
-        if(found_x)
-          {
-          if( loc_x    > 0           ) { str_real = token.substr(0,loc_x);                     } else { str_real.clear(); }
-          if((loc_x+1) < token.size()) { str_imag = token.substr(loc_x, token.size()-loc_x-1); } else { str_imag.clear(); }
-          }
-        else
-          {
-          str_real.clear();
-          str_imag.clear();
-          }
-        }
+      std::getline(f, line_string);
       
-      T val_real = T(0);
-      T val_imag = T(0);
+      if(line_string.size() == 0)  { break; }
       
-      diskio::convert_token(val_real, str_real);
-      diskio::convert_token(val_imag, str_imag);
+      line_stream.clear();
+      line_stream.str(line_string);
       
-      x.at(row,col) = std::complex<T>(val_real, val_imag);
+      uword col = 0;
       
-      ++col;
+      while(line_stream.good())
+        {
+        std::getline(line_stream, token, separator);
+        
+        eT val = eT(0);
+        
+        diskio::convert_token( val, token );
+        
+        if(val != eT(0))  { tmp(row,col) = val; }
+        
+        ++col;
+        }
+      
+      ++row;
       }
     
-    ++row;
+    x = tmp;
+    }
+  catch(...)
+    {
+    err_msg = "not enough memory";
+    return false;
     }
   
   return true;
@@ -2019,37 +3754,52 @@ diskio::load_csv_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string&
 
 
 
+template<typename T>
+inline
+bool
+diskio::load_csv_ascii(SpMat< std::complex<T> >& x, std::istream& f, std::string& err_msg, const char separator)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_ignore(x);
+  arma_ignore(f);
+  arma_ignore(err_msg);
+  arma_ignore(separator);
+  
+  arma_debug_warn_level(1, "loading complex sparse matrices as csv_ascii not yet implemented");
+  
+  return false;
+  }
+
+
+
 template<typename eT>
 inline
 bool
-diskio::load_coord_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_coord_ascii(SpMat<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
   std::fstream f;
-  f.open(name.c_str(), std::fstream::in);
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
   bool load_okay = f.is_open();
   
-  if(load_okay == false)  { return false; }
-  
   if(load_okay)
     {
     load_okay = diskio::load_coord_ascii(x, f, err_msg);
+    f.close();
     }
   
-  f.close();
-  
   return load_okay;
   }
 
 
 
-//! Load a matrix in CSV text format (human readable)
 template<typename eT>
 inline
 bool
-diskio::load_coord_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_coord_ascii(SpMat<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
@@ -2104,7 +3854,7 @@ diskio::load_coord_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
   
   try
     {
-    Mat<eT> tmp(f_n_rows, f_n_cols, arma_zeros_indicator());
+    MapMat<eT> tmp(f_n_rows, f_n_cols);
     
     while(f.good())
       {
@@ -2133,7 +3883,7 @@ diskio::load_coord_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
       if(val != eT(0))  { tmp(line_row,line_col) = val; }
       }
     
-    x.steal_mem(tmp);
+    x = tmp;
     }
   catch(...)
     {
@@ -2149,7 +3899,7 @@ diskio::load_coord_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
 template<typename T>
 inline
 bool
-diskio::load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string& err_msg)
+diskio::load_coord_ascii(SpMat< std::complex<T> >& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
@@ -2205,7 +3955,7 @@ diskio::load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string
   
   try
     {
-    Mat< std::complex<T> > tmp(f_n_rows, f_n_cols, arma_zeros_indicator());
+    MapMat< std::complex<T> > tmp(f_n_rows, f_n_cols);
     
     while(f.good())
       {
@@ -2246,7 +3996,7 @@ diskio::load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string
         }
       }
     
-    x.steal_mem(tmp);
+    x = tmp;
     }
   catch(...)
     {
@@ -2264,7 +4014,7 @@ diskio::load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string
 template<typename eT>
 inline
 bool
-diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_arma_binary(SpMat<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
@@ -2287,198 +4037,93 @@ diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_m
 template<typename eT>
 inline
 bool
-diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_arma_binary(SpMat<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::streampos pos = f.tellg();
-  
   bool load_okay = true;
   
   std::string f_header;
-  uword       f_n_rows;
-  uword       f_n_cols;
   
   f >> f_header;
-  f >> f_n_rows;
-  f >> f_n_cols;
   
   if(f_header == diskio::gen_bin_header(x))
     {
-    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
-    f.get();
-    
-    try { x.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    uword f_n_rows;
+    uword f_n_cols;
+    uword f_n_nz;
     
-    f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem*sizeof(eT)) );
+    f >> f_n_rows;
+    f >> f_n_cols;
+    f >> f_n_nz;
     
-    load_okay = f.good();
-    }
-  else
-    {
-    load_okay = false;
-    err_msg = "incorrect header";
-    }
-  
-  
-  // allow automatic conversion of u32/s32 matrices into u64/s64 matrices
-  
-  if(load_okay == false)
-    {
-    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
-      {
-      Mat<u32>    tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_binary(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
-      }
-    else
-    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
-      {
-      Mat<s32>    tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_binary(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
-      }
-    }
-  
-  return load_okay;
-  }
-
-
-
-inline
-void
-diskio::pnm_skip_comments(std::istream& f)
-  {
-  while( isspace(f.peek()) )
-    {
-    while( isspace(f.peek()) )  { f.get(); }
+    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
+    f.get();
     
-    if(f.peek() == '#')
-      {
-      while( (f.peek() != '\r') && (f.peek() != '\n') )  { f.get(); }
-      }
-    }
-  }
-
-
-
-//! Load a PGM greyscale image as a matrix
-template<typename eT>
-inline
-bool
-diskio::load_pgm_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
-  {
-  arma_extra_debug_sigprint();
-  
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
-  
-  bool load_okay = f.is_open();
-  
-  if(load_okay)
-    {
-    load_okay = diskio::load_pgm_binary(x, f, err_msg);
-    f.close();
-    }
-  
-  return load_okay;
-  }
-
-
-
-//! Load a PGM greyscale image as a matrix
-template<typename eT>
-inline
-bool
-diskio::load_pgm_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
-  {
-  bool load_okay = true;
-  
-  std::string f_header;
-  
-  f >> f_header;
-  
-  if(f_header == "P5")
-    {
-    uword f_n_rows = 0;
-    uword f_n_cols = 0;
-    int f_maxval = 0;
+    try { x.reserve(f_n_rows, f_n_cols, f_n_nz); } catch(...) { err_msg = "not enough memory"; return false; }
     
-    diskio::pnm_skip_comments(f);
+    f.read( reinterpret_cast<char*>(access::rwp(x.values)),      std::streamsize(x.n_nonzero*sizeof(eT))     );
     
-    f >> f_n_cols;
-    diskio::pnm_skip_comments(f);
+    std::streampos pos = f.tellg();
     
-    f >> f_n_rows;
-    diskio::pnm_skip_comments(f);
+    f.read( reinterpret_cast<char*>(access::rwp(x.row_indices)), std::streamsize(x.n_nonzero*sizeof(uword))  );
+    f.read( reinterpret_cast<char*>(access::rwp(x.col_ptrs)),    std::streamsize((x.n_cols+1)*sizeof(uword)) );
     
-    f >> f_maxval;
-    f.get();
+    bool check1 = true;  for(uword i=0; i < x.n_nonzero; ++i)  { if(x.values[i] == eT(0))  { check1 = false; break; } }
+    bool check2 = true;  for(uword i=0; i < x.n_cols;    ++i)  { if(x.col_ptrs[i+1] < x.col_ptrs[i])  { check2 = false; break; } }
+    bool check3 = (x.col_ptrs[x.n_cols] == x.n_nonzero);
     
-    if( (f_maxval > 0) && (f_maxval <= 65535) )
+    if((check1 == true) && ((check2 == false) || (check3 == false)))
       {
-      try { x.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-      
-      if(f_maxval <= 255)
+      if(sizeof(uword) == 8)
         {
-        const uword n_elem = f_n_cols*f_n_rows;
-        podarray<u8> tmp(n_elem);
+        arma_extra_debug_print("detected inconsistent data while loading; re-reading integer parts as u32");
         
-        f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem) );
+        // inconstency could be due to a different uword size used during saving,
+        // so try loading the row_indices and col_ptrs under the assumption of 32 bit unsigned integers
         
-        uword i = 0;
+        f.clear();
+        f.seekg(pos);
         
-        //cout << "f_n_cols = " << f_n_cols << endl;
-        //cout << "f_n_rows = " << f_n_rows << endl;
+        podarray<u32> tmp_a(x.n_nonzero );  tmp_a.zeros();
+        podarray<u32> tmp_b(x.n_cols + 1);  tmp_b.zeros();
         
-        for(uword row=0; row < f_n_rows; ++row)
-        for(uword col=0; col < f_n_cols; ++col)
-          {
-          x.at(row,col) = eT(tmp[i]);
-          ++i;
-          }
-        }
-      else
-        {
-        const uword n_elem = f_n_cols*f_n_rows;
-        podarray<u16> tmp(n_elem);
+        f.read( reinterpret_cast<char*>(tmp_a.memptr()), std::streamsize( x.n_nonzero   * sizeof(u32)) );
+        f.read( reinterpret_cast<char*>(tmp_b.memptr()), std::streamsize((x.n_cols + 1) * sizeof(u32)) );
         
-        f.read( reinterpret_cast<char *>(tmp.memptr()), std::streamsize(n_elem*2) );
+        check2 = true;  for(uword i=0; i < x.n_cols; ++i)  { if(tmp_b[i+1] < tmp_b[i])  { check2 = false; break; } }
+        check3 = (tmp_b[x.n_cols] == x.n_nonzero);
         
-        uword i = 0;
+        load_okay = f.good();
         
-        for(uword row=0; row < f_n_rows; ++row)
-        for(uword col=0; col < f_n_cols; ++col)
+        if( load_okay && (check2 == true) && (check3 == true) )
           {
-          x.at(row,col) = eT(tmp[i]);
-          ++i;
+          arma_extra_debug_print("reading integer parts as u32 succeeded");
+          
+          arrayops::convert(access::rwp(x.row_indices), tmp_a.memptr(), x.n_nonzero );
+          arrayops::convert(access::rwp(x.col_ptrs),    tmp_b.memptr(), x.n_cols + 1);
+          }
+        else
+          {
+          arma_extra_debug_print("reading integer parts as u32 failed");
           }
         }
       }
-    else
+    
+    if((check1 == false) || (check2 == false) || (check3 == false))
       {
       load_okay = false;
-      err_msg = "functionality unimplemented";
+      err_msg = "inconsistent data";
+      }
+    else
+      {
+      load_okay = f.good();
       }
-    
-    if(f.good() == false)  { load_okay = false; }
     }
   else
     {
     load_okay = false;
-    err_msg = "unsupported header";
+    err_msg = "incorrect header";
     }
   
   return load_okay;
@@ -2486,279 +4131,126 @@ diskio::load_pgm_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
 
 
 
-//! Load a PGM greyscale image as a matrix
-template<typename T>
-inline
-bool
-diskio::load_pgm_binary(Mat< std::complex<T> >& x, const std::string& name, std::string& err_msg)
-  {
-  arma_extra_debug_sigprint();
-  
-  uchar_mat tmp;
-  const bool load_okay = diskio::load_pgm_binary(tmp, name, err_msg);
-  
-  x = conv_to< Mat< std::complex<T> > >::from(tmp);
-  
-  return load_okay;
-  }
+// cubes
 
 
 
-//! Load a PGM greyscale image as a matrix
-template<typename T>
+//! Save a cube as raw text (no header, human readable).
+template<typename eT>
 inline
 bool
-diskio::load_pgm_binary(Mat< std::complex<T> >& x, std::istream& is, std::string& err_msg)
+diskio::save_raw_ascii(const Cube<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  uchar_mat tmp;
-  const bool load_okay = diskio::load_pgm_binary(tmp, is, err_msg);
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  x = conv_to< Mat< std::complex<T> > >::from(tmp);
+  std::fstream f(tmp_name.c_str(), std::fstream::out);
   
-  return load_okay;
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = save_raw_ascii(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
   }
 
 
 
-//! Load a HDF5 file as a matrix
+//! Save a cube as raw text (no header, human readable).
 template<typename eT>
 inline
 bool
-diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec, std::string& err_msg)
+diskio::save_raw_ascii(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_HDF5)
+  const arma_ostream_state stream_state(f);
+  
+  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
+  
+  for(uword slice=0; slice < x.n_slices; ++slice)
     {
-    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
-    
-    bool load_okay = false;
-    
-    hid_t fid = arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
-    
-    if(fid >= 0)
+    for(uword row=0; row < x.n_rows; ++row)
       {
-      // MATLAB HDF5 dataset names are user-specified;
-      // Octave tends to store the datasets in a group, with the actual dataset being referred to as "value".
-      // If the user hasn't specified a dataset, we will search for "dataset" and "value",
-      // and if those are not found we will take the first dataset we do find.
-      
-      std::vector<std::string> searchNames;
-      
-      const bool exact = (spec.dsname.empty() == false);
-      
-      if(exact)
-        {
-        searchNames.push_back(spec.dsname);
-        }
-      else
-        {
-        searchNames.push_back("dataset");
-        searchNames.push_back("value"  );
-        }
-      
-      hid_t dataset = hdf5_misc::search_hdf5_file(searchNames, fid, 2, exact);
-      
-      if(dataset >= 0)
+      for(uword col=0; col < x.n_cols; ++col)
         {
-        hid_t filespace = arma_H5Dget_space(dataset);
-        
-        // This must be <= 2 due to our search rules.
-        const int ndims = arma_H5Sget_simple_extent_ndims(filespace);
-        
-        hsize_t dims[2];
-        const herr_t query_status = arma_H5Sget_simple_extent_dims(filespace, dims, NULL);
-        
-        // arma_check(query_status < 0, "Mat::load(): cannot get size of HDF5 dataset");
-        if(query_status < 0)
-          {
-          err_msg = "cannot get size of HDF5 dataset";
-          
-          arma_H5Sclose(filespace);
-          arma_H5Dclose(dataset);
-          arma_H5Fclose(fid);
-          
-          return false;
-          }
-        
-        if(ndims == 1) { dims[1] = 1; }  // Vector case; fake second dimension (one column).
-        
-        try { x.set_size(dims[1], dims[0]); } catch(...) { err_msg = "not enough memory"; return false; }
-        
-        // Now we have to see what type is stored to figure out how to load it.
-        hid_t datatype = arma_H5Dget_type(dataset);
-        hid_t mat_type = hdf5_misc::get_hdf5_type<eT>();
+        f.put(' ');
         
-        // If these are the same type, it is simple.
-        if(arma_H5Tequal(datatype, mat_type) > 0)
-          {
-          // Load directly; H5S_ALL used so that we load the entire dataset.
-          hid_t read_status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(x.memptr()));
-          
-          if(read_status >= 0) { load_okay = true; }
-          }
-        else
-          {
-          // Load into another array and convert its type accordingly.
-          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem);
-          
-          if(read_status >= 0) { load_okay = true; }
-          }
+        if(is_real<eT>::value)  { f.width(cell_width); }
         
-        // Now clean up.
-        arma_H5Tclose(datatype);
-        arma_H5Tclose(mat_type);
-        arma_H5Sclose(filespace);
-        }
-      
-      arma_H5Dclose(dataset);
-      
-      arma_H5Fclose(fid);
-      
-      if(load_okay == false)
-        {
-        err_msg = "unsupported or missing HDF5 data";
+        arma_ostream::raw_print_elem(f, x.at(row,col,slice));
         }
+        
+      f.put('\n');
       }
-    else
-      {
-      err_msg = "cannot open";
-      }
-    
-    return load_okay;
-    }
-  #else
-    {
-    arma_ignore(x);
-    arma_ignore(spec);
-    arma_ignore(err_msg);
-    
-    arma_stop_logic_error("Mat::load(): use of HDF5 must be enabled");
-    
-    return false;
     }
-  #endif
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
   }
 
 
 
-//! Try to load a matrix by automatically determining its type
+//! Save a cube as raw binary (no header)
 template<typename eT>
 inline
 bool
-diskio::load_auto_detect(Mat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::save_raw_binary(const Cube<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_HDF5)
-    // We're currently using the C bindings for the HDF5 library, which don't support C++ streams
-    if( arma_H5Fis_hdf5(name.c_str()) ) { return load_hdf5_binary(x, name, err_msg); }
-  #endif
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
   
-  bool load_okay = f.is_open();
+  bool save_okay = f.is_open();
   
-  if(load_okay)
+  if(save_okay)
     {
-    load_okay = diskio::load_auto_detect(x, f, err_msg);
+    save_okay = diskio::save_raw_binary(x, f);
+    
+    f.flush();
     f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
-//! Try to load a matrix by automatically determining its type
 template<typename eT>
 inline
 bool
-diskio::load_auto_detect(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::save_raw_binary(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  const char* ARMA_MAT_TXT_str = "ARMA_MAT_TXT";
-  const char* ARMA_MAT_BIN_str = "ARMA_MAT_BIN";
-  const char*           P5_str = "P5";
-  
-  const uword ARMA_MAT_TXT_len = uword(12);
-  const uword ARMA_MAT_BIN_len = uword(12);
-  const uword           P5_len = uword(2);
-  
-  podarray<char> header(ARMA_MAT_TXT_len + 1);
-  
-  char* header_mem = header.memptr();
-  
-  std::streampos pos = f.tellg();
-    
-  f.read( header_mem, std::streamsize(ARMA_MAT_TXT_len) );
-  f.clear();
-  f.seekg(pos);
-  
-  header_mem[ARMA_MAT_TXT_len] = '\0';
-  
-  if( std::strncmp(ARMA_MAT_TXT_str, header_mem, size_t(ARMA_MAT_TXT_len)) == 0 )
-    {
-    return load_arma_ascii(x, f, err_msg);
-    }
-  else
-  if( std::strncmp(ARMA_MAT_BIN_str, header_mem, size_t(ARMA_MAT_BIN_len)) == 0 )
-    {
-    return load_arma_binary(x, f, err_msg);
-    }
-  else
-  if( std::strncmp(P5_str, header_mem, size_t(P5_len)) == 0 )
-    {
-    return load_pgm_binary(x, f, err_msg);
-    }
-  else
-    {
-    const file_type ft = guess_file_type_internal(f);
-    
-    switch(ft)
-      {
-      case csv_ascii:
-        return load_csv_ascii(x, f, err_msg, char(','));
-        break;
-      
-      case ssv_ascii:
-        return load_csv_ascii(x, f, err_msg, char(';'));
-        break;
-      
-      case raw_binary:
-        return load_raw_binary(x, f, err_msg);
-        break;
-        
-      case raw_ascii:
-        return load_raw_ascii(x, f, err_msg);
-        break;
-      
-      default:
-        err_msg = "unknown data";
-        return false;
-      }
-    }
+  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
-  return false;
+  return f.good();
   }
 
 
 
-//
-// sparse matrices
-//
-
-
-
-//! Save a sparse matrix in CSV format
+//! Save a cube in text format (human readable),
+//! with a header that indicates the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_csv_ascii(const SpMat<eT>& x, const std::string& final_name, const field<std::string>& header, const bool with_header, const char separator)
+diskio::save_arma_ascii(const Cube<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
@@ -2768,65 +4260,52 @@ diskio::save_csv_ascii(const SpMat<eT>& x, const std::string& final_name, const
   
   bool save_okay = f.is_open();
   
-  if(save_okay == false)  { return false; }
-  
-  if(with_header)
+  if(save_okay)
     {
-    arma_extra_debug_print("diskio::save_csv_ascii(): writing header");
-    
-    for(uword i=0; i < header.n_elem; ++i)
-      {
-      f << header(i);
-      
-      if(i != (header.n_elem-1))  { f.put(separator); }
-      }
+    save_okay = diskio::save_arma_ascii(x, f);
     
-    f.put('\n');
+    f.flush();
+    f.close();
     
-    save_okay = f.good();
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  if(save_okay)  { save_okay = diskio::save_csv_ascii(x, f, separator); }
-  
-  f.flush();
-  f.close();
-  
-  if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
-  
   return save_okay;
   }
 
 
 
-//! Save a sparse matrix in CSV format
+//! Save a cube in text format (human readable),
+//! with a header that indicates the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_csv_ascii(const SpMat<eT>& x, std::ostream& f, const char separator)
+diskio::save_arma_ascii(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
   const arma_ostream_state stream_state(f);
   
-  diskio::prepare_stream<eT>(f);
-  
-  x.sync();
+  f << diskio::gen_txt_header(x) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
   
-  uword x_n_rows = x.n_rows;
-  uword x_n_cols = x.n_cols;
+  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
   
-  for(uword row=0; row < x_n_rows; ++row)
+  for(uword slice=0; slice < x.n_slices; ++slice)
     {
-    for(uword col=0; col < x_n_cols; ++col)
+    for(uword row=0; row < x.n_rows; ++row)
       {
-      const eT val = x.at(row,col);
-      
-      if(val != eT(0))  { arma_ostream::raw_print_elem(f, val); }
+      for(uword col=0; col < x.n_cols; ++col)
+        {
+        f.put(' ');
+        
+        if(is_real<eT>::value)  { f.width(cell_width); }
+        
+        arma_ostream::raw_print_elem(f, x.at(row,col,slice));
+        }
       
-      if( col < (x_n_cols-1) )  { f.put(separator); }
+      f.put('\n');
       }
-    
-    f.put('\n');
     }
   
   const bool save_okay = f.good();
@@ -2838,42 +4317,24 @@ diskio::save_csv_ascii(const SpMat<eT>& x, std::ostream& f, const char separator
 
 
 
-//! Save a sparse matrix in CSV format (complex numbers)
-template<typename T>
-inline
-bool
-diskio::save_csv_ascii(const SpMat< std::complex<T> >& x, std::ostream& f, const char separator)
-  {
-  arma_extra_debug_sigprint();
-  
-  arma_ignore(x);
-  arma_ignore(f);
-  arma_ignore(separator);
-  
-  arma_debug_warn_level(1, "saving complex sparse matrices as csv_ascii not yet implemented");
-  
-  return false;
-  }
-
-
-
-//! Save a matrix in ASCII coord format
+//! Save a cube in binary format,
+//! with a header that stores the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_coord_ascii(const SpMat<eT>& x, const std::string& final_name)
+diskio::save_arma_binary(const Cube<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
   const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::ofstream f(tmp_name.c_str());
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
   
   bool save_okay = f.is_open();
   
   if(save_okay)
     {
-    save_okay = diskio::save_coord_ascii(x, f);
+    save_okay = diskio::save_arma_binary(x, f);
     
     f.flush();
     f.close();
@@ -2886,343 +4347,383 @@ diskio::save_coord_ascii(const SpMat<eT>& x, const std::string& final_name)
 
 
 
-//! Save a matrix in ASCII coord format
+//! Save a cube in binary format,
+//! with a header that stores the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_coord_ascii(const SpMat<eT>& x, std::ostream& f)
+diskio::save_arma_binary(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  const arma_ostream_state stream_state(f);
+  f << diskio::gen_bin_header(x) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
   
-  diskio::prepare_stream<eT>(f);
+  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
-  typename SpMat<eT>::const_iterator iter     = x.begin();
-  typename SpMat<eT>::const_iterator iter_end = x.end();
+  return f.good();
+  }
+
+
+
+//! Save a cube as part of a HDF5 file
+template<typename eT>
+inline
+bool
+diskio::save_hdf5_binary(const Cube<eT>& x, const hdf5_name& spec, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
   
-  for(; iter != iter_end; ++iter)
+  #if defined(ARMA_USE_HDF5)
     {
-    const eT val = (*iter);
+    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
-    f << iter.row() << ' ' << iter.col() << ' ' << val << '\n';
+    bool save_okay = false;
+    
+    const bool append  = bool(spec.opts.flags & hdf5_opts::flag_append);
+    const bool replace = bool(spec.opts.flags & hdf5_opts::flag_replace);
+    
+    const bool use_existing_file = ((append || replace) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
+    
+    const std::string tmp_name = (use_existing_file) ? std::string() : diskio::gen_tmp_name(spec.filename);
+    
+    // Set up the file according to HDF5's preferences
+    hid_t file = (use_existing_file) ? arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT) : arma_H5Fcreate(tmp_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    
+    if(file < 0)  { return false; }
+    
+    // We need to create a dataset, datatype, and dataspace
+    hsize_t dims[3];
+    dims[2] = x.n_rows;
+    dims[1] = x.n_cols;
+    dims[0] = x.n_slices;
+    
+    hid_t dataspace = arma_H5Screate_simple(3, dims, NULL);   // treat the cube as a 3d array dataspace
+    hid_t datatype  = hdf5_misc::get_hdf5_type<eT>();
+    
+    // If this returned something invalid, well, it's time to crash.
+    arma_check(datatype == -1, "Cube::save(): unknown datatype for HDF5");
+    
+    // MATLAB forces the users to specify a name at save time for HDF5;
+    // Octave will use the default of 'dataset' unless otherwise specified.
+    // If the user hasn't specified a dataset name, we will use 'dataset'
+    // We may have to split out the group name from the dataset name.
+    std::vector<hid_t> groups;
+    std::string full_name = spec.dsname;
+    size_t loc;
+    while((loc = full_name.find("/")) != std::string::npos)
+      {
+      // Create another group...
+      if(loc != 0) // Ignore the first /, if there is a leading /.
+        {
+        hid_t gid = arma_H5Gcreate((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        
+        if((gid < 0) && use_existing_file)
+          {
+          gid = arma_H5Gopen((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT);
+          }
+        
+        groups.push_back(gid);
+        }
+      
+      full_name = full_name.substr(loc + 1);
+      }
+    
+    const std::string dataset_name = full_name.empty() ? std::string("dataset") : full_name;
+    
+    const hid_t last_group = (groups.size() == 0) ? file : groups[groups.size() - 1];
+    
+    if(use_existing_file && replace)
+      {
+      arma_H5Ldelete(last_group, dataset_name.c_str(), H5P_DEFAULT);
+      // NOTE: H5Ldelete() in HDF5 v1.8 doesn't reclaim the deleted space; use h5repack to reclaim space: h5repack oldfile.h5 newfile.h5
+      // NOTE: has this behaviour changed in HDF5 1.10 ?
+      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010482.html
+      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010486.html
+      }
+    
+    const hid_t dcpl = hdf5_misc::create_dcpl<eT>(spec.opts, 3, dims);
+    
+    hid_t dataset = (dcpl >= 0) ? arma_H5Dcreate(last_group, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, dcpl, H5P_DEFAULT) : hid_t(-1);
+    
+    if( (dcpl >= 0) && (dcpl != H5P_DEFAULT) )  { arma_H5Pclose(dcpl); }
+    
+    if(dataset < 0)
+      {
+      save_okay = false;
+      
+      err_msg = (dcpl >= 0) ? "couldn't create dataset" : "couldn't set up chunked or compressed storage";
+      }
+    else
+      {
+      save_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.mem) >= 0);
+      
+      arma_H5Dclose(dataset);
+      }
+    
+    arma_H5Tclose(datatype);
+    arma_H5Sclose(dataspace);
+    for(size_t i = 0; i < groups.size(); ++i)  { arma_H5Gclose(groups[i]); }
+    arma_H5Fclose(file);
+    
+    if((use_existing_file == false) && (save_okay == true))  { save_okay = diskio::safe_rename(tmp_name, spec.filename); }
+    
+    return save_okay;
+    }
+  #else
+    {
+    arma_ignore(x);
+    arma_ignore(spec);
+    arma_ignore(err_msg);
+    
+    arma_stop_logic_error("Cube::save(): use of HDF5 must be enabled");
+    
+    return false;
     }
+  #endif
+  }
+
+
+
+//! Load a cube as raw text (no header, human readable).
+//! NOTE: this is much slower than reading a file with a header.
+template<typename eT>
+inline
+bool
+diskio::load_raw_ascii(Cube<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
   
+  Mat<eT> tmp;
+  const bool load_okay = diskio::load_raw_ascii(tmp, name, err_msg);
   
-  // make sure it's possible to figure out the matrix size later
-  if( (x.n_rows > 0) && (x.n_cols > 0) )
+  if(load_okay)
     {
-    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
-    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
-    
-    if( x.at(max_row, max_col) == eT(0) )
+    if(tmp.is_empty() == false)
       {
-      f << max_row << ' ' << max_col << " 0\n";
+      try { x.set_size(tmp.n_rows, tmp.n_cols, 1); } catch(...) { err_msg = "not enough memory"; return false; }
+      
+      x.slice(0) = tmp;
+      }
+    else
+      {
+      x.reset();
       }
     }
   
-  const bool save_okay = f.good();
-  
-  stream_state.restore(f);
-  
-  return save_okay;
+  return load_okay;
   }
 
 
 
-//! Save a matrix in ASCII coord format (complex numbers)
-template<typename T>
+//! Load a cube as raw text (no header, human readable).
+//! NOTE: this is much slower than reading a file with a header.
+template<typename eT>
 inline
 bool
-diskio::save_coord_ascii(const SpMat< std::complex<T> >& x, std::ostream& f)
+diskio::load_raw_ascii(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  typedef typename std::complex<T> eT;
-  
-  const arma_ostream_state stream_state(f);
-  
-  diskio::prepare_stream<eT>(f);
-  
-  typename SpMat<eT>::const_iterator iter     = x.begin();
-  typename SpMat<eT>::const_iterator iter_end = x.end();
-  
-  for(; iter != iter_end; ++iter)
-    {
-    const eT val = (*iter);
-    
-    f << iter.row() << ' ' << iter.col() << ' ' << val.real() << ' ' << val.imag() << '\n';
-    }
+  Mat<eT> tmp;
+  const bool load_okay = diskio::load_raw_ascii(tmp, f, err_msg);
   
-  // make sure it's possible to figure out the matrix size later
-  if( (x.n_rows > 0) && (x.n_cols > 0) )
+  if(load_okay)
     {
-    const uword max_row = (x.n_rows > 0) ? x.n_rows-1 : 0;
-    const uword max_col = (x.n_cols > 0) ? x.n_cols-1 : 0;
-    
-    if( x.at(max_row, max_col) == eT(0) )
+    if(tmp.is_empty() == false)
       {
-      f << max_row << ' ' << max_col << " 0 0\n";
+      try { x.set_size(tmp.n_rows, tmp.n_cols, 1); } catch(...) { err_msg = "not enough memory"; return false; }
+      
+      x.slice(0) = tmp;
+      }
+    else
+      {
+      x.reset();
       }
     }
   
-  const bool save_okay = f.good();
-  
-  stream_state.restore(f);
-  
-  return save_okay;
+  return load_okay;
   }
 
 
 
-//! Save a matrix in binary format,
-//! with a header that stores the matrix type as well as its dimensions
+//! Load a cube in binary format (no header);
+//! the cube is assumed to have one slice with one column
 template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const SpMat<eT>& x, const std::string& final_name)
+diskio::load_raw_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
-  
-  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
   
-  bool save_okay = f.is_open();
+  bool load_okay = f.is_open();
   
-  if(save_okay)
+  if(load_okay)
     {
-    save_okay = diskio::save_arma_binary(x, f);
-    
-    f.flush();
+    load_okay = diskio::load_raw_binary(x, f, err_msg);
     f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return save_okay;
+  return load_okay;
   }
 
 
 
-//! Save a matrix in binary format,
-//! with a header that stores the matrix type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const SpMat<eT>& x, std::ostream& f)
+diskio::load_raw_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_nonzero << '\n';
+  f.clear();
+  const std::streampos pos1 = f.tellg();
   
-  f.write( reinterpret_cast<const char*>(x.values),      std::streamsize(x.n_nonzero*sizeof(eT))     );
-  f.write( reinterpret_cast<const char*>(x.row_indices), std::streamsize(x.n_nonzero*sizeof(uword))  );
-  f.write( reinterpret_cast<const char*>(x.col_ptrs),    std::streamsize((x.n_cols+1)*sizeof(uword)) );
+  f.clear();
+  f.seekg(0, ios::end);
+  
+  f.clear();
+  const std::streampos pos2 = f.tellg();
+  
+  const uword N = ( (pos1 >= 0) && (pos2 >= 0) ) ? uword(pos2 - pos1) : 0;
+  
+  f.clear();
+  //f.seekg(0, ios::beg);
+  f.seekg(pos1);
+  
+  try { x.set_size(N / uword(sizeof(eT)), 1, 1); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  f.clear();
+  f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem * uword(sizeof(eT))) );
   
   return f.good();
   }
 
 
 
+//! Load a cube in text format (human readable),
+//! with a header that indicates the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::load_csv_ascii(SpMat<eT>& x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header, const char separator)
+diskio::load_arma_ascii(Cube<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in);
+  std::ifstream f(name.c_str());
   
   bool load_okay = f.is_open();
   
-  if(load_okay == false)  { return false; }
-  
-  if(with_header)
-    {
-    arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
-    
-    std::string              header_line;
-    std::stringstream        header_stream;
-    std::vector<std::string> header_tokens;
-    
-    std::getline(f, header_line);
-    
-    load_okay = f.good();
-    
-    if(load_okay)
-      {
-      std::string token;
-      
-      header_stream.clear();
-      header_stream.str(header_line);
-      
-      uword header_n_tokens = 0;
-      
-      while(header_stream.good())
-        {
-        std::getline(header_stream, token, separator);
-        ++header_n_tokens;
-        header_tokens.push_back(token);
-        }
-      
-      if(header_n_tokens == uword(0))
-        {
-        header.reset();
-        }
-      else
-        {
-        header.set_size(1,header_n_tokens);
-        
-        for(uword i=0; i < header_n_tokens; ++i)  { header.at(i) = header_tokens[i]; }
-        }
-      }
-    }
-  
   if(load_okay)
     {
-    load_okay = diskio::load_csv_ascii(x, f, err_msg, separator);
+    load_okay = diskio::load_arma_ascii(x, f, err_msg);
+    f.close();
     }
   
-  f.close();
-  
   return load_okay;
   }
+  
 
 
-
+//! Load a cube in text format (human readable),
+//! with a header that indicates the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::load_csv_ascii(SpMat<eT>& x, std::istream& f, std::string& err_msg, const char separator)
+diskio::load_arma_ascii(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  // TODO: replace with more efficient implementation
-  
-  if(f.good() == false)  { return false; }
-  
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
-  
-  //
-  // work out the size
+  std::streampos pos = f.tellg();
   
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
+  bool load_okay = true;
   
-  std::string       line_string;
-  std::stringstream line_stream;
+  std::string f_header;
+  uword       f_n_rows;
+  uword       f_n_cols;
+  uword       f_n_slices;
   
-  std::string token;
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f >> f_n_slices;
   
-  while(f.good())
+  if(f_header == diskio::gen_txt_header(x))
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
-    
-    uword line_n_cols = 0;
-    
-    while(line_stream.good())
+    try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
+
+    for(uword slice = 0; slice < x.n_slices; ++slice)
+    for(uword   row = 0;   row < x.n_rows;   ++row  )
+    for(uword   col = 0;   col < x.n_cols;   ++col  )
       {
-      std::getline(line_stream, token, separator);
-      ++line_n_cols;
+      f >> x.at(row,col,slice);
       }
     
-    if(f_n_cols < line_n_cols)  { f_n_cols = line_n_cols; }
-    
-    ++f_n_rows;
+    load_okay = f.good();
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "incorrect header";
     }
   
-  f.clear();
-  f.seekg(pos1);
   
-  try
+  // allow automatic conversion of u32/s32 cubes into u64/s64 cubes
+  
+  if(load_okay == false)
     {
-    MapMat<eT> tmp(f_n_rows, f_n_cols);
-    
-    uword row = 0;
-    
-    while(f.good())
+    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
       {
-      std::getline(f, line_string);
-      
-      if(line_string.size() == 0)  { break; }
+      Cube<u32>   tmp;
+      std::string junk;
       
-      line_stream.clear();
-      line_stream.str(line_string);
+      f.clear();
+      f.seekg(pos);
       
-      uword col = 0;
+      load_okay = diskio::load_arma_ascii(tmp, f, junk);
       
-      while(line_stream.good())
-        {
-        std::getline(line_stream, token, separator);
-        
-        eT val = eT(0);
-        
-        diskio::convert_token( val, token );
-        
-        if(val != eT(0))  { tmp(row,col) = val; }
-        
-        ++col;
-        }
+      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
+      }
+    else
+    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
+      {
+      Cube<s32>   tmp;
+      std::string junk;
       
-      ++row;
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_ascii(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
       }
-    
-    x = tmp;
-    }
-  catch(...)
-    {
-    err_msg = "not enough memory";
-    return false;
     }
   
-  return true;
-  }
-
-
-
-template<typename T>
-inline
-bool
-diskio::load_csv_ascii(SpMat< std::complex<T> >& x, std::istream& f, std::string& err_msg, const char separator)
-  {
-  arma_extra_debug_sigprint();
-  
-  arma_ignore(x);
-  arma_ignore(f);
-  arma_ignore(err_msg);
-  arma_ignore(separator);
-  
-  arma_debug_warn_level(1, "loading complex sparse matrices as csv_ascii not yet implemented");
-  
-  return false;
+  return load_okay;
   }
 
 
 
+//! Load a cube in binary format,
+//! with a header that indicates the cube type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::load_coord_ascii(SpMat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_arma_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
   
   bool load_okay = f.is_open();
   
   if(load_okay)
     {
-    load_okay = diskio::load_coord_ascii(x, f, err_msg);
+    load_okay = diskio::load_arma_binary(x, f, err_msg);
     f.close();
     }
   
@@ -3234,233 +4735,247 @@ diskio::load_coord_ascii(SpMat<eT>& x, const std::string& name, std::string& err
 template<typename eT>
 inline
 bool
-diskio::load_coord_ascii(SpMat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_arma_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  if(f.good() == false)  { return false; }
-  
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
-  
-  // work out the size
-  
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
-  
-  bool size_found = false;
+  std::streampos pos = f.tellg();
+    
+  bool load_okay = true;
   
-  std::string       line_string;
-  std::stringstream line_stream;
+  std::string f_header;
+  uword       f_n_rows;
+  uword       f_n_cols;
+  uword       f_n_slices;
   
-  std::string token;
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f >> f_n_slices;
   
-  while(f.good())
+  if(f_header == diskio::gen_bin_header(x))
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
-    
-    uword line_row = 0;
-    uword line_col = 0;
-    
-    // a valid line in co-ord format has at least 2 entries
-    
-    line_stream >> line_row;
-    
-    if(line_stream.good() == false)  { err_msg = "incorrect format"; return false; }
+    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
+    f.get();
     
-    line_stream >> line_col;
+    try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
     
-    size_found = true;
+    f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem*sizeof(eT)) );
     
-    if(f_n_rows < line_row)  { f_n_rows = line_row; }
-    if(f_n_cols < line_col)  { f_n_cols = line_col; }
+    load_okay = f.good();
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "incorrect header";
     }
   
-  // take into account that indices start at 0
-  if(size_found)  { ++f_n_rows;  ++f_n_cols; }
   
-  f.clear();
-  f.seekg(pos1);
+  // allow automatic conversion of u32/s32 cubes into u64/s64 cubes
   
-  try
+  if(load_okay == false)
     {
-    MapMat<eT> tmp(f_n_rows, f_n_cols);
-    
-    while(f.good())
+    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
       {
-      std::getline(f, line_string);
-      
-      if(line_string.size() == 0)  { break; }
-      
-      line_stream.clear();
-      line_stream.str(line_string);
+      Cube<u32>   tmp;
+      std::string junk;
       
-      uword line_row = 0;
-      uword line_col = 0;
+      f.clear();
+      f.seekg(pos);
       
-      line_stream >> line_row;
-      line_stream >> line_col;
+      load_okay = diskio::load_arma_binary(tmp, f, junk);
       
-      eT val = eT(0);
+      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
+      }
+    else
+    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
+      {
+      Cube<s32>   tmp;
+      std::string junk;
       
-      line_stream >> token;
+      f.clear();
+      f.seekg(pos);
       
-      if(line_stream.fail() == false)
-        {
-        diskio::convert_token( val, token );
-        }
+      load_okay = diskio::load_arma_binary(tmp, f, junk);
       
-      if(val != eT(0))  { tmp(line_row,line_col) = val; }
+      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
       }
-    
-    x = tmp;
-    }
-  catch(...)
-    {
-    err_msg = "not enough memory";
-    return false;
     }
   
-  return true;
+  return load_okay;
   }
 
 
 
-template<typename T>
+//! Load a HDF5 file as a cube
+template<typename eT>
 inline
 bool
-diskio::load_coord_ascii(SpMat< std::complex<T> >& x, std::istream& f, std::string& err_msg)
+diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  if(f.good() == false)  { return false; }
-  
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
-  
-  // work out the size
-  
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
-  
-  bool size_found = false;
-  
-  std::string       line_string;
-  std::stringstream line_stream;
-  
-  std::string token_real;
-  std::string token_imag;
-  
-  while(f.good())
+  #if defined(ARMA_USE_HDF5)
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
-    
-    uword line_row = 0;
-    uword line_col = 0;
-    
-    // a valid line in co-ord format has at least 2 entries
-    
-    line_stream >> line_row;
-    
-    if(line_stream.good() == false)  { err_msg = "incorrect format"; return false; }
-    
-    line_stream >> line_col;
+    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
-    size_found = true;
+    bool load_okay = false;
     
-    if(f_n_rows < line_row)  f_n_rows = line_row;
-    if(f_n_cols < line_col)  f_n_cols = line_col;
-    }
-  
-  // take into account that indices start at 0
-  if(size_found)  { ++f_n_rows;  ++f_n_cols; }
-  
-  f.clear();
-  f.seekg(pos1);
-  
-  try
-    {
-    MapMat< std::complex<T> > tmp(f_n_rows, f_n_cols);
+    hid_t fid = arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
     
-    while(f.good())
+    if(fid >= 0)
       {
-      std::getline(f, line_string);
-      
-      if(line_string.size() == 0)  { break; }
-      
-      line_stream.clear();
-      line_stream.str(line_string);
+      // MATLAB HDF5 dataset names are user-specified;
+      // Octave tends to store the datasets in a group, with the actual dataset being referred to as "value".
+      // If the user hasn't specified a dataset, we will search for "dataset" and "value",
+      // and if those are not found we will take the first dataset we do find.
       
-      uword line_row = 0;
-      uword line_col = 0;
+      std::vector<std::string> searchNames;
       
-      line_stream >> line_row;
-      line_stream >> line_col;
+      const bool exact = (spec.dsname.empty() == false);
       
-      T val_real = T(0);
-      T val_imag = T(0);
+      if(exact)
+        {
+        searchNames.push_back(spec.dsname);
+        }
+      else
+        {
+        searchNames.push_back("dataset");
+        searchNames.push_back("value"  );
+        }
       
-      line_stream >> token_real;
+      hid_t dataset = hdf5_misc::search_hdf5_file(searchNames, fid, 3, exact);
       
-      if(line_stream.fail() == false)
+      if(dataset >= 0)
         {
-        diskio::convert_token( val_real, token_real );
+        hid_t filespace = arma_H5Dget_space(dataset);
+        
+        // This must be <= 3 due to our search rules.
+        const int ndims = arma_H5Sget_simple_extent_ndims(filespace);
+        
+        hsize_t dims[3];
+        const herr_t query_status = arma_H5Sget_simple_extent_dims(filespace, dims, NULL);
+        
+        // arma_check(query_status < 0, "Cube::load(): cannot get size of HDF5 dataset");
+        if(query_status < 0)
+          {
+          err_msg = "cannot get size of HDF5 dataset";
+          
+          arma_H5Sclose(filespace);
+          arma_H5Dclose(dataset);
+          arma_H5Fclose(fid);
+          
+          return false;
+          }
+        
+        hid_t memspace = H5S_ALL;
+        
+        if(spec.opts.flags & hdf5_opts::flag_subset)
+          {
+          const bool select_okay = hdf5_misc::select_subset(filespace, spec.opts, ndims, 3, dims, err_msg);
+          
+          if(select_okay)  { memspace = arma_H5Screate_simple(ndims, dims, NULL); }
+          
+          if( (select_okay == false) || (memspace < 0) )
+            {
+            if(select_okay)  { err_msg = "cannot create HDF5 dataspace"; }
+            
+            arma_H5Sclose(filespace);
+            arma_H5Dclose(dataset);
+            arma_H5Fclose(fid);
+            
+            return false;
+            }
+          }
+        
+        // read the whole dataset unless a subset was selected
+        const hid_t readspace = (memspace == H5S_ALL) ? hid_t(H5S_ALL) : filespace;
+        
+        if(ndims == 1) { dims[1] = 1; dims[2] = 1; }  // Vector case; one row/colum, several slices
+        if(ndims == 2) {              dims[2] = 1; }  // Matrix case; one column, several rows/slices
+        
+        try { x.set_size(dims[2], dims[1], dims[0]); } catch(...) { err_msg = "not enough memory"; return false; }
+        
+        // Now we have to see what type is stored to figure out how to load it.
+        hid_t datatype = arma_H5Dget_type(dataset);
+        hid_t mat_type = hdf5_misc::get_hdf5_type<eT>();
+        
+        // If these are the same type, it is simple.
+        if(arma_H5Tequal(datatype, mat_type) > 0)
+          {
+          // Load directly; H5S_ALL used so that we load the entire dataset.
+          hid_t read_status = arma_H5Dread(dataset, datatype, memspace, readspace, H5P_DEFAULT, void_ptr(x.memptr()));
+          
+          if(read_status >= 0) { load_okay = true; }
+          }
+        else
+          {
+          // Load into another array and convert its type accordingly.
+          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem, memspace, readspace);
+          
+          if(read_status >= 0) { load_okay = true; }
+          }
+        
+        // Now clean up.
+        arma_H5Tclose(datatype);
+        arma_H5Tclose(mat_type);
+        arma_H5Sclose(filespace);
+        
+        if(memspace != H5S_ALL)  { arma_H5Sclose(memspace); }
         }
       
+      arma_H5Dclose(dataset);
       
-      line_stream >> token_imag;
-      
-      if(line_stream.fail() == false)
-        {
-        diskio::convert_token( val_imag, token_imag );
-        }
+      arma_H5Fclose(fid);
       
-      if( (val_real != T(0)) || (val_imag != T(0)) )
+      if(load_okay == false)
         {
-        tmp(line_row,line_col) = std::complex<T>(val_real, val_imag);
+        err_msg = "unsupported or missing HDF5 data";
         }
       }
+    else
+      {
+      err_msg = "cannot open";
+      }
     
-    x = tmp;
+    return load_okay;
     }
-  catch(...)
+  #else
     {
-    err_msg = "not enough memory";
+    arma_ignore(x);
+    arma_ignore(spec);
+    arma_ignore(err_msg);
+    
+    arma_stop_logic_error("Cube::load(): use of HDF5 must be enabled");
+    
     return false;
     }
-  
-  return true;
+  #endif
   }
 
 
 
-//! Load a matrix in binary format,
-//! with a header that indicates the matrix type as well as its dimensions
+//! Try to load a cube by automatically determining its type
 template<typename eT>
 inline
 bool
-diskio::load_arma_binary(SpMat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_auto_detect(Cube<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f;
-  f.open(name.c_str(), std::fstream::binary);
+  #if defined(ARMA_USE_HDF5)
+    // We're currently using the C bindings for the HDF5 library, which don't support C++ streams
+    if( arma_H5Fis_hdf5(name.c_str()) ) { return load_hdf5_binary(x, name, err_msg); }
+  #endif
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
   bool load_okay = f.is_open();
   
   if(load_okay)
     {
-    load_okay = diskio::load_arma_binary(x, f, err_msg);
+    load_okay = diskio::load_auto_detect(x, f, err_msg);
     f.close();
     }
   
@@ -3469,129 +4984,149 @@ diskio::load_arma_binary(SpMat<eT>& x, const std::string& name, std::string& err
 
 
 
+//! Try to load a cube by automatically determining its type
 template<typename eT>
 inline
 bool
-diskio::load_arma_binary(SpMat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  bool load_okay = true;
+  const char* ARMA_CUB_TXT_str = "ARMA_CUB_TXT";
+  const char* ARMA_CUB_BIN_str = "ARMA_CUB_BIN";
+  const char*           P6_str = "P6";
+  const char*           PF_str = "PF\n";
+  const char*           Pf_str = "Pf\n";
   
-  std::string f_header;
+  const uword ARMA_CUB_TXT_len = uword(12);
+  const uword ARMA_CUB_BIN_len = uword(12);
+  const uword           P6_len = uword(2);
+  const uword           PF_len = uword(3);
   
-  f >> f_header;
+  podarray<char> header(ARMA_CUB_TXT_len + 1);
   
-  if(f_header == diskio::gen_bin_header(x))
+  char* header_mem = header.memptr();
+  
+  std::streampos pos = f.tellg();
+  
+  f.read( header_mem, std::streamsize(ARMA_CUB_TXT_len) );
+  f.clear();
+  f.seekg(pos);
+  
+  header_mem[ARMA_CUB_TXT_len] = '\0';
+  
+  if( std::strncmp(ARMA_CUB_TXT_str, header_mem, size_t(ARMA_CUB_TXT_len)) == 0 )
     {
-    uword f_n_rows;
-    uword f_n_cols;
-    uword f_n_nz;
-    
-    f >> f_n_rows;
-    f >> f_n_cols;
-    f >> f_n_nz;
-    
-    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
-    f.get();
-    
-    try { x.reserve(f_n_rows, f_n_cols, f_n_nz); } catch(...) { err_msg = "not enough memory"; return false; }
-    
-    f.read( reinterpret_cast<char*>(access::rwp(x.values)),      std::streamsize(x.n_nonzero*sizeof(eT))     );
-    
-    std::streampos pos = f.tellg();
-    
-    f.read( reinterpret_cast<char*>(access::rwp(x.row_indices)), std::streamsize(x.n_nonzero*sizeof(uword))  );
-    f.read( reinterpret_cast<char*>(access::rwp(x.col_ptrs)),    std::streamsize((x.n_cols+1)*sizeof(uword)) );
-    
-    bool check1 = true;  for(uword i=0; i < x.n_nonzero; ++i)  { if(x.values[i] == eT(0))  { check1 = false; break; } }
-    bool check2 = true;  for(uword i=0; i < x.n_cols;    ++i)  { if(x.col_ptrs[i+1] < x.col_ptrs[i])  { check2 = false; break; } }
-    bool check3 = (x.col_ptrs[x.n_cols] == x.n_nonzero);
+    return load_arma_ascii(x, f, err_msg);
+    }
+  else
+  if( std::strncmp(ARMA_CUB_BIN_str, header_mem, size_t(ARMA_CUB_BIN_len)) == 0 )
+    {
+    return load_arma_binary(x, f, err_msg);
+    }
+  else
+  if( std::strncmp(P6_str, header_mem, size_t(P6_len)) == 0 )
+    {
+    return load_ppm_binary(x, f, err_msg);
+    }
+  else
+  if( (std::strncmp(PF_str, header_mem, size_t(PF_len)) == 0) || (std::strncmp(Pf_str, header_mem, size_t(PF_len)) == 0) )
+    {
+    return load_pfm_binary(x, f, err_msg);
+    }
+  else
+    {
+    const file_type ft = guess_file_type_internal(f);
     
-    if((check1 == true) && ((check2 == false) || (check3 == false)))
+    switch(ft)
       {
-      if(sizeof(uword) == 8)
-        {
-        arma_extra_debug_print("detected inconsistent data while loading; re-reading integer parts as u32");
-        
-        // inconstency could be due to a different uword size used during saving,
-        // so try loading the row_indices and col_ptrs under the assumption of 32 bit unsigned integers
-        
-        f.clear();
-        f.seekg(pos);
-        
-        podarray<u32> tmp_a(x.n_nonzero );  tmp_a.zeros();
-        podarray<u32> tmp_b(x.n_cols + 1);  tmp_b.zeros();
-        
-        f.read( reinterpret_cast<char*>(tmp_a.memptr()), std::streamsize( x.n_nonzero   * sizeof(u32)) );
-        f.read( reinterpret_cast<char*>(tmp_b.memptr()), std::streamsize((x.n_cols + 1) * sizeof(u32)) );
-        
-        check2 = true;  for(uword i=0; i < x.n_cols; ++i)  { if(tmp_b[i+1] < tmp_b[i])  { check2 = false; break; } }
-        check3 = (tmp_b[x.n_cols] == x.n_nonzero);
+      // case csv_ascii:
+      //   return load_csv_ascii(x, f, err_msg);
+      //   break;
+      
+      case raw_binary:
+        return load_raw_binary(x, f, err_msg);
+        break;
         
-        load_okay = f.good();
+      case raw_ascii:
+        return load_raw_ascii(x, f, err_msg);
+        break;
         
-        if( load_okay && (check2 == true) && (check3 == true) )
-          {
-          arma_extra_debug_print("reading integer parts as u32 succeeded");
-          
-          arrayops::convert(access::rwp(x.row_indices), tmp_a.memptr(), x.n_nonzero );
-          arrayops::convert(access::rwp(x.col_ptrs),    tmp_b.memptr(), x.n_cols + 1);
-          }
-        else
-          {
-          arma_extra_debug_print("reading integer parts as u32 failed");
-          }
-        }
-      }
-    
-    if((check1 == false) || (check2 == false) || (check3 == false))
-      {
-      load_okay = false;
-      err_msg = "inconsistent data";
-      }
-    else
-      {
-      load_okay = f.good();
+      default:
+        err_msg = "unknown data";
+        return false;
       }
     }
-  else
+  
+  return false;
+  }
+
+
+
+
+
+// fields
+
+
+
+template<typename T1>
+inline
+bool
+diskio::save_arma_binary(const field<T1>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
     {
-    load_okay = false;
-    err_msg = "incorrect header";
+    save_okay = diskio::save_arma_binary(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
-// cubes
-
-
-
-//! Save a cube as raw text (no header, human readable).
-template<typename eT>
+template<typename T1>
 inline
 bool
-diskio::save_raw_ascii(const Cube<eT>& x, const std::string& final_name)
+diskio::save_arma_binary(const field<T1>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  arma_type_check(( (is_Mat<T1>::value == false) && (is_Cube<T1>::value == false) ));
   
-  std::fstream f(tmp_name.c_str(), std::fstream::out);
+  if(x.n_slices <= 1)
+    {
+    f << "ARMA_FLD_BIN" << '\n';
+    f << x.n_rows       << '\n';
+    f << x.n_cols       << '\n';
+    }
+  else
+    {
+    f << "ARMA_FL3_BIN" << '\n';
+    f << x.n_rows       << '\n';
+    f << x.n_cols       << '\n';
+    f << x.n_slices     << '\n';
+    }
   
-  bool save_okay = f.is_open();
+  bool save_okay = true;
   
-  if(save_okay)
+  for(uword i=0; i<x.n_elem; ++i)
     {
-    save_okay = save_raw_ascii(x, f);
-    
-    f.flush();
-    f.close();
+    save_okay = diskio::save_arma_binary(x[i], f);
     
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    if(save_okay == false)  { break; }
     }
   
   return save_okay;
@@ -3599,61 +5134,115 @@ diskio::save_raw_ascii(const Cube<eT>& x, const std::string& final_name)
 
 
 
-//! Save a cube as raw text (no header, human readable).
-template<typename eT>
+template<typename T1>
 inline
 bool
-diskio::save_raw_ascii(const Cube<eT>& x, std::ostream& f)
+diskio::load_arma_binary(field<T1>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const arma_ostream_state stream_state(f);
+  std::ifstream f( name.c_str(), std::fstream::binary );
   
-  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
+  bool load_okay = f.is_open();
   
-  for(uword slice=0; slice < x.n_slices; ++slice)
+  if(load_okay)
     {
-    for(uword row=0; row < x.n_rows; ++row)
+    if(diskio::is_arma_binary_indexed(f))
       {
-      for(uword col=0; col < x.n_cols; ++col)
-        {
-        f.put(' ');
-        
-        if(is_real<eT>::value)  { f.width(cell_width); }
-        
-        arma_ostream::raw_print_elem(f, x.at(row,col,slice));
-        }
-        
-      f.put('\n');
+      f.close();
+      return diskio::load_arma_binary_indexed(x, name, err_msg);
       }
+    
+    load_okay = diskio::load_arma_binary(x, f, err_msg);
+    f.close();
     }
   
-  const bool save_okay = f.good();
+  return load_okay;
+  }
+
+
+
+template<typename T1>
+inline
+bool
+diskio::load_arma_binary(field<T1>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
   
-  stream_state.restore(f);
+  arma_type_check(( (is_Mat<T1>::value == false) && (is_Cube<T1>::value == false) ));
   
-  return save_okay;
+  bool load_okay = true;
+  
+  std::string f_type;
+  f >> f_type;
+  
+  if(f_type == "ARMA_FLD_BIN")
+    {
+    uword f_n_rows;
+    uword f_n_cols;
+    
+    f >> f_n_rows;
+    f >> f_n_cols;
+    
+    try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    f.get();
+    
+    for(uword i=0; i<x.n_elem; ++i)
+      {
+      load_okay = diskio::load_arma_binary(x[i], f, err_msg);
+      
+      if(load_okay == false)  { break; }
+      }
+    }
+  else
+  if(f_type == "ARMA_FL3_BIN")
+    {
+    uword f_n_rows;
+    uword f_n_cols;
+    uword f_n_slices;
+    
+    f >> f_n_rows;
+    f >> f_n_cols;
+    f >> f_n_slices;
+    
+    try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    f.get();
+    
+    for(uword i=0; i<x.n_elem; ++i)
+      {
+      load_okay = diskio::load_arma_binary(x[i], f, err_msg);
+      
+      if(load_okay == false)  { break; }
+      }
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "unsupported field type";
+    }
+  
+  return load_okay;
   }
 
 
 
-//! Save a cube as raw binary (no header)
-template<typename eT>
 inline
 bool
-diskio::save_raw_binary(const Cube<eT>& x, const std::string& final_name)
+diskio::save_std_string(const field<std::string>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
   const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
   
   bool save_okay = f.is_open();
   
   if(save_okay)
     {
-    save_okay = diskio::save_raw_binary(x, f);
+    save_okay = diskio::save_std_string(x, f);
     
     f.flush();
     f.close();
@@ -3666,714 +5255,743 @@ diskio::save_raw_binary(const Cube<eT>& x, const std::string& final_name)
 
 
 
-template<typename eT>
 inline
 bool
-diskio::save_raw_binary(const Cube<eT>& x, std::ostream& f)
+diskio::save_std_string(const field<std::string>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
+  for(uword row=0; row<x.n_rows; ++row)
+  for(uword col=0; col<x.n_cols; ++col)
+    {
+    f << x.at(row,col);
+    
+    if(col < x.n_cols-1)
+      {
+      f << ' ';
+      }
+    else
+      {
+      f << '\n';
+      }
+    }
   
   return f.good();
   }
 
 
 
-//! Save a cube in text format (human readable),
-//! with a header that indicates the cube type as well as its dimensions
-template<typename eT>
 inline
 bool
-diskio::save_arma_ascii(const Cube<eT>& x, const std::string& final_name)
+diskio::load_std_string(field<std::string>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
-  
-  std::ofstream f(tmp_name.c_str());
+  std::ifstream f( name.c_str() );
   
-  bool save_okay = f.is_open();
+  bool load_okay = f.is_open();
   
-  if(save_okay)
+  if(load_okay)
     {
-    save_okay = diskio::save_arma_ascii(x, f);
-    
-    f.flush();
+    load_okay = diskio::load_std_string(x, f, err_msg);
     f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return save_okay;
+  return load_okay;
   }
 
 
 
-//! Save a cube in text format (human readable),
-//! with a header that indicates the cube type as well as its dimensions
-template<typename eT>
 inline
 bool
-diskio::save_arma_ascii(const Cube<eT>& x, std::ostream& f)
+diskio::load_std_string(field<std::string>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const arma_ostream_state stream_state(f);
+  bool load_okay = true;
   
-  f << diskio::gen_txt_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  //
+  // work out the size
   
-  const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
   
-  for(uword slice=0; slice < x.n_slices; ++slice)
+  bool f_n_cols_found = false;
+  
+  std::string line_string;
+  std::string token;
+  
+  while( f.good() && load_okay )
     {
-    for(uword row=0; row < x.n_rows; ++row)
+    std::getline(f, line_string);
+    
+    if(line_string.size() == 0)  { break; }
+    
+    std::stringstream line_stream(line_string);
+    
+    uword line_n_cols = 0;
+    
+    while(line_stream >> token)  { line_n_cols++; }
+    
+    if(f_n_cols_found == false)
       {
-      for(uword col=0; col < x.n_cols; ++col)
+      f_n_cols = line_n_cols;
+      f_n_cols_found = true;
+      }
+    else
+      {
+      if(line_n_cols != f_n_cols)
         {
-        f.put(' ');
-        
-        if(is_real<eT>::value)  { f.width(cell_width); }
-        
-        arma_ostream::raw_print_elem(f, x.at(row,col,slice));
+        load_okay = false;
+        err_msg = "inconsistent number of columns";
         }
-      
-      f.put('\n');
+      }
+    
+    ++f_n_rows;
+    }
+    
+  if(load_okay)
+    {
+    f.clear();
+    f.seekg(0, ios::beg);
+    //f.seekg(start);
+    
+    try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    for(uword row=0; row < x.n_rows; ++row)
+    for(uword col=0; col < x.n_cols; ++col)
+      {
+      f >> x.at(row,col);
       }
     }
   
-  const bool save_okay = f.good();
-  
-  stream_state.restore(f);
+  if(f.good() == false)  { load_okay = false; }
   
-  return save_okay;
+  return load_okay;
   }
 
-
-
-//! Save a cube in binary format,
-//! with a header that stores the cube type as well as its dimensions
-template<typename eT>
+
+
+//! Try to load a field by automatically determining its type
+template<typename T1>
 inline
 bool
-diskio::save_arma_binary(const Cube<eT>& x, const std::string& final_name)
+diskio::load_auto_detect(field<T1>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
-  
-  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
-  bool save_okay = f.is_open();
+  bool load_okay = f.is_open();
   
-  if(save_okay)
+  if(load_okay)
     {
-    save_okay = diskio::save_arma_binary(x, f);
+    if(diskio::is_arma_binary_indexed(f))
+      {
+      f.close();
+      return diskio::load_arma_binary_indexed(x, name, err_msg);
+      }
     
-    f.flush();
+    load_okay = diskio::load_auto_detect(x, f, err_msg);
     f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return save_okay;
+  return load_okay;
   }
 
 
 
-//! Save a cube in binary format,
-//! with a header that stores the cube type as well as its dimensions
-template<typename eT>
+//! Try to load a field by automatically determining its type
+template<typename T1>
 inline
 bool
-diskio::save_arma_binary(const Cube<eT>& x, std::ostream& f)
+diskio::load_auto_detect(field<T1>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  arma_type_check(( is_Mat<T1>::value == false ));
   
-  f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
+  static const std::string ARMA_FLD_BIN = "ARMA_FLD_BIN";
+  static const std::string ARMA_FL3_BIN = "ARMA_FL3_BIN";
+  static const std::string ARMA_FLX_BIN = "ARMA_FLX_BIN";
+  static const std::string           P6 = "P6";
   
-  return f.good();
+  podarray<char> raw_header(uword(ARMA_FLD_BIN.length()) + 1);
+  
+  std::streampos pos = f.tellg();
+  
+  f.read( raw_header.memptr(), std::streamsize(ARMA_FLD_BIN.length()) );
+  
+  f.clear();
+  f.seekg(pos);
+  
+  raw_header[uword(ARMA_FLD_BIN.length())] = '\0';
+  
+  const std::string header = raw_header.mem;
+  
+  if(ARMA_FLD_BIN == header.substr(0, ARMA_FLD_BIN.length()))
+    {
+    return load_arma_binary(x, f, err_msg);
+    }
+  else
+  if(ARMA_FL3_BIN == header.substr(0, ARMA_FL3_BIN.length()))
+    {
+    return load_arma_binary(x, f, err_msg);
+    }
+  else
+  if(ARMA_FLX_BIN == header.substr(0, ARMA_FLX_BIN.length()))
+    {
+    return load_arma_binary_indexed(x, f, err_msg);
+    }
+  else
+  if(P6 == header.substr(0, P6.length()))
+    {
+    return load_ppm_binary(x, f, err_msg);
+    }
+  else
+    {
+    err_msg = "unsupported header";
+    return false;
+    }
   }
 
 
 
-//! Save a cube as part of a HDF5 file
-template<typename eT>
+//! Save a field in the indexed Armadillo binary format.
+//! Format: "ARMA_FLX_BIN_ABXYZ", followed by the field dimensions on the next line,
+//! followed by a table with 4 u64 values per element (offset, n_rows, n_cols, n_slices),
+//! followed by the raw element data. Each offset is relative to the start of the header,
+//! and is aligned to 64 bytes, so that elements can be written, read or memory-mapped independently.
+//! The elements are written in parallel via separate file handles.
+template<typename T1>
 inline
 bool
-diskio::save_hdf5_binary(const Cube<eT>& x, const hdf5_name& spec, std::string& err_msg)
+diskio::save_arma_binary_indexed(const field<T1>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_HDF5)
+  typedef typename T1::elem_type eT;
+  
+  podarray<u64> table;
+  std::string   header;
+  
+  const u64 n_bytes_total = diskio::gen_index_table(table, header, x);
+  const u64 n_bytes_head  = u64(header.length()) + u64(table.n_elem * sizeof(u64));
+  
+  const bool use_mp = (x.n_elem >= 2) && mp_gate<eT>::eval_task(uword((n_bytes_total - n_bytes_head) / sizeof(eT)));
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay == false)  { return false; }
+  
+  if(use_mp == false)
     {
-    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
-    
-    bool save_okay = false;
-    
-    const bool append  = bool(spec.opts.flags & hdf5_opts::flag_append);
-    const bool replace = bool(spec.opts.flags & hdf5_opts::flag_replace);
-    
-    const bool use_existing_file = ((append || replace) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
-    
-    const std::string tmp_name = (use_existing_file) ? std::string() : diskio::gen_tmp_name(spec.filename);
-    
-    // Set up the file according to HDF5's preferences
-    hid_t file = (use_existing_file) ? arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT) : arma_H5Fcreate(tmp_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-    
-    if(file < 0)  { return false; }
-    
-    // We need to create a dataset, datatype, and dataspace
-    hsize_t dims[3];
-    dims[2] = x.n_rows;
-    dims[1] = x.n_cols;
-    dims[0] = x.n_slices;
-    
-    hid_t dataspace = arma_H5Screate_simple(3, dims, NULL);   // treat the cube as a 3d array dataspace
-    hid_t datatype  = hdf5_misc::get_hdf5_type<eT>();
-    
-    // If this returned something invalid, well, it's time to crash.
-    arma_check(datatype == -1, "Cube::save(): unknown datatype for HDF5");
-    
-    // MATLAB forces the users to specify a name at save time for HDF5;
-    // Octave will use the default of 'dataset' unless otherwise specified.
-    // If the user hasn't specified a dataset name, we will use 'dataset'
-    // We may have to split out the group name from the dataset name.
-    std::vector<hid_t> groups;
-    std::string full_name = spec.dsname;
-    size_t loc;
-    while((loc = full_name.find("/")) != std::string::npos)
-      {
-      // Create another group...
-      if(loc != 0) // Ignore the first /, if there is a leading /.
-        {
-        hid_t gid = arma_H5Gcreate((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-        
-        if((gid < 0) && use_existing_file)
-          {
-          gid = arma_H5Gopen((groups.size() == 0) ? file : groups[groups.size() - 1], full_name.substr(0, loc).c_str(), H5P_DEFAULT);
-          }
-        
-        groups.push_back(gid);
-        }
-      
-      full_name = full_name.substr(loc + 1);
-      }
-    
-    const std::string dataset_name = full_name.empty() ? std::string("dataset") : full_name;
-    
-    const hid_t last_group = (groups.size() == 0) ? file : groups[groups.size() - 1];
-    
-    if(use_existing_file && replace)
-      {
-      arma_H5Ldelete(last_group, dataset_name.c_str(), H5P_DEFAULT);
-      // NOTE: H5Ldelete() in HDF5 v1.8 doesn't reclaim the deleted space; use h5repack to reclaim space: h5repack oldfile.h5 newfile.h5
-      // NOTE: has this behaviour changed in HDF5 1.10 ?
-      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010482.html
-      // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010486.html
-      }
-    
-    hid_t dataset = arma_H5Dcreate(last_group, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-    
-    if(dataset < 0)
-      {
-      save_okay = false;
-      
-      err_msg = "couldn't create dataset";
-      }
-    else
-      {
-      save_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.mem) >= 0);
-      
-      arma_H5Dclose(dataset);
-      }
+    save_okay = diskio::save_arma_binary_indexed(x, f);
     
-    arma_H5Tclose(datatype);
-    arma_H5Sclose(dataspace);
-    for(size_t i = 0; i < groups.size(); ++i)  { arma_H5Gclose(groups[i]); }
-    arma_H5Fclose(file);
+    f.flush();
+    f.close();
     
-    if((use_existing_file == false) && (save_okay == true))  { save_okay = diskio::safe_rename(tmp_name, spec.filename); }
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     
     return save_okay;
     }
-  #else
+  
+  f.write( header.c_str(), std::streamsize(header.length()) );
+  f.write( reinterpret_cast<const char*>(table.memptr()), std::streamsize(table.n_elem * sizeof(u64)) );
+  
+  // extend the file to its final size, so that the elements can be written in any order
+  
+  if(n_bytes_total > n_bytes_head)
     {
-    arma_ignore(x);
-    arma_ignore(spec);
-    arma_ignore(err_msg);
-    
-    arma_stop_logic_error("Cube::save(): use of HDF5 must be enabled");
+    const char zero = char(0);
     
-    return false;
+    f.seekp( std::streamoff(n_bytes_total - 1) );
+    f.write( &zero, std::streamsize(1) );
     }
-  #endif
-  }
-
-
-
-//! Load a cube as raw text (no header, human readable).
-//! NOTE: this is much slower than reading a file with a header.
-template<typename eT>
-inline
-bool
-diskio::load_raw_ascii(Cube<eT>& x, const std::string& name, std::string& err_msg)
-  {
-  arma_extra_debug_sigprint();
   
-  Mat<eT> tmp;
-  const bool load_okay = diskio::load_raw_ascii(tmp, name, err_msg);
+  f.flush();
   
-  if(load_okay)
-    {
-    if(tmp.is_empty() == false)
-      {
-      try { x.set_size(tmp.n_rows, tmp.n_cols, 1); } catch(...) { err_msg = "not enough memory"; return false; }
-      
-      x.slice(0) = tmp;
-      }
-    else
-      {
-      x.reset();
-      }
-    }
+  save_okay = f.good();
   
-  return load_okay;
-  }
-
-
-
-//! Load a cube as raw text (no header, human readable).
-//! NOTE: this is much slower than reading a file with a header.
-template<typename eT>
-inline
-bool
-diskio::load_raw_ascii(Cube<eT>& x, std::istream& f, std::string& err_msg)
-  {
-  arma_extra_debug_sigprint();
+  f.close();
   
-  Mat<eT> tmp;
-  const bool load_okay = diskio::load_raw_ascii(tmp, f, err_msg);
+  if(save_okay == false)  { return false; }
   
-  if(load_okay)
+  podarray<u8> status(x.n_elem);
+  
+  status.zeros();
+  
+  struct save_task : public mp_task
     {
-    if(tmp.is_empty() == false)
+    const field<T1>&     x;
+    const std::string&   name;
+    const podarray<u64>& table;
+          u8*            status;
+    
+    inline save_task(const field<T1>& in_x, const std::string& in_name, const podarray<u64>& in_table, u8* in_status)
+      : x(in_x), name(in_name), table(in_table), status(in_status) {}
+    
+    inline
+    void
+    run(const uword start, const uword endp1) const
       {
-      try { x.set_size(tmp.n_rows, tmp.n_cols, 1); } catch(...) { err_msg = "not enough memory"; return false; }
+      std::fstream g( name.c_str(), std::fstream::in | std::fstream::out | std::fstream::binary );
       
-      x.slice(0) = tmp;
-      }
-    else
-      {
-      x.reset();
+      for(uword i=start; i < endp1; ++i)
+        {
+        const T1& X = x[i];
+        
+        if(X.n_elem > 0)
+          {
+          g.seekp( std::streamoff(table[4*i]) );
+          g.write( reinterpret_cast<const char*>(X.memptr()), std::streamsize(X.n_elem * sizeof(eT)) );
+          }
+        
+        status[i] = g.good() ? u8(1) : u8(0);
+        }
       }
-    }
+    };
+  
+  mp_task_runner::run(x.n_elem, save_task(x, tmp_name, table, status.memptr()));
+  
+  for(uword i=0; i < x.n_elem; ++i)  { if(status[i] == u8(0))  { save_okay = false; break; } }
+  
+  if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
-//! Load a cube in binary format (no header);
-//! the cube is assumed to have one slice with one column
-template<typename eT>
+//! Save a field in the indexed Armadillo binary format; the elements are written sequentially
+template<typename T1>
 inline
 bool
-diskio::load_raw_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
+diskio::save_arma_binary_indexed(const field<T1>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f;
-  f.open(name.c_str(), std::fstream::binary);
+  typedef typename T1::elem_type eT;
   
-  bool load_okay = f.is_open();
+  podarray<u64> table;
+  std::string   header;
   
-  if(load_okay)
+  diskio::gen_index_table(table, header, x);
+  
+  f.write( header.c_str(), std::streamsize(header.length()) );
+  f.write( reinterpret_cast<const char*>(table.memptr()), std::streamsize(table.n_elem * sizeof(u64)) );
+  
+  u64 n_bytes_written = u64(header.length()) + u64(table.n_elem * sizeof(u64));
+  
+  for(uword i=0; i < x.n_elem; ++i)
     {
-    load_okay = diskio::load_raw_binary(x, f, err_msg);
-    f.close();
+    const T1& X = x[i];
+    
+    for(; n_bytes_written < table[4*i]; ++n_bytes_written)  { f.put(char(0)); }
+    
+    f.write( reinterpret_cast<const char*>(X.memptr()), std::streamsize(X.n_elem * sizeof(eT)) );
+    
+    n_bytes_written += u64(X.n_elem * sizeof(eT));
     }
   
-  return load_okay;
+  return f.good();
   }
 
 
 
-template<typename eT>
+//! Load a field saved in the indexed Armadillo binary format.
+//! The elements are read in parallel via separate file handles.
+template<typename T1>
 inline
 bool
-diskio::load_raw_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_arma_binary_indexed(field<T1>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  f.clear();
-  const std::streampos pos1 = f.tellg();
+  typedef typename T1::elem_type eT;
   
-  f.clear();
-  f.seekg(0, ios::end);
+  podarray<u64> table;
   
-  f.clear();
-  const std::streampos pos2 = f.tellg();
+  uword f_n_rows   = 0;
+  uword f_n_cols   = 0;
+  uword f_n_slices = 0;
+  u64   f_n_bytes  = 0;
   
-  const uword N = ( (pos1 >= 0) && (pos2 >= 0) ) ? uword(pos2 - pos1) : 0;
+  std::ifstream f( name.c_str(), std::fstream::binary );
   
-  f.clear();
-  //f.seekg(0, ios::beg);
-  f.seekg(pos1);
+  if(f.is_open() == false)  { return false; }
   
-  try { x.set_size(N / uword(sizeof(eT)), 1, 1); } catch(...) { err_msg = "not enough memory"; return false; }
+  bool load_okay = diskio::load_index_table<T1>(table, f_n_rows, f_n_cols, f_n_slices, f_n_bytes, f, err_msg);
   
-  f.clear();
-  f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem * uword(sizeof(eT))) );
+  f.close();
   
-  return f.good();
+  if(load_okay == false)  { return false; }
+  
+  uword n_elem_total = 0;
+  
+  try
+    {
+    x.set_size(f_n_rows, f_n_cols, f_n_slices);
+    
+    for(uword i=0; i < x.n_elem; ++i)
+      {
+      if(diskio::index_set_size(x[i], &(table[4*i+1])) == false)  { err_msg = "incompatible element size"; return false; }
+      
+      n_elem_total += x[i].n_elem;
+      }
+    }
+  catch(...)
+    {
+    err_msg = "not enough memory";
+    return false;
+    }
+  
+  podarray<u8> status(x.n_elem);
+  
+  status.zeros();
+  
+  struct load_task : public mp_task
+    {
+          field<T1>&     x;
+    const std::string&   name;
+    const podarray<u64>& table;
+          u8*         status;
+    
+    inline load_task(field<T1>& in_x, const std::string& in_name, const podarray<u64>& in_table, u8* in_status)
+      : x(in_x), name(in_name), table(in_table), status(in_status) {}
+    
+    inline
+    void
+    run(const uword start, const uword endp1) const
+      {
+      std::ifstream g( name.c_str(), std::fstream::binary );
+      
+      for(uword i=start; i < endp1; ++i)
+        {
+        T1& X = x[i];
+        
+        if(X.n_elem > 0)
+          {
+          g.seekg( std::streamoff(table[4*i]) );
+          g.read( reinterpret_cast<char*>(X.memptr()), std::streamsize(X.n_elem * sizeof(eT)) );
+          }
+        
+        status[i] = g.good() ? u8(1) : u8(0);
+        }
+      }
+    };
+  
+  const load_task task(x, name, table, status.memptr());
+  
+  if( (x.n_elem >= 2) && mp_gate<eT>::eval_task(n_elem_total) )
+    {
+    mp_task_runner::run(x.n_elem, task);
+    }
+  else
+    {
+    task.run(0, x.n_elem);
+    }
+  
+  for(uword i=0; i < x.n_elem; ++i)  { if(status[i] == u8(0))  { load_okay = false; break; } }
+  
+  return load_okay;
   }
 
 
 
-//! Load a cube in text format (human readable),
-//! with a header that indicates the cube type as well as its dimensions
-template<typename eT>
+//! Load a field saved in the indexed Armadillo binary format; the elements are read sequentially
+template<typename T1>
 inline
 bool
-diskio::load_arma_ascii(Cube<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_arma_binary_indexed(field<T1>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f(name.c_str());
+  typedef typename T1::elem_type eT;
   
-  bool load_okay = f.is_open();
+  podarray<u64> table;
   
-  if(load_okay)
+  uword f_n_rows   = 0;
+  uword f_n_cols   = 0;
+  uword f_n_slices = 0;
+  u64   f_n_bytes  = 0;
+  
+  if(diskio::load_index_table<T1>(table, f_n_rows, f_n_cols, f_n_slices, f_n_bytes, f, err_msg) == false)  { return false; }
+  
+  try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  for(uword i=0; i < x.n_elem; ++i)
     {
-    load_okay = diskio::load_arma_ascii(x, f, err_msg);
-    f.close();
+    T1& X = x[i];
+    
+    try
+      {
+      if(diskio::index_set_size(X, &(table[4*i+1])) == false)  { err_msg = "incompatible element size"; return false; }
+      }
+    catch(...)
+      {
+      err_msg = "not enough memory";
+      return false;
+      }
+    
+    // skip the alignment padding without seeking, so that non-seekable streams can be used
+    
+    f.ignore( std::streamsize(table[4*i] - f_n_bytes) );
+    
+    f.read( reinterpret_cast<char*>(X.memptr()), std::streamsize(X.n_elem * sizeof(eT)) );
+    
+    f_n_bytes = table[4*i] + u64(X.n_elem * sizeof(eT));
+    
+    if(f.good() == false)  { return false; }
     }
   
-  return load_okay;
+  return true;
   }
-  
 
 
-//! Load a cube in text format (human readable),
-//! with a header that indicates the cube type as well as its dimensions
-template<typename eT>
+
+//! Load one element of a field saved in the indexed Armadillo binary format, without reading the other elements.
+//! The field is resized to match the file if required; the other elements are not modified.
+template<typename T1>
 inline
 bool
-diskio::load_arma_ascii(Cube<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_arma_binary_indexed_elem(field<T1>& x, const uword index, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::streampos pos = f.tellg();
+  typedef typename T1::elem_type eT;
   
-  bool load_okay = true;
+  podarray<u64> table;
   
-  std::string f_header;
-  uword       f_n_rows;
-  uword       f_n_cols;
-  uword       f_n_slices;
+  uword f_n_rows   = 0;
+  uword f_n_cols   = 0;
+  uword f_n_slices = 0;
+  u64   f_n_bytes  = 0;
   
-  f >> f_header;
-  f >> f_n_rows;
-  f >> f_n_cols;
-  f >> f_n_slices;
+  std::ifstream f( name.c_str(), std::fstream::binary );
   
-  if(f_header == diskio::gen_txt_header(x))
+  if(f.is_open() == false)  { return false; }
+  
+  if(diskio::load_index_table<T1>(table, f_n_rows, f_n_cols, f_n_slices, f_n_bytes, f, err_msg) == false)  { return false; }
+  
+  if(index >= (f_n_rows * f_n_cols * f_n_slices))  { err_msg = "index out of bounds"; return false; }
+  
+  if( (x.n_rows != f_n_rows) || (x.n_cols != f_n_cols) || (x.n_slices != f_n_slices) )
     {
     try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
-
-    for(uword slice = 0; slice < x.n_slices; ++slice)
-    for(uword   row = 0;   row < x.n_rows;   ++row  )
-    for(uword   col = 0;   col < x.n_cols;   ++col  )
-      {
-      f >> x.at(row,col,slice);
-      }
-    
-    load_okay = f.good();
-    }
-  else
-    {
-    load_okay = false;
-    err_msg = "incorrect header";
     }
   
+  T1& X = x[index];
   
-  // allow automatic conversion of u32/s32 cubes into u64/s64 cubes
+  try
+    {
+    if(diskio::index_set_size(X, &(table[4*index+1])) == false)  { err_msg = "incompatible element size"; return false; }
+    }
+  catch(...)
+    {
+    err_msg = "not enough memory";
+    return false;
+    }
   
-  if(load_okay == false)
+  if(X.n_elem > 0)
     {
-    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
-      {
-      Cube<u32>   tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_ascii(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
-      }
-    else
-    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
-      {
-      Cube<s32>   tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_ascii(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
-      }
+    f.seekg( std::streamoff(table[4*index]) );
+    f.read( reinterpret_cast<char*>(X.memptr()), std::streamsize(X.n_elem * sizeof(eT)) );
     }
   
-  return load_okay;
+  return f.good();
   }
 
 
 
-//! Load a cube in binary format,
-//! with a header that indicates the cube type as well as its dimensions
-template<typename eT>
+//! Generate the header and offset table of the indexed Armadillo binary format; returns the total size in bytes
+template<typename T1>
 inline
-bool
-diskio::load_arma_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
+u64
+diskio::gen_index_table(podarray<u64>& table, std::string& header, const field<T1>& x)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f;
-  f.open(name.c_str(), std::fstream::binary);
+  typedef typename T1::elem_type eT;
   
-  bool load_okay = f.is_open();
+  arma_type_check(( (is_Mat<T1>::value == false) && (is_Cube<T1>::value == false) ));
   
-  if(load_okay)
+  const u64 align = u64(64);
+  
+  std::ostringstream ss;
+  
+  ss << "ARMA_FLX_BIN_" << diskio::gen_bin_header(Mat<eT>()).substr(13,5) << '\n';
+  ss << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  
+  header = ss.str();
+  
+  table.set_size(4 * x.n_elem);
+  
+  u64 offset = u64(header.length()) + u64(table.n_elem * sizeof(u64));
+  
+  for(uword i=0; i < x.n_elem; ++i)
     {
-    load_okay = diskio::load_arma_binary(x, f, err_msg);
-    f.close();
+    const T1& X = x[i];
+    
+    offset = ((offset + align - 1) / align) * align;
+    
+    table[4*i] = offset;
+    
+    diskio::index_get_dims(&(table[4*i+1]), X);
+    
+    offset += u64(X.n_elem * sizeof(eT));
     }
   
-  return load_okay;
+  return offset;
   }
 
 
 
-template<typename eT>
+//! Read the header and offset table of the indexed Armadillo binary format,
+//! and check that the offsets are consistent with the element sizes
+template<typename T1>
 inline
 bool
-diskio::load_arma_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_index_table(podarray<u64>& table, uword& n_rows, uword& n_cols, uword& n_slices, u64& n_bytes_read, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::streampos pos = f.tellg();
-    
-  bool load_okay = true;
+  typedef typename T1::elem_type eT;
+  
+  const std::streampos pos1 = f.tellg();
   
   std::string f_header;
-  uword       f_n_rows;
-  uword       f_n_cols;
-  uword       f_n_slices;
   
   f >> f_header;
-  f >> f_n_rows;
-  f >> f_n_cols;
-  f >> f_n_slices;
+  f >> n_rows;
+  f >> n_cols;
+  f >> n_slices;
+  f.get();
   
-  if(f_header == diskio::gen_bin_header(x))
+  const std::string expected_header = std::string("ARMA_FLX_BIN_") + diskio::gen_bin_header(Mat<eT>()).substr(13,5);
+  
+  if(f_header != expected_header)  { err_msg = "incorrect header"; return false; }
+  
+  if(f.good() == false)  { return false; }
+  
+  const uword n_elem = n_rows * n_cols * n_slices;
+  
+  try { table.set_size(4 * n_elem); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  f.read( reinterpret_cast<char*>(table.memptr()), std::streamsize(table.n_elem * sizeof(u64)) );
+  
+  if(f.good() == false)  { return false; }
+  
+  n_bytes_read = u64(f.tellg() - pos1);
+  
+  u64 offset = n_bytes_read;
+  
+  for(uword i=0; i < n_elem; ++i)
     {
-    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
-    f.get();
+    const u64* entry = &(table[4*i]);
     
-    try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
-    
-    f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem*sizeof(eT)) );
+    if(entry[0] < offset)  { err_msg = "corrupted offset table"; return false; }
     
-    load_okay = f.good();
-    }
-  else
-    {
-    load_okay = false;
-    err_msg = "incorrect header";
+    offset = entry[0] + (entry[1] * entry[2] * entry[3]) * u64(sizeof(eT));
     }
   
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+diskio::index_get_dims(u64* dims, const Mat<eT>& X)
+  {
+  dims[0] = u64(X.n_rows);
+  dims[1] = u64(X.n_cols);
+  dims[2] = u64(1);
+  }
+
+
+
+template<typename eT>
+inline
+void
+diskio::index_get_dims(u64* dims, const Cube<eT>& X)
+  {
+  dims[0] = u64(X.n_rows);
+  dims[1] = u64(X.n_cols);
+  dims[2] = u64(X.n_slices);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::index_set_size(Mat<eT>& X, const u64* dims)
+  {
+  if(dims[2] != u64(1))  { return false; }
   
-  // allow automatic conversion of u32/s32 cubes into u64/s64 cubes
+  if( (X.vec_state == 1) && (dims[1] != u64(1)) )  { return false; }
+  if( (X.vec_state == 2) && (dims[0] != u64(1)) )  { return false; }
   
-  if(load_okay == false)
-    {
-    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
-      {
-      Cube<u32>   tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_binary(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
-      }
-    else
-    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
-      {
-      Cube<s32>   tmp;
-      std::string junk;
-      
-      f.clear();
-      f.seekg(pos);
-      
-      load_okay = diskio::load_arma_binary(tmp, f, junk);
-      
-      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
-      }
-    }
+  X.set_size(uword(dims[0]), uword(dims[1]));
   
-  return load_okay;
+  return true;
   }
 
 
 
-//! Load a HDF5 file as a cube
 template<typename eT>
 inline
 bool
-diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec, std::string& err_msg)
+diskio::index_set_size(Cube<eT>& X, const u64* dims)
+  {
+  X.set_size(uword(dims[0]), uword(dims[1]), uword(dims[2]));
+  
+  return true;
+  }
+
+
+
+//! Check whether a stream contains a field in the indexed Armadillo binary format; the stream position is not changed
+inline
+bool
+diskio::is_arma_binary_indexed(std::istream& f)
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_HDF5)
-    {
-    hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
-    
-    bool load_okay = false;
-    
-    hid_t fid = arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
-    
-    if(fid >= 0)
-      {
-      // MATLAB HDF5 dataset names are user-specified;
-      // Octave tends to store the datasets in a group, with the actual dataset being referred to as "value".
-      // If the user hasn't specified a dataset, we will search for "dataset" and "value",
-      // and if those are not found we will take the first dataset we do find.
-      
-      std::vector<std::string> searchNames;
-      
-      const bool exact = (spec.dsname.empty() == false);
-      
-      if(exact)
-        {
-        searchNames.push_back(spec.dsname);
-        }
-      else
-        {
-        searchNames.push_back("dataset");
-        searchNames.push_back("value"  );
-        }
-      
-      hid_t dataset = hdf5_misc::search_hdf5_file(searchNames, fid, 3, exact);
-      
-      if(dataset >= 0)
-        {
-        hid_t filespace = arma_H5Dget_space(dataset);
-        
-        // This must be <= 3 due to our search rules.
-        const int ndims = arma_H5Sget_simple_extent_ndims(filespace);
-        
-        hsize_t dims[3];
-        const herr_t query_status = arma_H5Sget_simple_extent_dims(filespace, dims, NULL);
-        
-        // arma_check(query_status < 0, "Cube::load(): cannot get size of HDF5 dataset");
-        if(query_status < 0)
-          {
-          err_msg = "cannot get size of HDF5 dataset";
-          
-          arma_H5Sclose(filespace);
-          arma_H5Dclose(dataset);
-          arma_H5Fclose(fid);
-          
-          return false;
-          }
-        
-        if(ndims == 1) { dims[1] = 1; dims[2] = 1; }  // Vector case; one row/colum, several slices
-        if(ndims == 2) {              dims[2] = 1; }  // Matrix case; one column, several rows/slices
-        
-        try { x.set_size(dims[2], dims[1], dims[0]); } catch(...) { err_msg = "not enough memory"; return false; }
-        
-        // Now we have to see what type is stored to figure out how to load it.
-        hid_t datatype = arma_H5Dget_type(dataset);
-        hid_t mat_type = hdf5_misc::get_hdf5_type<eT>();
-        
-        // If these are the same type, it is simple.
-        if(arma_H5Tequal(datatype, mat_type) > 0)
-          {
-          // Load directly; H5S_ALL used so that we load the entire dataset.
-          hid_t read_status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(x.memptr()));
-          
-          if(read_status >= 0) { load_okay = true; }
-          }
-        else
-          {
-          // Load into another array and convert its type accordingly.
-          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem);
-          
-          if(read_status >= 0) { load_okay = true; }
-          }
-        
-        // Now clean up.
-        arma_H5Tclose(datatype);
-        arma_H5Tclose(mat_type);
-        arma_H5Sclose(filespace);
-        }
-      
-      arma_H5Dclose(dataset);
-      
-      arma_H5Fclose(fid);
-      
-      if(load_okay == false)
-        {
-        err_msg = "unsupported or missing HDF5 data";
-        }
-      }
-    else
-      {
-      err_msg = "cannot open";
-      }
-    
-    return load_okay;
-    }
-  #else
-    {
-    arma_ignore(x);
-    arma_ignore(spec);
-    arma_ignore(err_msg);
-    
-    arma_stop_logic_error("Cube::load(): use of HDF5 must be enabled");
-    
-    return false;
-    }
-  #endif
+  static const std::string ARMA_FLX_BIN = "ARMA_FLX_BIN";
+  
+  char raw_header[12] = {};
+  
+  const std::streampos pos = f.tellg();
+  
+  f.read( raw_header, std::streamsize(12) );
+  
+  f.clear();
+  f.seekg(pos);
+  
+  return (ARMA_FLX_BIN.compare(0, 12, raw_header, 12) == 0);
   }
 
 
 
-//! Try to load a cube by automatically determining its type
+//
+// handling of PPM images by cubes
+
+
 template<typename eT>
 inline
 bool
-diskio::load_auto_detect(Cube<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_ppm_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_HDF5)
-    // We're currently using the C bindings for the HDF5 library, which don't support C++ streams
-    if( arma_H5Fis_hdf5(name.c_str()) ) { return load_hdf5_binary(x, name, err_msg); }
-  #endif
-  
   std::fstream f;
   f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
@@ -4381,7 +5999,7 @@ diskio::load_auto_detect(Cube<eT>& x, const std::string& name, std::string& err_
   
   if(load_okay)
     {
-    load_okay = diskio::load_auto_detect(x, f, err_msg);
+    load_okay = diskio::load_ppm_binary(x, f, err_msg);
     f.close();
     }
   
@@ -4390,87 +6008,95 @@ diskio::load_auto_detect(Cube<eT>& x, const std::string& name, std::string& err_
 
 
 
-//! Try to load a cube by automatically determining its type
 template<typename eT>
 inline
 bool
-diskio::load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_ppm_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const char* ARMA_CUB_TXT_str = "ARMA_CUB_TXT";
-  const char* ARMA_CUB_BIN_str = "ARMA_CUB_BIN";
-  const char*           P6_str = "P6";
-  
-  const uword ARMA_CUB_TXT_len = uword(12);
-  const uword ARMA_CUB_BIN_len = uword(12);
-  const uword           P6_len = uword(2);
-  
-  podarray<char> header(ARMA_CUB_TXT_len + 1);
-  
-  char* header_mem = header.memptr();
-  
-  std::streampos pos = f.tellg();
+  bool load_okay = true;
   
-  f.read( header_mem, std::streamsize(ARMA_CUB_TXT_len) );
-  f.clear();
-  f.seekg(pos);
+  std::string f_header;
   
-  header_mem[ARMA_CUB_TXT_len] = '\0';
+  f >> f_header;
   
-  if( std::strncmp(ARMA_CUB_TXT_str, header_mem, size_t(ARMA_CUB_TXT_len)) == 0 )
-    {
-    return load_arma_ascii(x, f, err_msg);
-    }
-  else
-  if( std::strncmp(ARMA_CUB_BIN_str, header_mem, size_t(ARMA_CUB_BIN_len)) == 0 )
-    {
-    return load_arma_binary(x, f, err_msg);
-    }
-  else
-  if( std::strncmp(P6_str, header_mem, size_t(P6_len)) == 0 )
-    {
-    return load_ppm_binary(x, f, err_msg);
-    }
-  else
+  if(f_header == "P6")
     {
-    const file_type ft = guess_file_type_internal(f);
+    uword f_n_rows = 0;
+    uword f_n_cols = 0;
+    int f_maxval = 0;
     
-    switch(ft)
+    diskio::pnm_skip_comments(f);
+    
+    f >> f_n_cols;
+    diskio::pnm_skip_comments(f);
+    
+    f >> f_n_rows;
+    diskio::pnm_skip_comments(f);
+    
+    f >> f_maxval;
+    f.get();
+    
+    if( (f_maxval > 0) && (f_maxval <= 65535) )
       {
-      // case csv_ascii:
-      //   return load_csv_ascii(x, f, err_msg);
-      //   break;
+      try { x.set_size(f_n_rows, f_n_cols, 3); } catch(...) { err_msg = "not enough memory"; return false; }
       
-      case raw_binary:
-        return load_raw_binary(x, f, err_msg);
-        break;
+      const uword n_elem = 3*f_n_cols*f_n_rows;
+      
+      if(f_maxval <= 255)
+        {
+        podarray<u8> tmp(n_elem);
         
-      case raw_ascii:
-        return load_raw_ascii(x, f, err_msg);
-        break;
+        f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem) );
         
-      default:
-        err_msg = "unknown data";
-        return false;
+        if(f.good())
+          {
+          for(uword slice=0; slice < 3; ++slice)
+            {
+            diskio::convert_interleaved(x.slice_memptr(slice), tmp.memptr(), f_n_rows, f_n_cols, 3, slice, false, false);
+            }
+          }
+        }
+      else
+        {
+        // 16 bit data is stored in big-endian byte order
+        podarray<u16> tmp(n_elem);
+        
+        f.read( reinterpret_cast<char *>(tmp.memptr()), std::streamsize(2*n_elem) );
+        
+        if(f.good())
+          {
+          for(uword slice=0; slice < 3; ++slice)
+            {
+            diskio::convert_interleaved(x.slice_memptr(slice), tmp.memptr(), f_n_rows, f_n_cols, 3, slice, (diskio::is_big_endian() == false), false);
+            }
+          }
+        }
       }
+    else
+      {
+      load_okay = false;
+      err_msg = "functionality unimplemented";
+      }
+    
+    if(f.good() == false)  { load_okay = false; }
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "unsupported header";
     }
   
-  return false;
+  return load_okay;
   }
 
 
 
-
-
-// fields
-
-
-
-template<typename T1>
+template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const field<T1>& x, const std::string& final_name)
+diskio::save_ppm_binary(const Cube<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
@@ -4482,7 +6108,7 @@ diskio::save_arma_binary(const field<T1>& x, const std::string& final_name)
   
   if(save_okay)
     {
-    save_okay = diskio::save_arma_binary(x, f);
+    save_okay = diskio::save_ppm_binary(x, f);
     
     f.flush();
     f.close();
@@ -4495,57 +6121,92 @@ diskio::save_arma_binary(const field<T1>& x, const std::string& final_name)
 
 
 
-template<typename T1>
+template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const field<T1>& x, std::ostream& f)
+diskio::save_ppm_binary(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  arma_type_check(( (is_Mat<T1>::value == false) && (is_Cube<T1>::value == false) ));
+  arma_debug_check( (x.n_slices != 3), "diskio::save_ppm_binary(): given cube must have exactly 3 slices" );
   
-  if(x.n_slices <= 1)
-    {
-    f << "ARMA_FLD_BIN" << '\n';
-    f << x.n_rows       << '\n';
-    f << x.n_cols       << '\n';
-    }
-  else
+  const uword n_elem = 3 * x.n_rows * x.n_cols;
+  
+  if(is_u16<eT>::value)
     {
-    f << "ARMA_FL3_BIN" << '\n';
-    f << x.n_rows       << '\n';
-    f << x.n_cols       << '\n';
-    f << x.n_slices     << '\n';
+    // 16 bit data is stored in big-endian byte order
+    const bool swap = (diskio::is_big_endian() == false);
+    
+    podarray<u16> tmp(n_elem);
+    
+    uword i = 0;
+    for(uword row=0; row < x.n_rows; ++row)
+    for(uword col=0; col < x.n_cols; ++col)
+    for(uword slice=0; slice < 3; ++slice)
+      {
+      const u16 val = u16( access::tmp_real( x.at(row,col,slice) ) );
+      
+      tmp[i] = (swap) ? diskio::swap_bytes(val) : val;
+      ++i;
+      }
+    
+    f << "P6" << '\n';
+    f << x.n_cols << '\n';
+    f << x.n_rows << '\n';
+    f << 65535 << '\n';
+    
+    f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(2*n_elem) );
+    
+    return f.good();
     }
   
-  bool save_okay = true;
+  podarray<u8> tmp(n_elem);
   
-  for(uword i=0; i<x.n_elem; ++i)
+  uword i = 0;
+  for(uword row=0; row < x.n_rows; ++row)
     {
-    save_okay = diskio::save_arma_binary(x[i], f);
-    
-    if(save_okay == false)  { break; }
+    for(uword col=0; col < x.n_cols; ++col)
+      {
+      tmp[i+0] = u8( access::tmp_real( x.at(row,col,0) ) );
+      tmp[i+1] = u8( access::tmp_real( x.at(row,col,1) ) );
+      tmp[i+2] = u8( access::tmp_real( x.at(row,col,2) ) );
+      
+      i+=3;
+      }
     }
   
-  return save_okay;
+  f << "P6" << '\n';
+  f << x.n_cols << '\n';
+  f << x.n_rows << '\n';
+  f << 255 << '\n';
+  
+  f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem) );
+  
+  return f.good();
   }
 
 
 
+//
+// handling of PPM images by fields
+
+
+
 template<typename T1>
 inline
 bool
-diskio::load_arma_binary(field<T1>& x, const std::string& name, std::string& err_msg)
+diskio::load_ppm_binary(field<T1>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f( name.c_str(), std::fstream::binary );
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
   bool load_okay = f.is_open();
   
   if(load_okay)
     {
-    load_okay = diskio::load_arma_binary(x, f, err_msg);
+    load_okay = diskio::load_ppm_binary(x, f, err_msg);
     f.close();
     }
   
@@ -4557,72 +6218,190 @@ diskio::load_arma_binary(field<T1>& x, const std::string& name, std::string& err
 template<typename T1>
 inline
 bool
-diskio::load_arma_binary(field<T1>& x, std::istream& f, std::string& err_msg)
+diskio::load_ppm_binary(field<T1>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  arma_type_check(( (is_Mat<T1>::value == false) && (is_Cube<T1>::value == false) ));
+  arma_type_check(( is_Mat<T1>::value == false ));
+  typedef typename T1::elem_type eT;
   
   bool load_okay = true;
   
-  std::string f_type;
-  f >> f_type;
+  std::string f_header;
   
-  if(f_type == "ARMA_FLD_BIN")
+  f >> f_header;
+  
+  if(f_header == "P6")
     {
-    uword f_n_rows;
-    uword f_n_cols;
+    uword f_n_rows = 0;
+    uword f_n_cols = 0;
+    int f_maxval = 0;
+    
+    diskio::pnm_skip_comments(f);
     
-    f >> f_n_rows;
     f >> f_n_cols;
+    diskio::pnm_skip_comments(f);
     
-    try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    f >> f_n_rows;
+    diskio::pnm_skip_comments(f);
     
+    f >> f_maxval;
     f.get();
     
-    for(uword i=0; i<x.n_elem; ++i)
+    if( (f_maxval > 0) && (f_maxval <= 65535) )
       {
-      load_okay = diskio::load_arma_binary(x[i], f, err_msg);
+      x.set_size(3);
+      Mat<eT>& R = x(0);
+      Mat<eT>& G = x(1);
+      Mat<eT>& B = x(2);
       
-      if(load_okay == false)  { break; }
+      try { R.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+      try { G.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+      try { B.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+      
+      const uword n_elem = 3*f_n_cols*f_n_rows;
+      
+      if(f_maxval <= 255)
+        {
+        podarray<u8> tmp(n_elem);
+        
+        f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem) );
+        
+        if(f.good())
+          {
+          for(uword channel=0; channel < 3; ++channel)
+            {
+            diskio::convert_interleaved(x(channel).memptr(), tmp.memptr(), f_n_rows, f_n_cols, 3, channel, false, false);
+            }
+          }
+        }
+      else
+        {
+        // 16 bit data is stored in big-endian byte order
+        podarray<u16> tmp(n_elem);
+        
+        f.read( reinterpret_cast<char *>(tmp.memptr()), std::streamsize(2*n_elem) );
+        
+        if(f.good())
+          {
+          for(uword channel=0; channel < 3; ++channel)
+            {
+            diskio::convert_interleaved(x(channel).memptr(), tmp.memptr(), f_n_rows, f_n_cols, 3, channel, (diskio::is_big_endian() == false), false);
+            }
+          }
+        }
       }
+    else
+      {
+      load_okay = false;
+      err_msg = "functionality unimplemented";
+      }
+    
+    if(f.good() == false)  { load_okay = false; }
     }
   else
-  if(f_type == "ARMA_FL3_BIN")
     {
-    uword f_n_rows;
-    uword f_n_cols;
-    uword f_n_slices;
-    
-    f >> f_n_rows;
-    f >> f_n_cols;
-    f >> f_n_slices;
-    
-    try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
+    load_okay = false;
+    err_msg = "unsupported header";
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename T1>
+inline
+bool
+diskio::save_ppm_binary(const field<T1>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_ppm_binary(x, f);
     
-    f.get();
+    f.flush();
+    f.close();
     
-    for(uword i=0; i<x.n_elem; ++i)
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+template<typename T1>
+inline
+bool
+diskio::save_ppm_binary(const field<T1>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_type_check(( is_Mat<T1>::value == false ));
+  
+  typedef typename T1::elem_type eT;
+  
+  arma_debug_check( (x.n_elem != 3), "diskio::save_ppm_binary(): given field must have exactly 3 matrices of equal size" );
+  
+  bool same_size = true;
+  for(uword i=1; i<3; ++i)
+    {
+    if( (x(0).n_rows != x(i).n_rows) || (x(0).n_cols != x(i).n_cols) )
       {
-      load_okay = diskio::load_arma_binary(x[i], f, err_msg);
-      
-      if(load_okay == false)  { break; }
+      same_size = false;
+      break;
       }
     }
-  else
+  
+  arma_debug_check( (same_size != true), "diskio::save_ppm_binary(): given field must have exactly 3 matrices of equal size" );
+  
+  const Mat<eT>& R = x(0);
+  const Mat<eT>& G = x(1);
+  const Mat<eT>& B = x(2);
+  
+  f << "P6" << '\n';
+  f << R.n_cols << '\n';
+  f << R.n_rows << '\n';
+  f << 255 << '\n';
+
+  const uword n_elem = 3 * R.n_rows * R.n_cols;
+  podarray<u8> tmp(n_elem);
+
+  uword i = 0;
+  for(uword row=0; row < R.n_rows; ++row)
+  for(uword col=0; col < R.n_cols; ++col)
     {
-    load_okay = false;
-    err_msg = "unsupported field type";
+    tmp[i+0] = u8( access::tmp_real( R.at(row,col) ) );
+    tmp[i+1] = u8( access::tmp_real( G.at(row,col) ) );
+    tmp[i+2] = u8( access::tmp_real( B.at(row,col) ) );
+    
+    i+=3;
     }
   
-  return load_okay;
+  f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem) );
+  
+  return f.good();
   }
 
 
 
+//
+// handling of PFM images by matrices and cubes
+
+
+
+//! Save a matrix as a greyscale PFM image ("Pf"); rows are stored from the bottom of the image upwards
+template<typename eT>
 inline
 bool
-diskio::save_std_string(const field<std::string>& x, const std::string& final_name)
+diskio::save_pfm_binary(const Mat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
@@ -4634,7 +6413,7 @@ diskio::save_std_string(const field<std::string>& x, const std::string& final_na
   
   if(save_okay)
     {
-    save_okay = diskio::save_std_string(x, f);
+    save_okay = diskio::save_pfm_binary(x, f);
     
     f.flush();
     f.close();
@@ -4647,205 +6426,141 @@ diskio::save_std_string(const field<std::string>& x, const std::string& final_na
 
 
 
+//! Save a matrix as a greyscale PFM image ("Pf"); rows are stored from the bottom of the image upwards
+template<typename eT>
 inline
 bool
-diskio::save_std_string(const field<std::string>& x, std::ostream& f)
+diskio::save_pfm_binary(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  for(uword row=0; row<x.n_rows; ++row)
-  for(uword col=0; col<x.n_cols; ++col)
+  // a negative scale indicates little-endian data
+  f << "Pf" << '\n';
+  f << x.n_cols << ' ' << x.n_rows << '\n';
+  f << ( (diskio::is_big_endian()) ? "1.0" : "-1.0" ) << '\n';
+  
+  const uword n_elem = x.n_rows * x.n_cols;
+  podarray<float> tmp(n_elem);
+  
+  uword i = 0;
+  
+  for(uword row=x.n_rows; row > 0; --row)
+  for(uword col=0; col < x.n_cols; ++col)
     {
-    f << x.at(row,col);
-    
-    if(col < x.n_cols-1)
-      {
-      f << ' ';
-      }
-    else
-      {
-      f << '\n';
-      }
+    tmp[i] = float( access::tmp_real( x.at(row-1,col) ) );
+    ++i;
     }
   
+  f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem*sizeof(float)) );
+  
   return f.good();
   }
 
 
 
+//! Save a cube as a PFM image: a cube with 3 slices is stored as a colour image ("PF"),
+//! while a cube with 1 slice is stored as a greyscale image ("Pf")
+template<typename eT>
 inline
 bool
-diskio::load_std_string(field<std::string>& x, const std::string& name, std::string& err_msg)
+diskio::save_pfm_binary(const Cube<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
-  std::ifstream f( name.c_str() );
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  bool load_okay = f.is_open();
+  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
   
-  if(load_okay)
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
     {
-    load_okay = diskio::load_std_string(x, f, err_msg);
+    save_okay = diskio::save_pfm_binary(x, f);
+    
+    f.flush();
     f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return load_okay;
+  return save_okay;
   }
 
 
 
+template<typename eT>
 inline
 bool
-diskio::load_std_string(field<std::string>& x, std::istream& f, std::string& err_msg)
+diskio::save_pfm_binary(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  bool load_okay = true;
+  arma_debug_check( ((x.n_slices != 1) && (x.n_slices != 3)), "diskio::save_pfm_binary(): given cube must have exactly 1 or 3 slices" );
   
-  //
-  // work out the size
+  const uword n_channels = x.n_slices;
   
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
+  f << ( (n_channels == 3) ? "PF" : "Pf" ) << '\n';
+  f << x.n_cols << ' ' << x.n_rows << '\n';
+  f << ( (diskio::is_big_endian()) ? "1.0" : "-1.0" ) << '\n';
   
-  bool f_n_cols_found = false;
+  const uword n_elem = n_channels * x.n_rows * x.n_cols;
+  podarray<float> tmp(n_elem);
   
-  std::string line_string;
-  std::string token;
+  uword i = 0;
   
-  while( f.good() && load_okay )
-    {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    std::stringstream line_stream(line_string);
-    
-    uword line_n_cols = 0;
-    
-    while(line_stream >> token)  { line_n_cols++; }
-    
-    if(f_n_cols_found == false)
-      {
-      f_n_cols = line_n_cols;
-      f_n_cols_found = true;
-      }
-    else
-      {
-      if(line_n_cols != f_n_cols)
-        {
-        load_okay = false;
-        err_msg = "inconsistent number of columns";
-        }
-      }
-    
-    ++f_n_rows;
-    }
-    
-  if(load_okay)
+  for(uword row=x.n_rows; row > 0; --row)
+  for(uword col=0; col < x.n_cols; ++col)
+  for(uword slice=0; slice < n_channels; ++slice)
     {
-    f.clear();
-    f.seekg(0, ios::beg);
-    //f.seekg(start);
-    
-    try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-    
-    for(uword row=0; row < x.n_rows; ++row)
-    for(uword col=0; col < x.n_cols; ++col)
-      {
-      f >> x.at(row,col);
-      }
+    tmp[i] = float( access::tmp_real( x.at(row-1,col,slice) ) );
+    ++i;
     }
   
-  if(f.good() == false)  { load_okay = false; }
+  f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem*sizeof(float)) );
   
-  return load_okay;
+  return f.good();
   }
 
 
 
-//! Try to load a field by automatically determining its type
-template<typename T1>
+//! Read the header of a PFM image.
+//! The absolute value of the scale is ignored; a negative scale indicates little-endian data.
 inline
 bool
-diskio::load_auto_detect(field<T1>& x, const std::string& name, std::string& err_msg)
+diskio::load_pfm_header(std::istream& f, uword& n_rows, uword& n_cols, uword& n_channels, bool& swap, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
-  
-  bool load_okay = f.is_open();
-  
-  if(load_okay)
-    {
-    load_okay = diskio::load_auto_detect(x, f, err_msg);
-    f.close();
-    }
-  
-  return load_okay;
-  }
-
-
-
-//! Try to load a field by automatically determining its type
-template<typename T1>
-inline
-bool
-diskio::load_auto_detect(field<T1>& x, std::istream& f, std::string& err_msg)
-  {
-  arma_extra_debug_sigprint();
+  std::string f_header;
   
-  arma_type_check(( is_Mat<T1>::value == false ));
+  f >> f_header;
   
-  static const std::string ARMA_FLD_BIN = "ARMA_FLD_BIN";
-  static const std::string ARMA_FL3_BIN = "ARMA_FL3_BIN";
-  static const std::string           P6 = "P6";
+  if( (f_header != "Pf") && (f_header != "PF") )  { err_msg = "unsupported header"; return false; }
   
-  podarray<char> raw_header(uword(ARMA_FLD_BIN.length()) + 1);
+  n_channels = (f_header == "PF") ? uword(3) : uword(1);
   
-  std::streampos pos = f.tellg();
+  double f_scale = 0.0;
   
-  f.read( raw_header.memptr(), std::streamsize(ARMA_FLD_BIN.length()) );
+  f >> n_cols;
+  f >> n_rows;
+  f >> f_scale;
+  f.get();
   
-  f.clear();
-  f.seekg(pos);
+  if( (f.good() == false) || (f_scale == 0.0) )  { err_msg = "unsupported header"; return false; }
   
-  raw_header[uword(ARMA_FLD_BIN.length())] = '\0';
+  const bool data_is_big_endian = (f_scale > 0.0);
   
-  const std::string header = raw_header.mem;
+  swap = (data_is_big_endian != diskio::is_big_endian());
   
-  if(ARMA_FLD_BIN == header.substr(0, ARMA_FLD_BIN.length()))
-    {
-    return load_arma_binary(x, f, err_msg);
-    }
-  else
-  if(ARMA_FL3_BIN == header.substr(0, ARMA_FL3_BIN.length()))
-    {
-    return load_arma_binary(x, f, err_msg);
-    }
-  else
-  if(P6 == header.substr(0, P6.length()))
-    {
-    return load_ppm_binary(x, f, err_msg);
-    }
-  else
-    {
-    err_msg = "unsupported header";
-    return false;
-    }
+  return true;
   }
 
 
 
-//
-// handling of PPM images by cubes
-
-
 template<typename eT>
 inline
 bool
-diskio::load_ppm_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_pfm_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
@@ -4856,7 +6571,7 @@ diskio::load_ppm_binary(Cube<eT>& x, const std::string& name, std::string& err_m
   
   if(load_okay)
     {
-    load_okay = diskio::load_ppm_binary(x, f, err_msg);
+    load_okay = diskio::load_pfm_binary(x, f, err_msg);
     f.close();
     }
   
@@ -4865,95 +6580,35 @@ diskio::load_ppm_binary(Cube<eT>& x, const std::string& name, std::string& err_m
 
 
 
+//! Load a greyscale PFM image ("Pf") into a matrix
 template<typename eT>
 inline
 bool
-diskio::load_ppm_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_pfm_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  bool load_okay = true;
+  uword f_n_rows     = 0;
+  uword f_n_cols     = 0;
+  uword f_n_channels = 0;
+  bool  swap         = false;
   
-  std::string f_header;
+  if(diskio::load_pfm_header(f, f_n_rows, f_n_cols, f_n_channels, swap, err_msg) == false)  { return false; }
   
-  f >> f_header;
+  if(f_n_channels != 1)  { err_msg = "colour image can only be loaded into a cube"; return false; }
   
-  if(f_header == "P6")
-    {
-    uword f_n_rows = 0;
-    uword f_n_cols = 0;
-    int f_maxval = 0;
-    
-    diskio::pnm_skip_comments(f);
-    
-    f >> f_n_cols;
-    diskio::pnm_skip_comments(f);
-    
-    f >> f_n_rows;
-    diskio::pnm_skip_comments(f);
-    
-    f >> f_maxval;
-    f.get();
-    
-    if( (f_maxval > 0) && (f_maxval <= 65535) )
-      {
-      try { x.set_size(f_n_rows, f_n_cols, 3); } catch(...) { err_msg = "not enough memory"; return false; }
-      
-      if(f_maxval <= 255)
-        {
-        const uword n_elem = 3*f_n_cols*f_n_rows;
-        podarray<u8> tmp(n_elem);
-        
-        f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem) );
-        
-        uword i = 0;
-        
-        //cout << "f_n_cols = " << f_n_cols << endl;
-        //cout << "f_n_rows = " << f_n_rows << endl;
-        
-        for(uword row=0; row < f_n_rows; ++row)
-        for(uword col=0; col < f_n_cols; ++col)
-          {
-          x.at(row,col,0) = eT(tmp[i+0]);
-          x.at(row,col,1) = eT(tmp[i+1]);
-          x.at(row,col,2) = eT(tmp[i+2]);
-          i+=3;
-          }
-        }
-      else
-        {
-        const uword n_elem = 3*f_n_cols*f_n_rows;
-        podarray<u16> tmp(n_elem);
-        
-        f.read( reinterpret_cast<char *>(tmp.memptr()), std::streamsize(2*n_elem) );
-        
-        uword i = 0;
-        
-        for(uword row=0; row < f_n_rows; ++row)
-        for(uword col=0; col < f_n_cols; ++col)
-          {
-          x.at(row,col,0) = eT(tmp[i+0]);
-          x.at(row,col,1) = eT(tmp[i+1]);
-          x.at(row,col,2) = eT(tmp[i+2]);
-          i+=3;
-          }
-        }
-      }
-    else
-      {
-      load_okay = false;
-      err_msg = "functionality unimplemented";
-      }
-    
-    if(f.good() == false)  { load_okay = false; }
-    }
-  else
-    {
-    load_okay = false;
-    err_msg = "unsupported header";
-    }
+  try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  const uword n_elem = f_n_rows*f_n_cols;
+  podarray<float> tmp(n_elem);
   
-  return load_okay;
+  f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem*sizeof(float)) );
+  
+  if(f.good() == false)  { return false; }
+  
+  diskio::convert_interleaved(x.memptr(), tmp.memptr(), f_n_rows, f_n_cols, 1, 0, swap, true);
+  
+  return true;
   }
 
 
@@ -4961,281 +6616,301 @@ diskio::load_ppm_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
 template<typename eT>
 inline
 bool
-diskio::save_ppm_binary(const Cube<eT>& x, const std::string& final_name)
+diskio::load_pfm_binary(Cube<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
-  
-  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
   
-  bool save_okay = f.is_open();
+  bool load_okay = f.is_open();
   
-  if(save_okay)
+  if(load_okay)
     {
-    save_okay = diskio::save_ppm_binary(x, f);
-    
-    f.flush();
+    load_okay = diskio::load_pfm_binary(x, f, err_msg);
     f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
     }
   
-  return save_okay;
+  return load_okay;
   }
 
 
 
+//! Load a PFM image into a cube; colour images ("PF") have 3 slices, and greyscale images ("Pf") have 1 slice
 template<typename eT>
 inline
 bool
-diskio::save_ppm_binary(const Cube<eT>& x, std::ostream& f)
+diskio::load_pfm_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  arma_debug_check( (x.n_slices != 3), "diskio::save_ppm_binary(): given cube must have exactly 3 slices" );
+  uword f_n_rows     = 0;
+  uword f_n_cols     = 0;
+  uword f_n_channels = 0;
+  bool  swap         = false;
   
-  const uword n_elem = 3 * x.n_rows * x.n_cols;
-  podarray<u8> tmp(n_elem);
+  if(diskio::load_pfm_header(f, f_n_rows, f_n_cols, f_n_channels, swap, err_msg) == false)  { return false; }
   
-  uword i = 0;
-  for(uword row=0; row < x.n_rows; ++row)
-    {
-    for(uword col=0; col < x.n_cols; ++col)
-      {
-      tmp[i+0] = u8( access::tmp_real( x.at(row,col,0) ) );
-      tmp[i+1] = u8( access::tmp_real( x.at(row,col,1) ) );
-      tmp[i+2] = u8( access::tmp_real( x.at(row,col,2) ) );
-      
-      i+=3;
-      }
-    }
+  try { x.set_size(f_n_rows, f_n_cols, f_n_channels); } catch(...) { err_msg = "not enough memory"; return false; }
   
-  f << "P6" << '\n';
-  f << x.n_cols << '\n';
-  f << x.n_rows << '\n';
-  f << 255 << '\n';
+  const uword n_elem = f_n_channels*f_n_rows*f_n_cols;
+  podarray<float> tmp(n_elem);
   
-  f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem) );
+  f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem*sizeof(float)) );
   
-  return f.good();
+  if(f.good() == false)  { return false; }
+  
+  for(uword slice=0; slice < f_n_channels; ++slice)
+    {
+    diskio::convert_interleaved(x.slice_memptr(slice), tmp.memptr(), f_n_rows, f_n_cols, f_n_channels, slice, swap, true);
+    }
+  
+  return true;
   }
 
 
 
 //
-// handling of PPM images by fields
+// raw binary data with a known layout
 
 
 
-template<typename T1>
+//! Load raw binary data with a given size, byte offset, element type and byte order.
+//! The element type of the data can differ from the element type of the matrix.
+template<typename eT>
 inline
 bool
-diskio::load_ppm_binary(field<T1>& x, const std::string& name, std::string& err_msg)
+diskio::load_raw_binary(Mat<eT>& x, const raw_name& spec, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
+  const raw_opts::flag_type flags = spec.opts.flags;
   
-  bool load_okay = f.is_open();
+  const raw_opts::flag_type elem_flags = flags & raw_opts::flag_elem_mask;
   
-  if(load_okay)
+  // more than one element type given
+  if( (elem_flags & (elem_flags - 1)) != 0 )  { err_msg = "more than one element type specified"; return false; }
+  
+  const bool big_endian    = bool(flags & raw_opts::flag_big_endian   );
+  const bool little_endian = bool(flags & raw_opts::flag_little_endian);
+  const bool row_major     = bool(flags & raw_opts::flag_trans        );
+  
+  if(big_endian && little_endian)  { err_msg = "more than one byte order specified"; return false; }
+  
+  const bool swap = (big_endian && (diskio::is_big_endian() == false)) || (little_endian && diskio::is_big_endian());
+  
+  if( swap && (elem_flags == raw_opts::flag_none) && is_cx<eT>::yes )  { err_msg = "byte order conversion of complex elements not supported"; return false; }
+  
+  std::ifstream f;
+  f.open(spec.filename.c_str(), std::fstream::binary);
+  
+  if(f.is_open() == false)  { return false; }
+  
+  f.seekg( std::streamoff(spec.offset) );
+  
+  if(f.good() == false)  { err_msg = "offset beyond end of file"; return false; }
+  
+  const uword n_rows = spec.n_rows;
+  const uword n_cols = spec.n_cols;
+  
+  switch(elem_flags)
     {
-    load_okay = diskio::load_ppm_binary(x, f, err_msg);
-    f.close();
+    case raw_opts::flag_elem_u8:   return diskio::load_raw_typed<eT,    u8>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_s8:   return diskio::load_raw_typed<eT,    s8>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_u16:  return diskio::load_raw_typed<eT,   u16>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_s16:  return diskio::load_raw_typed<eT,   s16>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_u32:  return diskio::load_raw_typed<eT,   u32>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_s32:  return diskio::load_raw_typed<eT,   s32>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_u64:  return diskio::load_raw_typed<eT,   u64>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_s64:  return diskio::load_raw_typed<eT,   s64>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_f32:  return diskio::load_raw_typed<eT, float>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    case raw_opts::flag_elem_f64:  return diskio::load_raw_typed<eT,double>(x, f, n_rows, n_cols, swap, row_major, err_msg);
+    default:                       return diskio::load_raw_typed<eT,    eT>(x, f, n_rows, n_cols, swap, row_major, err_msg);
     }
-  
-  return load_okay;
   }
 
 
 
-template<typename T1>
+//! Read n_rows*n_cols elements of type in_eT from the stream with one bulk read, and convert them to eT.
+//! If no conversion is required, the data is read directly into the matrix.
+template<typename eT, typename in_eT>
 inline
 bool
-diskio::load_ppm_binary(field<T1>& x, std::istream& f, std::string& err_msg)
+diskio::load_raw_typed(Mat<eT>& x, std::istream& f, const uword n_rows, const uword n_cols, const bool swap, const bool row_major, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
-  arma_type_check(( is_Mat<T1>::value == false ));
-  typedef typename T1::elem_type eT;
-  
-  bool load_okay = true;
+  try { x.set_size(n_rows, n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
   
-  std::string f_header;
+  const uword n_elem = x.n_elem;
   
-  f >> f_header;
+  const std::streamsize n_bytes = std::streamsize(n_elem*sizeof(in_eT));
   
-  if(f_header == "P6")
+  if(is_same_type<eT,in_eT>::yes && (swap == false) && (row_major == false || n_rows == 1 || n_cols == 1))
     {
-    uword f_n_rows = 0;
-    uword f_n_cols = 0;
-    int f_maxval = 0;
-    
-    diskio::pnm_skip_comments(f);
-    
-    f >> f_n_cols;
-    diskio::pnm_skip_comments(f);
-    
-    f >> f_n_rows;
-    diskio::pnm_skip_comments(f);
-    
-    f >> f_maxval;
-    f.get();
+    f.read( reinterpret_cast<char*>(x.memptr()), n_bytes );
     
-    if( (f_maxval > 0) && (f_maxval <= 65535) )
-      {
-      x.set_size(3);
-      Mat<eT>& R = x(0);
-      Mat<eT>& G = x(1);
-      Mat<eT>& B = x(2);
-      
-      try { R.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-      try { G.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-      try { B.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-      
-      if(f_maxval <= 255)
-        {
-        const uword n_elem = 3*f_n_cols*f_n_rows;
-        podarray<u8> tmp(n_elem);
-        
-        f.read( reinterpret_cast<char*>(tmp.memptr()), std::streamsize(n_elem) );
-        
-        uword i = 0;
-        
-        //cout << "f_n_cols = " << f_n_cols << endl;
-        //cout << "f_n_rows = " << f_n_rows << endl;
-        
-        
-        for(uword row=0; row < f_n_rows; ++row)
-          {
-          for(uword col=0; col < f_n_cols; ++col)
-            {
-            R.at(row,col) = eT(tmp[i+0]);
-            G.at(row,col) = eT(tmp[i+1]);
-            B.at(row,col) = eT(tmp[i+2]);
-            i+=3;
-            }
-          
-          }
-        }
-      else
-        {
-        const uword n_elem = 3*f_n_cols*f_n_rows;
-        podarray<u16> tmp(n_elem);
-        
-        f.read( reinterpret_cast<char *>(tmp.memptr()), std::streamsize(2*n_elem) );
-        
-        uword i = 0;
-        
-        for(uword row=0; row < f_n_rows; ++row)
-        for(uword col=0; col < f_n_cols; ++col)
-          {
-          R.at(row,col) = eT(tmp[i+0]);
-          G.at(row,col) = eT(tmp[i+1]);
-          B.at(row,col) = eT(tmp[i+2]);
-          i+=3;
-          }
-        }
-      }
-    else
-      {
-      load_okay = false;
-      err_msg = "functionality unimplemented";
-      }
+    if(f.gcount() != n_bytes)  { err_msg = "not enough data"; return false; }
     
-    if(f.good() == false)  { load_okay = false; }
+    return true;
+    }
+  
+  podarray<in_eT> tmp(n_elem);
+  
+  f.read( reinterpret_cast<char*>(tmp.memptr()), n_bytes );
+  
+  if(f.gcount() != n_bytes)  { err_msg = "not enough data"; return false; }
+  
+  if(row_major)
+    {
+    diskio::convert_interleaved(x.memptr(), tmp.memptr(), n_rows, n_cols, 1, 0, swap, false);
     }
   else
     {
-    load_okay = false;
-    err_msg = "unsupported header";
+    diskio::convert_linear(x.memptr(), tmp.memptr(), n_elem, swap);
     }
   
-  return load_okay;
+  return true;
   }
 
 
 
-template<typename T1>
+//
+// bulk conversion of binary data
+
+
+
 inline
 bool
-diskio::save_ppm_binary(const field<T1>& x, const std::string& final_name)
+diskio::is_big_endian()
   {
-  arma_extra_debug_sigprint();
+  const u16 val = u16(1);
   
-  const std::string tmp_name = diskio::gen_tmp_name(final_name);
-  std::ofstream f( tmp_name.c_str(), std::fstream::binary );
+  unsigned char bytes[2];
   
-  bool save_okay = f.is_open();
+  std::memcpy(bytes, &val, 2);
   
-  if(save_okay)
-    {
-    save_okay = diskio::save_ppm_binary(x, f);
-    
-    f.flush();
-    f.close();
-    
-    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
-    }
+  return (bytes[0] == 0);
+  }
+
+
+
+//! Reverse the order of the bytes of the given value.
+//! The byte copies are recognised by compilers as byte swaps, and are vectorised within conversion loops.
+template<typename T>
+arma_inline
+T
+diskio::swap_bytes(const T val)
+  {
+  unsigned char in [sizeof(T)];
+  unsigned char out[sizeof(T)];
   
-  return save_okay;
+  std::memcpy(in, &val, sizeof(T));
+  
+  for(size_t k=0; k < sizeof(T); ++k)  { out[k] = in[sizeof(T)-1-k]; }
+  
+  T result;
+  
+  std::memcpy(&result, out, sizeof(T));
+  
+  return result;
   }
 
 
 
-template<typename T1>
+//! Convert N contiguous elements, optionally swapping the byte order of each element
+template<typename eT, typename in_eT>
 inline
-bool
-diskio::save_ppm_binary(const field<T1>& x, std::ostream& f)
+void
+diskio::convert_linear(eT* out_mem, const in_eT* in_mem, const uword N, const bool swap)
   {
   arma_extra_debug_sigprint();
   
-  arma_type_check(( is_Mat<T1>::value == false ));
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(N))
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword i=0; i < N; ++i)
+        {
+        out_mem[i] = eT( (swap) ? diskio::swap_bytes(in_mem[i]) : in_mem[i] );
+        }
+      
+      return;
+      }
+    }
+  #endif
   
-  typedef typename T1::elem_type eT;
+  if(swap)
+    {
+    for(uword i=0; i < N; ++i)  { out_mem[i] = eT( diskio::swap_bytes(in_mem[i]) ); }
+    }
+  else
+    {
+    for(uword i=0; i < N; ++i)  { out_mem[i] = eT( in_mem[i] ); }
+    }
+  }
+
+
+
+//! Convert one channel of row-major interleaved image data (as used by PGM, PPM and PFM images)
+//! into a column-major matrix of size n_rows x n_cols, optionally swapping the byte order of each element.
+//! With bottom_up, the first row of the data is the last row of the matrix (as used by PFM images).
+template<typename eT, typename in_eT>
+inline
+void
+diskio::convert_interleaved(eT* out_mem, const in_eT* in_mem, const uword n_rows, const uword n_cols, const uword n_channels, const uword channel, const bool swap, const bool bottom_up)
+  {
+  arma_extra_debug_sigprint();
   
-  arma_debug_check( (x.n_elem != 3), "diskio::save_ppm_binary(): given field must have exactly 3 matrices of equal size" );
+  const uword row_stride = n_cols * n_channels;
   
-  bool same_size = true;
-  for(uword i=1; i<3; ++i)
+  #if defined(ARMA_USE_OPENMP)
     {
-    if( (x(0).n_rows != x(i).n_rows) || (x(0).n_cols != x(i).n_cols) )
+    if(mp_gate<eT>::eval(n_rows*n_cols))
       {
-      same_size = false;
-      break;
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword col=0; col < n_cols; ++col)
+        {
+        eT* out_col = &(out_mem[col*n_rows]);
+        
+        const in_eT* in_col = &(in_mem[col*n_channels + channel]);
+        
+        for(uword row=0; row < n_rows; ++row)
+          {
+          const uword in_row = (bottom_up) ? (n_rows-1-row) : row;
+          
+          const in_eT val = in_col[in_row * row_stride];
+          
+          out_col[row] = eT( (swap) ? diskio::swap_bytes(val) : val );
+          }
+        }
+      
+      return;
       }
     }
+  #endif
   
-  arma_debug_check( (same_size != true), "diskio::save_ppm_binary(): given field must have exactly 3 matrices of equal size" );
-  
-  const Mat<eT>& R = x(0);
-  const Mat<eT>& G = x(1);
-  const Mat<eT>& B = x(2);
-  
-  f << "P6" << '\n';
-  f << R.n_cols << '\n';
-  f << R.n_rows << '\n';
-  f << 255 << '\n';
-
-  const uword n_elem = 3 * R.n_rows * R.n_cols;
-  podarray<u8> tmp(n_elem);
-
-  uword i = 0;
-  for(uword row=0; row < R.n_rows; ++row)
-  for(uword col=0; col < R.n_cols; ++col)
+  // process the data in the order it is stored in
+  for(uword in_row=0; in_row < n_rows; ++in_row)
     {
-    tmp[i+0] = u8( access::tmp_real( R.at(row,col) ) );
-    tmp[i+1] = u8( access::tmp_real( G.at(row,col) ) );
-    tmp[i+2] = u8( access::tmp_real( B.at(row,col) ) );
+    const uword row = (bottom_up) ? (n_rows-1-in_row) : in_row;
     
-    i+=3;
+    const in_eT* in_row_mem = &(in_mem[in_row * row_stride + channel]);
+    
+    if(swap)
+      {
+      for(uword col=0; col < n_cols; ++col)  { out_mem[col*n_rows + row] = eT( diskio::swap_bytes(in_row_mem[col*n_channels]) ); }
+      }
+    else
+      {
+      for(uword col=0; col < n_cols; ++col)  { out_mem[col*n_rows + row] = eT( in_row_mem[col*n_channels] ); }
+      }
     }
-  
-  f.write( reinterpret_cast<const char*>(tmp.mem), std::streamsize(n_elem) );
-  
-  return f.good();
   }
 
 
@@ -179,72 +179,115 @@
 
 
 
-#if defined(ARMA_USE_OPENMP)
-  
-  #define arma_applier_1_mp(operatorA, operatorB) \
+// the parallel appliers run on the user-provided executor if one is set, otherwise with OpenMP (see mp_task_runner);
+// the loop body is wrapped in a local mp_task, as the iteration space is split by the runner
+
+#define arma_applier_1_mp(operatorA, operatorB) \
+  {\
+  typedef typename std::decay<decltype(P1)>::type P1_type;\
+  typedef typename std::decay<decltype(P2)>::type P2_type;\
+  \
+  struct local_task : public mp_task\
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword i=0; i<n_elem; ++i)\
+          eT*      out_mem;\
+    const P1_type& P1;\
+    const P2_type& P2;\
+    \
+    inline local_task(eT* in_out_mem, const P1_type& in_P1, const P2_type& in_P2) : out_mem(in_out_mem), P1(in_P1), P2(in_P2) {}\
+    \
+    inline void run(const uword start, const uword endp1) const\
       {\
-      out_mem[i] operatorA P1[i] operatorB P2[i];\
+      for(uword i=start; i<endp1; ++i)\
+        {\
+        out_mem[i] operatorA P1[i] operatorB P2[i];\
+        }\
       }\
-    }
-  
-  #define arma_applier_2_mp(operatorA, operatorB) \
+    };\
+  \
+  mp_task_runner::run(n_elem, local_task(out_mem, P1, P2));\
+  }
+
+#define arma_applier_2_mp(operatorA, operatorB) \
+  {\
+  typedef typename std::decay<decltype(P1)>::type  P1_type;\
+  typedef typename std::decay<decltype(P2)>::type  P2_type;\
+  typedef typename std::decay<decltype(out)>::type out_type;\
+  \
+  struct local_task : public mp_task\
     {\
-    const int n_threads = mp_thread_limit::get();\
-    if(n_cols == 1)\
+          out_type& out;\
+          eT*       out_mem;\
+    const P1_type&  P1;\
+    const P2_type&  P2;\
+    const uword     n_rows;\
+    const uword     n_cols;\
+    \
+    inline local_task(out_type& in_out, eT* in_out_mem, const P1_type& in_P1, const P2_type& in_P2, const uword in_n_rows, const uword in_n_cols)\
+      : out(in_out), out_mem(in_out_mem), P1(in_P1), P2(in_P2), n_rows(in_n_rows), n_cols(in_n_cols) {}\
+    \
+    inline void run(const uword start, const uword endp1) const\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_rows; ++count)\
+      if(n_cols == 1)\
         {\
-        out_mem[count] operatorA P1.at(count,0) operatorB P2.at(count,0);\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA P1.at(count,0) operatorB P2.at(count,0);\
+          }\
         }\
-      }\
-    else\
-    if(n_rows == 1)\
-      {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_cols; ++count)\
+      else\
+      if(n_rows == 1)\
         {\
-        out_mem[count] operatorA P1.at(0,count) operatorB P2.at(0,count);\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA P1.at(0,count) operatorB P2.at(0,count);\
+          }\
         }\
-      }\
-    else\
-      {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword col=0; col<n_cols; ++col)\
+      else\
         {\
-        for(uword row=0; row<n_rows; ++row)\
+        for(uword col=start; col < endp1; ++col)\
+        for(uword row=0;     row < n_rows; ++row)\
           {\
           out.at(row,col) operatorA P1.at(row,col) operatorB P2.at(row,col);\
           }\
         }\
       }\
-    }
-  
-  #define arma_applier_3_mp(operatorA, operatorB) \
+    };\
+  \
+  mp_task_runner::run( ((n_cols == 1) ? n_rows : n_cols), local_task(out, out_mem, P1, P2, n_rows, n_cols) );\
+  }
+
+#define arma_applier_3_mp(operatorA, operatorB) \
+  {\
+  typedef typename std::decay<decltype(P1)>::type  P1_type;\
+  typedef typename std::decay<decltype(P2)>::type  P2_type;\
+  typedef typename std::decay<decltype(out)>::type out_type;\
+  \
+  struct local_task : public mp_task\
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword slice=0; slice<n_slices; ++slice)\
+          out_type& out;\
+    const P1_type&  P1;\
+    const P2_type&  P2;\
+    const uword     n_rows;\
+    const uword     n_cols;\
+    \
+    inline local_task(out_type& in_out, const P1_type& in_P1, const P2_type& in_P2, const uword in_n_rows, const uword in_n_cols)\
+      : out(in_out), P1(in_P1), P2(in_P2), n_rows(in_n_rows), n_cols(in_n_cols) {}\
+    \
+    inline void run(const uword start, const uword endp1) const\
       {\
-      for(uword col=0; col<n_cols; ++col)\
-      for(uword row=0; row<n_rows; ++row)\
+      for(uword slice=start; slice<endp1; ++slice)\
         {\
-        out.at(row,col,slice) operatorA P1.at(row,col,slice) operatorB P2.at(row,col,slice);\
+        for(uword col=0; col<n_cols; ++col)\
+        for(uword row=0; row<n_rows; ++row)\
+          {\
+          out.at(row,col,slice) operatorA P1.at(row,col,slice) operatorB P2.at(row,col,slice);\
+          }\
         }\
       }\
-    }
-  
-#else
-  
-  #define arma_applier_1_mp(operatorA, operatorB)  arma_applier_1u(operatorA, operatorB)
-  #define arma_applier_2_mp(operatorA, operatorB)  arma_applier_2(operatorA, operatorB)
-  #define arma_applier_3_mp(operatorA, operatorB)  arma_applier_3(operatorA, operatorB)
-  
-#endif
+    };\
+  \
+  mp_task_runner::run(n_slices, local_task(out, P1, P2, n_rows, n_cols));\
+  }
 
 
 
@@ -261,11 +304,12 @@ void
 eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
   {
   arma_extra_debug_sigprint();
+  arma_extra_debug_plan(eGlue<T1, T2, eglue_type>);
   
   typedef typename T1::elem_type eT;
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp);
   
   // NOTE: we're assuming that the matrix has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Mat contructor or operator=()
@@ -277,7 +321,7 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -334,7 +378,7 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(=, -); }
@@ -372,13 +416,13 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -432,7 +476,7 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(+=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(+=, -); }
@@ -470,13 +514,13 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -530,7 +574,7 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(-=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(-=, -); }
@@ -568,13 +612,13 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -628,7 +672,7 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(*=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(*=, -); }
@@ -666,13 +710,13 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -726,7 +770,7 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(/=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(/=, -); }
@@ -758,11 +802,12 @@ void
 eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube<T1, T2, eglue_type>& x)
   {
   arma_extra_debug_sigprint();
+  arma_extra_debug_plan(eGlueCube<T1, T2, eglue_type>);
   
   typedef typename T1::elem_type eT;
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp);
   
   // NOTE: we're assuming that the cube has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Cube contructor or operator=()
@@ -774,7 +819,7 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -832,7 +877,7 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(=, -); }
@@ -871,13 +916,13 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -931,7 +976,7 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(+=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(+=, -); }
@@ -970,13 +1015,13 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1030,7 +1075,7 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(-=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(-=, -); }
@@ -1069,13 +1114,13 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1129,7 +1174,7 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(*=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(*=, -); }
@@ -1168,13 +1213,13 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp);
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1228,7 +1273,7 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval_task(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(/=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(/=, -); }
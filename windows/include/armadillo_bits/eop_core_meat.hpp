@@ -165,72 +165,112 @@
 
 
 
-#if defined(ARMA_USE_OPENMP)
-  
-  #define arma_applier_1_mp(operatorA) \
+// the parallel appliers run on the user-provided executor if one is set, otherwise with OpenMP (see mp_task_runner);
+// the loop body is wrapped in a local mp_task, as the iteration space is split by the runner
+
+#define arma_applier_1_mp(operatorA) \
+  {\
+  typedef typename std::decay<decltype(P)>::type P_type;\
+  \
+  struct local_task : public mp_task\
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword i=0; i<n_elem; ++i)\
+          eT*     out_mem;\
+    const P_type& P;\
+    const eT      k;\
+    \
+    inline local_task(eT* in_out_mem, const P_type& in_P, const eT in_k) : out_mem(in_out_mem), P(in_P), k(in_k) {}\
+    \
+    inline void run(const uword start, const uword endp1) const\
       {\
-      out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);\
+      for(uword i=start; i<endp1; ++i)\
+        {\
+        out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);\
+        }\
       }\
-    }
-  
-  #define arma_applier_2_mp(operatorA) \
+    };\
+  \
+  mp_task_runner::run(n_elem, local_task(out_mem, P, k));\
+  }
+
+#define arma_applier_2_mp(operatorA) \
+  {\
+  typedef typename std::decay<decltype(P)>::type   P_type;\
+  typedef typename std::decay<decltype(out)>::type out_type;\
+  \
+  struct local_task : public mp_task\
     {\
-    const int n_threads = mp_thread_limit::get();\
-    if(n_cols == 1)\
+          out_type& out;\
+          eT*       out_mem;\
+    const P_type&   P;\
+    const eT        k;\
+    const uword     n_rows;\
+    const uword     n_cols;\
+    \
+    inline local_task(out_type& in_out, eT* in_out_mem, const P_type& in_P, const eT in_k, const uword in_n_rows, const uword in_n_cols)\
+      : out(in_out), out_mem(in_out_mem), P(in_P), k(in_k), n_rows(in_n_rows), n_cols(in_n_cols) {}\
+    \
+    inline void run(const uword start, const uword endp1) const\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_rows; ++count)\
+      if(n_cols == 1)\
         {\
-        out_mem[count] operatorA eop_core<eop_type>::process(P.at(count,0), k);\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA eop_core<eop_type>::process(P.at(count,0), k);\
+          }\
         }\
-      }\
-    else\
-    if(n_rows == 1)\
-      {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_cols; ++count)\
+      else\
+      if(n_rows == 1)\
         {\
-        out_mem[count] operatorA eop_core<eop_type>::process(P.at(0,count), k);\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA eop_core<eop_type>::process(P.at(0,count), k);\
+          }\
         }\
-      }\
-    else\
-      {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword col=0; col < n_cols; ++col)\
+      else\
         {\
-        for(uword row=0; row < n_rows; ++row)\
+        for(uword col=start; col < endp1; ++col)\
+        for(uword row=0;     row < n_rows; ++row)\
           {\
           out.at(row,col) operatorA eop_core<eop_type>::process(P.at(row,col), k);\
           }\
         }\
       }\
-    }
-  
-  #define arma_applier_3_mp(operatorA) \
+    };\
+  \
+  mp_task_runner::run( ((n_cols == 1) ? n_rows : n_cols), local_task(out, out_mem, P, k, n_rows, n_cols) );\
+  }
+
+#define arma_applier_3_mp(operatorA) \
+  {\
+  typedef typename std::decay<decltype(P)>::type   P_type;\
+  typedef typename std::decay<decltype(out)>::type out_type;\
+  \
+  struct local_task : public mp_task\
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword slice=0; slice<n_slices; ++slice)\
+          out_type& out;\
+    const P_type&   P;\
+    const eT        k;\
+    const uword     n_rows;\
+    const uword     n_cols;\
+    \
+    inline local_task(out_type& in_out, const P_type& in_P, const eT in_k, const uword in_n_rows, const uword in_n_cols)\
+      : out(in_out), P(in_P), k(in_k), n_rows(in_n_rows), n_cols(in_n_cols) {}\
+    \
+    inline void run(const uword start, const uword endp1) const\
       {\
-      for(uword col=0; col<n_cols; ++col)\
-      for(uword row=0; row<n_rows; ++row)\
+      for(uword slice=start; slice<endp1; ++slice)\
         {\
-        out.at(row,col,slice) operatorA eop_core<eop_type>::process(P.at(row,col,slice), k);\
+        for(uword col=0; col<n_cols; ++col)\
+        for(uword row=0; row<n_rows; ++row)\
+          {\
+          out.at(row,col,slice) operatorA eop_core<eop_type>::process(P.at(row,col,slice), k);\
+          }\
         }\
       }\
-    }
-
-#else
-  
-  #define arma_applier_1_mp(operatorA)  arma_applier_1u(operatorA)
-  #define arma_applier_2_mp(operatorA)  arma_applier_2(operatorA)
-  #define arma_applier_3_mp(operatorA)  arma_applier_3(operatorA)
-
-#endif
+    };\
+  \
+  mp_task_runner::run(n_slices, local_task(out, P, k, n_rows, n_cols));\
+  }
 
 
 
@@ -247,6 +287,7 @@ void
 eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
   {
   arma_extra_debug_sigprint();
+  arma_extra_debug_plan(eOp<T1, eop_type>);
   
   typedef typename T1::elem_type eT;
   
@@ -256,13 +297,13 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -302,7 +343,7 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
     
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_2_mp(=);
       }
@@ -334,13 +375,13 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -377,7 +418,7 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_2_mp(+=);
       }
@@ -409,13 +450,13 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -452,7 +493,7 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_2_mp(-=);
       }
@@ -484,13 +525,13 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -527,7 +568,7 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_2_mp(*=);
       }
@@ -559,13 +600,13 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -602,7 +643,7 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_2_mp(/=);
       }
@@ -628,6 +669,7 @@ void
 eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, eop_type>& x)
   {
   arma_extra_debug_sigprint();
+  arma_extra_debug_plan(eOpCube<T1, eop_type>);
   
   typedef typename T1::elem_type eT;
   
@@ -637,13 +679,13 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -684,7 +726,7 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
     
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_3_mp(=);
       }
@@ -717,13 +759,13 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -760,7 +802,7 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_3_mp(+=);
       }
@@ -793,13 +835,13 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
       
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -836,7 +878,7 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_3_mp(-=);
       }
@@ -869,13 +911,13 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -912,7 +954,7 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_3_mp(*=);
       }
@@ -945,13 +987,13 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval_task(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -988,7 +1030,7 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval_task(x.get_n_elem()))
       {
       arma_applier_3_mp(/=);
       }
@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup expr_plan
+//! @{
+
+
+// Describes how a delayed expression is evaluated.
+// Element-wise nodes (including clamp() and operations on mixed element types)
+// are fused into the single loop of the outermost element-wise node;
+// all other nodes (eg. matrix multiplication, solve, reductions) are barriers,
+// which are materialised into temporaries before the loop runs.
+// The plan is printed by eop_core and eglue_core when ARMA_EXTRA_DEBUG is defined.
+
+
+struct expr_plan_aux
+  {
+  template<typename T>
+  inline
+  static
+  std::string
+  name()
+    {
+    const std::string sig(ARMA_FNSIG);
+    
+    std::string out = sig;
+    
+    const std::string::size_type start = sig.find("T = ");
+    
+    if(start != std::string::npos)
+      {
+      const std::string::size_type endp1 = sig.find_first_of(";]", start);
+      
+      out = sig.substr(start + 4, (endp1 == std::string::npos) ? std::string::npos : (endp1 - start - 4));
+      }
+    
+    std::string::size_type pos;
+    
+    while( (pos = out.find("arma::")) != std::string::npos )  { out.erase(pos, 6); }
+    
+    return out;
+    }
+  
+  
+  inline
+  static
+  void
+  print_node(std::ostream& o, const uword depth, const char* label, const std::string& name)
+    {
+    o << "@ ";
+    
+    for(uword i=0; i < depth; ++i)  { o << "  "; }
+    
+    o << label << "  " << name << '\n';
+    }
+  };
+
+
+
+template<typename T1, bool is_cube = is_arma_cube_type<T1>::value>
+struct expr_plan_status
+  {
+  static constexpr bool is_operand   = is_Mat<T1>::value;
+  static constexpr bool materialised = (is_operand == false) && is_Mat<typename Proxy<T1>::stored_type>::value;
+  
+  inline static const char* label() { return is_operand ? "operand    " : (materialised ? "materialise" : "fused      "); }
+  };
+
+
+
+template<typename T1>
+struct expr_plan_status<T1, true>
+  {
+  static constexpr bool is_operand   = is_Cube<T1>::value;
+  static constexpr bool materialised = (is_operand == false) && is_Cube<typename ProxyCube<T1>::stored_type>::value;
+  
+  inline static const char* label() { return is_operand ? "operand    " : (materialised ? "materialise" : "fused      "); }
+  };
+
+
+
+//! leaf nodes: objects, subviews and generators
+template<typename T1>
+struct expr_plan
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status<T1>::label(), expr_plan_aux::name<T1>());
+    }
+  };
+
+
+
+template<typename T1, typename eop_type>
+struct expr_plan< eOp<T1, eop_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, "fused      ", expr_plan_aux::name<eop_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename T2, typename eglue_type>
+struct expr_plan< eGlue<T1, T2, eglue_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, "fused      ", expr_plan_aux::name<eglue_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    expr_plan<T2>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename op_type>
+struct expr_plan< Op<T1, op_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< Op<T1, op_type> >::label(), expr_plan_aux::name<op_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename T2, typename glue_type>
+struct expr_plan< Glue<T1, T2, glue_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< Glue<T1, T2, glue_type> >::label(), expr_plan_aux::name<glue_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    expr_plan<T2>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename out_eT, typename T1, typename op_type>
+struct expr_plan< mtOp<out_eT, T1, op_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< mtOp<out_eT, T1, op_type> >::label(), expr_plan_aux::name<op_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2, typename glue_type>
+struct expr_plan< mtGlue<out_eT, T1, T2, glue_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< mtGlue<out_eT, T1, T2, glue_type> >::label(), expr_plan_aux::name<glue_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    expr_plan<T2>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename eop_type>
+struct expr_plan< eOpCube<T1, eop_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, "fused      ", expr_plan_aux::name<eop_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename T2, typename eglue_type>
+struct expr_plan< eGlueCube<T1, T2, eglue_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, "fused      ", expr_plan_aux::name<eglue_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    expr_plan<T2>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename op_type>
+struct expr_plan< OpCube<T1, op_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< OpCube<T1, op_type> >::label(), expr_plan_aux::name<op_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename T1, typename T2, typename glue_type>
+struct expr_plan< GlueCube<T1, T2, glue_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< GlueCube<T1, T2, glue_type> >::label(), expr_plan_aux::name<glue_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    expr_plan<T2>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename out_eT, typename T1, typename op_type>
+struct expr_plan< mtOpCube<out_eT, T1, op_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< mtOpCube<out_eT, T1, op_type> >::label(), expr_plan_aux::name<op_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    }
+  };
+
+
+
+template<typename out_eT, typename T1, typename T2, typename glue_type>
+struct expr_plan< mtGlueCube<out_eT, T1, T2, glue_type> >
+  {
+  inline static void print(std::ostream& o, const uword depth = 0)
+    {
+    expr_plan_aux::print_node(o, depth, expr_plan_status< mtGlueCube<out_eT, T1, T2, glue_type> >::label(), expr_plan_aux::name<glue_type>());
+    
+    expr_plan<T1>::print(o, depth+1);
+    expr_plan<T2>::print(o, depth+1);
+    }
+  };
+
+
+
+//! @}
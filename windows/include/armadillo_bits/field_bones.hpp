@@ -223,6 +223,8 @@ class field
   inline arma_cold bool quiet_load(const std::string   name, const file_type type = auto_detect);
   inline arma_cold bool quiet_load(      std::istream& is,   const file_type type = auto_detect);
   
+  inline arma_cold bool load_elem(const std::string name, const uword index);
+  
   
   // for container-like functionality
   
@@ -351,6 +353,12 @@ class field_aux
   inline static bool load(      field< std::string >& x, const std::string&  name, const file_type type, std::string& err_msg);
   inline static bool load(      field< std::string >& x,       std::istream& is,   const file_type type, std::string& err_msg);
   
+  template<typename oT> inline static bool load_elem(field< oT       >& x, const std::string& name, const uword index, std::string& err_msg);
+  template<typename eT> inline static bool load_elem(field< Mat<eT>  >& x, const std::string& name, const uword index, std::string& err_msg);
+  template<typename eT> inline static bool load_elem(field< Col<eT>  >& x, const std::string& name, const uword index, std::string& err_msg);
+  template<typename eT> inline static bool load_elem(field< Row<eT>  >& x, const std::string& name, const uword index, std::string& err_msg);
+  template<typename eT> inline static bool load_elem(field< Cube<eT> >& x, const std::string& name, const uword index, std::string& err_msg);
+  
   };
 
 
@@ -1985,6 +1985,37 @@ field<oT>::quiet_load(std::istream& is, const file_type type)
 
 
 
+//! load only the element at the given linear index from a field saved in arma_binary_indexed format;
+//! the field is resized to match the file if required, and the other elements are not read
+template<typename oT>
+inline
+arma_cold
+bool
+field<oT>::load_elem(const std::string name, const uword index)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::string err_msg;
+  
+  const bool load_okay = field_aux::load_elem(*this, name, index, err_msg);
+  
+  if(load_okay == false)
+    {
+    if(err_msg.length() > 0)
+      {
+      arma_debug_warn_level(3, "field::load_elem(): ", err_msg, "; file: ", name);
+      }
+    else
+      {
+      arma_debug_warn_level(3, "field::load_elem(): couldn't read; file: ", name);
+      }
+    }
+  
+  return load_okay;
+  }
+
+
+
 //! construct a field from a given field
 template<typename oT>
 inline
@@ -2567,6 +2598,10 @@ field_aux::save(const field< Mat<eT> >& x, const std::string& name, const file_t
       return diskio::save_ppm_binary(x, name);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, name);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2592,6 +2627,10 @@ field_aux::save(const field< Mat<eT> >& x, std::ostream& os, const file_type typ
       return diskio::save_ppm_binary(x, os);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, os);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2621,6 +2660,10 @@ field_aux::load(field< Mat<eT> >& x, const std::string& name, const file_type ty
       return diskio::load_ppm_binary(x, name, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, name, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2650,6 +2693,10 @@ field_aux::load(field< Mat<eT> >& x, std::istream& is, const file_type type, std
       return diskio::load_ppm_binary(x, is, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, is, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2675,6 +2722,10 @@ field_aux::save(const field< Col<eT> >& x, const std::string& name, const file_t
       return diskio::save_ppm_binary(x, name);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, name);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2700,6 +2751,10 @@ field_aux::save(const field< Col<eT> >& x, std::ostream& os, const file_type typ
       return diskio::save_ppm_binary(x, os);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, os);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2729,6 +2784,10 @@ field_aux::load(field< Col<eT> >& x, const std::string& name, const file_type ty
       return diskio::load_ppm_binary(x, name, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, name, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2758,6 +2817,10 @@ field_aux::load(field< Col<eT> >& x, std::istream& is, const file_type type, std
       return diskio::load_ppm_binary(x, is, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, is, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2783,6 +2846,10 @@ field_aux::save(const field< Row<eT> >& x, const std::string& name, const file_t
       return diskio::save_ppm_binary(x, name);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, name);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2808,6 +2875,10 @@ field_aux::save(const field< Row<eT> >& x, std::ostream& os, const file_type typ
       return diskio::save_ppm_binary(x, os);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, os);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2837,6 +2908,10 @@ field_aux::load(field< Row<eT> >& x, const std::string& name, const file_type ty
       return diskio::load_ppm_binary(x, name, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, name, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2866,6 +2941,10 @@ field_aux::load(field< Row<eT> >& x, std::istream& is, const file_type type, std
       return diskio::load_ppm_binary(x, is, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, is, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2887,6 +2966,10 @@ field_aux::save(const field< Cube<eT> >& x, const std::string& name, const file_
       return diskio::save_arma_binary(x, name);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, name);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2908,6 +2991,10 @@ field_aux::save(const field< Cube<eT> >& x, std::ostream& os, const file_type ty
       return diskio::save_arma_binary(x, os);
       break;
     
+    case arma_binary_indexed:
+      return diskio::save_arma_binary_indexed(x, os);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2930,6 +3017,10 @@ field_aux::load(field< Cube<eT> >& x, const std::string& name, const file_type t
       return diskio::load_arma_binary(x, name, err_msg);
       break;
     
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, name, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -2948,10 +3039,17 @@ field_aux::load(field< Cube<eT> >& x, std::istream& is, const file_type type, st
   switch(type)
     {
     case auto_detect:
+      return (diskio::is_arma_binary_indexed(is)) ? diskio::load_arma_binary_indexed(x, is, err_msg) : diskio::load_arma_binary(x, is, err_msg);
+      break;
+    
     case arma_binary:
       return diskio::load_arma_binary(x, is, err_msg);
       break;
       
+    case arma_binary_indexed:
+      return diskio::load_arma_binary_indexed(x, is, err_msg);
+      break;
+    
     default:
       err_msg = "unsupported type";
       return false;
@@ -3016,6 +3114,68 @@ field_aux::load(field< std::string >& x, std::istream& is, const file_type type,
 
 
 
+template<typename oT>
+inline
+bool
+field_aux::load_elem(field<oT>&, const std::string&, const uword, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  err_msg = "loading individual elements of this type of field is currently not supported";
+  
+  return false;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+field_aux::load_elem(field< Mat<eT> >& x, const std::string& name, const uword index, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return diskio::load_arma_binary_indexed_elem(x, index, name, err_msg);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+field_aux::load_elem(field< Col<eT> >& x, const std::string& name, const uword index, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return diskio::load_arma_binary_indexed_elem(x, index, name, err_msg);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+field_aux::load_elem(field< Row<eT> >& x, const std::string& name, const uword index, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return diskio::load_arma_binary_indexed_elem(x, index, name, err_msg);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+field_aux::load_elem(field< Cube<eT> >& x, const std::string& name, const uword index, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return diskio::load_arma_binary_indexed_elem(x, index, name, err_msg);
+  }
+
+
+
 #if defined(ARMA_EXTRA_FIELD_MEAT)
   #include ARMA_INCFILE_WRAP(ARMA_EXTRA_FIELD_MEAT)
 #endif
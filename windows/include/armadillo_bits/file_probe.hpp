@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup diskio
+//! @{
+
+
+//! description of a saved object, as obtained by probe() from the header of a file (without reading the data)
+struct file_probe
+  {
+  file_type   type;        //!< detected file type; file_type_unknown if the file could not be read or recognised
+  std::string elem_type;   //!< element type stored in the file (eg. "double", "u8", "cx_float"); empty if not recorded in the file
+  uword       elem_size;   //!< size of each element in bytes; 0 if not recorded in the file
+  uword       n_rows;
+  uword       n_cols;
+  uword       n_slices;    //!< number of slices for cubes and PPM images; 1 for matrices
+  uword       n_nonzero;   //!< number of non-zero elements for sparse matrices; 0 otherwise
+  bool        is_sparse;
+  bool        size_exact;  //!< false if n_rows was estimated from a sample of the file (text formats only)
+  u64         offset;      //!< byte offset of the data from the start of the file
+  u64         file_size;   //!< size of the file in bytes
+  
+  inline
+  file_probe()
+    : type      (file_type_unknown)
+    , elem_size (0    )
+    , n_rows    (0    )
+    , n_cols    (0    )
+    , n_slices  (0    )
+    , n_nonzero (0    )
+    , is_sparse (false)
+    , size_exact(false)
+    , offset    (0    )
+    , file_size (0    )
+    {}
+  };
+
+
+//! @}
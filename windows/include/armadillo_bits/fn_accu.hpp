@@ -21,6 +21,131 @@
 
 
 
+//! sums of n_parts contiguous chunks of linear elements, one sum per part
+template<typename ea_type, typename eT>
+struct accu_mp_linear_task : public mp_task
+  {
+  const ea_type& Pea;
+  const uword    chunk_size;
+        eT*      part_accs;
+  
+  inline accu_mp_linear_task(const ea_type& in_Pea, const uword in_chunk_size, eT* in_part_accs)
+    : Pea(in_Pea), chunk_size(in_chunk_size), part_accs(in_part_accs) {}
+  
+  inline
+  void
+  run(const uword start, const uword endp1) const
+    {
+    for(uword part=start; part < endp1; ++part)
+      {
+      const uword i_start = (part+0) * chunk_size;
+      const uword i_endp1 = (part+1) * chunk_size;
+      
+      eT acc = eT(0);
+      for(uword i=i_start; i < i_endp1; ++i)  { acc += Pea[i]; }
+      
+      part_accs[part] = acc;
+      }
+    }
+  };
+
+
+
+//! as per accu_mp_linear_task, but using P.at(); for a column or row vector each part is a contiguous chunk,
+//! otherwise each part is one column
+template<typename T1>
+struct accu_mp_at_task : public mp_task
+  {
+  typedef typename T1::elem_type eT;
+  
+  const Proxy<T1>& P;
+  const uword      chunk_size;
+        eT*        part_accs;
+  
+  inline accu_mp_at_task(const Proxy<T1>& in_P, const uword in_chunk_size, eT* in_part_accs)
+    : P(in_P), chunk_size(in_chunk_size), part_accs(in_part_accs) {}
+  
+  inline
+  void
+  run(const uword start, const uword endp1) const
+    {
+    const uword n_rows = P.get_n_rows();
+    const uword n_cols = P.get_n_cols();
+    
+    for(uword part=start; part < endp1; ++part)
+      {
+      if( (n_cols == 1) || (n_rows == 1) )
+        {
+        const uword i_start = (part+0) * chunk_size;
+        const uword i_endp1 = (part+1) * chunk_size;
+        
+        eT acc = eT(0);
+        
+        if(n_cols == 1)  { for(uword i=i_start; i < i_endp1; ++i)  { acc += P.at(i,0); } }
+        else             { for(uword i=i_start; i < i_endp1; ++i)  { acc += P.at(0,i); } }
+        
+        part_accs[part] = acc;
+        }
+      else
+        {
+        const uword col = part;
+        
+        eT val1 = eT(0);
+        eT val2 = eT(0);
+        
+        uword i,j;
+        for(i=0, j=1; j < n_rows; i+=2, j+=2)  { val1 += P.at(i,col); val2 += P.at(j,col); }
+        
+        if(i < n_rows)  { val1 += P.at(i,col); }
+        
+        part_accs[part] = val1 + val2;
+        }
+      }
+    }
+  };
+
+
+
+//! sums of slices, one sum per slice
+template<typename T1>
+struct accu_mp_cube_at_task : public mp_task
+  {
+  typedef typename T1::elem_type eT;
+  
+  const ProxyCube<T1>& P;
+        eT*            slice_accs;
+  
+  inline accu_mp_cube_at_task(const ProxyCube<T1>& in_P, eT* in_slice_accs)
+    : P(in_P), slice_accs(in_slice_accs) {}
+  
+  inline
+  void
+  run(const uword start, const uword endp1) const
+    {
+    const uword n_rows = P.get_n_rows();
+    const uword n_cols = P.get_n_cols();
+    
+    for(uword slice=start; slice < endp1; ++slice)
+      {
+      eT val1 = eT(0);
+      eT val2 = eT(0);
+      
+      for(uword col = 0; col < n_cols; ++col)
+        {
+        uword i,j;
+        for(i=0, j=1; j<n_rows; i+=2, j+=2)  { val1 += P.at(i,col,slice);  val2 += P.at(j,col,slice); }
+        
+        if(i < n_rows)  { val1 += P.at(i,col,slice); }
+        }
+      
+      slice_accs[slice] = val1 + val2;
+      }
+    }
+  };
+
+
+
+
 template<typename T1>
 arma_hot
 inline
@@ -37,36 +162,22 @@ accu_proxy_linear(const Proxy<T1>& P)
   
   const uword n_elem = P.get_n_elem();
   
-  if( arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(n_elem) )
+  if( Proxy<T1>::use_mp && mp_gate<eT>::eval_task(n_elem) )
     {
-    #if defined(ARMA_USE_OPENMP)
-      {
-      // NOTE: using parallelisation with manual reduction workaround to take into account complex numbers;
-      // NOTE: OpenMP versions lower than 4.0 do not support user-defined reduction
-      
-      const int   n_threads_max = mp_thread_limit::get();
-      const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
-      const uword chunk_size    = n_elem / n_threads_use;
-      
-      podarray<eT> partial_accs(n_threads_use);
-      
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
-        {
-        const uword start = (thread_id+0) * chunk_size;
-        const uword endp1 = (thread_id+1) * chunk_size;
-        
-        eT acc = eT(0);
-        for(uword i=start; i < endp1; ++i)  { acc += Pea[i]; }
-        
-        partial_accs[thread_id] = acc;
-        }
-      
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
-      
-      for(uword i=(n_threads_use*chunk_size); i < n_elem; ++i)  { val += Pea[i]; }
-      }
-    #endif
+    // NOTE: using parallelisation with manual reduction to take into account complex numbers,
+    // NOTE: and to obtain the same result regardless of how the executor schedules the parts
+    
+    const int   n_threads_max = mp_thread_limit::get();
+    const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
+    const uword chunk_size    = n_elem / n_threads_use;
+    
+    podarray<eT> partial_accs(n_threads_use);
+    
+    mp_task_runner::run(n_threads_use, accu_mp_linear_task<typename Proxy<T1>::ea_type, eT>(Pea, chunk_size, partial_accs.memptr()));
+    
+    for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
+    
+    for(uword i=(n_threads_use*chunk_size); i < n_elem; ++i)  { val += Pea[i]; }
     }
   else
     {
@@ -115,88 +226,34 @@ accu_proxy_at_mp(const Proxy<T1>& P)
   
   eT val = eT(0);
   
-  #if defined(ARMA_USE_OPENMP)
+  const uword n_rows = P.get_n_rows();
+  const uword n_cols = P.get_n_cols();
+  
+  if( (n_cols == 1) || (n_rows == 1) )
     {
-    const uword n_rows = P.get_n_rows();
-    const uword n_cols = P.get_n_cols();
+    const uword n_elem = (n_cols == 1) ? n_rows : n_cols;
     
-    if(n_cols == 1)
-      {
-      const int   n_threads_max = mp_thread_limit::get();
-      const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
-      const uword chunk_size    = n_rows / n_threads_use;
-      
-      podarray<eT> partial_accs(n_threads_use);
-      
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
-        {
-        const uword start = (thread_id+0) * chunk_size;
-        const uword endp1 = (thread_id+1) * chunk_size;
-        
-        eT acc = eT(0);
-        for(uword i=start; i < endp1; ++i)  { acc += P.at(i,0); }
-        
-        partial_accs[thread_id] = acc;
-        }
-      
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
-      
-      for(uword i=(n_threads_use*chunk_size); i < n_rows; ++i)  { val += P.at(i,0); }
-      }
-    else
-    if(n_rows == 1)
-      {
-      const int   n_threads_max = mp_thread_limit::get();
-      const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
-      const uword chunk_size    = n_cols / n_threads_use;
-      
-      podarray<eT> partial_accs(n_threads_use);
-      
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
-        {
-        const uword start = (thread_id+0) * chunk_size;
-        const uword endp1 = (thread_id+1) * chunk_size;
-        
-        eT acc = eT(0);
-        for(uword i=start; i < endp1; ++i)  { acc += P.at(0,i); }
-        
-        partial_accs[thread_id] = acc;
-        }
-      
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
-      
-      for(uword i=(n_threads_use*chunk_size); i < n_cols; ++i)  { val += P.at(0,i); }
-      }
-    else
-      {
-      podarray<eT> col_accs(n_cols);
-      
-      const int n_threads = mp_thread_limit::get();
-      
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword col=0; col < n_cols; ++col)
-        {
-        eT val1 = eT(0);
-        eT val2 = eT(0);
-        
-        uword i,j;
-        for(i=0, j=1; j < n_rows; i+=2, j+=2)  { val1 += P.at(i,col); val2 += P.at(j,col); }
-        
-        if(i < n_rows)  { val1 += P.at(i,col); }
-        
-        col_accs[col] = val1 + val2;
-        }
-      
-      val = arrayops::accumulate(col_accs.memptr(), n_cols);
-      }
+    const int   n_threads_max = mp_thread_limit::get();
+    const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
+    const uword chunk_size    = n_elem / n_threads_use;
+    
+    podarray<eT> partial_accs(n_threads_use);
+    
+    mp_task_runner::run(n_threads_use, accu_mp_at_task<T1>(P, chunk_size, partial_accs.memptr()));
+    
+    for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
+    
+    if(n_cols == 1)  { for(uword i=(n_threads_use*chunk_size); i < n_rows; ++i)  { val += P.at(i,0); } }
+    else             { for(uword i=(n_threads_use*chunk_size); i < n_cols; ++i)  { val += P.at(0,i); } }
     }
-  #else
+  else
     {
-    arma_ignore(P);
+    podarray<eT> col_accs(n_cols);
+    
+    mp_task_runner::run(n_cols, accu_mp_at_task<T1>(P, uword(0), col_accs.memptr()));
+    
+    val = arrayops::accumulate(col_accs.memptr(), n_cols);
     }
-  #endif
   
   return val;
   }
@@ -213,7 +270,7 @@ accu_proxy_at(const Proxy<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  if(arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem()))
+  if(Proxy<T1>::use_mp && mp_gate<eT>::eval_task(P.get_n_elem()))
     {
     return accu_proxy_at_mp(P);
     }
@@ -610,36 +667,22 @@ accu_cube_proxy_linear(const ProxyCube<T1>& P)
   
   const uword n_elem = P.get_n_elem();
   
-  if( arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(n_elem) )
+  if( ProxyCube<T1>::use_mp && mp_gate<eT>::eval_task(n_elem) )
     {
-    #if defined(ARMA_USE_OPENMP)
-      {
-      // NOTE: using parallelisation with manual reduction workaround to take into account complex numbers;
-      // NOTE: OpenMP versions lower than 4.0 do not support user-defined reduction
-      
-      const int   n_threads_max = mp_thread_limit::get();
-      const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
-      const uword chunk_size    = n_elem / n_threads_use;
-      
-      podarray<eT> partial_accs(n_threads_use);
-      
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
-        {
-        const uword start = (thread_id+0) * chunk_size;
-        const uword endp1 = (thread_id+1) * chunk_size;
-        
-        eT acc = eT(0);
-        for(uword i=start; i < endp1; ++i)  { acc += Pea[i]; }
-        
-        partial_accs[thread_id] = acc;
-        }
-      
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
-      
-      for(uword i=(n_threads_use*chunk_size); i < n_elem; ++i)  { val += Pea[i]; }
-      }
-    #endif
+    // NOTE: using parallelisation with manual reduction to take into account complex numbers,
+    // NOTE: and to obtain the same result regardless of how the executor schedules the parts
+    
+    const int   n_threads_max = mp_thread_limit::get();
+    const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
+    const uword chunk_size    = n_elem / n_threads_use;
+    
+    podarray<eT> partial_accs(n_threads_use);
+    
+    mp_task_runner::run(n_threads_use, accu_mp_linear_task<typename ProxyCube<T1>::ea_type, eT>(Pea, chunk_size, partial_accs.memptr()));
+    
+    for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
+    
+    for(uword i=(n_threads_use*chunk_size); i < n_elem; ++i)  { val += Pea[i]; }
     }
   else
     {
@@ -686,42 +729,13 @@ accu_cube_proxy_at_mp(const ProxyCube<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  eT val = eT(0);
+  const uword n_slices = P.get_n_slices();
   
-  #if defined(ARMA_USE_OPENMP)
-    {
-    const uword n_rows   = P.get_n_rows();
-    const uword n_cols   = P.get_n_cols();
-    const uword n_slices = P.get_n_slices();
-    
-    podarray<eT> slice_accs(n_slices);
-    
-    const int n_threads = mp_thread_limit::get();
-    
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice = 0; slice < n_slices; ++slice)
-      {
-      eT val1 = eT(0);
-      eT val2 = eT(0);
-      
-      for(uword col = 0; col < n_cols; ++col)
-        {
-        uword i,j;
-        for(i=0, j=1; j<n_rows; i+=2, j+=2)  { val1 += P.at(i,col,slice);  val2 += P.at(j,col,slice); }
-        
-        if(i < n_rows)  { val1 += P.at(i,col,slice); }
-        }
-      
-      slice_accs[slice] = val1 + val2;
-      }
-    
-    val = arrayops::accumulate(slice_accs.memptr(), slice_accs.n_elem);
-    }
-  #else
-    {
-    arma_ignore(P);
-    }
-  #endif
+  podarray<eT> slice_accs(n_slices);
+  
+  mp_task_runner::run(n_slices, accu_mp_cube_at_task<T1>(P, slice_accs.memptr()));
+  
+  const eT val = arrayops::accumulate(slice_accs.memptr(), slice_accs.n_elem);
   
   return val;
   }
@@ -738,7 +752,7 @@ accu_cube_proxy_at(const ProxyCube<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  if(arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem()))
+  if(ProxyCube<T1>::use_mp && mp_gate<eT>::eval_task(P.get_n_elem()))
     {
     return accu_cube_proxy_at_mp(P);
     }
@@ -50,5 +50,46 @@ cor(const Base<typename T1::elem_type,T1>& A, const Base<typename T1::elem_type,
   }
 
 
+//! weighted correlation of the columns of X; w holds one non-negative weight per observation (row of X)
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+Mat<typename T1::elem_type>
+wcor(const Base<typename T1::elem_type,T1>& X, const Base<typename T1::pod_type,T2>& w, const uword norm_type = 0)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
+  
+  arma_debug_check( (norm_type > 1), "wcor(): parameter 'norm_type' must be 0 or 1" );
+  
+  const quasi_unwrap<T1> UX(X.get_ref());
+  const quasi_unwrap<T2> UW(w.get_ref());
+  
+  const Mat<eT>& A = UX.M;
+  const Mat<T>&  W = UW.M;
+  
+  Mat<eT> out;
+  
+  if(A.n_elem == 0)  { return out; }
+  
+  const Mat<eT>& AA = (A.n_rows == 1)
+                      ? Mat<eT>(const_cast<eT*>(A.memptr()), A.n_cols, A.n_rows, false, false)
+                      : Mat<eT>(const_cast<eT*>(A.memptr()), A.n_rows, A.n_cols, false, false);
+  
+  arma_debug_check( (W.n_elem != AA.n_rows),  "wcor(): number of weights must match the number of observations" );
+  arma_debug_check( any(vectorise(W) < T(0)), "wcor(): weights must be non-negative" );
+  
+  op_cov::apply_blocked<eT>(out, AA, nullptr, W.memptr(), norm_type, false);
+  
+  const Col<eT> s = sqrt(out.diag());
+  
+  out /= (s * s.t());
+  
+  return out;
+  }
+
+
 
 //! @}
@@ -422,4 +422,40 @@ eigs_gen
 
 
 
+//! eigenvalues and eigenvectors of general real operator of size n x n,
+//! given as a function which computes y = A*x (the matrix is not formed)
+template<typename T>
+inline
+typename enable_if2< is_real<T>::value, bool >::result
+eigs_gen
+  (
+           Col< std::complex<T> >&    eigval,
+           Mat< std::complex<T> >&    eigvec,
+  const typename eigs_fn<T>::type&    fn,
+  const uword                         n,
+  const uword                         n_eigvals,
+  const char*                         form = "lm",
+  const eigs_opts                     opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_gen(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_gen(eigval, eigvec, fn, n, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_debug_warn_level(3, "eigs_gen(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
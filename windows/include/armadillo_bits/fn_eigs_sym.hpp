@@ -287,4 +287,40 @@ eigs_sym
 
 
 
+//! eigenvalues and eigenvectors of symmetric real operator of size n x n,
+//! given as a function which computes y = A*x (the matrix is not formed)
+template<typename eT>
+inline
+typename enable_if2< is_real<eT>::value, bool >::result
+eigs_sym
+  (
+           Col<eT>&                   eigval,
+           Mat<eT>&                   eigvec,
+  const typename eigs_fn<eT>::type&   fn,
+  const uword                         n,
+  const uword                         n_eigvals,
+  const char*                         form = "lm",
+  const eigs_opts                     opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_sym(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_sym(eigval, eigvec, fn, n, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_debug_warn_level(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
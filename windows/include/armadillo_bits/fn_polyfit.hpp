@@ -64,4 +64,56 @@ polyfit(const Base<typename T1::elem_type, T1>& X, const Base<typename T1::elem_
 
 
 
+//! fit a polynomial of degree N to each column of Y, with all columns sampled at X
+template<typename T1, typename T2>
+inline
+typename
+enable_if2
+  <
+  is_supported_blas_type<typename T1::elem_type>::value,
+  bool
+  >::result
+polyfit_batch(Mat<typename T1::elem_type>& out, const Base<typename T1::elem_type, T1>& X, const Base<typename T1::elem_type, T2>& Y, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  const bool status = glue_polyfit::apply_batch(out, X.get_ref(), Y.get_ref(), N);
+  
+  if(status == false)
+    {
+    out.soft_reset();
+    arma_debug_warn_level(3, "polyfit_batch(): failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! fit a polynomial of degree N to each tube of Y, with slice i of Y sampled at X(i)
+template<typename T1, typename T2>
+inline
+typename
+enable_if2
+  <
+  is_supported_blas_type<typename T1::elem_type>::value,
+  bool
+  >::result
+polyfit_batch(Cube<typename T1::elem_type>& out, const Base<typename T1::elem_type, T1>& X, const BaseCube<typename T1::elem_type, T2>& Y, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  const bool status = glue_polyfit::apply_batch(out, X.get_ref(), Y.get_ref(), N);
+  
+  if(status == false)
+    {
+    out.soft_reset();
+    arma_debug_warn_level(3, "polyfit_batch(): failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
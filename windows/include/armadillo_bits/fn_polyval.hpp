@@ -39,4 +39,48 @@ polyval(const Base<typename T1::elem_type, T1>& P, const T2& X)
 
 
 
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_supported_blas_type<typename T1::elem_type>::value && is_same_type<typename T1::elem_type,typename T2::elem_type>::value),
+  Mat<typename T1::elem_type>
+  >::result
+polyval_batch(const Base<typename T1::elem_type, T1>& P, const Base<typename T2::elem_type, T2>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<typename T1::elem_type> out;
+  
+  glue_polyval::apply_batch(out, P.get_ref(), X.get_ref());
+  
+  return out;
+  }
+
+
+
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_supported_blas_type<typename T1::elem_type>::value && is_same_type<typename T1::elem_type,typename T2::elem_type>::value),
+  Mat<typename T1::elem_type>
+  >::result
+polyval_batch(const BaseCube<typename T1::elem_type, T1>& P, const Base<typename T2::elem_type, T2>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<typename T1::elem_type> out;
+  
+  glue_polyval::apply_batch(out, P.get_ref(), X.get_ref());
+  
+  return out;
+  }
+
+
+
 //! @}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup fn_probe
+//! @{
+
+
+
+//! Obtain the type, element type and size of an object saved in a file, without reading the data.
+//! Only the header is read for arma_binary, arma_ascii, PGM, PPM and HDF5 files;
+//! for text files without a header (CSV, SSV, raw ASCII) a bounded sample from the start of the file is examined.
+inline
+arma_cold
+file_probe
+probe(const std::string& name)
+  {
+  arma_extra_debug_sigprint();
+  
+  file_probe  info;
+  std::string err_msg;
+  
+  const bool probe_okay = diskio::probe(info, name, err_msg);
+  
+  if(probe_okay == false)
+    {
+    if(err_msg.length() > 0)
+      {
+      arma_debug_warn_level(3, "probe(): ", err_msg, "; file: ", name);
+      }
+    
+    info = file_probe();
+    }
+  
+  return info;
+  }
+
+
+
+//! @}
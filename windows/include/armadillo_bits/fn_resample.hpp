@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fn_resample
+//! @{
+
+
+
+//! resample X to the given size using interpolation;
+//! method is one of "nearest", "linear", "cubic" or "area";
+//! "area" averages over the footprint of each output element and is preferred for downsampling;
+//! when the input size is an integer multiple of the output size, "area" performs exact binning
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_real<typename T1::elem_type>::value || is_cx<typename T1::elem_type>::yes),
+  const Op<T1, op_resample>
+  >::result
+resample(const Base<typename T1::elem_type,T1>& X, const uword in_n_rows, const uword in_n_cols, const char* method = "linear")
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_resample>(X.get_ref(), in_n_rows, in_n_cols, op_resample::parse_method(method), char(0));
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_real<typename T1::elem_type>::value || is_cx<typename T1::elem_type>::yes),
+  const Op<T1, op_resample>
+  >::result
+resample(const Base<typename T1::elem_type,T1>& X, const SizeMat& s, const char* method = "linear")
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_resample>(X.get_ref(), s.n_rows, s.n_cols, op_resample::parse_method(method), char(0));
+  }
+
+
+
+//! resample each slice of X; the number of slices is unchanged
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_real<typename T1::elem_type>::value || is_cx<typename T1::elem_type>::yes),
+  const OpCube<T1, op_resample>
+  >::result
+resample(const BaseCube<typename T1::elem_type,T1>& X, const uword in_n_rows, const uword in_n_cols, const char* method = "linear")
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_resample>(X.get_ref(), in_n_rows, in_n_cols, op_resample::parse_method(method));
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_real<typename T1::elem_type>::value || is_cx<typename T1::elem_type>::yes),
+  const OpCube<T1, op_resample>
+  >::result
+resample(const BaseCube<typename T1::elem_type,T1>& X, const SizeMat& s, const char* method = "linear")
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_resample>(X.get_ref(), s.n_rows, s.n_cols, op_resample::parse_method(method));
+  }
+
+
+
+//! @}
@@ -97,4 +97,158 @@ shift
 
 
 
+//! swap the halves of each dimension, moving the zero-frequency component to the centre
+template<typename T1>
+arma_warn_unused
+arma_inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value),
+  const Op<T1, op_fftshift>
+  >::result
+fftshift
+  (
+  const T1& X
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_fftshift>(X, uword(0), uword(0), uword(1), 'j');
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+arma_inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value),
+  const Op<T1, op_fftshift>
+  >::result
+fftshift
+  (
+  const T1&   X,
+  const uword dim
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_fftshift>(X, uword(0), dim, uword(0), 'j');
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+arma_inline
+const OpCube<T1, op_fftshift>
+fftshift
+  (
+  const BaseCube<typename T1::elem_type,T1>& X
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_fftshift>(X.get_ref(), uword(0), uword(0), uword(1));
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+arma_inline
+const OpCube<T1, op_fftshift>
+fftshift
+  (
+  const BaseCube<typename T1::elem_type,T1>& X,
+  const uword                                dim
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_fftshift>(X.get_ref(), uword(0), dim, uword(0));
+  }
+
+
+
+//! inverse of fftshift()
+template<typename T1>
+arma_warn_unused
+arma_inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value),
+  const Op<T1, op_fftshift>
+  >::result
+ifftshift
+  (
+  const T1& X
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_fftshift>(X, uword(1), uword(0), uword(1), 'j');
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+arma_inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value),
+  const Op<T1, op_fftshift>
+  >::result
+ifftshift
+  (
+  const T1&   X,
+  const uword dim
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_fftshift>(X, uword(1), dim, uword(0), 'j');
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+arma_inline
+const OpCube<T1, op_fftshift>
+ifftshift
+  (
+  const BaseCube<typename T1::elem_type,T1>& X
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_fftshift>(X.get_ref(), uword(1), uword(0), uword(1));
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+arma_inline
+const OpCube<T1, op_fftshift>
+ifftshift
+  (
+  const BaseCube<typename T1::elem_type,T1>& X,
+  const uword                                dim
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_fftshift>(X.get_ref(), uword(1), dim, uword(0));
+  }
+
+
+
 //! @}
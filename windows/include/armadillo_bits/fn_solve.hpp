@@ -221,4 +221,86 @@ solve
 
 
 
+
+
+//
+// solve_tridiag: batch of independent tridiagonal systems, one system per row
+
+
+template<typename T1, typename T2, typename T3, typename T4>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+solve_tridiag
+  (
+         Mat<typename T1::elem_type>&    X,
+  const Base<typename T1::elem_type,T1>& DL,
+  const Base<typename T1::elem_type,T2>& D,
+  const Base<typename T1::elem_type,T3>& DU,
+  const Base<typename T1::elem_type,T4>& B
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1> U_DL(DL.get_ref());
+  const quasi_unwrap<T2> U_D ( D.get_ref());
+  const quasi_unwrap<T3> U_DU(DU.get_ref());
+  const quasi_unwrap<T4> U_B ( B.get_ref());
+  
+  const bool is_alias = U_DL.is_alias(X) || U_D.is_alias(X) || U_DU.is_alias(X) || U_B.is_alias(X);
+  
+  Mat<eT> CP;
+  Mat<eT> tmp;
+  
+  Mat<eT>& out = (is_alias) ? tmp : X;
+  
+  const bool status = glue_solve_batch::apply_tridiag(out, CP, U_DL.M, U_D.M, U_DU.M, U_B.M);
+  
+  if(is_alias)  { X.steal_mem(tmp); }
+  
+  if(status == false)
+    {
+    X.soft_reset();
+    arma_debug_warn_level(3, "solve_tridiag(): solution not found");
+    }
+  
+  return status;
+  }
+
+
+
+//
+// solve_band: batch of independent band systems, one system per slice
+
+
+template<typename T1, typename T2>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+solve_band
+  (
+             Cube<typename T1::elem_type>&    X,
+  const BaseCube<typename T1::elem_type,T1>& A,
+  const BaseCube<typename T1::elem_type,T2>& B,
+  const uword                                KL,
+  const uword                                KU
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  const unwrap_cube_check<T1> U_A(A.get_ref(), X);
+  const unwrap_cube_check<T2> U_B(B.get_ref(), X);
+  
+  const bool status = glue_solve_batch::apply_band(X, U_A.M, U_B.M, KL, KU);
+  
+  if(status == false)
+    {
+    X.soft_reset();
+    arma_debug_warn_level(3, "solve_band(): solution not found");
+    }
+  
+  return status;
+  }
+
+
 //! @}
@@ -34,11 +34,18 @@ class glue_polyfit
     static constexpr bool is_xvec = false;
     };
   
+  template<typename eT> inline static void vandermonde(Mat<eT>& V, const Col<eT>& X, const uword N);
+  
+  template<typename eT> inline static bool fit_matrix(Mat<eT>& W, const Col<eT>& X, const uword N);
+  
   template<typename eT> inline static bool apply_noalias(Mat<eT>& out, const Col<eT>& X, const Col<eT>& Y, const uword N);
   
   template<typename T1, typename T2> inline static bool apply_direct(Mat<typename T1::elem_type>& out, const Base<typename T1::elem_type,T1>& X_expr, const Base<typename T1::elem_type, T2>& Y_expr, const uword N);
   
   template<typename T1, typename T2> inline static void apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_polyfit>& expr);
+  
+  template<typename T1, typename T2> inline static bool apply_batch(Mat<typename T1::elem_type>&  out, const Base<typename T1::elem_type,T1>& X_expr, const Base<typename T1::elem_type,T2>&     Y_expr, const uword N);
+  template<typename T1, typename T2> inline static bool apply_batch(Cube<typename T1::elem_type>& out, const Base<typename T1::elem_type,T1>& X_expr, const BaseCube<typename T1::elem_type,T2>& Y_expr, const uword N);
   };
 
 
@@ -23,14 +23,12 @@
 
 template<typename eT>
 inline
-bool
-glue_polyfit::apply_noalias(Mat<eT>& out, const Col<eT>& X, const Col<eT>& Y, const uword N)
+void
+glue_polyfit::vandermonde(Mat<eT>& V, const Col<eT>& X, const uword N)
   {
   arma_extra_debug_sigprint();
   
-  // create Vandermonde matrix
-  
-  Mat<eT> V(X.n_elem, N+1, arma_nozeros_indicator());
+  V.set_size(X.n_elem, N+1);
   
   V.tail_cols(1).ones();
   
@@ -43,6 +41,49 @@ glue_polyfit::apply_noalias(Mat<eT>& out, const Col<eT>& X, const Col<eT>& Y, co
     
     V_col_j = V_col_jp1 % X;
     }
+  }
+
+
+
+//! W = inv(R) * Q.t(), where Q*R is the QR decomposition of the Vandermonde matrix;
+//! the coefficients for any set of observations Y taken at X are then W*Y
+template<typename eT>
+inline
+bool
+glue_polyfit::fit_matrix(Mat<eT>& W, const Col<eT>& X, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> V;
+  
+  glue_polyfit::vandermonde(V, X, N);
+  
+  Mat<eT> Q;
+  Mat<eT> R;
+  
+  const bool status1 = auxlib::qr_econ(Q, R, V);
+  
+  if(status1 == false)  { return false; }
+  
+  const bool status2 = auxlib::solve_trimat_fast(W, R, Q.t(), uword(0));
+  
+  if(status2 == false)  { return false; }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+glue_polyfit::apply_noalias(Mat<eT>& out, const Col<eT>& X, const Col<eT>& Y, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> V;
+  
+  glue_polyfit::vandermonde(V, X, N);
   
   Mat<eT> Q;
   Mat<eT> R;
@@ -130,4 +171,109 @@ glue_polyfit::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_poly
 
 
 
+//! fit a polynomial of degree N to each column of Y;
+//! all columns share the sample points in X, so the Vandermonde matrix is factorised only once
+template<typename T1, typename T2>
+inline
+bool
+glue_polyfit::apply_batch(Mat<typename T1::elem_type>& out, const Base<typename T1::elem_type,T1>& X_expr, const Base<typename T1::elem_type,T2>& Y_expr, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1> UX(X_expr.get_ref());
+  const quasi_unwrap<T2> UY(Y_expr.get_ref());
+  
+  const Mat<eT>& X = UX.M;
+  const Mat<eT>& Y = UY.M;
+  
+  arma_debug_check( ((X.is_vec() == false) && (X.is_empty() == false)), "polyfit_batch(): argument X must be a vector" );
+  
+  arma_debug_check( (X.n_elem != Y.n_rows), "polyfit_batch(): number of elements in X must match number of rows in Y" );
+  
+  if(Y.is_empty())
+    {
+    out.set_size( ((X.n_elem == 0) ? uword(0) : (N+1)), Y.n_cols );
+    return true;
+    }
+  
+  arma_debug_check( (N >= X.n_elem), "polyfit_batch(): N must be less than the number of elements in X" );
+  
+  const Col<eT> X_as_colvec( const_cast<eT*>(X.memptr()), X.n_elem, false, false);
+  
+  Mat<eT> W;
+  
+  const bool status = glue_polyfit::fit_matrix(W, X_as_colvec, N);
+  
+  if(status == false)  { return false; }
+  
+  if(UY.is_alias(out))
+    {
+    Mat<eT> tmp = W * Y;
+    out.steal_mem(tmp);
+    }
+  else
+    {
+    out = W * Y;
+    }
+  
+  return true;
+  }
+
+
+
+//! fit a polynomial of degree N to each tube (row,col,:) of Y, with X holding the sample point of each slice;
+//! slice k of the output holds coefficient k of every tube, so that the output can be used directly with polyval_batch()
+template<typename T1, typename T2>
+inline
+bool
+glue_polyfit::apply_batch(Cube<typename T1::elem_type>& out, const Base<typename T1::elem_type,T1>& X_expr, const BaseCube<typename T1::elem_type,T2>& Y_expr, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1>      UX(X_expr.get_ref());
+  const unwrap_cube_check<T2> UY(Y_expr.get_ref(), out);
+  
+  const Mat<eT>&  X = UX.M;
+  const Cube<eT>& Y = UY.M;
+  
+  arma_debug_check( ((X.is_vec() == false) && (X.is_empty() == false)), "polyfit_batch(): argument X must be a vector" );
+  
+  arma_debug_check( (X.n_elem != Y.n_slices), "polyfit_batch(): number of elements in X must match number of slices in Y" );
+  
+  if(Y.is_empty())
+    {
+    out.set_size( Y.n_rows, Y.n_cols, ((X.n_elem == 0) ? uword(0) : (N+1)) );
+    return true;
+    }
+  
+  arma_debug_check( (N >= X.n_elem), "polyfit_batch(): N must be less than the number of elements in X" );
+  
+  const Col<eT> X_as_colvec( const_cast<eT*>(X.memptr()), X.n_elem, false, false);
+  
+  Mat<eT> W;
+  
+  const bool status = glue_polyfit::fit_matrix(W, X_as_colvec, N);
+  
+  if(status == false)  { return false; }
+  
+  // each slice is stored contiguously, so Y can be viewed as a matrix with one row per tube and one column per slice;
+  // the coefficients are then Y*W.t(), computed by a single matrix multiply
+  
+  out.set_size(Y.n_rows, Y.n_cols, N+1);
+  
+  const Mat<eT> Y_as_mat( const_cast<eT*>(Y.memptr()), Y.n_elem_slice, Y.n_slices, false, true);
+  
+        Mat<eT> out_as_mat(out.memptr(), out.n_elem_slice, out.n_slices, false, true);
+  
+  out_as_mat = Y_as_mat * W.t();
+  
+  return true;
+  }
+
+
+
 //! @}
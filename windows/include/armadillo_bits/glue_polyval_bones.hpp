@@ -37,6 +37,14 @@ class glue_polyval
   template<typename eT> inline static void apply_noalias(Mat<eT>& out, const Mat<eT>& P, const Mat<eT>& X);
   
   template<typename T1, typename T2> inline static void apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_polyval>& expr);
+  
+  static constexpr uword batch_block_len = 4096;  //!< number of elements evaluated by one work unit in apply_batch()
+  
+  template<typename eT> arma_hot inline static void apply_batch_col(eT* out_mem, const eT* P_mem, const uword P_n_terms, const eT* X_mem, const uword N);
+  template<typename eT> arma_hot inline static void apply_batch_block(eT* out_mem, const eT* P_mem, const uword P_stride, const uword P_n_terms, const eT* X_mem, const uword start, const uword endp1);
+  
+  template<typename T1, typename T2> inline static void apply_batch(Mat<typename T1::elem_type>& out, const Base<typename T1::elem_type,T1>&     P_expr, const Base<typename T1::elem_type,T2>& X_expr);
+  template<typename T1, typename T2> inline static void apply_batch(Mat<typename T1::elem_type>& out, const BaseCube<typename T1::elem_type,T1>& P_expr, const Base<typename T1::elem_type,T2>& X_expr);
   };
 
 
@@ -80,4 +80,174 @@ glue_polyval::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_poly
 
 
 
+//! Horner's scheme for one polynomial evaluated at N points
+template<typename eT>
+arma_hot
+inline
+void
+glue_polyval::apply_batch_col(eT* out_mem, const eT* P_mem, const uword P_n_terms, const eT* X_mem, const uword N)
+  {
+  const eT P0 = P_mem[0];
+  
+  for(uword i=0; i < N; ++i)  { out_mem[i] = P0; }
+  
+  for(uword k=1; k < P_n_terms; ++k)
+    {
+    const eT Pk = P_mem[k];
+    
+    for(uword i=0; i < N; ++i)
+      {
+      out_mem[i] = out_mem[i] * X_mem[i] + Pk;
+      }
+    }
+  }
+
+
+
+//! Horner's scheme for elements [start,endp1) of many polynomials, with coefficient k of polynomial i stored at P_mem[k*P_stride + i];
+//! the inner loop runs across independent polynomials and can be vectorised
+template<typename eT>
+arma_hot
+inline
+void
+glue_polyval::apply_batch_block(eT* out_mem, const eT* P_mem, const uword P_stride, const uword P_n_terms, const eT* X_mem, const uword start, const uword endp1)
+  {
+  for(uword i=start; i < endp1; ++i)  { out_mem[i] = P_mem[i]; }
+  
+  for(uword k=1; k < P_n_terms; ++k)
+    {
+    const eT* Pk_mem = &(P_mem[k*P_stride]);
+    
+    for(uword i=start; i < endp1; ++i)
+      {
+      out_mem[i] = out_mem[i] * X_mem[i] + Pk_mem[i];
+      }
+    }
+  }
+
+
+
+//! evaluate the polynomial in column j of P at each element in column j of X;
+//! if X has one column, it is used for all columns of P
+template<typename T1, typename T2>
+inline
+void
+glue_polyval::apply_batch(Mat<typename T1::elem_type>& out, const Base<typename T1::elem_type,T1>& P_expr, const Base<typename T1::elem_type,T2>& X_expr)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_check<T1> UP(P_expr.get_ref(), out);
+  const unwrap_check<T2> UX(X_expr.get_ref(), out);
+  
+  const Mat<eT>& P = UP.M;
+  const Mat<eT>& X = UX.M;
+  
+  arma_debug_check( ((X.n_cols != 1) && (X.n_cols != P.n_cols)), "polyval_batch(): number of columns in X must be 1 or match number of columns in P" );
+  
+  if(P.is_empty() || X.is_empty())
+    {
+    out.zeros(X.n_rows, P.n_cols);
+    return;
+    }
+  
+  out.set_size(X.n_rows, P.n_cols);
+  
+  const uword N         = X.n_rows;
+  const uword n_cols    = P.n_cols;
+  const uword P_n_terms = P.n_rows;
+  const bool  X_shared  = (X.n_cols == 1);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_cols > 1) && (mp_thread_limit::in_parallel() == false) && mp_gate<eT>::eval(out.n_elem * P_n_terms) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword col=0; col < n_cols; ++col)
+        {
+        glue_polyval::apply_batch_col(out.colptr(col), P.colptr(col), P_n_terms, X.colptr( (X_shared) ? uword(0) : col ), N);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  for(uword col=0; col < n_cols; ++col)
+    {
+    glue_polyval::apply_batch_col(out.colptr(col), P.colptr(col), P_n_terms, X.colptr( (X_shared) ? uword(0) : col ), N);
+    }
+  }
+
+
+
+//! evaluate the polynomial in tube (row,col,:) of P at X(row,col);
+//! slice k of P holds coefficient k, in the layout produced by polyfit_batch()
+template<typename T1, typename T2>
+inline
+void
+glue_polyval::apply_batch(Mat<typename T1::elem_type>& out, const BaseCube<typename T1::elem_type,T1>& P_expr, const Base<typename T1::elem_type,T2>& X_expr)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_cube<T1>  UP(P_expr.get_ref());
+  const unwrap_check<T2> UX(X_expr.get_ref(), out);
+  
+  const Cube<eT>& P = UP.M;
+  const Mat<eT>&  X = UX.M;
+  
+  arma_debug_check( ((X.n_rows != P.n_rows) || (X.n_cols != P.n_cols)), "polyval_batch(): size of X must match size of each slice in P" );
+  
+  if(P.is_empty())
+    {
+    out.zeros(X.n_rows, X.n_cols);
+    return;
+    }
+  
+  out.set_size(X.n_rows, X.n_cols);
+  
+  const uword N         = X.n_elem;
+  const uword P_n_terms = P.n_slices;
+  const uword n_blocks  = (N + batch_block_len - 1) / batch_block_len;
+  
+        eT* out_mem = out.memptr();
+  const eT*   P_mem =   P.memptr();
+  const eT*   X_mem =   X.memptr();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_blocks > 1) && (mp_thread_limit::in_parallel() == false) && mp_gate<eT>::eval(P.n_elem) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword blk=0; blk < n_blocks; ++blk)
+        {
+        const uword start = blk * batch_block_len;
+        const uword endp1 = (std::min)(N, start + batch_block_len);
+        
+        glue_polyval::apply_batch_block(out_mem, P_mem, N, P_n_terms, X_mem, start, endp1);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  for(uword blk=0; blk < n_blocks; ++blk)
+    {
+    const uword start = blk * batch_block_len;
+    const uword endp1 = (std::min)(N, start + batch_block_len);
+    
+    glue_polyval::apply_batch_block(out_mem, P_mem, N, P_n_terms, X_mem, start, endp1);
+    }
+  }
+
+
+
 //! @}
@@ -98,6 +98,26 @@ class glue_solve_tri_full
 
 
 
+//! solvers for batches of many small independent systems, without per-system structure detection
+class glue_solve_batch
+  {
+  public:
+  
+  static constexpr uword tridiag_block_n_rows = 256;  //!< number of systems processed together by one work unit of the tridiagonal solver
+  
+  template<typename eT> inline static bool apply_tridiag(Mat<eT>& X, Mat<eT>& CP, const Mat<eT>& DL, const Mat<eT>& D, const Mat<eT>& DU, const Mat<eT>& B);
+  
+  template<typename eT> arma_hot inline static void apply_tridiag_block(Mat<eT>& X, Mat<eT>& CP, uword* bad_piv, const Mat<eT>& DL, const Mat<eT>& D, const Mat<eT>& DU, const Mat<eT>& B, const uword row_start, const uword row_endp1);
+  
+  template<typename eT> inline static bool apply_tridiag_pivoted(Mat<eT>& X, const Mat<eT>& DL, const Mat<eT>& D, const Mat<eT>& DU, const Mat<eT>& B, const uword row);
+  
+  template<typename eT> inline static bool apply_band(Cube<eT>& X, const Cube<eT>& A, const Cube<eT>& B, const uword KL, const uword KU);
+  
+  template<typename eT> inline static bool apply_band_slice(Cube<eT>& X, const Cube<eT>& A, const Cube<eT>& B, const uword KL, const uword KU, const uword slice);
+  };
+
+
+
 namespace solve_opts
   {
   struct opts
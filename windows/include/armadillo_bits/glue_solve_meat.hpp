@@ -584,4 +584,345 @@ glue_solve_tri_full::apply(Mat<eT>& actual_out, const Base<eT,T1>& A_expr, const
 
 
 
+
+
+//
+// glue_solve_batch
+
+
+
+//! solve a batch of tridiagonal systems via the Thomas algorithm (no pivoting).
+//! each row of the inputs holds one system: D is the main diagonal (n_sys x N),
+//! DL and DU are the sub- and super-diagonals (n_sys x N-1), B is the right hand side (n_sys x N).
+//! the systems are processed in blocks of rows, so that the innermost loops run across systems
+//! over contiguous memory and can be vectorised; with OpenMP the blocks are distributed across threads.
+//! systems which encounter a pivot that is zero, non-finite or tiny relative to its row,
+//! or which produce a non-finite solution, are solved again via LAPACK gtsv (partial pivoting),
+//! so that singular systems are reported by its info code, as done by solve().
+//! CP is used as workspace for the modified super-diagonal.
+template<typename eT>
+inline
+bool
+glue_solve_batch::apply_tridiag(Mat<eT>& X, Mat<eT>& CP, const Mat<eT>& DL, const Mat<eT>& D, const Mat<eT>& DU, const Mat<eT>& B)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_sys = D.n_rows;
+  const uword N     = D.n_cols;
+  
+  const uword N_off = (N > 0) ? (N-1) : uword(0);
+  
+  arma_debug_check( ((DL.n_rows != n_sys) || (DU.n_rows != n_sys) || (B.n_rows != n_sys)), "solve_tridiag(): number of rows (systems) in the given matrices must be the same" );
+  arma_debug_check( ((DL.n_cols != N_off) || (DU.n_cols != N_off)),                         "solve_tridiag(): off-diagonals must have one column fewer than the main diagonal" );
+  arma_debug_check( (B.n_cols != N),                                                         "solve_tridiag(): right hand side must have the same number of columns as the main diagonal" );
+  
+  X.set_size(n_sys, N);
+  
+  if(X.is_empty())  { return true; }
+  
+  CP.set_size(n_sys, N_off);
+  
+  // non-zero for each system which needs to be solved again with pivoting
+  podarray<uword> bad_piv(n_sys);
+  
+  bad_piv.zeros();
+  
+  const uword n_blocks = (n_sys + tridiag_block_n_rows - 1) / tridiag_block_n_rows;
+  
+  bool done = false;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_blocks > 1) && mp_gate<eT>::eval(X.n_elem) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword blk=0; blk < n_blocks; ++blk)
+        {
+        const uword row_start = blk * tridiag_block_n_rows;
+        const uword row_endp1 = (std::min)(n_sys, row_start + tridiag_block_n_rows);
+        
+        glue_solve_batch::apply_tridiag_block(X, CP, bad_piv.memptr(), DL, D, DU, B, row_start, row_endp1);
+        }
+      
+      done = true;
+      }
+    }
+  #endif
+  
+  if(done == false)
+    {
+    for(uword blk=0; blk < n_blocks; ++blk)
+      {
+      const uword row_start = blk * tridiag_block_n_rows;
+      const uword row_endp1 = (std::min)(n_sys, row_start + tridiag_block_n_rows);
+      
+      glue_solve_batch::apply_tridiag_block(X, CP, bad_piv.memptr(), DL, D, DU, B, row_start, row_endp1);
+      }
+    }
+  
+  for(uword r=0; r < n_sys; ++r)
+    {
+    if(bad_piv[r] != uword(0))
+      {
+      if(glue_solve_batch::apply_tridiag_pivoted(X, DL, D, DU, B, r) == false)  { return false; }
+      }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+arma_hot
+inline
+void
+glue_solve_batch::apply_tridiag_block(Mat<eT>& X, Mat<eT>& CP, uword* bad_piv, const Mat<eT>& DL, const Mat<eT>& D, const Mat<eT>& DU, const Mat<eT>& B, const uword row_start, const uword row_endp1)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  const T eps = std::numeric_limits<T>::epsilon();
+  const T big = std::numeric_limits<T>::max();
+  
+  const uword N = D.n_cols;
+  
+  // forward sweep; X holds the modified right hand side;
+  // a pivot is flagged when it is not larger than eps times the magnitude of the terms in its row,
+  // or when its reciprocal is not finite (eg. zero or denormal pivots);
+  // the last pivot has no reciprocal, so a non-finite result there is caught by the check on X below;
+  // the tests are written as negated comparisons so that NaN is flagged and the loops stay vectorisable
+  
+  {
+        eT*  X_col =  X.colptr(0);
+  const eT*  D_col =  D.colptr(0);
+  const eT*  B_col =  B.colptr(0);
+  
+  if(N > 1)
+    {
+          eT* CP_col = CP.colptr(0);
+    const eT* DU_col = DU.colptr(0);
+    
+    for(uword r=row_start; r < row_endp1; ++r)
+      {
+      const eT m = D_col[r];
+      
+      const eT inv_m = eT(1) / m;
+      
+      bad_piv[r] |= uword( ((std::abs(m) > eps * std::abs(DU_col[r])) && (std::abs(inv_m) <= big)) == false );
+      
+      CP_col[r] = DU_col[r] * inv_m;
+       X_col[r] =  B_col[r] * inv_m;
+      }
+    }
+  else
+    {
+    for(uword r=row_start; r < row_endp1; ++r)
+      {
+      bad_piv[r] |= uword(D_col[r] == eT(0));
+      
+      X_col[r] = B_col[r] / D_col[r];
+      }
+    }
+  }
+  
+  for(uword i=1; i < N; ++i)
+    {
+          eT*      X_col =  X.colptr(i  );
+    const eT* X_prev_col =  X.colptr(i-1);
+    const eT*      D_col =  D.colptr(i  );
+    const eT*      B_col =  B.colptr(i  );
+    const eT*     DL_col = DL.colptr(i-1);
+    const eT* CP_prev_col = CP.colptr(i-1);
+    
+    if(i < (N-1))
+      {
+            eT* CP_col = CP.colptr(i);
+      const eT* DU_col = DU.colptr(i);
+      
+      for(uword r=row_start; r < row_endp1; ++r)
+        {
+        const eT L = DL_col[r] * CP_prev_col[r];
+        const eT m = D_col[r] - L;
+        
+        const eT inv_m = eT(1) / m;
+        
+        bad_piv[r] |= uword( ((std::abs(m) > eps * (std::abs(D_col[r]) + std::abs(L) + std::abs(DU_col[r]))) && (std::abs(inv_m) <= big)) == false );
+        
+        CP_col[r] = DU_col[r] * inv_m;
+         X_col[r] = (B_col[r] - DL_col[r] * X_prev_col[r]) * inv_m;
+        }
+      }
+    else
+      {
+      for(uword r=row_start; r < row_endp1; ++r)
+        {
+        const eT L = DL_col[r] * CP_prev_col[r];
+        const eT m = D_col[r] - L;
+        
+        bad_piv[r] |= uword(std::abs(m) <= eps * (std::abs(D_col[r]) + std::abs(L)));
+        
+        X_col[r] = (B_col[r] - DL_col[r] * X_prev_col[r]) / m;
+        }
+      }
+    }
+  
+  // back substitution; systems with a non-finite solution are also flagged
+  
+  {
+  const eT* X_col = X.colptr(N-1);
+  
+  for(uword r=row_start; r < row_endp1; ++r)  { bad_piv[r] |= uword((std::abs(X_col[r]) <= big) == false); }
+  }
+  
+  for(uword i=N-1; i > 0; --i)
+    {
+          eT*      X_col =  X.colptr(i-1);
+    const eT* X_next_col =  X.colptr(i  );
+    const eT*     CP_col = CP.colptr(i-1);
+    
+    for(uword r=row_start; r < row_endp1; ++r)
+      {
+      X_col[r] -= CP_col[r] * X_next_col[r];
+      
+      bad_piv[r] |= uword((std::abs(X_col[r]) <= big) == false);
+      }
+    }
+  }
+
+
+
+//! solve one system of a batch of tridiagonal systems via LAPACK gtsv, which uses partial pivoting
+template<typename eT>
+inline
+bool
+glue_solve_batch::apply_tridiag_pivoted(Mat<eT>& X, const Mat<eT>& DL, const Mat<eT>& D, const Mat<eT>& DU, const Mat<eT>& B, const uword row)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N = D.n_cols;
+  
+  // layout as produced by band_helper::extract_tridiag()
+  Mat<eT> tridiag(N, 3, arma_zeros_indicator());
+  Mat<eT> out(N, 1, arma_nozeros_indicator());
+  
+  eT* tri_DL = tridiag.colptr(0);
+  eT* tri_DD = tridiag.colptr(1);
+  eT* tri_DU = tridiag.colptr(2);
+  
+  for(uword i=0; i < N; ++i)
+    {
+    tri_DD[i] = D.at(row,i);
+    out[i]    = B.at(row,i);
+    }
+  
+  for(uword i=0; (i+1) < N; ++i)
+    {
+    tri_DL[i] = DL.at(row,i);
+    tri_DU[i] = DU.at(row,i);
+    }
+  
+  if(auxlib::solve_tridiag_extracted(out, tridiag) == false)  { return false; }
+  
+  if(out.is_finite() == false)  { return false; }
+  
+  for(uword i=0; i < N; ++i)  { X.at(row,i) = out[i]; }
+  
+  return true;
+  }
+
+
+
+//! solve a batch of band systems, one system per slice, using the given band structure for all slices
+template<typename eT>
+inline
+bool
+glue_solve_batch::apply_band(Cube<eT>& X, const Cube<eT>& A, const Cube<eT>& B, const uword KL, const uword KU)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N        = A.n_rows;
+  const uword n_slices = A.n_slices;
+  
+  arma_debug_check( (A.n_rows != A.n_cols),      "solve_band(): each slice of A must be square sized" );
+  arma_debug_check( (B.n_rows != N),             "solve_band(): number of rows in the given objects must be the same" );
+  arma_debug_check( (B.n_slices != n_slices),    "solve_band(): number of slices in the given objects must be the same" );
+  arma_debug_check( ((N > 0) && ((KL >= N) || (KU >= N))), "solve_band(): band size must be less than the number of rows" );
+  
+  X.set_size(N, B.n_cols, n_slices);
+  
+  if(X.is_empty())  { X.zeros(); return true; }
+  
+  arma_debug_assert_blas_size(A.slice(0), B.slice(0));
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_slices > 1) && mp_gate<eT>::eval(A.n_elem) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      // status of each slice: 0 = not solved, 1 = solved, 2 = exception;
+      // exceptions must not leave the parallel region, so they are rethrown after it
+      
+      podarray<uword> status(n_slices);
+      
+      std::vector<std::exception_ptr> err(n_slices);
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword slice=0; slice < n_slices; ++slice)
+        {
+        try
+          {
+          status[slice] = glue_solve_batch::apply_band_slice(X, A, B, KL, KU, slice) ? uword(1) : uword(0);
+          }
+        catch(...)
+          {
+          status[slice] = uword(2);
+          err[slice]    = std::current_exception();
+          }
+        }
+      
+      // report the first failed slice, as in the serial case
+      
+      for(uword slice=0; slice < n_slices; ++slice)
+        {
+        if(status[slice] == uword(0))  { return false; }
+        if(status[slice] == uword(2))  { std::rethrow_exception(err[slice]); }
+        }
+      
+      return true;
+      }
+    }
+  #endif
+  
+  for(uword slice=0; slice < n_slices; ++slice)
+    {
+    if(glue_solve_batch::apply_band_slice(X, A, B, KL, KU, slice) == false)  { return false; }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+glue_solve_batch::apply_band_slice(Cube<eT>& X, const Cube<eT>& A, const Cube<eT>& B, const uword KL, const uword KU, const uword slice)
+  {
+  const Mat<eT> A_slice(const_cast<eT*>(A.slice_memptr(slice)), A.n_rows, A.n_cols, false, true);
+  const Mat<eT> B_slice(const_cast<eT*>(B.slice_memptr(slice)), B.n_rows, B.n_cols, false, true);
+  
+        Mat<eT> X_slice(X.slice_memptr(slice), X.n_rows, X.n_cols, false, true);
+  
+  if( (KL == 1) && (KU == 1) )
+    {
+    return auxlib::solve_tridiag_fast_common(X_slice, A_slice, B_slice);
+    }
+  
+  return auxlib::solve_band_fast_common(X_slice, A_slice, KL, KU, B_slice);
+  }
+
+
 //! @}
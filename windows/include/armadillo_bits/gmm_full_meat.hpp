@@ -1029,7 +1029,9 @@ gmm_full<eT>::internal_gen_boundaries(const uword N) const
   arma_extra_debug_sigprint();
   
   #if defined(ARMA_USE_OPENMP)
-    const uword n_threads_avail = uword(omp_get_max_threads());
+    // loops over the boundaries are parallelised directly with OpenMP, so run them serially while a user-provided executor is set
+    const bool  use_serial      = (omp_in_parallel()) || (mp_executor_state::get() != nullptr);
+    const uword n_threads_avail = (use_serial) ? uword(1) : uword(mp_thread_limit::get());
     const uword n_threads       = (n_threads_avail > 0) ? ( (n_threads_avail <= N) ? n_threads_avail : 1 ) : 1;
   #else
     static constexpr uword n_threads = 1;
@@ -179,6 +179,25 @@ get_hdf5_type< std::complex<double> >()
 
 
 
+//! Check whether the given HDF5 datatype matches the HDF5 datatype corresponding to eT.
+template<typename eT>
+inline
+bool
+is_hdf5_type(hid_t datatype)
+  {
+  hid_t mat_type = get_hdf5_type<eT>();
+  
+  if(mat_type < 0)  { return false; }
+  
+  const bool result = (arma_H5Tequal(datatype, mat_type) > 0);
+  
+  arma_H5Tclose(mat_type);
+  
+  return result;
+  }
+
+
+
 // Compare datatype against all supported types.
 inline
 bool
@@ -494,7 +513,9 @@ load_and_convert_hdf5
   eT   *dest,
   hid_t dataset,
   hid_t datatype,
-  uword n_elem
+  uword n_elem,
+  hid_t mem_space  = H5S_ALL,
+  hid_t file_space = H5S_ALL
   )
   {
   
@@ -514,7 +535,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u8> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -529,7 +550,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s8> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -544,7 +565,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u16> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -559,7 +580,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s16> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -574,7 +595,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u32> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -589,7 +610,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s32> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -604,7 +625,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u64> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -619,7 +640,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s64> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -634,7 +655,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<ulng_t> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -649,7 +670,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<slng_t> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -664,7 +685,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<float> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -679,7 +700,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<double> v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -699,7 +720,7 @@ load_and_convert_hdf5
       }
     
     Col< std::complex<float> > v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert_cx(dest, v.memptr(), n_elem);
     
     return status;
@@ -719,7 +740,7 @@ load_and_convert_hdf5
       }
     
     Col< std::complex<double> > v(n_elem, arma_nozeros_indicator());
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert_cx(dest, v.memptr(), n_elem);
     
     return status;
@@ -731,6 +752,125 @@ load_and_convert_hdf5
 
 
 
+//! Create a dataset creation property list for chunked and/or compressed storage,
+//! as requested via hdf5_opts::chunk(), hdf5_opts::deflate() and hdf5_opts::shuffle.
+//! dims holds the dataset dimensions in HDF5 order (ie. reversed with respect to Armadillo).
+//! Returns H5P_DEFAULT if contiguous storage is to be used, or -1 if there was a problem.
+template<typename eT>
+inline
+hid_t
+create_dcpl(const hdf5_opts::opts& opts, const int ndims, const hsize_t* dims)
+  {
+  const bool use_chunk   = bool(opts.flags & hdf5_opts::flag_chunk  );
+  const bool use_deflate = bool(opts.flags & hdf5_opts::flag_deflate);
+  const bool use_shuffle = bool(opts.flags & hdf5_opts::flag_shuffle);
+  
+  if( (use_chunk == false) && (use_deflate == false) && (use_shuffle == false) )  { return H5P_DEFAULT; }
+  
+  // chunks can't be defined for empty datasets
+  for(int k=0; k < ndims; ++k)  { if(dims[k] == 0)  { return H5P_DEFAULT; } }
+  
+  // chunk shape in Armadillo order: rows, cols, slices
+  hsize_t arma_chunk[3];
+  
+  if(use_chunk)
+    {
+    arma_chunk[0] = hsize_t( (std::max)(opts.chunk_n_rows,   uword(1)) );
+    arma_chunk[1] = hsize_t( (std::max)(opts.chunk_n_cols,   uword(1)) );
+    arma_chunk[2] = hsize_t( (std::max)(opts.chunk_n_slices, uword(1)) );
+    }
+  else
+    {
+    // default: whole slices for cubes, and roughly 1 MB worth of whole columns for matrices
+    
+    const hsize_t n_rows = dims[ndims-1];
+    
+    arma_chunk[0] = n_rows;
+    arma_chunk[1] = (ndims == 3) ? dims[1] : (std::max)( hsize_t(1), hsize_t(1u << 20) / (n_rows * hsize_t(sizeof(eT))) );
+    arma_chunk[2] = 1;
+    }
+  
+  hsize_t chunk_dims[3];
+  
+  for(int k=0; k < ndims; ++k)  { chunk_dims[k] = (std::min)( arma_chunk[ndims-1-k], dims[k] ); }
+  
+  // HDF5 limits the size of a chunk to 4 GB
+  
+  const hsize_t max_chunk_elem = hsize_t(0x7FFFFFFF) / hsize_t(sizeof(eT));
+  
+  for(int k=0; k < ndims; ++k)
+    {
+    hsize_t n_elem = 1;
+    
+    for(int kk=0; kk < ndims; ++kk)  { n_elem *= chunk_dims[kk]; }
+    
+    if(n_elem <= max_chunk_elem)  { break; }
+    
+    chunk_dims[k] = (std::max)( hsize_t(1), chunk_dims[k] / ((n_elem / max_chunk_elem) + 1) );
+    }
+  
+  hid_t dcpl = arma_H5Pcreate(arma_H5P_DATASET_CREATE);
+  
+  if(dcpl < 0)  { return -1; }
+  
+  bool status_okay = (arma_H5Pset_chunk(dcpl, ndims, chunk_dims) >= 0);
+  
+  // the shuffle filter must come before the deflate filter in the pipeline
+  if(status_okay && use_shuffle)  { status_okay = (arma_H5Pset_shuffle(dcpl) >= 0);                                }
+  if(status_okay && use_deflate)  { status_okay = (arma_H5Pset_deflate(dcpl, unsigned(opts.deflate_level)) >= 0); }
+  
+  if(status_okay == false)  { arma_H5Pclose(dcpl); return -1; }
+  
+  return dcpl;
+  }
+
+
+
+//! Restrict filespace to the rows, columns and slices requested via
+//! hdf5_opts::rows(), hdf5_opts::cols() and hdf5_opts::slices().
+//! dims holds the dataset dimensions in HDF5 order and is overwritten with the extent of the selection.
+//! arma_rank is 2 for matrices and 3 for cubes.
+inline
+bool
+select_subset(hid_t filespace, const hdf5_opts::opts& opts, const int ndims, const int arma_rank, hsize_t* dims, std::string& err_msg)
+  {
+  const bool sel[3]   = { bool(opts.flags & hdf5_opts::flag_rows), bool(opts.flags & hdf5_opts::flag_cols), bool(opts.flags & hdf5_opts::flag_slices) };
+  const uword first[3] = { opts.row_first, opts.col_first, opts.slice_first };
+  const uword last[3]  = { opts.row_last,  opts.col_last,  opts.slice_last  };
+  
+  if( (arma_rank == 2) && sel[2] )  { err_msg = "range of slices given for a matrix"; return false; }
+  
+  hsize_t offset[3];
+  hsize_t count[3];
+  
+  // dimensions absent from the dataset are treated as having length 1
+  
+  for(int d=0; d < arma_rank; ++d)
+    {
+    const int     k     = arma_rank - 1 - d;  // position of Armadillo dimension d in HDF5 order
+    const hsize_t n_all = (k < ndims) ? dims[k] : hsize_t(1);
+    
+    if(sel[d])
+      {
+      if( (first[d] > last[d]) || (hsize_t(last[d]) >= n_all) )  { err_msg = "requested range out of bounds"; return false; }
+      }
+    
+    if(k < ndims)
+      {
+      offset[k] = (sel[d]) ? hsize_t(first[d])                : hsize_t(0);
+      count[k]  = (sel[d]) ? hsize_t(last[d] - first[d] + 1)  : n_all;
+      }
+    }
+  
+  if(arma_H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, NULL, count, NULL) < 0)  { err_msg = "cannot select HDF5 hyperslab"; return false; }
+  
+  for(int k=0; k < ndims; ++k)  { dims[k] = count[k]; }
+  
+  return true;
+  }
+
+
+
 struct hdf5_suspend_printing_errors
   {
   #if defined(ARMA_PRINT_HDF5_ERRORS)
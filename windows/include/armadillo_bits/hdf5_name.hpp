@@ -28,42 +28,169 @@ namespace hdf5_opts
     {
     const flag_type flags;
     
+    const uword deflate_level;   //!< compression level for the deflate filter (0 to 9)
+    
+    const uword chunk_n_rows;    //!< chunk shape, in terms of the saved object
+    const uword chunk_n_cols;
+    const uword chunk_n_slices;
+    
+    const uword row_first;       //!< range of rows, columns and slices to load
+    const uword row_last;
+    const uword col_first;
+    const uword col_last;
+    const uword slice_first;
+    const uword slice_last;
+    
     inline explicit opts(const flag_type in_flags);
     
+    inline opts
+      (
+      const flag_type in_flags,
+      const uword in_deflate_level,
+      const uword in_chunk_n_rows, const uword in_chunk_n_cols, const uword in_chunk_n_slices,
+      const uword in_row_first,    const uword in_row_last,
+      const uword in_col_first,    const uword in_col_last,
+      const uword in_slice_first,  const uword in_slice_last
+      );
+    
     inline const opts operator+(const opts& rhs) const;
     };
   
+  // The values below (eg. 1u << 0) are for internal Armadillo use only.
+  // The values can change without notice.
+  
+  static const flag_type flag_none    = flag_type(0      );
+  static const flag_type flag_trans   = flag_type(1u << 0);
+  static const flag_type flag_append  = flag_type(1u << 1);
+  static const flag_type flag_replace = flag_type(1u << 2);
+  static const flag_type flag_deflate = flag_type(1u << 3);
+  static const flag_type flag_shuffle = flag_type(1u << 4);
+  static const flag_type flag_chunk   = flag_type(1u << 5);
+  static const flag_type flag_rows    = flag_type(1u << 6);
+  static const flag_type flag_cols    = flag_type(1u << 7);
+  static const flag_type flag_slices  = flag_type(1u << 8);
+  
+  static const flag_type flag_subset  = flag_type(flag_rows | flag_cols | flag_slices);
+  
   inline
   opts::opts(const flag_type in_flags)
-    : flags(in_flags)
+    : flags         (in_flags)
+    , deflate_level (0)
+    , chunk_n_rows  (0)
+    , chunk_n_cols  (0)
+    , chunk_n_slices(0)
+    , row_first     (0)
+    , row_last      (0)
+    , col_first     (0)
+    , col_last      (0)
+    , slice_first   (0)
+    , slice_last    (0)
+    {}
+  
+  inline
+  opts::opts
+    (
+    const flag_type in_flags,
+    const uword in_deflate_level,
+    const uword in_chunk_n_rows, const uword in_chunk_n_cols, const uword in_chunk_n_slices,
+    const uword in_row_first,    const uword in_row_last,
+    const uword in_col_first,    const uword in_col_last,
+    const uword in_slice_first,  const uword in_slice_last
+    )
+    : flags         (in_flags         )
+    , deflate_level (in_deflate_level )
+    , chunk_n_rows  (in_chunk_n_rows  )
+    , chunk_n_cols  (in_chunk_n_cols  )
+    , chunk_n_slices(in_chunk_n_slices)
+    , row_first     (in_row_first     )
+    , row_last      (in_row_last      )
+    , col_first     (in_col_first     )
+    , col_last      (in_col_last      )
+    , slice_first   (in_slice_first   )
+    , slice_last    (in_slice_last    )
     {}
   
   inline
   const opts
   opts::operator+(const opts& rhs) const
     {
-    const opts result( flags | rhs.flags );
+    // parameters given by rhs take precedence
+    
+    const bool rhs_deflate = bool(rhs.flags & flag_deflate);
+    const bool rhs_chunk   = bool(rhs.flags & flag_chunk  );
+    const bool rhs_rows    = bool(rhs.flags & flag_rows   );
+    const bool rhs_cols    = bool(rhs.flags & flag_cols   );
+    const bool rhs_slices  = bool(rhs.flags & flag_slices );
+    
+    const opts result
+      (
+      flags | rhs.flags,
+      (rhs_deflate) ? rhs.deflate_level  : deflate_level,
+      (rhs_chunk  ) ? rhs.chunk_n_rows   : chunk_n_rows,
+      (rhs_chunk  ) ? rhs.chunk_n_cols   : chunk_n_cols,
+      (rhs_chunk  ) ? rhs.chunk_n_slices : chunk_n_slices,
+      (rhs_rows   ) ? rhs.row_first      : row_first,
+      (rhs_rows   ) ? rhs.row_last       : row_last,
+      (rhs_cols   ) ? rhs.col_first      : col_first,
+      (rhs_cols   ) ? rhs.col_last       : col_last,
+      (rhs_slices ) ? rhs.slice_first    : slice_first,
+      (rhs_slices ) ? rhs.slice_last     : slice_last
+      );
     
     return result;
     }
   
-  // The values below (eg. 1u << 0) are for internal Armadillo use only.
-  // The values can change without notice.
-  
-  static const flag_type flag_none    = flag_type(0      );
-  static const flag_type flag_trans   = flag_type(1u << 0);
-  static const flag_type flag_append  = flag_type(1u << 1);
-  static const flag_type flag_replace = flag_type(1u << 2);
-  
   struct opts_none    : public opts { inline opts_none()    : opts(flag_none   ) {} };
   struct opts_trans   : public opts { inline opts_trans()   : opts(flag_trans  ) {} };
   struct opts_append  : public opts { inline opts_append()  : opts(flag_append ) {} };
   struct opts_replace : public opts { inline opts_replace() : opts(flag_replace) {} };
+  struct opts_shuffle : public opts { inline opts_shuffle() : opts(flag_shuffle) {} };
   
   static const opts_none    none;
   static const opts_trans   trans;
   static const opts_append  append;
   static const opts_replace replace;
+  static const opts_shuffle shuffle;
+  
+  //! compress the saved dataset with the deflate (gzip) filter; implies chunked storage
+  inline
+  const opts
+  deflate(const uword level = 6)
+    {
+    return opts(flag_deflate, (std::min)(level, uword(9)), 0,0,0, 0,0, 0,0, 0,0);
+    }
+  
+  //! store the saved dataset in chunks of the given shape, eg. chunk(C.n_rows, C.n_cols, 1) for one chunk per slice
+  inline
+  const opts
+  chunk(const uword n_rows, const uword n_cols, const uword n_slices = 1)
+    {
+    return opts(flag_chunk, 0, n_rows, n_cols, n_slices, 0,0, 0,0, 0,0);
+    }
+  
+  //! load only rows in_first to in_last (inclusive) of the stored object
+  inline
+  const opts
+  rows(const uword in_first, const uword in_last)
+    {
+    return opts(flag_rows, 0, 0,0,0, in_first, in_last, 0,0, 0,0);
+    }
+  
+  //! load only columns in_first to in_last (inclusive) of the stored object
+  inline
+  const opts
+  cols(const uword in_first, const uword in_last)
+    {
+    return opts(flag_cols, 0, 0,0,0, 0,0, in_first, in_last, 0,0);
+    }
+  
+  //! load only slices in_first to in_last (inclusive) of the stored cube
+  inline
+  const opts
+  slices(const uword in_first, const uword in_last)
+    {
+    return opts(flag_slices, 0, 0,0,0, 0,0, 0,0, in_first, in_last);
+    }
   }
 
 
@@ -98,6 +98,8 @@ memory::acquire(const uword n_elem)
   
   arma_check_bad_alloc( (out_memptr == nullptr), "arma::memory::acquire(): out of memory" );
   
+  arma_profile_alloc( sizeof(eT)*n_elem );
+  
   return out_memptr;
   }
 
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup mp_executor
+//! @{
+
+
+// Parallel loops in Armadillo are run either with OpenMP (the default),
+// or on a user-provided thread pool which implements the mp_executor interface.
+// 
+// Example:
+// 
+//   struct my_executor : public arma::mp_executor
+//     {
+//     void parallel_for(const arma::uword n, const arma::mp_task& task, const int n_threads)
+//       {
+//       // split [0,n) into at most n_threads ranges, submit task.run(start,endp1) for each range, and wait
+//       }
+//     
+//     int  n_threads()   const { return pool_size; }
+//     bool in_parallel() const { return is_worker_thread(); }
+//     };
+//   
+//   my_executor ex;
+//   arma::set_executor(ex);     // all subsequent parallel loops use ex
+//   ...
+//   arma::reset_executor();     // back to OpenMP
+// 
+// While a user-provided executor is set, loops which haven't been adapted to mp_task are run serially,
+// so that OpenMP threads are never started in addition to the threads of the pool.
+// 
+// The number of threads can be limited for the calling thread with an mp_hint object:
+// 
+//   {
+//   arma::mp_hint hint(1);  // no parallelism within this scope (on this thread only)
+//   B = exp(A);
+//   }
+
+
+
+//! a parallel loop body, run over ranges of the iteration space
+struct mp_task
+  {
+  virtual ~mp_task() {}
+  
+  //! run iterations [start, endp1)
+  virtual void run(const uword start, const uword endp1) const = 0;
+  };
+
+
+
+//! interface for running parallel loops on a user-provided thread pool
+class mp_executor
+  {
+  public:
+  
+  virtual ~mp_executor() {}
+  
+  //! run task.run() on disjoint ranges which cover [0,n), using at most n_threads threads at a time;
+  //! must return only after all ranges have been processed
+  virtual void parallel_for(const uword n, const mp_task& task, const int n_threads) = 0;
+  
+  //! number of threads available for a parallel loop
+  virtual int n_threads() const = 0;
+  
+  //! true if the calling thread is a worker of the pool; nested parallel loops are run serially
+  virtual bool in_parallel() const = 0;
+  };
+
+
+
+//! limit the number of threads used by parallel loops started from the calling thread, for the lifetime of the object;
+//! n_threads = 1 disables parallelism; hints can be nested, and the innermost hint applies
+class mp_hint
+  {
+  public:
+  
+  inline explicit mp_hint(const int n_threads);
+  inline         ~mp_hint();
+  
+  inline static int get();  //!< current limit for the calling thread; 0 if there is no limit
+  
+  
+  private:
+  
+  const int old_n_threads;
+  
+  inline static int& local_n_threads();
+  
+  mp_hint(const mp_hint&) = delete;
+  mp_hint& operator=(const mp_hint&) = delete;
+  };
+
+
+
+inline
+mp_hint::mp_hint(const int n_threads)
+  : old_n_threads(local_n_threads())
+  {
+  local_n_threads() = (std::max)(int(1), n_threads);
+  }
+
+
+
+inline
+mp_hint::~mp_hint()
+  {
+  local_n_threads() = old_n_threads;
+  }
+
+
+
+inline
+int
+mp_hint::get()
+  {
+  return local_n_threads();
+  }
+
+
+
+inline
+int&
+mp_hint::local_n_threads()
+  {
+  thread_local int n_threads = 0;
+  
+  return n_threads;
+  }
+
+
+
+struct mp_executor_state
+  {
+  #if defined(ARMA_DONT_USE_STD_MUTEX)
+    typedef mp_executor* ptr_type;
+  #else
+    typedef std::atomic<mp_executor*> ptr_type;
+  #endif
+  
+  inline
+  static
+  ptr_type&
+  get_ptr()
+    {
+    static ptr_type ptr(nullptr);
+    
+    return ptr;
+    }
+  
+  //! user-provided executor, or nullptr if OpenMP is used
+  arma_inline
+  static
+  mp_executor*
+  get()
+    {
+    #if defined(ARMA_DONT_USE_STD_MUTEX)
+      return get_ptr();
+    #else
+      return get_ptr().load(std::memory_order_acquire);
+    #endif
+    }
+  
+  inline
+  static
+  void
+  set(mp_executor* ex)
+    {
+    #if defined(ARMA_DONT_USE_STD_MUTEX)
+      get_ptr() = ex;
+    #else
+      get_ptr().store(ex, std::memory_order_release);
+    #endif
+    }
+  };
+
+
+
+//! run all parallel loops on the given executor;
+//! the executor must remain valid until reset_executor() is called or another executor is set;
+//! should not be called while Armadillo functions are running in other threads
+inline
+void
+set_executor(mp_executor& ex)
+  {
+  mp_executor_state::set(&ex);
+  }
+
+
+
+//! run all parallel loops with OpenMP (if enabled)
+inline
+void
+reset_executor()
+  {
+  mp_executor_state::set(nullptr);
+  }
+
+
+
+//! @}
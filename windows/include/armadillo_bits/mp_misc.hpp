@@ -22,9 +22,19 @@
 
 
 
+//! gate for loops which are parallelised directly with OpenMP;
+//! these loops are run serially while a user-provided executor is set, or while mp_hint limits the calling thread to 1 thread
 template<typename eT, const bool use_smaller_thresh = false>
 struct mp_gate
   {
+  arma_inline
+  static
+  bool
+  length_ok(const uword n_elem)
+    {
+    return (is_cx<eT>::yes || use_smaller_thresh) ? (n_elem >= (arma_config::mp_threshold/uword(2))) : (n_elem >= arma_config::mp_threshold);
+    }
+  
   arma_inline
   static
   bool
@@ -32,14 +42,15 @@ struct mp_gate
     {
     #if defined(ARMA_USE_OPENMP)
       {
-      const bool length_ok = (is_cx<eT>::yes || use_smaller_thresh) ? (n_elem >= (arma_config::mp_threshold/uword(2))) : (n_elem >= arma_config::mp_threshold);
+      if(length_ok(n_elem) == false)  { return false; }
       
-      if(length_ok)
-        {
-        if(omp_in_parallel())  { return false; }
-        }
+      if(mp_executor_state::get() != nullptr)  { return false; }
       
-      return length_ok;
+      if(mp_hint::get() == 1)  { return false; }
+      
+      if(omp_in_parallel())  { return false; }
+      
+      return true;
       }
     #else
       {
@@ -49,6 +60,32 @@ struct mp_gate
       }
     #endif
     }
+  
+  //! gate for loops which are run via mp_task_runner, either on a user-provided executor or with OpenMP;
+  //! unlike eval(), this can be true when OpenMP isn't enabled
+  arma_inline
+  static
+  bool
+  eval_task(const uword n_elem)
+    {
+    if(length_ok(n_elem) == false)  { return false; }
+    
+    if(mp_hint::get() == 1)  { return false; }
+    
+    const mp_executor* ex = mp_executor_state::get();
+    
+    if(ex != nullptr)  { return (ex->in_parallel() == false) && (ex->n_threads() > 1); }
+    
+    #if defined(ARMA_USE_OPENMP)
+      {
+      return (omp_in_parallel() == false);
+      }
+    #else
+      {
+      return false;
+      }
+    #endif
+    }
   };
 
 
@@ -66,6 +103,16 @@ struct mp_thread_limit
       int n_threads = int(1);
     #endif
     
+    const mp_executor* ex = mp_executor_state::get();
+    
+    if(ex != nullptr)  { n_threads = (std::min)(int(arma_config::mp_threads), int((std::max)(int(1), ex->n_threads()))); }
+    
+    const int hint = mp_hint::get();
+    
+    if(hint > 0)  { n_threads = (std::min)(n_threads, hint); }
+    
+    arma_profile_region(n_threads);
+    
     return n_threads;
     }
   
@@ -74,6 +121,10 @@ struct mp_thread_limit
   bool
   in_parallel()
     {
+    const mp_executor* ex = mp_executor_state::get();
+    
+    if(ex != nullptr)  { return ex->in_parallel(); }
+    
     #if defined(ARMA_USE_OPENMP)
       {
       return bool(omp_in_parallel());
@@ -88,4 +139,44 @@ struct mp_thread_limit
 
 
 
+//! run a parallel loop over [0,n) on the user-provided executor if one is set, otherwise with OpenMP;
+//! with OpenMP the range is split into one contiguous part per thread, matching schedule(static)
+struct mp_task_runner
+  {
+  inline
+  static
+  void
+  run(const uword n, const mp_task& task)
+    {
+    if(n == 0)  { return; }
+    
+    const int n_threads = mp_thread_limit::get();
+    
+    mp_executor* ex = mp_executor_state::get();
+    
+    if(ex != nullptr)  { ex->parallel_for(n, task, n_threads); return; }
+    
+    #if defined(ARMA_USE_OPENMP)
+      {
+      const uword n_parts = (std::min)(n, uword(n_threads));
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword part=0; part < n_parts; ++part)
+        {
+        const uword start = (n / n_parts) * part + (std::min)(part, n % n_parts);
+        const uword endp1 = start + (n / n_parts) + ((part < (n % n_parts)) ? uword(1) : uword(0));
+        
+        task.run(start, endp1);
+        }
+      }
+    #else
+      {
+      task.run(0, n);
+      }
+    #endif
+    }
+  };
+
+
+
 //! @}
@@ -270,6 +270,13 @@ class gemm
         gemm_emul_tinysq<do_trans_A, use_alpha, use_beta>::apply(C, A, BB, alpha, beta);
         }
       }
+    else
+    if( (A.n_rows <= tinymat_helper::max_n) && (A.n_rows == A.n_cols) && (A.n_rows == B.n_rows) && (B.n_rows == B.n_cols) && (is_cx<eT>::no) )
+      {
+      // small matrices: unrolled code is considerably faster than the overhead of calling BLAS
+      
+      tinymat_helper::apply_gemm<do_trans_A, do_trans_B, use_alpha, use_beta>(A.n_rows, C.memptr(), A.memptr(), B.memptr(), alpha, beta);
+      }
     else
       {
       #if defined(ARMA_USE_ATLAS)
@@ -313,6 +313,11 @@ class gemv
       {
       gemv_emul_tinysq<do_trans_A, use_alpha, use_beta>::apply(y, A, x, alpha, beta);
       }
+    else
+    if( (A.n_rows <= tinymat_helper::max_n) && (A.n_rows == A.n_cols) && (is_cx<eT>::no) )
+      {
+      tinymat_helper::apply_gemv<do_trans_A, use_alpha, use_beta>(A.n_rows, y, A.memptr(), x, alpha, beta);
+      }
     else
       {
       #if defined(ARMA_USE_ATLAS)
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+namespace newarp
+{
+
+
+//! Define matrix operations via a user function, without forming the matrix
+template<typename eT>
+class FuncMatProd
+  {
+  private:
+  
+  const typename eigs_fn<eT>::type& op_fn;
+  
+  
+  public:
+  
+  const uword n_rows;  // number of rows of the underlying operator
+  const uword n_cols;  // number of columns of the underlying operator
+  
+  inline FuncMatProd(const typename eigs_fn<eT>::type& fn_obj, const uword n);
+  
+  inline void perform_op(eT* x_in, eT* y_out) const;
+  };
+
+
+}  // namespace newarp
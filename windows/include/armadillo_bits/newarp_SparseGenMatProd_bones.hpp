@@ -28,13 +28,23 @@ class SparseGenMatProd
   
   const SpMat<eT>& op_mat;
   
+  const bool is_sym;  // op_mat is symmetric, so each column of op_mat also gives a row
+  
+          podarray<uword> part_col;  // boundaries of the column ranges used by the partitioned product; empty if not used
+  mutable podarray<eT>    partial;   // partial results of column ranges 1 onwards, n_rows elements per range
+  
+  inline void perform_op_parts(const eT* x_in, eT* y_out) const;
+  inline void perform_op_part(const eT* x_in, eT* y_out, const uword part) const;
+  
   
   public:
   
+  static constexpr uword n_parts = 8;  //!< number of column ranges for the product of non-symmetric matrices; fixed so results do not depend on the thread count
+  
   const uword n_rows;  // number of rows of the underlying matrix
   const uword n_cols;  // number of columns of the underlying matrix
   
-  inline SparseGenMatProd(const SpMat<eT>& mat_obj);
+  inline SparseGenMatProd(const SpMat<eT>& mat_obj, const bool is_symmetric = false);
   
   inline void perform_op(eT* x_in, eT* y_out) const;
   };
@@ -22,12 +22,41 @@ namespace newarp
 
 template<typename eT>
 inline
-SparseGenMatProd<eT>::SparseGenMatProd(const SpMat<eT>& mat_obj)
+SparseGenMatProd<eT>::SparseGenMatProd(const SpMat<eT>& mat_obj, const bool is_symmetric)
   : op_mat(mat_obj)
+  , is_sym(is_symmetric)
   , n_rows(mat_obj.n_rows)
   , n_cols(mat_obj.n_cols)
   {
   arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    // a symmetric matrix is multiplied row by row directly (see perform_op()), which needs no extra memory;
+    // otherwise the columns are split into n_parts ranges with about the same number of non-zeros,
+    // each accumulated into its own partial result; this avoids storing a transposed copy of the matrix
+    
+    if( (is_sym == false) && (op_mat.n_nonzero >= (n_parts * arma_config::mp_threshold)) && (n_cols >= n_parts) )
+      {
+      op_mat.sync();
+      
+      part_col.set_size(n_parts + 1);
+      
+      const uword* col_ptrs = op_mat.col_ptrs;
+      
+      for(uword part=0; part < n_parts; ++part)
+        {
+        const uword target = (op_mat.n_nonzero / n_parts) * part;
+        
+        part_col[part] = uword( std::lower_bound(col_ptrs, col_ptrs + n_cols, target) - col_ptrs );
+        }
+      
+      part_col[n_parts] = n_cols;
+      
+      partial.set_size((n_parts - 1) * n_rows);
+      }
+    }
+  #endif
   }
 
 
@@ -41,6 +70,41 @@ SparseGenMatProd<eT>::perform_op(eT* x_in, eT* y_out) const
   {
   arma_extra_debug_sigprint();
   
+  if(part_col.n_elem > 0)  { perform_op_parts(x_in, y_out); return; }
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(is_sym && mp_gate<eT>::eval(op_mat.n_nonzero) && (mp_thread_limit::get() > 1))
+      {
+      // as op_mat is symmetric, column j also holds the elements of row j;
+      // the elements are accumulated in the same order as by the serial product
+      
+      op_mat.sync();
+      
+      const eT*    values      = op_mat.values;
+      const uword* row_indices = op_mat.row_indices;
+      const uword* col_ptrs    = op_mat.col_ptrs;
+      
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword row=0; row < n_rows; ++row)
+        {
+        const uword index_start = col_ptrs[row    ];
+        const uword index_endp1 = col_ptrs[row + 1];
+        
+        eT acc = eT(0);
+        
+        for(uword i=index_start; i < index_endp1; ++i)  { acc += values[i] * x_in[ row_indices[i] ]; }
+        
+        y_out[row] = acc;
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
   const Col<eT> x(x_in , n_cols, false, true);
         Col<eT> y(y_out, n_rows, false, true);
   
@@ -48,4 +112,89 @@ SparseGenMatProd<eT>::perform_op(eT* x_in, eT* y_out) const
   }
 
 
+
+//! product via n_parts column ranges; the ranges are processed in parallel if possible,
+//! and the partial results are always added in the same order, so the result does not depend on the thread count
+template<typename eT>
+inline
+void
+SparseGenMatProd<eT>::perform_op_parts(const eT* x_in, eT* y_out) const
+  {
+  arma_extra_debug_sigprint();
+  
+  bool done = false;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(op_mat.n_nonzero))
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword part=0; part < n_parts; ++part)
+        {
+        perform_op_part(x_in, y_out, part);
+        }
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword row=0; row < n_rows; ++row)
+        {
+        eT acc = y_out[row];
+        
+        for(uword part=1; part < n_parts; ++part)  { acc += partial[(part-1)*n_rows + row]; }
+        
+        y_out[row] = acc;
+        }
+      
+      done = true;
+      }
+    }
+  #endif
+  
+  if(done == false)
+    {
+    for(uword part=0; part < n_parts; ++part)  { perform_op_part(x_in, y_out, part); }
+    
+    for(uword row=0; row < n_rows; ++row)
+      {
+      eT acc = y_out[row];
+      
+      for(uword part=1; part < n_parts; ++part)  { acc += partial[(part-1)*n_rows + row]; }
+      
+      y_out[row] = acc;
+      }
+    }
+  }
+
+
+
+//! accumulate the product of the given column range into y_out (range 0) or into its partial result
+template<typename eT>
+inline
+void
+SparseGenMatProd<eT>::perform_op_part(const eT* x_in, eT* y_out, const uword part) const
+  {
+  eT* out_mem = (part == 0) ? y_out : (partial.memptr() + (part-1)*n_rows);
+  
+  arrayops::fill_zeros(out_mem, n_rows);
+  
+  const eT*    values      = op_mat.values;
+  const uword* row_indices = op_mat.row_indices;
+  const uword* col_ptrs    = op_mat.col_ptrs;
+  
+  const uword col_start = part_col[part    ];
+  const uword col_endp1 = part_col[part + 1];
+  
+  for(uword col=col_start; col < col_endp1; ++col)
+    {
+    const eT x_val = x_in[col];
+    
+    const uword index_start = col_ptrs[col    ];
+    const uword index_endp1 = col_ptrs[col + 1];
+    
+    for(uword i=index_start; i < index_endp1; ++i)  { out_mem[ row_indices[i] ] += values[i] * x_val; }
+    }
+  }
+
+
 }  // namespace newarp
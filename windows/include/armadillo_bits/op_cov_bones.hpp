@@ -29,6 +29,27 @@ class op_cov
   
   template<typename T1> inline static void apply(Mat<typename T1::elem_type>& out, const Op< T1,               op_cov>& in);
   template<typename T1> inline static void apply(Mat<typename T1::elem_type>& out, const Op< Op<T1,op_htrans>, op_cov>& in);
+  
+  //! running state of the blocked algorithm
+  template<typename eT>
+  struct moments
+    {
+    typedef typename get_pod_type<eT>::result T;
+    
+    Mat<eT> M;               //!< weighted sum of cross-products of deviations from the means
+    Row<eT> mean_a;
+    Row<eT> mean_b;
+    T       sum_w  = T(0);
+    T       sum_w2 = T(0);   //!< sum of squared weights
+    };
+  
+  template<typename eT> inline static void apply_blocked(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>* B, const typename get_pod_type<eT>::result* w, const uword norm_type, const bool obs_in_cols);
+  
+  template<typename eT> inline static void accumulate(moments<eT>& acc, const Mat<eT>& A, const Mat<eT>* B, const Row<eT>& shift_a, const Row<eT>& shift_b, const typename get_pod_type<eT>::result* w, const bool obs_in_cols, const uword i_start, const uword i_end, const uword block_len);
+  
+  template<typename eT> inline static void merge(moments<eT>& acc, const Row<eT>& mean_a, const Row<eT>& mean_b, const typename get_pod_type<eT>::result sum_w, const bool self);
+  
+  template<typename eT> inline static void weighted_mean(Row<eT>& out, const Mat<eT>& X, const typename get_pod_type<eT>::result* w, const typename get_pod_type<eT>::result sum_w);
   };
 
 
@@ -46,13 +46,7 @@ op_cov::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_cov>& in)
                       ? Mat<eT>(const_cast<eT*>(A.memptr()), A.n_cols, A.n_rows, false, false)
                       : Mat<eT>(const_cast<eT*>(A.memptr()), A.n_rows, A.n_cols, false, false);
   
-  const uword N        = AA.n_rows;
-  const eT    norm_val = (norm_type == 0) ? ( (N > 1) ? eT(N-1) : eT(1) ) : eT(N);
-  
-  const Mat<eT> tmp = AA.each_row() - mean(AA,0);
-  
-  out = tmp.t() * tmp;
-  out /= norm_val;
+  op_cov::apply_blocked<eT>(out, AA, nullptr, nullptr, norm_type, false);
   }
 
 
@@ -89,13 +83,271 @@ op_cov::apply(Mat<typename T1::elem_type>& out, const Op< Op<T1,op_htrans>, op_c
                         ? Mat<eT>(const_cast<eT*>(A.memptr()), A.n_cols, A.n_rows, false, false)
                         : Mat<eT>(const_cast<eT*>(A.memptr()), A.n_rows, A.n_cols, false, false);
     
-    const uword N        = AA.n_cols;
-    const eT    norm_val = (norm_type == 0) ? ( (N > 1) ? eT(N-1) : eT(1) ) : eT(N);
+    op_cov::apply_blocked<eT>(out, AA, nullptr, nullptr, norm_type, true);
+    }
+  }
+
+
+
+//! Covariance of the columns of A (or of A and B), computed over blocks of observations:
+//! each block is centred about its own mean and added to a running sum of cross-products,
+//! which is corrected for the difference between the block mean and the running mean (pairwise update of Chan et al).
+//! Only one block is centred at a time, so memory use does not grow with the number of observations.
+//! Observations are the rows of A and B, or the columns of A if obs_in_cols is true (B must then be nullptr).
+//! If w is not nullptr, it holds one non-negative weight per observation;
+//! the unbiased estimate (norm_type = 0) then treats the weights as reliability weights.
+template<typename eT>
+inline
+void
+op_cov::apply_blocked(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>* B, const typename get_pod_type<eT>::result* w, const uword norm_type, const bool obs_in_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const uword N = (obs_in_cols) ? A.n_cols : A.n_rows;
+  const uword p = (obs_in_cols) ? A.n_rows : A.n_cols;
+  const uword q = (B == nullptr) ? p : B->n_cols;
+  
+  // observations per block: enough for an efficient matrix multiply, few enough for the block to stay in cache
+  
+  const uword block_len = (std::max)( uword(256), uword(262144) / (std::max)(p,q) );
+  const uword n_blocks  = (N + block_len - 1) / block_len;
+  
+  // The observations are shifted by the mean of the first block before accumulation,
+  // so that the block means are close to zero and the pairwise updates lose little precision
+  // when the data has a large offset.
+  
+  Row<eT> shift_a;
+  Row<eT> shift_b;
+  
+  const uword n_first = (std::min)(N, block_len);
+  
+  if(obs_in_cols)  { shift_a = mean(A.head_cols(n_first), 1).st(); }  else  { shift_a = mean(A.head_rows(n_first), 0); }
+  
+  if(B != nullptr)  { shift_b = mean(B->head_rows(n_first), 0); }
+  
+  uword n_threads = 1;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_blocks > 1) && mp_gate<eT>::eval(N * (std::max)(p,q)) )
+      {
+      n_threads = (std::min)( uword(mp_thread_limit::get()), n_blocks );
+      
+      // each thread has its own p x q accumulator; don't let these exceed the size of the input
+      while( (n_threads > 1) && ((n_threads * p * q) > (N * (std::max)(p,q))) )  { --n_threads; }
+      }
+    }
+  #endif
+  
+  std::vector< moments<eT> > part(n_threads);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword i_start = (std::min)( N, block_len * ((n_blocks *  t   ) / n_threads) );
+      const uword i_end   = (std::min)( N, block_len * ((n_blocks * (t+1)) / n_threads) );
+      
+      op_cov::accumulate(part[t], A, B, shift_a, shift_b, w, obs_in_cols, i_start, i_end, block_len);
+      }
+    }
+  #else
+    {
+    arma_ignore(n_blocks);
+    
+    op_cov::accumulate(part[0], A, B, shift_a, shift_b, w, obs_in_cols, uword(0), N, block_len);
+    }
+  #endif
+  
+  moments<eT>& acc = part[0];
+  
+  for(uword t=1; t < n_threads; ++t)
+    {
+    acc.M += part[t].M;
+    
+    op_cov::merge(acc, part[t].mean_a, part[t].mean_b, part[t].sum_w, (B == nullptr));
+    
+    acc.sum_w2 += part[t].sum_w2;
+    }
+  
+  const T V1 = acc.sum_w;
+  const T V2 = acc.sum_w2;
+  
+  const T unbiased_norm = V1 - (V2 / V1);  // N-1 for unit weights
+  
+  const T norm_val = ( (norm_type == 0) && (unbiased_norm > T(0)) ) ? unbiased_norm : V1;
+  
+  out.steal_mem(acc.M);
+  out /= eT(norm_val);
+  }
+
+
+
+//! start a new set of moments from observations i_start to i_end-1
+template<typename eT>
+inline
+void
+op_cov::accumulate(moments<eT>& acc, const Mat<eT>& A, const Mat<eT>* B, const Row<eT>& shift_a, const Row<eT>& shift_b, const typename get_pod_type<eT>::result* w, const bool obs_in_cols, const uword i_start, const uword i_end, const uword block_len)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const bool self = (B == nullptr);
+  
+  const uword p = (obs_in_cols) ? A.n_rows : A.n_cols;
+  const uword q = (self) ? p : B->n_cols;
+  
+  acc.M.zeros(p,q);
+  
+  Mat<eT> Xa;
+  Mat<eT> Xb;
+  
+  Row<eT> block_mean_a;
+  Row<eT> block_mean_b;
+  
+  podarray<T> scale;
+  
+  for(uword a=i_start; a < i_end; a += block_len)
+    {
+    const uword b = (std::min)(a + block_len, i_end) - 1;
+    const uword n = b - a + 1;
     
-    const Mat<eT> tmp = AA.each_col() - mean(AA,1);
+    if(obs_in_cols)  { Xa = A.cols(a,b).st(); }  else  { Xa = A.rows(a,b); }
+    
+    Xa.each_row() -= shift_a;
+    
+    if(self == false)  { Xb = B->rows(a,b);  Xb.each_row() -= shift_b; }
+    
+    const T* w_block = (w != nullptr) ? (w + a) : nullptr;
+    
+    T block_w  = T(n);
+    T block_w2 = T(n);
+    
+    if(w_block != nullptr)
+      {
+      block_w  = T(0);
+      block_w2 = T(0);
+      
+      for(uword i=0; i < n; ++i)  { block_w += w_block[i];  block_w2 += w_block[i] * w_block[i]; }
+      
+      if(block_w == T(0))  { continue; }
+      }
+    
+    op_cov::weighted_mean(block_mean_a, Xa, w_block, block_w);
+    
+    Xa.each_row() -= block_mean_a;
+    
+    if(self == false)
+      {
+      op_cov::weighted_mean(block_mean_b, Xb, w_block, block_w);
+      
+      Xb.each_row() -= block_mean_b;
+      }
+    
+    if(w_block != nullptr)
+      {
+      // scale the deviations so that a single product gives the weighted sum of cross-products
+      
+      scale.set_size(n);
+      
+      for(uword i=0; i < n; ++i)  { scale[i] = (self) ? std::sqrt(w_block[i]) : w_block[i]; }
+      
+      for(uword j=0; j < p; ++j)
+        {
+        eT* col_mem = Xa.colptr(j);
+        
+        for(uword i=0; i < n; ++i)  { col_mem[i] *= scale[i]; }
+        }
+      }
+    
+    if(self)  { acc.M += Xa.t() * Xa; }  else  { acc.M += Xa.t() * Xb; }
+    
+    op_cov::merge(acc, block_mean_a, block_mean_b, block_w, self);
+    
+    acc.sum_w2 += block_w2;
+    }
+  }
+
+
+
+//! update the running means and total weight with a set of observations summarised by its means and total weight,
+//! and add the correction for the difference in means to the sum of cross-products;
+//! the caller adds the cross-products of the new observations about their own means
+template<typename eT>
+inline
+void
+op_cov::merge(moments<eT>& acc, const Row<eT>& mean_a, const Row<eT>& mean_b, const typename get_pod_type<eT>::result sum_w, const bool self)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  if(sum_w == T(0))  { return; }
+  
+  if(acc.sum_w == T(0))
+    {
+    acc.mean_a = mean_a;
+    acc.mean_b = mean_b;
+    acc.sum_w  = sum_w;
+    
+    return;
+    }
+  
+  const T new_w = acc.sum_w + sum_w;
+  const T coeff = (acc.sum_w / new_w) * sum_w;
+  const T ratio = sum_w / new_w;
+  
+  const Row<eT> delta_a = mean_a - acc.mean_a;
+  
+  if(self)
+    {
+    acc.M += (eT(coeff) * delta_a).t() * delta_a;
+    }
+  else
+    {
+    const Row<eT> delta_b = mean_b - acc.mean_b;
+    
+    acc.M += (eT(coeff) * delta_a).t() * delta_b;
+    
+    acc.mean_b += eT(ratio) * delta_b;
+    }
+  
+  acc.mean_a += eT(ratio) * delta_a;
+  acc.sum_w   = new_w;
+  }
+
+
+
+template<typename eT>
+inline
+void
+op_cov::weighted_mean(Row<eT>& out, const Mat<eT>& X, const typename get_pod_type<eT>::result* w, const typename get_pod_type<eT>::result sum_w)
+  {
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  out.set_size(X_n_cols);
+  
+  for(uword j=0; j < X_n_cols; ++j)
+    {
+    const eT* col_mem = X.colptr(j);
+    
+    eT acc = eT(0);
+    
+    if(w != nullptr)
+      {
+      for(uword i=0; i < X_n_rows; ++i)  { acc += w[i] * col_mem[i]; }
+      }
+    else
+      {
+      acc = arrayops::accumulate(col_mem, X_n_rows);
+      }
     
-    out = tmp * tmp.t();
-    out /= norm_val;
+    out[j] = acc / eT(sum_w);
     }
   }
 
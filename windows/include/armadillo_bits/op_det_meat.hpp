@@ -49,6 +49,26 @@ op_det::apply_direct(typename T1::elem_type& out_val, const Base<typename T1::el
     return true;
     }
   
+  if( (is_cx<eT>::no) && (is_Mat<T1>::value) )
+    {
+    // small matrices (eg. fixed size) are handled without a copy and without LAPACK
+    
+    const unwrap<T1> U(expr.get_ref());
+    
+    const uword N = U.M.n_rows;
+    
+    if( (N > 4) && (N <= tinymat_helper::max_n) && (N == U.M.n_cols) )
+      {
+      eT det_val = eT(0);
+      
+      tinymat_helper::apply_det(det_val, N, U.M.memptr());
+      
+      if(arma_isfinite(det_val))  { out_val = det_val; return true; }
+      
+      // fallthrough if det_val is suspect
+      }
+    }
+  
   Mat<eT> A(expr.get_ref());
   
   arma_debug_check( (A.is_square() == false), "det(): given matrix must be square sized" );
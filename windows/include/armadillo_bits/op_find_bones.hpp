@@ -79,6 +79,47 @@ class op_find
   
   template<typename T1>
   inline static void apply(Mat<uword>& out, const mtOp<uword, T1, op_find>& X);
+  
+  template<typename functor>
+  inline static bool helper_mt(Mat<uword>& indices, uword& n_nz, const uword n_elem, const functor& is_found);
+  
+  //
+  // element tests for helper_mt()
+  
+  template<typename ea_type, typename eT>
+  struct test_nonzero
+    {
+    const ea_type PA;
+    
+    arma_inline bool operator()(const uword i) const { return (PA[i] != eT(0)); }
+    };
+  
+  template<typename op_type, typename ea_type, typename eT>
+  struct test_rel
+    {
+    const ea_type PA;
+    const eT      val;
+    
+    inline bool operator()(const uword i) const;
+    };
+  
+  template<typename glue_type, typename ea_type1, typename ea_type2>
+  struct test_rel_glue
+    {
+    const ea_type1 PA;
+    const ea_type2 PB;
+    
+    inline bool operator()(const uword i) const;
+    };
+  
+  template<typename ea_type>
+  struct test_finite
+    {
+    const ea_type PA;
+    const bool    finite;
+    
+    inline bool operator()(const uword i) const;
+    };
   };
 
 
@@ -39,6 +39,15 @@ op_find::helper
   
   const uword n_elem = A.get_n_elem();
   
+  if(Proxy<T1>::use_at == false)
+    {
+    const test_nonzero<typename Proxy<T1>::ea_type, eT> is_found = { A.get_ea() };
+    
+    uword n_found = 0;
+    
+    if(op_find::helper_mt(indices, n_found, n_elem, is_found))  { return n_found; }
+    }
+  
   indices.set_size(n_elem, 1);
   
   uword* indices_mem = indices.memptr();
@@ -102,6 +111,15 @@ op_find::helper
   
   const uword n_elem = A.get_n_elem();
   
+  if(Proxy<T1>::use_at == false)
+    {
+    const test_rel<op_type, typename Proxy<T1>::ea_type, eT> is_found = { A.get_ea(), val };
+    
+    uword n_found = 0;
+    
+    if(op_find::helper_mt(indices, n_found, n_elem, is_found))  { return n_found; }
+    }
+  
   indices.set_size(n_elem, 1);
   
   uword* indices_mem = indices.memptr();
@@ -317,6 +335,15 @@ op_find::helper
   
   const uword n_elem = A.get_n_elem();
   
+  if((Proxy<T1>::use_at == false) && (Proxy<T2>::use_at == false))
+    {
+    const test_rel_glue<glue_type, ea_type1, ea_type2> is_found = { A.get_ea(), B.get_ea() };
+    
+    uword n_found = 0;
+    
+    if(op_find::helper_mt(indices, n_found, n_elem, is_found))  { return n_found; }
+    }
+  
   indices.set_size(n_elem, 1);
   
   uword* indices_mem = indices.memptr();
@@ -490,6 +517,140 @@ op_find::apply(Mat<uword>& out, const mtOp<uword, T1, op_find>& X)
 
 
 
+//! Two-pass parallel search: each thread counts the found elements in its part of the input,
+//! then writes their indices directly to their final position, given by the counts of the preceding parts.
+//! The output is allocated with its final size, so no full-size temporary is needed.
+//! Returns false if the serial search should be used instead.
+template<typename functor>
+inline
+bool
+op_find::helper_mt(Mat<uword>& indices, uword& n_nz, const uword n_elem, const functor& is_found)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<uword>::eval(n_elem))
+      {
+      const uword n_threads = uword(mp_thread_limit::get());
+      
+      if(n_threads < 2)  { return false; }
+      
+      const uword part_len = n_elem / n_threads;
+      
+      podarray<uword> part_offset(n_threads);
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword i_start = t * part_len;
+        const uword i_end   = (t+1 == n_threads) ? n_elem : (i_start + part_len);
+        
+        uword count = 0;
+        
+        for(uword i=i_start; i < i_end; ++i)  { count += (is_found(i)) ? uword(1) : uword(0); }
+        
+        part_offset[t] = count;
+        }
+      
+      n_nz = 0;
+      
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword count = part_offset[t];
+        
+        part_offset[t] = n_nz;
+        
+        n_nz += count;
+        }
+      
+      indices.set_size(n_nz, 1);
+      
+      uword* indices_mem = indices.memptr();
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword i_start = t * part_len;
+        const uword i_end   = (t+1 == n_threads) ? n_elem : (i_start + part_len);
+        
+        uword* out_mem = indices_mem + part_offset[t];
+        
+        for(uword i=i_start; i < i_end; ++i)
+          {
+          if(is_found(i))  { (*out_mem) = i;  ++out_mem; }
+          }
+        }
+      
+      return true;
+      }
+    }
+  #else
+    {
+    arma_ignore(indices);
+    arma_ignore(n_nz);
+    arma_ignore(n_elem);
+    arma_ignore(is_found);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename op_type, typename ea_type, typename eT>
+inline
+bool
+op_find::test_rel<op_type, ea_type, eT>::operator()(const uword i) const
+  {
+  const eT tmp = PA[i];
+  
+       if(is_same_type<op_type, op_rel_lt_pre   >::yes)  { return (val <  tmp); }
+  else if(is_same_type<op_type, op_rel_lt_post  >::yes)  { return (tmp <  val); }
+  else if(is_same_type<op_type, op_rel_gt_pre   >::yes)  { return (val >  tmp); }
+  else if(is_same_type<op_type, op_rel_gt_post  >::yes)  { return (tmp >  val); }
+  else if(is_same_type<op_type, op_rel_lteq_pre >::yes)  { return (val <= tmp); }
+  else if(is_same_type<op_type, op_rel_lteq_post>::yes)  { return (tmp <= val); }
+  else if(is_same_type<op_type, op_rel_gteq_pre >::yes)  { return (val >= tmp); }
+  else if(is_same_type<op_type, op_rel_gteq_post>::yes)  { return (tmp >= val); }
+  else if(is_same_type<op_type, op_rel_eq       >::yes)  { return (tmp == val); }
+  else if(is_same_type<op_type, op_rel_noteq    >::yes)  { return (tmp != val); }
+  
+  return false;
+  }
+
+
+
+template<typename glue_type, typename ea_type1, typename ea_type2>
+inline
+bool
+op_find::test_rel_glue<glue_type, ea_type1, ea_type2>::operator()(const uword i) const
+  {
+       if(is_same_type<glue_type, glue_rel_lt    >::yes)  { return (PA[i] <  PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_gt    >::yes)  { return (PA[i] >  PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_lteq  >::yes)  { return (PA[i] <= PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_gteq  >::yes)  { return (PA[i] >= PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_eq    >::yes)  { return (PA[i] == PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_noteq >::yes)  { return (PA[i] != PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_and   >::yes)  { return (PA[i] && PB[i]); }
+  else if(is_same_type<glue_type, glue_rel_or    >::yes)  { return (PA[i] || PB[i]); }
+  
+  return false;
+  }
+
+
+
+template<typename ea_type>
+inline
+bool
+op_find::test_finite<ea_type>::operator()(const uword i) const
+  {
+  return (arma_isfinite(PA[i]) == finite);
+  }
+
+
+
 //
 
 
@@ -524,6 +685,16 @@ op_find_finite::apply(Mat<uword>& out, const mtOp<uword, T1, op_find_finite>& X)
   
   const uword n_elem = P.get_n_elem();
   
+  if(Proxy<T1>::use_at == false)
+    {
+    const op_find::test_finite<typename Proxy<T1>::ea_type> is_found = { P.get_ea(), true };
+    
+    Mat<uword> indices;
+    uword      n_found = 0;
+    
+    if(op_find::helper_mt(indices, n_found, n_elem, is_found))  { out.steal_mem_col(indices, n_found); return; }
+    }
+  
   Mat<uword> indices(n_elem, 1, arma_nozeros_indicator());
   
   uword* indices_mem = indices.memptr();
@@ -570,6 +741,16 @@ op_find_nonfinite::apply(Mat<uword>& out, const mtOp<uword, T1, op_find_nonfinit
   
   const uword n_elem = P.get_n_elem();
   
+  if(Proxy<T1>::use_at == false)
+    {
+    const op_find::test_finite<typename Proxy<T1>::ea_type> is_found = { P.get_ea(), false };
+    
+    Mat<uword> indices;
+    uword      n_found = 0;
+    
+    if(op_find::helper_mt(indices, n_found, n_elem, is_found))  { out.steal_mem_col(indices, n_found); return; }
+    }
+  
   Mat<uword> indices(n_elem, 1, arma_nozeros_indicator());
   
   uword* indices_mem = indices.memptr();
@@ -183,6 +183,13 @@ op_inv_gen_full::apply_direct(Mat<typename T1::elem_type>& out, const Base<typen
       {
       const bool status = op_inv_gen_full::apply_tiny_4x4(out);
       
+      if(status)  { return true; }
+      }
+    else
+    if((N <= tinymat_helper::max_n) && tiny)
+      {
+      const bool status = tinymat_helper::apply_inv(out.memptr(), N, out.memptr());
+      
       if(status)  { return true; }
       }
     
@@ -54,6 +54,12 @@ class op_max
   //
   // for non-complex numbers
   
+  template<typename eT>
+  inline static void apply_slices(eT* out_mem, const Cube<eT>& X);
+  
+  template<typename eT>
+  arma_hot inline static void apply_slices_tile(eT* out_mem, const Cube<eT>& X, const uword start, const uword endp1);
+  
   template<typename eT>
   inline static eT direct_max(const eT* const X, const uword N);
   
@@ -335,12 +335,9 @@ op_mean::apply_noalias_unwrap(Cube<typename T1::elem_type>& out, const ProxyCube
     
     if(X_n_slices == 0)  { return; }
     
-    eT* out_mem = out.memptr();
+    const ProxyCube< Cube<eT> > PX(X);
     
-    for(uword slice=0; slice < X_n_slices; ++slice)
-      {
-      arrayops::inplace_plus(out_mem, X.slice_memptr(slice), X.n_elem_slice );
-      }
+    op_sum::apply_slices(out, PX);
     
     out /= T(X_n_slices);
     
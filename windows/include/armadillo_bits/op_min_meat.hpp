@@ -250,23 +250,7 @@ op_min::apply_noalias(Cube<eT>& out, const Cube<eT>& X, const uword dim, const t
     
     if(X_n_slices == 0)  { return; }
     
-    const uword N = X.n_elem_slice;
-    
-    eT* out_mem = out.slice_memptr(0);
-    
-    arrayops::copy(out_mem, X.slice_memptr(0), N);
-    
-    for(uword slice=1; slice < X_n_slices; ++slice)
-      {
-      const eT* X_mem = X.slice_memptr(slice);
-      
-      for(uword i=0; i < N; ++i)
-        {
-        const eT val = X_mem[i];
-        
-        if(val < out_mem[i])  { out_mem[i] = val; }
-        }
-      }
+    op_min::apply_slices(out.memptr(), X);
     }
   }
 
@@ -1322,4 +1306,92 @@ op_min::min_with_index(const ProxyCube<T1>& P, uword& index_of_min_val)
 
 
 
+
+
+//! min along the slice dimension, for non-complex numbers.
+//! the output is processed in cache-resident tiles; with OpenMP the tiles are distributed across threads
+template<typename eT>
+inline
+void
+op_min::apply_slices(eT* out_mem, const Cube<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N        = X.n_elem_slice;
+  const uword n_slices = X.n_slices;
+  
+  if( (N == 0) || (n_slices == 0) )  { return; }
+  
+  uword tile_len = op_sum::slice_tile_len;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(X.n_elem))
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      // use smaller tiles if needed to give the threads some work, but not so small as to share cache lines;
+      // the tile count is fixed rather than derived from n_threads, so the partition is the same for any thread count
+      tile_len = (std::max)( uword(64), (std::min)( tile_len, (N + op_sum::slice_n_parts - 1) / op_sum::slice_n_parts ) );
+      
+      const uword n_tiles = (N + tile_len - 1) / tile_len;
+      
+      if(n_tiles > 1)
+        {
+        #pragma omp parallel for schedule(static) num_threads(n_threads)
+        for(uword tile=0; tile < n_tiles; ++tile)
+          {
+          const uword start = tile * tile_len;
+          const uword endp1 = (std::min)(N, start + tile_len);
+          
+          op_min::apply_slices_tile(out_mem, X, start, endp1);
+          }
+        
+        return;
+        }
+      }
+    }
+  #endif
+  
+  const uword n_tiles = (N + tile_len - 1) / tile_len;
+  
+  for(uword tile=0; tile < n_tiles; ++tile)
+    {
+    const uword start = tile * tile_len;
+    const uword endp1 = (std::min)(N, start + tile_len);
+    
+    op_min::apply_slices_tile(out_mem, X, start, endp1);
+    }
+  }
+
+
+
+template<typename eT>
+arma_hot
+inline
+void
+op_min::apply_slices_tile(eT* out_mem, const Cube<eT>& X, const uword start, const uword endp1)
+  {
+  const uword N = endp1 - start;
+  
+  eT* out_tile = &(out_mem[start]);
+  
+  arrayops::copy(out_tile, &(X.slice_memptr(0)[start]), N);
+  
+  const uword n_slices = X.n_slices;
+  
+  for(uword slice=1; slice < n_slices; ++slice)
+    {
+    const eT* X_mem = &(X.slice_memptr(slice)[start]);
+    
+    for(uword i=0; i < N; ++i)
+      {
+      const eT val = X_mem[i];
+      
+      if(val < out_tile[i])  { out_tile[i] = val; }
+      }
+    }
+  }
+
+
 //! @}
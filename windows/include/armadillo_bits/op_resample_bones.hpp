@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup op_resample
+//! @{
+
+
+
+class op_resample
+  : public traits_op_default
+  {
+  public:
+  
+  //! precomputed separable weights for resampling one dimension;
+  //! output element o is the weighted sum of input elements start[o] ... start[o]+n_taps-1, divided by divisor
+  template<typename T>
+  struct weights
+    {
+    uword           n_in    = 0;
+    uword           n_out   = 0;
+    uword           n_taps  = 0;
+    T               divisor = T(1);
+    podarray<uword> start;
+    podarray<T>     w;
+    };
+  
+  inline static uword parse_method(const char* method);
+  
+  template<typename T> inline static void build_weights(weights<T>& W, const uword n_in, const uword n_out, const uword method_id);
+  
+  template<typename eT, typename T> arma_hot inline static void apply_rows(Mat<eT>& out, const Mat<eT>& A, const weights<T>& W, const bool allow_mp);
+  template<typename eT, typename T> arma_hot inline static void apply_cols(Mat<eT>& out, const Mat<eT>& A, const weights<T>& W, const bool allow_mp);
+  
+  template<typename T> inline static bool rows_first(const uword n_rows, const uword n_cols, const weights<T>& W_rows, const weights<T>& W_cols);
+  
+  template<typename eT, typename T> inline static void apply_mat_weights(Mat<eT>& out, Mat<eT>& tmp, const Mat<eT>& A, const weights<T>& W_rows, const weights<T>& W_cols, const bool allow_mp);
+  
+  template<typename eT> inline static void apply_mat_noalias(Mat<eT>& out, const Mat<eT>& A, const uword new_n_rows, const uword new_n_cols, const uword method_id);
+  
+  template<typename T1> inline static void apply(Mat<typename T1::elem_type>& out, const Op<T1,op_resample>& in);
+  
+  //
+  
+  template<typename T1> inline static void apply(Cube<typename T1::elem_type>& out, const OpCube<T1,op_resample>& in);
+  };
+
+
+
+//! @}
@@ -0,0 +1,510 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup op_resample
+//! @{
+
+
+
+//! method_id = 0: nearest neighbour
+//! method_id = 1: linear
+//! method_id = 2: cubic (Keys kernel with a = -0.5)
+//! method_id = 3: area averaging
+inline
+uword
+op_resample::parse_method(const char* method)
+  {
+  arma_extra_debug_sigprint();
+  
+  const char sig = (method != nullptr) ? method[0] : char(0);
+  
+  arma_debug_check( ((sig != 'n') && (sig != 'l') && (sig != 'c') && (sig != 'a')), "resample(): unsupported interpolation type" );
+  
+  if(sig == 'n')  { return uword(0); }
+  if(sig == 'l')  { return uword(1); }
+  if(sig == 'c')  { return uword(2); }
+  
+  return uword(3);
+  }
+
+
+
+//! the centres of the input and output grids are aligned,
+//! ie. output element o is located at input coordinate (o + 0.5) * (n_in / n_out) - 0.5;
+//! input elements beyond the borders are replaced with the nearest border element
+template<typename T>
+inline
+void
+op_resample::build_weights(weights<T>& W, const uword n_in, const uword n_out, const uword method_id)
+  {
+  arma_extra_debug_sigprint();
+  
+  const double scale = double(n_in) / double(n_out);
+  
+  const bool is_binning = (method_id == 3) && (n_in >= n_out) && ((n_in % n_out) == 0);
+  
+  uword n_taps = 1;
+  
+       if(method_id == 1)  { n_taps = 2; }
+  else if(method_id == 2)  { n_taps = 4; }
+  else if(method_id == 3)  { n_taps = (is_binning) ? (n_in / n_out) : (uword(std::ceil(scale)) + 1); }
+  
+  n_taps = (std::min)(n_taps, n_in);
+  
+  W.n_in    = n_in;
+  W.n_out   = n_out;
+  W.n_taps  = n_taps;
+  W.divisor = T(1);
+  
+  W.start.set_size(n_out);
+  W.w.zeros(n_out * n_taps);
+  
+  uword* start_mem = W.start.memptr();
+  T*         w_mem = W.w.memptr();
+  
+  const sword last = sword(n_in) - 1;
+  
+  double tap_w  [4];
+  sword  tap_idx[4];
+  
+  for(uword o=0; o < n_out; ++o)
+    {
+    T* w_o = &(w_mem[o * n_taps]);
+    
+    if(method_id == 0)
+      {
+      const sword i = (std::min)( sword( std::floor((double(o) + 0.5) * scale) ), last );
+      
+      start_mem[o] = uword(i);
+      w_o[0]       = T(1);
+      }
+    else
+    if(is_binning)
+      {
+      start_mem[o] = o * n_taps;
+      
+      for(uword k=0; k < n_taps; ++k)  { w_o[k] = T(1); }
+      }
+    else
+    if(method_id == 3)
+      {
+      const double lo = double(o    ) * scale;
+      const double hi = double(o + 1) * scale;
+      
+      const sword i_start = (std::min)( sword(std::floor(lo)), last );
+      
+      start_mem[o] = uword(i_start);
+      
+      for(uword k=0; k < n_taps; ++k)
+        {
+        const sword i = i_start + sword(k);
+        
+        if(i > last)  { break; }
+        
+        const double overlap = (std::min)(hi, double(i+1)) - (std::max)(lo, double(i));
+        
+        if(overlap > double(0))  { w_o[k] = T(overlap / scale); }
+        }
+      }
+    else
+      {
+      const double x  = (double(o) + 0.5) * scale - 0.5;
+      const double xf = std::floor(x);
+      const double t  = x - xf;
+      const sword  i0 = sword(xf);
+      
+      uword n_tap_pairs = 0;
+      
+      if(method_id == 1)
+        {
+        tap_idx[0] = i0;      tap_w[0] = double(1) - t;
+        tap_idx[1] = i0 + 1;  tap_w[1] = t;
+        
+        n_tap_pairs = 2;
+        }
+      else
+        {
+        constexpr double a = double(-0.5);
+        
+        for(uword k=0; k < 4; ++k)
+          {
+          const double d = std::abs(t - (double(k) - double(1)));
+          
+          tap_idx[k] = i0 - 1 + sword(k);
+          
+          tap_w[k] = (d <= double(1)) ? (((a + double(2)) * d - (a + double(3))) * d * d + double(1)) : (((a * d - double(5) * a) * d + double(8) * a) * d - double(4) * a);
+          }
+        
+        n_tap_pairs = 4;
+        }
+      
+      // clamping preserves the ordering of the indices, so the first clamped index is the smallest
+      
+      for(uword k=0; k < n_tap_pairs; ++k)  { tap_idx[k] = (std::max)( sword(0), (std::min)(tap_idx[k], last) ); }
+      
+      const sword i_start = tap_idx[0];
+      
+      start_mem[o] = uword(i_start);
+      
+      for(uword k=0; k < n_tap_pairs; ++k)  { w_o[ tap_idx[k] - i_start ] += T(tap_w[k]); }
+      }
+    
+    // ensure that the window does not extend beyond the last input element
+    
+    if( (start_mem[o] + n_taps) > n_in )
+      {
+      const uword shift = start_mem[o] + n_taps - n_in;
+      
+      for(uword k=n_taps; k > shift; --k)  { w_o[k-1] = w_o[k-1-shift]; }
+      for(uword k=0;      k < shift; ++k)  { w_o[k]   = T(0);           }
+      
+      start_mem[o] -= shift;
+      }
+    }
+  
+  if(is_binning)  { W.divisor = T(n_taps); }
+  }
+
+
+
+//! resample along each column; the weighted sum for each output element reads a short contiguous run of input elements
+template<typename eT, typename T>
+arma_hot
+inline
+void
+op_resample::apply_rows(Mat<eT>& out, const Mat<eT>& A, const weights<T>& W, const bool allow_mp)
+  {
+  arma_extra_debug_sigprint();
+  
+  out.set_size(W.n_out, A.n_cols);
+  
+  const uword  n_out     = W.n_out;
+  const uword  n_taps    = W.n_taps;
+  const T      divisor   = W.divisor;
+  const uword* start_mem = W.start.memptr();
+  const T*         w_mem = W.w.memptr();
+  
+  auto worker = [&](const uword col)
+    {
+    const eT* A_colmem   =   A.colptr(col);
+          eT* out_colmem = out.colptr(col);
+    
+    for(uword o=0; o < n_out; ++o)
+      {
+      const eT* A_mem = &(A_colmem[ start_mem[o] ]);
+      const T*  w_o   = &(w_mem[o * n_taps]);
+      
+      eT acc = eT(0);
+      
+      for(uword k=0; k < n_taps; ++k)  { acc += w_o[k] * A_mem[k]; }
+      
+      out_colmem[o] = acc / divisor;
+      }
+    };
+  
+  const uword n_cols = A.n_cols;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( allow_mp && (n_cols > 1) && mp_gate<eT>::eval(out.n_elem * n_taps) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword col=0; col < n_cols; ++col)  { worker(col); }
+      
+      return;
+      }
+    }
+  #else
+    {
+    arma_ignore(allow_mp);
+    }
+  #endif
+  
+  for(uword col=0; col < n_cols; ++col)  { worker(col); }
+  }
+
+
+
+//! resample along each row; each output column is a weighted sum of whole input columns,
+//! so the inner loop runs down contiguous columns and can be vectorised
+template<typename eT, typename T>
+arma_hot
+inline
+void
+op_resample::apply_cols(Mat<eT>& out, const Mat<eT>& A, const weights<T>& W, const bool allow_mp)
+  {
+  arma_extra_debug_sigprint();
+  
+  out.set_size(A.n_rows, W.n_out);
+  
+  const uword  n_rows    = A.n_rows;
+  const uword  n_taps    = W.n_taps;
+  const T      divisor   = W.divisor;
+  const uword* start_mem = W.start.memptr();
+  const T*         w_mem = W.w.memptr();
+  
+  auto worker = [&](const uword o)
+    {
+    const T* w_o = &(w_mem[o * n_taps]);
+    
+    eT* out_colmem = out.colptr(o);
+    
+    const eT* A_colmem = A.colptr(start_mem[o]);
+    
+    const T w0 = w_o[0];
+    
+    for(uword row=0; row < n_rows; ++row)  { out_colmem[row] = w0 * A_colmem[row]; }
+    
+    for(uword k=1; k < n_taps; ++k)
+      {
+      const T wk = w_o[k];
+      
+      if(wk == T(0))  { continue; }
+      
+      A_colmem = A.colptr(start_mem[o] + k);
+      
+      for(uword row=0; row < n_rows; ++row)  { out_colmem[row] += wk * A_colmem[row]; }
+      }
+    
+    if(divisor != T(1))
+      {
+      for(uword row=0; row < n_rows; ++row)  { out_colmem[row] /= divisor; }
+      }
+    };
+  
+  const uword n_out = W.n_out;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( allow_mp && (n_out > 1) && mp_gate<eT>::eval(out.n_elem * n_taps) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword o=0; o < n_out; ++o)  { worker(o); }
+      
+      return;
+      }
+    }
+  #else
+    {
+    arma_ignore(allow_mp);
+    }
+  #endif
+  
+  for(uword o=0; o < n_out; ++o)  { worker(o); }
+  }
+
+
+
+//! the two passes are separable; do first the pass which leaves less work for the second
+template<typename T>
+inline
+bool
+op_resample::rows_first(const uword n_rows, const uword n_cols, const weights<T>& W_rows, const weights<T>& W_cols)
+  {
+  const double cost_rows_first = double(W_rows.n_out) * double(n_cols) * double(W_rows.n_taps) + double(W_rows.n_out) * double(W_cols.n_out) * double(W_cols.n_taps);
+  const double cost_cols_first = double(n_rows) * double(W_cols.n_out) * double(W_cols.n_taps) + double(W_rows.n_out) * double(W_cols.n_out) * double(W_rows.n_taps);
+  
+  return (cost_rows_first <= cost_cols_first);
+  }
+
+
+
+//! resample A using precomputed weights; W_rows and W_cols are empty (n_out = 0) for a dimension which isn't resized;
+//! tmp is workspace for the intermediate result of the two separable passes
+template<typename eT, typename T>
+inline
+void
+op_resample::apply_mat_weights(Mat<eT>& out, Mat<eT>& tmp, const Mat<eT>& A, const weights<T>& W_rows, const weights<T>& W_cols, const bool allow_mp)
+  {
+  arma_extra_debug_sigprint();
+  
+  const bool do_rows = (W_rows.n_out > 0);
+  const bool do_cols = (W_cols.n_out > 0);
+  
+  if( (do_rows == false) && (do_cols == false) )  { out = A; return; }
+  
+  if(do_rows && (do_cols == false))  { op_resample::apply_rows(out, A, W_rows, allow_mp); return; }
+  if(do_cols && (do_rows == false))  { op_resample::apply_cols(out, A, W_cols, allow_mp); return; }
+  
+  if(op_resample::rows_first(A.n_rows, A.n_cols, W_rows, W_cols))
+    {
+    op_resample::apply_rows(tmp, A,   W_rows, allow_mp);
+    op_resample::apply_cols(out, tmp, W_cols, allow_mp);
+    }
+  else
+    {
+    op_resample::apply_cols(tmp, A,   W_cols, allow_mp);
+    op_resample::apply_rows(out, tmp, W_rows, allow_mp);
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+op_resample::apply_mat_noalias(Mat<eT>& out, const Mat<eT>& A, const uword new_n_rows, const uword new_n_cols, const uword method_id)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  if( (new_n_rows == 0) || (new_n_cols == 0) )  { out.set_size(new_n_rows, new_n_cols); return; }
+  
+  arma_debug_check( A.is_empty(), "resample(): given object must not be empty" );
+  
+  weights<T> W_rows;
+  weights<T> W_cols;
+  
+  if(new_n_rows != A.n_rows)  { op_resample::build_weights(W_rows, A.n_rows, new_n_rows, method_id); }
+  if(new_n_cols != A.n_cols)  { op_resample::build_weights(W_cols, A.n_cols, new_n_cols, method_id); }
+  
+  Mat<eT> tmp;
+  
+  op_resample::apply_mat_weights(out, tmp, A, W_rows, W_cols, true);
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_resample::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_resample>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1> U(in.m);
+  
+  if(U.is_alias(out))
+    {
+    Mat<eT> tmp;
+    
+    op_resample::apply_mat_noalias(tmp, U.M, in.aux_uword_a, in.aux_uword_b, in.aux_uword_c);
+    
+    out.steal_mem(tmp);
+    }
+  else
+    {
+    op_resample::apply_mat_noalias(out, U.M, in.aux_uword_a, in.aux_uword_b, in.aux_uword_c);
+    }
+  }
+
+
+
+//! each slice is resampled separately; the number of slices is unchanged.
+//! the weights are computed once for all slices, and each slice is written directly into the output;
+//! with OpenMP, the slices are distributed across threads when there are enough of them or when they are too small
+//! to be worth parallelising individually; otherwise each slice is parallelised internally
+template<typename T1>
+inline
+void
+op_resample::apply(Cube<typename T1::elem_type>& out, const OpCube<T1,op_resample>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
+  
+  const unwrap_cube_check<T1> U(in.m, out);
+  const Cube<eT>&             A = U.M;
+  
+  const uword new_n_rows = in.aux_uword_a;
+  const uword new_n_cols = in.aux_uword_b;
+  const uword method_id  = in.aux_uword_c;
+  
+  out.set_size(new_n_rows, new_n_cols, A.n_slices);
+  
+  if(out.is_empty())  { return; }
+  
+  arma_debug_check( (A.n_elem_slice == 0), "resample(): given object must not be empty" );
+  
+  weights<T> W_rows;
+  weights<T> W_cols;
+  
+  if(new_n_rows != A.n_rows)  { op_resample::build_weights(W_rows, A.n_rows, new_n_rows, method_id); }
+  if(new_n_cols != A.n_cols)  { op_resample::build_weights(W_cols, A.n_cols, new_n_cols, method_id); }
+  
+  const uword n_slices = A.n_slices;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const uword n_taps = (std::max)(W_rows.n_taps, W_cols.n_taps);
+    
+    if( (n_slices > 1) && mp_gate<eT>::eval(out.n_elem * n_taps) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      const bool small_slices = (mp_gate<eT>::eval(out.n_elem_slice * n_taps) == false);
+      
+      if( small_slices || (n_slices >= uword(n_threads)) )
+        {
+        // each thread processes a contiguous range of slices, with its own workspace allocated beforehand
+        
+        const uword n_parts    = (std::min)(uword(n_threads), n_slices);
+        const uword chunk_size = (n_slices + n_parts - 1) / n_parts;
+        
+        field< Mat<eT> > t_tmp(n_parts);
+        
+        if( (W_rows.n_out > 0) && (W_cols.n_out > 0) )
+          {
+          const bool rf = op_resample::rows_first(A.n_rows, A.n_cols, W_rows, W_cols);
+          
+          for(uword t=0; t < n_parts; ++t)  { t_tmp(t).set_size( (rf ? new_n_rows : A.n_rows), (rf ? A.n_cols : new_n_cols) ); }
+          }
+        
+        #pragma omp parallel for schedule(static) num_threads(n_threads)
+        for(uword t=0; t < n_parts; ++t)
+          {
+          const uword slice_start = t * chunk_size;
+          const uword slice_endp1 = (std::min)(n_slices, slice_start + chunk_size);
+          
+          for(uword s=slice_start; s < slice_endp1; ++s)
+            {
+            const Mat<eT> A_slice(const_cast<eT*>(A.slice_memptr(s)), A.n_rows, A.n_cols, false, true);
+                  Mat<eT> out_slice(out.slice_memptr(s), new_n_rows, new_n_cols, false, true);
+            
+            op_resample::apply_mat_weights(out_slice, t_tmp(t), A_slice, W_rows, W_cols, false);
+            }
+          }
+        
+        return;
+        }
+      }
+    }
+  #endif
+  
+  Mat<eT> tmp;
+  
+  for(uword s=0; s < n_slices; ++s)
+    {
+    const Mat<eT> A_slice(const_cast<eT*>(A.slice_memptr(s)), A.n_rows, A.n_cols, false, true);
+          Mat<eT> out_slice(out.slice_memptr(s), new_n_rows, new_n_cols, false, true);
+    
+    op_resample::apply_mat_weights(out_slice, tmp, A_slice, W_rows, W_cols, true);
+    }
+  }
+
+
+
+//! @}
@@ -44,6 +44,26 @@ class op_shift
   template<typename eT> inline static void apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword len, const uword neg, const uword dim);
   
   template<typename eT> inline static void apply_alias(Mat<eT>& out, const uword len, const uword neg, const uword dim);
+  
+  template<typename eT> inline static void rotate_noalias(eT* out_mem, const eT* X_mem, const uword n_inner, const uword n_dim, const uword n_outer, const uword len, const uword neg);
+  
+  template<typename eT> inline static void rotate_inplace(eT* mem, const uword n_inner, const uword n_dim, const uword n_outer, const uword len, const uword neg);
+  };
+
+
+
+class op_fftshift
+  : public traits_op_passthru
+  {
+  public:
+  
+  arma_inline static uword shift_len(const uword n, const uword inv);
+  
+  template<typename eT> inline static void apply_mem(eT* out_mem, const eT* X_mem, const uword n_rows, const uword n_cols, const uword len_rows, const uword len_cols);
+  
+  template<typename T1> inline static void apply(Mat<typename T1::elem_type>& out, const Op<T1,op_fftshift>& in);
+  
+  template<typename T1> inline static void apply(Cube<typename T1::elem_type>& out, const OpCube<T1,op_fftshift>& in);
   };
 
 
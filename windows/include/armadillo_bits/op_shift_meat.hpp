@@ -92,132 +92,253 @@ op_shift::apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword len, const u
   
   out.copy_size(X);
   
-  const uword X_n_rows = X.n_rows;
-  const uword X_n_cols = X.n_cols;
+  if(X.n_elem == 0)  { return; }
   
   if(dim == 0)
     {
-    if(neg == 0)
-      {
-      for(uword col=0; col < X_n_cols; ++col)
-        {
-              eT* out_ptr = out.colptr(col);
-        const eT*   X_ptr =   X.colptr(col);
-        
-        for(uword out_row=len, row=0; row < (X_n_rows - len); ++row, ++out_row)
-          {
-          out_ptr[out_row] = X_ptr[row];
-          }
-        
-        for(uword out_row=0, row=(X_n_rows - len); row < X_n_rows; ++row, ++out_row)
-          {
-          out_ptr[out_row] = X_ptr[row];
-          }
-        }
-      }
-    else
-    if(neg == 1)
-      {
-      for(uword col=0; col < X_n_cols; ++col)
-        {
-              eT* out_ptr = out.colptr(col);
-        const eT*   X_ptr =   X.colptr(col);
-        
-        for(uword out_row=0, row=len; row < X_n_rows; ++row, ++out_row)
-          {
-          out_ptr[out_row] = X_ptr[row];
-          }
-        
-        for(uword out_row=(X_n_rows-len), row=0; row < len; ++row, ++out_row)
-          {
-          out_ptr[out_row] = X_ptr[row];
-          }
-        }
-      }
+    op_shift::rotate_noalias(out.memptr(), X.memptr(), uword(1), X.n_rows, X.n_cols, len, neg);
+    }
+  else
+  if(dim == 1)
+    {
+    // columns are stored contiguously, so shifting columns is equivalent to rotating the entire memory
+    
+    op_shift::rotate_noalias(out.memptr(), X.memptr(), X.n_rows, X.n_cols, uword(1), len, neg);
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+op_shift::apply_alias(Mat<eT>& X, const uword len, const uword neg, const uword dim)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(X.n_elem == 0)  { return; }
+  
+  if(dim == 0)
+    {
+    op_shift::rotate_inplace(X.memptr(), uword(1), X.n_rows, X.n_cols, len, neg);
     }
   else
   if(dim == 1)
     {
-    if(neg == 0)
+    op_shift::rotate_inplace(X.memptr(), X.n_rows, X.n_cols, uword(1), len, neg);
+    }
+  }
+
+
+
+//! circular shift along the middle dimension of memory laid out as n_inner x n_dim x n_outer;
+//! each of the n_outer segments is copied as two contiguous blocks
+template<typename eT>
+inline
+void
+op_shift::rotate_noalias(eT* out_mem, const eT* X_mem, const uword n_inner, const uword n_dim, const uword n_outer, const uword len, const uword neg)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword seg_len = n_inner * n_dim;
+  const uword offset  = n_inner * ( (neg == 0) ? len : (n_dim - len) );  // equivalent forward shift
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_outer > 1) && mp_gate<eT>::eval(seg_len * n_outer) )
       {
-      if(X_n_rows == 1)
-        {
-              eT* out_ptr = out.memptr();
-        const eT*   X_ptr =   X.memptr();
-        
-        for(uword out_col=len, col=0; col < (X_n_cols - len); ++col, ++out_col)
-          {
-          out_ptr[out_col] = X_ptr[col];
-          }
-        
-        for(uword out_col=0, col=(X_n_cols - len); col < X_n_cols; ++col, ++out_col)
-          {
-          out_ptr[out_col] = X_ptr[col];
-          }
-        }
-      else
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword o=0; o < n_outer; ++o)
         {
-        for(uword out_col=len, col=0; col < (X_n_cols - len); ++col, ++out_col)
-          {
-          arrayops::copy( out.colptr(out_col), X.colptr(col), X_n_rows );
-          }
+        const eT*   X_seg =   X_mem + o*seg_len;
+              eT* out_seg = out_mem + o*seg_len;
         
-        for(uword out_col=0, col=(X_n_cols - len); col < X_n_cols; ++col, ++out_col)
-          {
-          arrayops::copy( out.colptr(out_col), X.colptr(col), X_n_rows );
-          }
+        arrayops::copy(out_seg + offset, X_seg,                     seg_len - offset);
+        arrayops::copy(out_seg,          X_seg + seg_len - offset,            offset);
         }
+      
+      return;
       }
-    else
-    if(neg == 1)
+    }
+  #endif
+  
+  for(uword o=0; o < n_outer; ++o)
+    {
+    const eT*   X_seg =   X_mem + o*seg_len;
+          eT* out_seg = out_mem + o*seg_len;
+    
+    arrayops::copy(out_seg + offset, X_seg,                     seg_len - offset);
+    arrayops::copy(out_seg,          X_seg + seg_len - offset,            offset);
+    }
+  }
+
+
+
+//! in-place counterpart of rotate_noalias(); std::rotate() moves each element without a temporary copy of the segment
+template<typename eT>
+inline
+void
+op_shift::rotate_inplace(eT* mem, const uword n_inner, const uword n_dim, const uword n_outer, const uword len, const uword neg)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword seg_len = n_inner * n_dim;
+  const uword mid     = n_inner * ( (neg == 0) ? (n_dim - len) : len );  // element which becomes the first
+  
+  if( (mid == 0) || (mid == seg_len) )  { return; }
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_outer > 1) && mp_gate<eT>::eval(seg_len * n_outer) )
       {
-      if(X_n_rows == 1)
-        {
-              eT* out_ptr = out.memptr();
-        const eT*   X_ptr =   X.memptr();
-        
-        for(uword out_col=0, col=len; col < X_n_cols; ++col, ++out_col)
-          {
-          out_ptr[out_col] = X_ptr[col];
-          }
-        
-        for(uword out_col=(X_n_cols-len), col=0; col < len; ++col, ++out_col)
-          {
-          out_ptr[out_col] = X_ptr[col];
-          }
-        }
-      else
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword o=0; o < n_outer; ++o)
         {
-        for(uword out_col=0, col=len; col < X_n_cols; ++col, ++out_col)
-          {
-          arrayops::copy( out.colptr(out_col), X.colptr(col), X_n_rows );
-          }
+        eT* seg = mem + o*seg_len;
         
-        for(uword out_col=(X_n_cols-len), col=0; col < len; ++col, ++out_col)
-          {
-          arrayops::copy( out.colptr(out_col), X.colptr(col), X_n_rows );
-          }
+        std::rotate(seg, seg + mid, seg + seg_len);
         }
+      
+      return;
       }
     }
+  #endif
+  
+  for(uword o=0; o < n_outer; ++o)
+    {
+    eT* seg = mem + o*seg_len;
+    
+    std::rotate(seg, seg + mid, seg + seg_len);
+    }
+  }
+
+
+
+//
+
+
+
+//! forward shift used by fftshift (inv = 0) and ifftshift (inv = 1);
+//! fftshift moves element 0 to position floor(n/2)
+arma_inline
+uword
+op_fftshift::shift_len(const uword n, const uword inv)
+  {
+  if(n == 0)  { return uword(0); }
+  
+  const uword half = n / 2;
+  
+  return (inv == 0) ? half : ((n - half) % n);
   }
 
 
 
+//! shift a column-major n_rows x n_cols block by len_rows rows and len_cols columns (forward, circular);
+//! if out_mem and X_mem are the same, the shift is done in-place
 template<typename eT>
 inline
 void
-op_shift::apply_alias(Mat<eT>& X, const uword len, const uword neg, const uword dim)
+op_fftshift::apply_mem(eT* out_mem, const eT* X_mem, const uword n_rows, const uword n_cols, const uword len_rows, const uword len_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(out_mem == X_mem)
+    {
+    if(len_rows > 0)  { op_shift::rotate_inplace(out_mem, uword(1), n_rows, n_cols,   len_rows, uword(0)); }
+    if(len_cols > 0)  { op_shift::rotate_inplace(out_mem, n_rows,   n_cols, uword(1), len_cols, uword(0)); }
+    
+    return;
+    }
+  
+  if(len_rows == 0)
+    {
+    op_shift::rotate_noalias(out_mem, X_mem, n_rows, n_cols, uword(1), len_cols, uword(0));
+    
+    return;
+    }
+  
+  // each column is rotated directly into its destination column
+  
+  for(uword col=0; col < n_cols; ++col)
+    {
+    const uword out_col = (col + len_cols) % n_cols;
+    
+    op_shift::rotate_noalias(out_mem + out_col*n_rows, X_mem + col*n_rows, uword(1), n_rows, uword(1), len_rows, uword(0));
+    }
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_fftshift::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_fftshift>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  const unwrap<T1> U(in.m);
+  
+  const uword inv = in.aux_uword_a;
+  const uword dim = in.aux_uword_b;
+  const uword all = in.aux_uword_c;
+  
+  arma_debug_check( ((all == 0) && (dim > 1)), "fftshift(): parameter 'dim' must be 0 or 1" );
+  
+  if(&out != &(U.M))  { out.copy_size(U.M); }
+  
+  if(out.n_elem == 0)  { return; }
+  
+  const uword len_rows = ( (all == 1) || (dim == 0) ) ? op_fftshift::shift_len(out.n_rows, inv) : uword(0);
+  const uword len_cols = ( (all == 1) || (dim == 1) ) ? op_fftshift::shift_len(out.n_cols, inv) : uword(0);
+  
+  op_fftshift::apply_mem(out.memptr(), U.M.memptr(), out.n_rows, out.n_cols, len_rows, len_cols);
+  }
+
+
+
+//! without a dimension, each slice is shifted along both rows and columns
+template<typename T1>
+inline
+void
+op_fftshift::apply(Cube<typename T1::elem_type>& out, const OpCube<T1,op_fftshift>& in)
   {
   arma_extra_debug_sigprint();
   
-  // TODO: replace with better implementation
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_cube<T1> U(in.m);
+  const Cube<eT>&       X = U.M;
   
-  Mat<eT> tmp;
+  const uword inv = in.aux_uword_a;
+  const uword dim = in.aux_uword_b;
+  const uword all = in.aux_uword_c;
   
-  op_shift::apply_noalias(tmp, X, len, neg, dim);
+  arma_debug_check( ((all == 0) && (dim > 2)), "fftshift(): parameter 'dim' must be 0, 1, or 2" );
   
-  X.steal_mem(tmp);
+  if(&out != &X)  { out.copy_size(X); }
+  
+  if(out.n_elem == 0)  { return; }
+  
+  if( (all == 0) && (dim == 2) )
+    {
+    const uword len_slices = op_fftshift::shift_len(out.n_slices, inv);
+    
+    op_fftshift::apply_mem(out.memptr(), X.memptr(), out.n_elem_slice, out.n_slices, uword(0), len_slices);
+    
+    return;
+    }
+  
+  const uword len_rows = ( (all == 1) || (dim == 0) ) ? op_fftshift::shift_len(out.n_rows, inv) : uword(0);
+  const uword len_cols = ( (all == 1) || (dim == 1) ) ? op_fftshift::shift_len(out.n_cols, inv) : uword(0);
+  
+  for(uword s=0; s < out.n_slices; ++s)
+    {
+    op_fftshift::apply_mem(out.slice_memptr(s), X.slice_memptr(s), out.n_rows, out.n_cols, len_rows, len_cols);
+    }
   }
 
 
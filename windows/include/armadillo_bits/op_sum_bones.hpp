@@ -53,6 +53,15 @@ class op_sum
   
   template<typename T1>
   arma_hot inline static void apply_noalias_proxy(Cube<typename T1::elem_type>& out, const ProxyCube<T1>& P, const uword dim);
+  
+  template<typename T1>
+  arma_hot inline static void apply_slices(Cube<typename T1::elem_type>& out, const ProxyCube<T1>& P);
+  
+  template<typename eaT, typename eT>
+  arma_hot inline static void apply_slices_part(eT* partial_mem, const eaT& Pea, const uword N, const uword slice_start, const uword slice_endp1);
+  
+  static constexpr uword slice_tile_len = 2048;  //!< number of elements in each tile of the output when summing along the slice dimension
+  static constexpr uword slice_n_parts  = 16;    //!< number of tiles below which the slices are split into this many partial sums; fixed so results do not depend on the thread count
   };
 
 
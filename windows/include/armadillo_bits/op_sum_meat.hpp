@@ -216,6 +216,11 @@ op_sum::apply_noalias(Cube<typename T1::elem_type>& out, const ProxyCube<T1>& P,
   {
   arma_extra_debug_sigprint();
   
+  if( (dim == 2) && (ProxyCube<T1>::use_at == false) )
+    {
+    op_sum::apply_slices(out, P);
+    }
+  else
   if(is_Cube<typename ProxyCube<T1>::stored_type>::value || (arma_config::openmp && ProxyCube<T1>::use_mp))
     {
     op_sum::apply_noalias_unwrap(out, P, dim);
@@ -374,4 +379,131 @@ op_sum::apply_noalias_proxy(Cube<typename T1::elem_type>& out, const ProxyCube<T
 
 
 
+
+
+//! sum along the slice dimension.
+//! the output is processed in tiles that stay in cache while all slices are streamed through them;
+//! expressions are evaluated element-wise during the pass, so no temporary cube is created.
+//! with OpenMP, tiles are distributed across threads when there are enough of them;
+//! otherwise the slices are split into a fixed number of contiguous ranges, each summed into its own partial sum.
+//! the split does not depend on the number of threads (or on whether OpenMP is used),
+//! so the result is the same for any thread count.
+template<typename T1>
+arma_hot
+inline
+void
+op_sum::apply_slices(Cube<typename T1::elem_type>& out, const ProxyCube<T1>& P)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const uword P_n_rows   = P.get_n_rows();
+  const uword P_n_cols   = P.get_n_cols();
+  const uword P_n_slices = P.get_n_slices();
+  
+  out.zeros(P_n_rows, P_n_cols, 1);
+  
+  const uword N = P_n_rows * P_n_cols;
+  
+  if( (N == 0) || (P_n_slices == 0) )  { return; }
+  
+  eT* out_mem = out.memptr();
+  
+  typename ProxyCube<T1>::ea_type Pea = P.get_ea();
+  
+  const uword n_tiles = (N + slice_tile_len - 1) / slice_tile_len;
+  const uword n_parts = (std::min)(slice_n_parts, P_n_slices);
+  
+  if( (n_tiles < slice_n_parts) && (n_parts > 1) )
+    {
+    const uword chunk_size = (P_n_slices + n_parts - 1) / n_parts;
+    
+    Mat<eT> partial(N, n_parts, arma_zeros_indicator());
+    
+    #if defined(ARMA_USE_OPENMP)
+      {
+      if(mp_gate<eT>::eval(P.get_n_elem()))
+        {
+        const int n_threads = mp_thread_limit::get();
+        
+        #pragma omp parallel for schedule(static) num_threads(n_threads)
+        for(uword part=0; part < n_parts; ++part)
+          {
+          op_sum::apply_slices_part(partial.colptr(part), Pea, N, part * chunk_size, (std::min)(P_n_slices, (part+1) * chunk_size));
+          }
+        
+        for(uword part=0; part < n_parts; ++part)  { arrayops::inplace_plus(out_mem, partial.colptr(part), N); }
+        
+        return;
+        }
+      }
+    #endif
+    
+    for(uword part=0; part < n_parts; ++part)
+      {
+      op_sum::apply_slices_part(partial.colptr(part), Pea, N, part * chunk_size, (std::min)(P_n_slices, (part+1) * chunk_size));
+      }
+    
+    for(uword part=0; part < n_parts; ++part)  { arrayops::inplace_plus(out_mem, partial.colptr(part), N); }
+    
+    return;
+    }
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(P.get_n_elem()))
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword tile=0; tile < n_tiles; ++tile)
+        {
+        const uword start = tile * slice_tile_len;
+        const uword endp1 = (std::min)(N, start + slice_tile_len);
+        
+        for(uword slice=0; slice < P_n_slices; ++slice)
+          {
+          const uword offset = slice * N;
+          
+          for(uword i=start; i < endp1; ++i)  { out_mem[i] += Pea[offset + i]; }
+          }
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  for(uword tile=0; tile < n_tiles; ++tile)
+    {
+    const uword start = tile * slice_tile_len;
+    const uword endp1 = (std::min)(N, start + slice_tile_len);
+    
+    for(uword slice=0; slice < P_n_slices; ++slice)
+      {
+      const uword offset = slice * N;
+      
+      for(uword i=start; i < endp1; ++i)  { out_mem[i] += Pea[offset + i]; }
+      }
+    }
+  }
+
+
+
+template<typename eaT, typename eT>
+arma_hot
+inline
+void
+op_sum::apply_slices_part(eT* partial_mem, const eaT& Pea, const uword N, const uword slice_start, const uword slice_endp1)
+  {
+  for(uword slice=slice_start; slice < slice_endp1; ++slice)
+    {
+    const uword offset = slice * N;
+    
+    for(uword i=0; i < N; ++i)  { partial_mem[i] += Pea[offset + i]; }
+    }
+  }
+
+
 //! @}
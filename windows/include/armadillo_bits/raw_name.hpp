@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup diskio
+//! @{
+
+
+namespace raw_opts
+  {
+  typedef unsigned int flag_type;
+  
+  struct opts
+    {
+    const flag_type flags;
+    
+    inline explicit opts(const flag_type in_flags);
+    
+    inline const opts operator+(const opts& rhs) const;
+    };
+  
+  inline
+  opts::opts(const flag_type in_flags)
+    : flags(in_flags)
+    {}
+  
+  inline
+  const opts
+  opts::operator+(const opts& rhs) const
+    {
+    const opts result( flags | rhs.flags );
+    
+    return result;
+    }
+  
+  // The values below (eg. 1u << 0) are for internal Armadillo use only.
+  // The values can change without notice.
+  
+  static const flag_type flag_none          = flag_type(0       );
+  static const flag_type flag_elem_u8       = flag_type(1u <<  0);
+  static const flag_type flag_elem_s8       = flag_type(1u <<  1);
+  static const flag_type flag_elem_u16      = flag_type(1u <<  2);
+  static const flag_type flag_elem_s16      = flag_type(1u <<  3);
+  static const flag_type flag_elem_u32      = flag_type(1u <<  4);
+  static const flag_type flag_elem_s32      = flag_type(1u <<  5);
+  static const flag_type flag_elem_u64      = flag_type(1u <<  6);
+  static const flag_type flag_elem_s64      = flag_type(1u <<  7);
+  static const flag_type flag_elem_f32      = flag_type(1u <<  8);
+  static const flag_type flag_elem_f64      = flag_type(1u <<  9);
+  static const flag_type flag_big_endian    = flag_type(1u << 10);
+  static const flag_type flag_little_endian = flag_type(1u << 11);
+  static const flag_type flag_trans         = flag_type(1u << 12);
+  
+  static const flag_type flag_elem_mask     = flag_type((1u << 10) - 1u);
+  
+  struct opts_none          : public opts { inline opts_none()          : opts(flag_none         ) {} };
+  struct opts_elem_u8       : public opts { inline opts_elem_u8()       : opts(flag_elem_u8      ) {} };
+  struct opts_elem_s8       : public opts { inline opts_elem_s8()       : opts(flag_elem_s8      ) {} };
+  struct opts_elem_u16      : public opts { inline opts_elem_u16()      : opts(flag_elem_u16     ) {} };
+  struct opts_elem_s16      : public opts { inline opts_elem_s16()      : opts(flag_elem_s16     ) {} };
+  struct opts_elem_u32      : public opts { inline opts_elem_u32()      : opts(flag_elem_u32     ) {} };
+  struct opts_elem_s32      : public opts { inline opts_elem_s32()      : opts(flag_elem_s32     ) {} };
+  struct opts_elem_u64      : public opts { inline opts_elem_u64()      : opts(flag_elem_u64     ) {} };
+  struct opts_elem_s64      : public opts { inline opts_elem_s64()      : opts(flag_elem_s64     ) {} };
+  struct opts_elem_f32      : public opts { inline opts_elem_f32()      : opts(flag_elem_f32     ) {} };
+  struct opts_elem_f64      : public opts { inline opts_elem_f64()      : opts(flag_elem_f64     ) {} };
+  struct opts_big_endian    : public opts { inline opts_big_endian()    : opts(flag_big_endian   ) {} };
+  struct opts_little_endian : public opts { inline opts_little_endian() : opts(flag_little_endian) {} };
+  struct opts_trans         : public opts { inline opts_trans()         : opts(flag_trans        ) {} };
+  
+  static const opts_none          none;
+  static const opts_elem_u8       elem_u8;
+  static const opts_elem_s8       elem_s8;
+  static const opts_elem_u16      elem_u16;
+  static const opts_elem_s16      elem_s16;
+  static const opts_elem_u32      elem_u32;
+  static const opts_elem_s32      elem_s32;
+  static const opts_elem_u64      elem_u64;
+  static const opts_elem_s64      elem_s64;
+  static const opts_elem_f32      elem_f32;
+  static const opts_elem_f64      elem_f64;
+  static const opts_big_endian    big_endian;
+  static const opts_little_endian little_endian;
+  static const opts_trans         trans;
+  }
+
+
+//! specification for loading raw binary data with a known layout:
+//! the data starts at the given byte offset, has the given size, and is stored in column-major order
+//! (or row-major order with raw_opts::trans) using the element type given by one of the raw_opts::elem_* options;
+//! if no element type is given, the element type of the matrix is assumed
+struct raw_name
+  {
+  const std::string    filename;
+  const uword          n_rows;
+  const uword          n_cols;
+  const raw_opts::opts opts;
+  const u64            offset;
+  
+  inline
+  raw_name(const std::string& in_filename, const uword in_n_rows, const uword in_n_cols, const raw_opts::opts& in_opts = raw_opts::none, const u64 in_offset = 0)
+    : filename(in_filename)
+    , n_rows  (in_n_rows  )
+    , n_cols  (in_n_cols  )
+    , opts    (in_opts    )
+    , offset  (in_offset  )
+    {}
+  };
+
+
+//! @}
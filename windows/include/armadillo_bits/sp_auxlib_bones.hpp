@@ -41,8 +41,14 @@ class sp_auxlib
   template<typename eT, typename T1>
   inline static bool eigs_sym(Col<eT>& eigval, Mat<eT>& eigvec, const SpBase<eT, T1>& X, const uword n_eigvals, const eT sigma, const eigs_opts& opts);
   
+  template<typename eT>
+  inline static bool eigs_sym(Col<eT>& eigval, Mat<eT>& eigvec, const typename eigs_fn<eT>::type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
   template<typename eT>
   inline static bool eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename eT, typename OpType>
+  inline static bool eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const OpType& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
 
   template<typename eT>
   inline static bool eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const eT sigma, const eigs_opts& opts);
@@ -59,9 +65,15 @@ class sp_auxlib
   template<typename T, typename T1>
   inline static bool eigs_gen(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpBase<T, T1>& X, const uword n_eigvals, const std::complex<T> sigma, const eigs_opts& opts);
   
+  template<typename T>
+  inline static bool eigs_gen(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const typename eigs_fn<T>::type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
   template<typename T>
   inline static bool eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
   
+  template<typename T, typename OpType>
+  inline static bool eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const OpType& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
   template<typename T, bool use_sigma>
   inline static bool eigs_gen_arpack(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const std::complex<T> sigma, const eigs_opts& opts);
   
@@ -95,6 +107,15 @@ class sp_auxlib
   //
   // support functions
   
+  template<typename eT>
+  inline static void eigs_warm_resid(podarray<eT>& resid, const Mat<eT>& V, const uword n);
+  
+  template<typename T>
+  inline static void eigs_warm_resid(podarray<T>& resid, const Mat< std::complex<T> >& V, const uword n);
+  
+  template<typename SolverType, typename eT>
+  inline static void eigs_init(SolverType& eigs, podarray<eT>& init_resid);
+  
   #if defined(ARMA_USE_SUPERLU)
     
     template<typename eT>
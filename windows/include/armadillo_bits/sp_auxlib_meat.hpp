@@ -158,20 +158,79 @@ sp_auxlib::eigs_sym(Col<eT>& eigval, Mat<eT>& eigvec, const SpBase<eT, T1>& X, c
 
 
 
+//! immediate eigendecomposition of symmetric real operator given as a function
 template<typename eT>
 inline
 bool
-sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+sp_auxlib::eigs_sym(Col<eT>& eigval, Mat<eT>& eigvec, const typename eigs_fn<eT>::type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
   {
   arma_extra_debug_sigprint();
   
   #if defined(ARMA_USE_NEWARP)
     {
-    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_la) && (form_val != form_sa), "eigs_sym(): unknown form specified" );
+    const newarp::FuncMatProd<eT> op(fn, n);
+    
+    return sp_auxlib::eigs_sym_newarp(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(fn);
+    arma_ignore(n);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
     
+    arma_stop_logic_error("eigs_sym(): use of NEWARP must be enabled for function operators");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+bool
+sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
     if(X.is_square() == false)  { return false; }
     
-    const newarp::SparseGenMatProd<eT> op(X);
+    const newarp::SparseGenMatProd<eT> op(X, true);  // X is symmetric, so its columns also give its rows
+    
+    return sp_auxlib::eigs_sym_newarp(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT, typename OpType>
+inline
+bool
+sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const OpType& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_la) && (form_val != form_sa), "eigs_sym(): unknown form specified" );
     
     arma_debug_check( (n_eigvals >= op.n_rows), "eigs_sym(): n_eigvals must be less than the number of rows in the matrix" );
     
@@ -221,6 +280,10 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     // eigval.set_size(n_eigvals);
     // eigvec.set_size(n, n_eigvals);
     
+    podarray<eT> init_resid;
+    
+    if(opts.warm_start)  { sp_auxlib::eigs_warm_resid(init_resid, eigvec, n); }
+    
     bool status = true;
     
     uword nconv = 0;
@@ -229,8 +292,8 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       {
       if(form_val == form_lm)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -238,8 +301,8 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_sm)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_MAGN, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -247,8 +310,8 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_la)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_ALGE, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_ALGE, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -256,8 +319,8 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_sa)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -279,7 +342,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
-    arma_ignore(X);
+    arma_ignore(op);
     arma_ignore(n_eigvals);
     arma_ignore(form_val);
     arma_ignore(opts);
@@ -611,21 +674,80 @@ sp_auxlib::eigs_gen(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigv
 
 
 
+//! immediate eigendecomposition of real operator given as a function
 template<typename T>
 inline
 bool
-sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+sp_auxlib::eigs_gen(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const typename eigs_fn<T>::type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
   {
   arma_extra_debug_sigprint();
   
   #if defined(ARMA_USE_NEWARP)
     {
-    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_lr) && (form_val != form_sr) && (form_val != form_li) && (form_val != form_si), "eigs_gen(): unknown form specified" );
+    const newarp::FuncMatProd<T> op(fn, n);
     
+    return sp_auxlib::eigs_gen_newarp(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(fn);
+    arma_ignore(n);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    arma_stop_logic_error("eigs_gen(): use of NEWARP must be enabled for function operators");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename T>
+inline
+bool
+sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
     if(X.is_square() == false)  { return false; }
     
     const newarp::SparseGenMatProd<T> op(X);
     
+    return sp_auxlib::eigs_gen_newarp(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename T, typename OpType>
+inline
+bool
+sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const OpType& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_lr) && (form_val != form_sr) && (form_val != form_li) && (form_val != form_si), "eigs_gen(): unknown form specified" );
+    
     arma_debug_check( (n_eigvals + 1 >= op.n_rows), "eigs_gen(): n_eigvals + 1 must be less than the number of rows in the matrix" );
     
     // If the matrix is empty, the case is trivial.
@@ -674,6 +796,10 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
     // eigval.set_size(n_eigvals);
     // eigvec.set_size(n, n_eigvals);
     
+    podarray<T> init_resid;
+    
+    if(opts.warm_start)  { sp_auxlib::eigs_warm_resid(init_resid, eigvec, n); }
+    
     bool status = true;
     
     uword nconv = 0;
@@ -682,8 +808,8 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       {
       if(form_val == form_lm)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -691,8 +817,8 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_sm)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_MAGN, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -700,8 +826,8 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_lr)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_REAL, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_REAL, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -709,8 +835,8 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_sr)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_REAL, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_REAL, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -718,8 +844,8 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_li)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_IMAG, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_IMAG, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -727,8 +853,8 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_si)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_IMAG, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
-        eigs.init();
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_IMAG, OpType > eigs(op, n_eigvals, ncv);
+        sp_auxlib::eigs_init(eigs, init_resid);
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
         eigvec = eigs.eigenvectors();
@@ -750,7 +876,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
-    arma_ignore(X);
+    arma_ignore(op);
     arma_ignore(n_eigvals);
     arma_ignore(form_val);
     arma_ignore(opts);
@@ -763,6 +889,66 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
 
 
 
+//! starting residual for a warm start: the sum of the given eigenvectors,
+//! which lies in the subspace spanned by them;
+//! resid is left empty if the given eigenvectors cannot be used
+template<typename eT>
+inline
+void
+sp_auxlib::eigs_warm_resid(podarray<eT>& resid, const Mat<eT>& V, const uword n)
+  {
+  arma_extra_debug_sigprint();
+  
+  resid.reset();
+  
+  if( (V.n_rows != n) || (V.n_cols == 0) || (V.is_finite() == false) )  { return; }
+  
+  resid.zeros(n);
+  
+  for(uword col=0; col < V.n_cols; ++col)  { arrayops::inplace_plus(resid.memptr(), V.colptr(col), n); }
+  
+  const eT sq_norm = op_dot::direct_dot(n, resid.memptr(), resid.memptr());
+  
+  if( (sq_norm <= std::numeric_limits<eT>::min()) || (arma_isfinite(sq_norm) == false) )  { resid.reset(); }
+  }
+
+
+
+template<typename T>
+inline
+void
+sp_auxlib::eigs_warm_resid(podarray<T>& resid, const Mat< std::complex<T> >& V, const uword n)
+  {
+  arma_extra_debug_sigprint();
+  
+  // the real and imaginary parts of complex eigenvectors of a real matrix both lie in the invariant subspace
+  
+  const Mat<T> V_parts = join_rows( real(V), imag(V) );
+  
+  sp_auxlib::eigs_warm_resid(resid, V_parts, n);
+  }
+
+
+
+template<typename SolverType, typename eT>
+inline
+void
+sp_auxlib::eigs_init(SolverType& eigs, podarray<eT>& init_resid)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(init_resid.n_elem > 0)
+    {
+    eigs.init(init_resid.memptr());
+    }
+  else
+    {
+    eigs.init();
+    }
+  }
+
+
+
 template<typename T, bool use_sigma>
 inline
 bool
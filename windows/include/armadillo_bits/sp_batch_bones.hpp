@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup sp_batch
+//! @{
+
+
+
+//! block of coordinate list entries: locs holds n (row, column) pairs, stored as a 2 x n matrix
+template<typename eT>
+struct sp_batch_chunk
+  {
+  const uword* locs;
+  const eT*    vals;
+        uword  n;
+  };
+
+
+
+//! Construction of CSC storage from one or more coordinate lists.
+//! The entries are first grouped by column via a counting sort (one radix pass with a bucket per column),
+//! using per-thread column histograms and a prefix sum to obtain each thread's write offsets;
+//! the entries of each column are then put in row order.
+//! Within each column the entries retain the order of the input, regardless of the number of threads,
+//! so the summation of duplicate locations is deterministic.
+//! For internal use only!
+class sp_batch
+  {
+  public:
+  
+  template<typename eT> inline static void apply(SpMat<eT>& out, const sp_batch_chunk<eT>* chunks, const uword n_chunks, const bool add_values, const bool sort_locations, const bool skip_zeros);
+  
+  
+  private:
+  
+  static constexpr uword status_bad_index = 1;
+  static constexpr uword status_bad_order = 2;
+  static constexpr uword status_identical = 4;
+  
+  template<typename eT> inline static uword get_n_threads(const uword N, const uword n_cols);
+  
+  inline static uword part_start(const uword n_elem, const uword n_parts, const uword t);
+  inline static uword col_part_start(const uword* col_ptrs, const uword n_cols, const uword n_parts, const uword t);
+  
+  inline static uword locate(const uword* chunk_start, const uword n_chunks, const uword g);
+  
+  inline static void prefix_sum(uword* mem, const uword n_elem, const uword n_threads);
+  
+  template<typename eT> inline static void count_part(uword* counts, uword& status, const sp_batch_chunk<eT>* chunks, const uword* chunk_start, const uword n_chunks, const uword g_start, const uword g_end, const uword n_rows, const uword n_cols, const bool check_order, const bool skip_zeros);
+  
+  inline static void scan_cols(uword* counts, uword* col_ptrs, const uword n_parts, const uword n_cols, const uword c_start, const uword c_end);
+  
+  template<typename eT> inline static void scatter_part(uword* offsets, uword* out_rows, eT* out_vals, const uword* col_ptrs, const sp_batch_chunk<eT>* chunks, const uword* chunk_start, const uword n_chunks, const uword g_start, const uword g_end, const bool skip_zeros);
+  
+  template<typename eT> inline static void arrange_cols(uword* n_unique, uword& status, uword* rows, eT* vals, const uword* col_ptrs, const uword c_start, const uword c_end, const bool sort_locations, const bool add_values);
+  
+  template<typename eT> inline static void combine_cols(uword* out_rows, eT* out_vals, const uword* out_col_ptrs, const uword* rows, const eT* vals, const uword* col_ptrs, const uword c_start, const uword c_end);
+  };
+
+
+
+//! @}
@@ -0,0 +1,578 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup sp_batch
+//! @{
+
+
+
+template<typename eT>
+inline
+void
+sp_batch::apply(SpMat<eT>& out, const sp_batch_chunk<eT>* chunks, const uword n_chunks, const bool add_values, const bool sort_locations, const bool skip_zeros)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword out_n_rows = out.n_rows;
+  const uword out_n_cols = out.n_cols;
+  
+  podarray<uword> chunk_start(n_chunks + 1);
+  
+  chunk_start[0] = 0;
+  
+  for(uword k=0; k < n_chunks; ++k)  { chunk_start[k+1] = chunk_start[k] + chunks[k].n; }
+  
+  const uword N = chunk_start[n_chunks];
+  
+  out.mem_resize(0);
+  
+  uword* col_ptrs = access::rwp(out.col_ptrs);
+  
+  arrayops::fill_zeros(col_ptrs, out_n_cols + 1);
+  
+  if(N == 0)  { return; }
+  
+  const uword n_threads = sp_batch::get_n_threads<eT>(N, out_n_cols);
+  
+  const uword* chunk_start_mem = chunk_start.memptr();
+  
+  podarray<uword> counts(n_threads * out_n_cols);
+  podarray<uword> status(n_threads);
+  
+  counts.zeros();
+  status.zeros();
+  
+  // count the entries of each column, separately for each part of the input
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword g_start = sp_batch::part_start(N, n_threads, t  );
+      const uword g_end   = sp_batch::part_start(N, n_threads, t+1);
+      
+      sp_batch::count_part(counts.memptr() + t*out_n_cols, status[t], chunks, chunk_start_mem, n_chunks, g_start, g_end, out_n_rows, out_n_cols, (sort_locations == false), skip_zeros);
+      }
+    }
+  #else
+    {
+    sp_batch::count_part(counts.memptr(), status[0], chunks, chunk_start_mem, n_chunks, uword(0), N, out_n_rows, out_n_cols, (sort_locations == false), skip_zeros);
+    }
+  #endif
+  
+  uword status_all = 0;
+  
+  for(uword t=0; t < n_threads; ++t)  { status_all |= status[t]; }
+  
+  arma_check( ((status_all & status_bad_index) != 0), "SpMat::SpMat(): invalid row or column index" );
+  
+  arma_debug_check( ((status_all & status_bad_order) != 0), "SpMat::SpMat(): out of order points; either pass sort_locations = true, or sort points in column-major ordering" );
+  
+  // turn the counts into the offset of each part within each column, and the column pointers
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword c_start = sp_batch::part_start(out_n_cols, n_threads, t  );
+      const uword c_end   = sp_batch::part_start(out_n_cols, n_threads, t+1);
+      
+      sp_batch::scan_cols(counts.memptr(), col_ptrs, n_threads, out_n_cols, c_start, c_end);
+      }
+    }
+  #else
+    {
+    sp_batch::scan_cols(counts.memptr(), col_ptrs, n_threads, out_n_cols, uword(0), out_n_cols);
+    }
+  #endif
+  
+  sp_batch::prefix_sum(col_ptrs + 1, out_n_cols, n_threads);
+  
+  const uword N_kept = col_ptrs[out_n_cols];
+  
+  if(N_kept == 0)  { return; }
+  
+  out.mem_resize(N_kept);
+  
+  uword* out_rows = access::rwp(out.row_indices);
+  eT*    out_vals = access::rwp(out.values);
+  
+  // place the entries in their columns; each part writes to its own region of each column,
+  // so the entries of each column retain the order of the input
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword g_start = sp_batch::part_start(N, n_threads, t  );
+      const uword g_end   = sp_batch::part_start(N, n_threads, t+1);
+      
+      sp_batch::scatter_part(counts.memptr() + t*out_n_cols, out_rows, out_vals, col_ptrs, chunks, chunk_start_mem, n_chunks, g_start, g_end, skip_zeros);
+      }
+    }
+  #else
+    {
+    sp_batch::scatter_part(counts.memptr(), out_rows, out_vals, col_ptrs, chunks, chunk_start_mem, n_chunks, uword(0), N, skip_zeros);
+    }
+  #endif
+  
+  counts.reset();
+  
+  // put each column in row order; the columns are split into parts holding similar numbers of entries
+  
+  podarray<uword> unique_ptrs( (add_values) ? (out_n_cols + 1) : uword(1) );
+  
+  unique_ptrs[0] = 0;
+  
+  status.zeros();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword c_start = sp_batch::col_part_start(col_ptrs, out_n_cols, n_threads, t  );
+      const uword c_end   = sp_batch::col_part_start(col_ptrs, out_n_cols, n_threads, t+1);
+      
+      sp_batch::arrange_cols(unique_ptrs.memptr() + 1, status[t], out_rows, out_vals, col_ptrs, c_start, c_end, sort_locations, add_values);
+      }
+    }
+  #else
+    {
+    sp_batch::arrange_cols(unique_ptrs.memptr() + 1, status[0], out_rows, out_vals, col_ptrs, uword(0), out_n_cols, sort_locations, add_values);
+    }
+  #endif
+  
+  status_all = 0;
+  
+  for(uword t=0; t < n_threads; ++t)  { status_all |= status[t]; }
+  
+  arma_debug_check( ((status_all & status_bad_order) != 0), "SpMat::SpMat(): out of order points; either pass sort_locations = true, or sort points in column-major ordering" );
+  
+  arma_debug_check( ((status_all & status_identical) != 0), "SpMat::SpMat(): detected identical locations" );
+  
+  if(add_values == false)  { return; }
+  
+  // sum the values at identical locations
+  
+  sp_batch::prefix_sum(unique_ptrs.memptr() + 1, out_n_cols, n_threads);
+  
+  const uword N_unique = unique_ptrs[out_n_cols];
+  
+  if(N_unique == N_kept)  { return; }
+  
+  eT*    new_values      = memory::acquire<eT>   (N_unique + 1);
+  uword* new_row_indices = memory::acquire<uword>(N_unique + 1);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword c_start = sp_batch::col_part_start(col_ptrs, out_n_cols, n_threads, t  );
+      const uword c_end   = sp_batch::col_part_start(col_ptrs, out_n_cols, n_threads, t+1);
+      
+      sp_batch::combine_cols(new_row_indices, new_values, unique_ptrs.memptr(), out_rows, out_vals, col_ptrs, c_start, c_end);
+      }
+    }
+  #else
+    {
+    sp_batch::combine_cols(new_row_indices, new_values, unique_ptrs.memptr(), out_rows, out_vals, col_ptrs, uword(0), out_n_cols);
+    }
+  #endif
+  
+  new_values[N_unique]      = eT(0);
+  new_row_indices[N_unique] = uword(0);
+  
+  memory::release(access::rw(out.values));
+  memory::release(access::rw(out.row_indices));
+  
+  access::rw(out.values)      = new_values;
+  access::rw(out.row_indices) = new_row_indices;
+  access::rw(out.n_nonzero)   = N_unique;
+  
+  arrayops::copy(col_ptrs, unique_ptrs.memptr(), out_n_cols + 1);
+  }
+
+
+
+template<typename eT>
+inline
+uword
+sp_batch::get_n_threads(const uword N, const uword n_cols)
+  {
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(N))
+      {
+      uword n_threads = uword(mp_thread_limit::get());
+      
+      // each thread has a histogram of the columns;
+      // don't let the histograms dominate the memory used for the entries themselves
+      
+      while( (n_threads > 1) && ((n_threads * n_cols) > (uword(4) * N)) )  { --n_threads; }
+      
+      return n_threads;
+      }
+    }
+  #else
+    {
+    arma_ignore(N);
+    arma_ignore(n_cols);
+    }
+  #endif
+  
+  return uword(1);
+  }
+
+
+
+//! start of part t when n_elem items are split into n_parts contiguous parts of near equal length
+inline
+uword
+sp_batch::part_start(const uword n_elem, const uword n_parts, const uword t)
+  {
+  const uword len = n_elem / n_parts;
+  const uword rem = n_elem % n_parts;
+  
+  return (t * len) + (std::min)(t, rem);
+  }
+
+
+
+//! first column of part t when the columns are split into n_parts contiguous parts holding similar numbers of entries
+inline
+uword
+sp_batch::col_part_start(const uword* col_ptrs, const uword n_cols, const uword n_parts, const uword t)
+  {
+  if(t == 0      )  { return uword(0); }
+  if(t >= n_parts)  { return n_cols;   }
+  
+  const uword target = sp_batch::part_start(col_ptrs[n_cols], n_parts, t);
+  
+  return uword( std::lower_bound(col_ptrs, col_ptrs + n_cols + 1, target) - col_ptrs );
+  }
+
+
+
+//! index of the chunk holding entry g of the concatenated chunks
+inline
+uword
+sp_batch::locate(const uword* chunk_start, const uword n_chunks, const uword g)
+  {
+  return uword( std::upper_bound(chunk_start, chunk_start + n_chunks + 1, g) - chunk_start ) - uword(1);
+  }
+
+
+
+//! inclusive prefix sum
+inline
+void
+sp_batch::prefix_sum(uword* mem, const uword n_elem, const uword n_threads)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_threads > 1) && (n_elem >= (n_threads * uword(4096))) )
+      {
+      podarray<uword> part_sum(n_threads);
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword i_start = sp_batch::part_start(n_elem, n_threads, t  );
+        const uword i_end   = sp_batch::part_start(n_elem, n_threads, t+1);
+        
+        uword acc = 0;
+        
+        for(uword i=i_start; i < i_end; ++i)  { acc += mem[i]; }
+        
+        part_sum[t] = acc;
+        }
+      
+      uword offset = 0;
+      
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword tmp = part_sum[t];
+        
+        part_sum[t] = offset;
+        
+        offset += tmp;
+        }
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword i_start = sp_batch::part_start(n_elem, n_threads, t  );
+        const uword i_end   = sp_batch::part_start(n_elem, n_threads, t+1);
+        
+        uword acc = part_sum[t];
+        
+        for(uword i=i_start; i < i_end; ++i)  { acc += mem[i]; mem[i] = acc; }
+        }
+      
+      return;
+      }
+    }
+  #else
+    {
+    arma_ignore(n_threads);
+    }
+  #endif
+  
+  for(uword i=1; i < n_elem; ++i)  { mem[i] += mem[i-1]; }
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_batch::count_part(uword* counts, uword& status, const sp_batch_chunk<eT>* chunks, const uword* chunk_start, const uword n_chunks, const uword g_start, const uword g_end, const uword n_rows, const uword n_cols, const bool check_order, const bool skip_zeros)
+  {
+  if(g_start >= g_end)  { return; }
+  
+  uword prev_col = 0;
+  
+  if(check_order && (g_start > 0))
+    {
+    const uword k_prev = sp_batch::locate(chunk_start, n_chunks, g_start - 1);
+    
+    prev_col = chunks[k_prev].locs[ 2*(g_start - 1 - chunk_start[k_prev]) + 1 ];
+    }
+  
+  uword k = sp_batch::locate(chunk_start, n_chunks, g_start);
+  uword g = g_start;
+  
+  while(g < g_end)
+    {
+    const uword* locs = chunks[k].locs;
+    const eT*    vals = chunks[k].vals;
+    
+    const uword i_start = g - chunk_start[k];
+    const uword i_end   = (std::min)(chunks[k].n, g_end - chunk_start[k]);
+    
+    for(uword i=i_start; i < i_end; ++i)
+      {
+      const uword row = locs[2*i    ];
+      const uword col = locs[2*i + 1];
+      
+      if(check_order)
+        {
+        if(col < prev_col)  { status |= status_bad_order; }
+        
+        prev_col = col;
+        }
+      
+      if(skip_zeros && (vals[i] == eT(0)))  { continue; }
+      
+      if( (row >= n_rows) || (col >= n_cols) )  { status |= status_bad_index; continue; }
+      
+      ++counts[col];
+      }
+    
+    g = chunk_start[k] + i_end;
+    
+    ++k;
+    }
+  }
+
+
+
+//! on input, counts holds the number of entries of each part of the input in each column (part-major);
+//! on output, it holds the offset of each part within each column, and col_ptrs[c+1] holds the length of column c
+inline
+void
+sp_batch::scan_cols(uword* counts, uword* col_ptrs, const uword n_parts, const uword n_cols, const uword c_start, const uword c_end)
+  {
+  for(uword c=c_start; c < c_end; ++c)
+    {
+    uword acc = 0;
+    
+    for(uword t=0; t < n_parts; ++t)
+      {
+      uword& count = counts[t*n_cols + c];
+      
+      const uword tmp = count;
+      
+      count = acc;
+      
+      acc += tmp;
+      }
+    
+    col_ptrs[c+1] = acc;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_batch::scatter_part(uword* offsets, uword* out_rows, eT* out_vals, const uword* col_ptrs, const sp_batch_chunk<eT>* chunks, const uword* chunk_start, const uword n_chunks, const uword g_start, const uword g_end, const bool skip_zeros)
+  {
+  if(g_start >= g_end)  { return; }
+  
+  uword k = sp_batch::locate(chunk_start, n_chunks, g_start);
+  uword g = g_start;
+  
+  while(g < g_end)
+    {
+    const uword* locs = chunks[k].locs;
+    const eT*    vals = chunks[k].vals;
+    
+    const uword i_start = g - chunk_start[k];
+    const uword i_end   = (std::min)(chunks[k].n, g_end - chunk_start[k]);
+    
+    for(uword i=i_start; i < i_end; ++i)
+      {
+      const eT val = vals[i];
+      
+      if(skip_zeros && (val == eT(0)))  { continue; }
+      
+      const uword col = locs[2*i + 1];
+      const uword pos = col_ptrs[col] + offsets[col];
+      
+      ++offsets[col];
+      
+      out_rows[pos] = locs[2*i];
+      out_vals[pos] = val;
+      }
+    
+    g = chunk_start[k] + i_end;
+    
+    ++k;
+    }
+  }
+
+
+
+//! sort the entries of each column by row (if requested), using a stable sort to keep identical locations in input order;
+//! if add_values is true, n_unique[c] is set to the number of distinct rows in column c
+template<typename eT>
+inline
+void
+sp_batch::arrange_cols(uword* n_unique, uword& status, uword* rows, eT* vals, const uword* col_ptrs, const uword c_start, const uword c_end, const bool sort_locations, const bool add_values)
+  {
+  // see op_sort_index_bones.hpp for the definition of arma_sort_index_packet and arma_sort_index_helper_ascend
+  
+  std::vector< arma_sort_index_packet<uword> > packet_vec;
+  
+  arma_sort_index_helper_ascend<uword> comparator;
+  
+  podarray<eT> tmp_vals;
+  
+  for(uword c=c_start; c < c_end; ++c)
+    {
+    const uword n = col_ptrs[c+1] - col_ptrs[c];
+    
+    uword* c_rows = rows + col_ptrs[c];
+    eT*    c_vals = vals + col_ptrs[c];
+    
+    bool in_order  = true;
+    bool identical = false;
+    
+    for(uword i=1; i < n; ++i)
+      {
+      if(c_rows[i-1] >  c_rows[i])  { in_order  = false; break; }
+      if(c_rows[i-1] == c_rows[i])  { identical = true;         }
+      }
+    
+    if( (in_order == false) && (sort_locations == false) )  { status |= status_bad_order; }
+    
+    if( (in_order == false) && (sort_locations == true) )
+      {
+      packet_vec.resize(n);
+      
+      for(uword i=0; i < n; ++i)
+        {
+        packet_vec[i].val   = c_rows[i];
+        packet_vec[i].index = i;
+        }
+      
+      std::stable_sort( packet_vec.begin(), packet_vec.end(), comparator );
+      
+      tmp_vals.set_min_size(n);
+      
+      arrayops::copy(tmp_vals.memptr(), c_vals, n);
+      
+      for(uword i=0; i < n; ++i)
+        {
+        c_rows[i] = packet_vec[i].val;
+        c_vals[i] = tmp_vals[ packet_vec[i].index ];
+        }
+      
+      identical = false;
+      
+      for(uword i=1; i < n; ++i)  { if(c_rows[i-1] == c_rows[i])  { identical = true; break; } }
+      }
+    
+    if( identical && (add_values == false) )  { status |= status_identical; }
+    
+    if(add_values)
+      {
+      uword count = (n > 0) ? uword(1) : uword(0);
+      
+      for(uword i=1; i < n; ++i)  { count += (c_rows[i-1] != c_rows[i]) ? uword(1) : uword(0); }
+      
+      n_unique[c] = count;
+      }
+    }
+  }
+
+
+
+//! copy each column, summing the values of consecutive entries with identical rows
+template<typename eT>
+inline
+void
+sp_batch::combine_cols(uword* out_rows, eT* out_vals, const uword* out_col_ptrs, const uword* rows, const eT* vals, const uword* col_ptrs, const uword c_start, const uword c_end)
+  {
+  for(uword c=c_start; c < c_end; ++c)
+    {
+    const uword i_start = col_ptrs[c  ];
+    const uword i_end   = col_ptrs[c+1];
+    
+    uword pos = out_col_ptrs[c];
+    
+    for(uword i=i_start; i < i_end; ++i)
+      {
+      if( (i > i_start) && (rows[i] == rows[i-1]) )
+        {
+        out_vals[pos-1] += vals[i];
+        }
+      else
+        {
+        out_rows[pos] = rows[i];
+        out_vals[pos] = vals[i];
+        
+        ++pos;
+        }
+      }
+    }
+  }
+
+
+
+//! @}
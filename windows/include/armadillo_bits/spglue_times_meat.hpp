@@ -419,7 +419,7 @@ spglue_times_misc::dense_times_sparse(Mat<typename T1::elem_type>& out, const T1
     
     if( (A.n_elem > 0) && (B.n_nonzero > 0) )
       {
-      if( (arma_config::openmp) && (mp_thread_limit::in_parallel() == false) && (A.n_rows <= (A.n_cols / uword(100))) )
+      if( (arma_config::openmp) && (mp_executor_state::get() == nullptr) && (mp_hint::get() != 1) && (mp_thread_limit::in_parallel() == false) && (A.n_rows <= (A.n_cols / uword(100))) )
         {
         #if defined(ARMA_USE_OPENMP)
           {
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup subview_where
+//! @{
+
+
+
+//! Elements of a matrix selected by a mask of the same size (non-zero mask elements are selected), in column-major order.
+//! Unlike X.elem(find(mask)), no vector of indices is formed: the mask is scanned directly,
+//! in parallel when OpenMP is enabled.
+template<typename eT, typename T1>
+class subview_where : public Base< eT, subview_where<eT,T1> >
+  {
+  public:
+  
+  typedef eT                                       elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  
+  static constexpr bool is_row  = false;
+  static constexpr bool is_col  = true;
+  static constexpr bool is_xvec = false;
+  
+  arma_aligned const Mat<eT>&        m;
+  arma_aligned const Base<uword,T1>& mask;
+  
+  
+  protected:
+  
+  arma_inline subview_where(const Mat<eT>& in_m, const Base<uword,T1>& in_mask);
+  
+  
+  public:
+  
+  inline ~subview_where();
+  inline  subview_where() = delete;
+  
+  template<typename op_type>              inline void inplace_op(const eT            val);
+  template<typename op_type, typename T2> inline void inplace_op(const Base<eT,T2>&  x  );
+  
+  inline void fill(const eT val);
+  inline void zeros();
+  inline void ones();
+  
+  inline void operator=  (const eT val);
+  inline void operator+= (const eT val);
+  inline void operator-= (const eT val);
+  inline void operator*= (const eT val);
+  inline void operator/= (const eT val);
+  
+  // deliberately returning void
+                        inline void operator=  (const subview_where<eT,T1>& x);
+  template<typename T2> inline void operator=  (const Base<eT,T2>& x);
+  template<typename T2> inline void operator+= (const Base<eT,T2>& x);
+  template<typename T2> inline void operator-= (const Base<eT,T2>& x);
+  template<typename T2> inline void operator%= (const Base<eT,T2>& x);
+  template<typename T2> inline void operator/= (const Base<eT,T2>& x);
+  
+  inline static void extract(Mat<eT>& out, const subview_where& in);
+  
+  
+  private:
+  
+  struct test_mask
+    {
+    const uword* mask_mem;
+    
+    arma_inline bool operator()(const uword i) const { return (mask_mem[i] != uword(0)); }
+    };
+  
+  template<typename op_type, typename functor> inline static void apply_val(eT* m_mem, const uword N, const functor& is_found, const eT val);
+  template<typename op_type, typename functor> inline static void apply_mat(eT* m_mem, const uword N, const functor& is_found, const Mat<eT>& X);
+  
+  template<typename op_type, typename functor> inline static void apply_part(eT* m_mem, const uword i_start, const uword i_end, const functor& is_found, const eT* x_mem);
+  
+  template<typename functor> inline static void gather_part(eT* out_mem, const eT* m_mem, const uword i_start, const uword i_end, const functor& is_found);
+  
+  template<typename functor> inline static void gather(Mat<eT>& out, const eT* m_mem, const uword N, const functor& is_found);
+  
+  template<typename functor> inline static uword count_parts(podarray<uword>& part_offset, const uword N, const uword n_threads, const functor& is_found);
+  
+  inline static uword get_n_threads(const uword N);
+  
+  template<typename op_type, typename T2>
+  inline void inplace_op_mask(const eT val, const Mat<eT>* X, const Base<uword,T2>& mask_expr);
+  
+  template<typename op_type, typename T2, typename rel_type>
+  inline void inplace_op_mask(const eT val, const Mat<eT>* X, const mtOp<uword,T2,rel_type>& mask_expr, const typename arma_op_rel_only<rel_type>::result* junk1 = nullptr, const typename arma_not_cx<typename T2::elem_type>::result* junk2 = nullptr);
+  
+  template<typename T2>
+  inline static void extract_mask(Mat<eT>& out, const Mat<eT>& m, const Base<uword,T2>& mask_expr);
+  
+  template<typename T2, typename rel_type>
+  inline static void extract_mask(Mat<eT>& out, const Mat<eT>& m, const mtOp<uword,T2,rel_type>& mask_expr, const typename arma_op_rel_only<rel_type>::result* junk1 = nullptr, const typename arma_not_cx<typename T2::elem_type>::result* junk2 = nullptr);
+  
+  
+  friend class Mat<eT>;
+  };
+
+
+
+//! @}
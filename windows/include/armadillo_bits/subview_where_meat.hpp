@@ -0,0 +1,636 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup subview_where
+//! @{
+
+
+template<typename eT, typename T1>
+inline
+subview_where<eT,T1>::~subview_where()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+template<typename eT, typename T1>
+arma_inline
+subview_where<eT,T1>::subview_where(const Mat<eT>& in_m, const Base<uword,T1>& in_mask)
+  : m(in_m)
+  , mask(in_mask)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+//! number of contiguous parts the mask is split into; 1 indicates serial processing
+template<typename eT, typename T1>
+inline
+uword
+subview_where<eT,T1>::get_n_threads(const uword N)
+  {
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(N))  { return uword( (std::max)(int(1), mp_thread_limit::get()) ); }
+    }
+  #else
+    {
+    arma_ignore(N);
+    }
+  #endif
+  
+  return uword(1);
+  }
+
+
+
+//! counts the selected elements in each part and converts the counts into the starting position of each part;
+//! returns the total number of selected elements
+template<typename eT, typename T1>
+template<typename functor>
+inline
+uword
+subview_where<eT,T1>::count_parts(podarray<uword>& part_offset, const uword N, const uword n_threads, const functor& is_found)
+  {
+  arma_extra_debug_sigprint();
+  
+  part_offset.set_size(n_threads);
+  
+  const uword part_len = N / n_threads;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword i_start = t * part_len;
+      const uword i_end   = (t+1 == n_threads) ? N : (i_start + part_len);
+      
+      uword count = 0;
+      
+      for(uword i=i_start; i < i_end; ++i)  { count += (is_found(i)) ? uword(1) : uword(0); }
+      
+      part_offset[t] = count;
+      }
+    }
+  #else
+    {
+    arma_ignore(part_len);
+    
+    uword count = 0;
+    
+    for(uword i=0; i < N; ++i)  { count += (is_found(i)) ? uword(1) : uword(0); }
+    
+    part_offset[0] = count;
+    }
+  #endif
+  
+  uword n_found = 0;
+  
+  for(uword t=0; t < n_threads; ++t)
+    {
+    const uword count = part_offset[t];
+    
+    part_offset[t] = n_found;
+    
+    n_found += count;
+    }
+  
+  return n_found;
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename op_type, typename functor>
+inline
+void
+subview_where<eT,T1>::apply_val(eT* m_mem, const uword N, const functor& is_found, const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(mp_gate<eT>::eval(N))
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword i=0; i < N; ++i)
+        {
+        if(is_found(i))
+          {
+          if(is_same_type<op_type, op_internal_equ  >::yes) { m_mem[i]  = val; }
+          if(is_same_type<op_type, op_internal_plus >::yes) { m_mem[i] += val; }
+          if(is_same_type<op_type, op_internal_minus>::yes) { m_mem[i] -= val; }
+          if(is_same_type<op_type, op_internal_schur>::yes) { m_mem[i] *= val; }
+          if(is_same_type<op_type, op_internal_div  >::yes) { m_mem[i] /= val; }
+          }
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  for(uword i=0; i < N; ++i)
+    {
+    if(is_found(i))
+      {
+      if(is_same_type<op_type, op_internal_equ  >::yes) { m_mem[i]  = val; }
+      if(is_same_type<op_type, op_internal_plus >::yes) { m_mem[i] += val; }
+      if(is_same_type<op_type, op_internal_minus>::yes) { m_mem[i] -= val; }
+      if(is_same_type<op_type, op_internal_schur>::yes) { m_mem[i] *= val; }
+      if(is_same_type<op_type, op_internal_div  >::yes) { m_mem[i] /= val; }
+      }
+    }
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename op_type, typename functor>
+inline
+void
+subview_where<eT,T1>::apply_part(eT* m_mem, const uword i_start, const uword i_end, const functor& is_found, const eT* x_mem)
+  {
+  for(uword i=i_start; i < i_end; ++i)
+    {
+    if(is_found(i))
+      {
+      const eT x_val = (*x_mem);  ++x_mem;
+      
+      if(is_same_type<op_type, op_internal_equ  >::yes) { m_mem[i]  = x_val; }
+      if(is_same_type<op_type, op_internal_plus >::yes) { m_mem[i] += x_val; }
+      if(is_same_type<op_type, op_internal_minus>::yes) { m_mem[i] -= x_val; }
+      if(is_same_type<op_type, op_internal_schur>::yes) { m_mem[i] *= x_val; }
+      if(is_same_type<op_type, op_internal_div  >::yes) { m_mem[i] /= x_val; }
+      }
+    }
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename functor>
+inline
+void
+subview_where<eT,T1>::gather_part(eT* out_mem, const eT* m_mem, const uword i_start, const uword i_end, const functor& is_found)
+  {
+  for(uword i=i_start; i < i_end; ++i)
+    {
+    if(is_found(i))  { (*out_mem) = m_mem[i];  ++out_mem; }
+    }
+  }
+
+
+
+//! the k-th selected element is combined with the k-th element of X;
+//! the starting position of each part within X is given by the counts of the preceding parts
+template<typename eT, typename T1>
+template<typename op_type, typename functor>
+inline
+void
+subview_where<eT,T1>::apply_mat(eT* m_mem, const uword N, const functor& is_found, const Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_threads = get_n_threads(N);
+  
+  podarray<uword> part_offset;
+  
+  const uword n_found = count_parts(part_offset, N, n_threads, is_found);
+  
+  arma_debug_check( (n_found != X.n_elem), "Mat::elem_where(): size mismatch" );
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const uword part_len = N / n_threads;
+    
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword i_start = t * part_len;
+      const uword i_end   = (t+1 == n_threads) ? N : (i_start + part_len);
+      
+      apply_part<op_type>(m_mem, i_start, i_end, is_found, X.memptr() + part_offset[t]);
+      }
+    }
+  #else
+    {
+    apply_part<op_type>(m_mem, 0, N, is_found, X.memptr());
+    }
+  #endif
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename functor>
+inline
+void
+subview_where<eT,T1>::gather(Mat<eT>& out, const eT* m_mem, const uword N, const functor& is_found)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_threads = get_n_threads(N);
+  
+  podarray<uword> part_offset;
+  
+  const uword n_found = count_parts(part_offset, N, n_threads, is_found);
+  
+  out.set_size(n_found, 1);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const uword part_len = N / n_threads;
+    
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword i_start = t * part_len;
+      const uword i_end   = (t+1 == n_threads) ? N : (i_start + part_len);
+      
+      gather_part(out.memptr() + part_offset[t], m_mem, i_start, i_end, is_found);
+      }
+    }
+  #else
+    {
+    gather_part(out.memptr(), m_mem, 0, N, is_found);
+    }
+  #endif
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename op_type, typename T2>
+inline
+void
+subview_where<eT,T1>::inplace_op_mask(const eT val, const Mat<eT>* X, const Base<uword,T2>& mask_expr)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT>& m_local = const_cast< Mat<eT>& >(m);
+  
+  const unwrap_check_mixed<T2> tmp(mask_expr.get_ref(), m_local);
+  const umat& M = tmp.M;
+  
+  arma_debug_check( (M.n_elem != m_local.n_elem), "Mat::elem_where(): size mismatch between matrix and mask" );
+  
+  const test_mask is_found = { M.memptr() };
+  
+  if(X == nullptr)  { apply_val<op_type>(m_local.memptr(), M.n_elem, is_found, val); }
+  else              { apply_mat<op_type>(m_local.memptr(), M.n_elem, is_found, (*X)); }
+  }
+
+
+
+//! the relational mask is evaluated on the fly, without forming the mask matrix;
+//! as each element of the mask depends only on the same element of the expression,
+//! the mask expression may refer to the matrix being modified
+template<typename eT, typename T1>
+template<typename op_type, typename T2, typename rel_type>
+inline
+void
+subview_where<eT,T1>::inplace_op_mask(const eT val, const Mat<eT>* X, const mtOp<uword,T2,rel_type>& mask_expr, const typename arma_op_rel_only<rel_type>::result* junk1, const typename arma_not_cx<typename T2::elem_type>::result* junk2)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk1);
+  arma_ignore(junk2);
+  
+  typedef typename T2::elem_type eT2;
+  
+  if(Proxy<T2>::use_at)
+    {
+    const Base<uword, mtOp<uword,T2,rel_type> >& mask_base = mask_expr;
+    
+    inplace_op_mask<op_type>(val, X, mask_base);
+    
+    return;
+    }
+  
+  Mat<eT>& m_local = const_cast< Mat<eT>& >(m);
+  
+  const Proxy<T2> P(mask_expr.m);
+  
+  arma_debug_check( (P.get_n_elem() != m_local.n_elem), "Mat::elem_where(): size mismatch between matrix and mask" );
+  
+  const op_find::test_rel<rel_type, typename Proxy<T2>::ea_type, eT2> is_found = { P.get_ea(), eT2(mask_expr.aux) };
+  
+  if(X == nullptr)  { apply_val<op_type>(m_local.memptr(), m_local.n_elem, is_found, val); }
+  else              { apply_mat<op_type>(m_local.memptr(), m_local.n_elem, is_found, (*X)); }
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename op_type>
+inline
+void
+subview_where<eT,T1>::inplace_op(const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op_mask<op_type>(val, nullptr, mask.get_ref());
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename op_type, typename T2>
+inline
+void
+subview_where<eT,T1>::inplace_op(const Base<eT,T2>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  const unwrap_check<T2> tmp(x.get_ref(), m);
+  const Mat<eT>& X = tmp.M;
+  
+  inplace_op_mask<op_type>(eT(0), &X, mask.get_ref());
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::fill(const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_equ>(val);
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::zeros()
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_equ>(eT(0));
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::ones()
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_equ>(eT(1));
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::operator= (const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_equ>(val);
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::operator+= (const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_plus>(val);
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::operator-= (const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_minus>(val);
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::operator*= (const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_schur>(val);
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::operator/= (const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_div>(val);
+  }
+
+
+
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::operator= (const subview_where<eT,T1>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  const Mat<eT> tmp(x);
+  
+  inplace_op<op_internal_equ>(tmp);
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2>
+inline
+void
+subview_where<eT,T1>::operator= (const Base<eT,T2>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_equ>(x);
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2>
+inline
+void
+subview_where<eT,T1>::operator+= (const Base<eT,T2>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_plus>(x);
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2>
+inline
+void
+subview_where<eT,T1>::operator-= (const Base<eT,T2>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_minus>(x);
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2>
+inline
+void
+subview_where<eT,T1>::operator%= (const Base<eT,T2>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_schur>(x);
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2>
+inline
+void
+subview_where<eT,T1>::operator/= (const Base<eT,T2>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  inplace_op<op_internal_div>(x);
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2>
+inline
+void
+subview_where<eT,T1>::extract_mask(Mat<eT>& out, const Mat<eT>& m, const Base<uword,T2>& mask_expr)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T2> U(mask_expr.get_ref());
+  const umat& M = U.M;
+  
+  arma_debug_check( (M.n_elem != m.n_elem), "Mat::elem_where(): size mismatch between matrix and mask" );
+  
+  const test_mask is_found = { M.memptr() };
+  
+  if(U.is_alias(out) || (&out == &m))
+    {
+    Mat<eT> tmp;
+    
+    gather(tmp, m.memptr(), M.n_elem, is_found);
+    
+    out.steal_mem(tmp);
+    }
+  else
+    {
+    gather(out, m.memptr(), M.n_elem, is_found);
+    }
+  }
+
+
+
+template<typename eT, typename T1>
+template<typename T2, typename rel_type>
+inline
+void
+subview_where<eT,T1>::extract_mask(Mat<eT>& out, const Mat<eT>& m, const mtOp<uword,T2,rel_type>& mask_expr, const typename arma_op_rel_only<rel_type>::result* junk1, const typename arma_not_cx<typename T2::elem_type>::result* junk2)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk1);
+  arma_ignore(junk2);
+  
+  typedef typename T2::elem_type eT2;
+  
+  if(Proxy<T2>::use_at)
+    {
+    const Base<uword, mtOp<uword,T2,rel_type> >& mask_base = mask_expr;
+    
+    extract_mask(out, m, mask_base);
+    
+    return;
+    }
+  
+  const Proxy<T2> P(mask_expr.m);
+  
+  arma_debug_check( (P.get_n_elem() != m.n_elem), "Mat::elem_where(): size mismatch between matrix and mask" );
+  
+  const op_find::test_rel<rel_type, typename Proxy<T2>::ea_type, eT2> is_found = { P.get_ea(), eT2(mask_expr.aux) };
+  
+  if(P.is_alias(out) || (&out == &m))
+    {
+    Mat<eT> tmp;
+    
+    gather(tmp, m.memptr(), m.n_elem, is_found);
+    
+    out.steal_mem(tmp);
+    }
+  else
+    {
+    gather(out, m.memptr(), m.n_elem, is_found);
+    }
+  }
+
+
+
+//! the selected elements are copied directly into an output of the final size,
+//! without forming a vector of indices
+template<typename eT, typename T1>
+inline
+void
+subview_where<eT,T1>::extract(Mat<eT>& out, const subview_where<eT,T1>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  extract_mask(out, in.m, in.mask.get_ref());
+  }
+
+
+
+//! @}
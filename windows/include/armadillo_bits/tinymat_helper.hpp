@@ -0,0 +1,420 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup tinymat_helper
+//! @{
+
+
+//! Engine for small square matrices (up to 8x8).
+//! The size is a template parameter and the inner loops are unrolled at compile time,
+//! so the compiler generates straight-line code which keeps the operands in registers;
+//! all workspace is kept on the stack.
+//! The apply_*() functions dispatch a run-time size to the matching instantiation.
+namespace tinymat_helper
+{
+
+
+
+static constexpr uword max_n = 8;
+
+
+
+//! compile-time unrolled loop: calls f.template apply<i>() for i = first, ..., last-1
+template<const uword first, const uword last>
+struct unroll
+  {
+  template<typename functor>
+  arma_inline
+  static
+  void
+  run(functor& f)
+    {
+    f.template apply<first>();
+    
+    unroll<first+1, last>::run(f);
+    }
+  };
+
+
+
+template<const uword last>
+struct unroll<last, last>
+  {
+  template<typename functor>
+  arma_inline
+  static
+  void
+  run(functor&)
+    {
+    }
+  };
+
+
+
+//! acc = op(A)*x, where A is stored in column-major order
+template<const uword N, const bool do_trans_A, typename eT>
+struct gemv_worker
+  {
+        eT* acc;
+  const eT* A;
+  const eT* x;
+  
+  inline gemv_worker(eT* in_acc, const eT* in_A, const eT* in_x) : acc(in_acc), A(in_A), x(in_x) {}
+  
+  // ii is the linear index of an element of A
+  template<const uword ii>
+  arma_inline
+  void
+  apply()
+    {
+    constexpr uword row = ii % N;
+    constexpr uword col = ii / N;
+    
+    if(do_trans_A == false)
+      {
+      if(col == 0)  { acc[row]  = A[ii] * x[col]; }
+      else          { acc[row] += A[ii] * x[col]; }
+      }
+    else
+      {
+      if(row == 0)  { acc[col]  = A[ii] * x[row]; }
+      else          { acc[col] += A[ii] * x[row]; }
+      }
+    }
+  };
+
+
+
+//! X -= c * r.t(), ie. a rank-1 update of X
+template<const uword N, typename eT>
+struct rank1_worker
+  {
+        eT* X;
+  const eT* c;
+  const eT* r;
+  
+  inline rank1_worker(eT* in_X, const eT* in_c, const eT* in_r) : X(in_X), c(in_c), r(in_r) {}
+  
+  template<const uword ii>
+  arma_inline
+  void
+  apply()
+    {
+    X[ii] -= c[ii % N] * r[ii / N];
+    }
+  };
+
+
+
+//! y = alpha*op(A)*x + beta*y
+template<const uword N, const bool do_trans_A, const bool use_alpha, const bool use_beta, typename eT>
+arma_hot
+inline
+void
+gemv(eT* y, const eT* A, const eT* x, const eT alpha, const eT beta)
+  {
+  eT acc[N];
+  
+  gemv_worker<N, do_trans_A, eT> worker(acc, A, x);
+  
+  unroll<0, N*N>::run(worker);
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT val = (use_alpha) ? (alpha * acc[i]) : acc[i];
+    
+    y[i] = (use_beta) ? (beta * y[i] + val) : val;
+    }
+  }
+
+
+
+//! C = alpha*op(A)*op(B) + beta*C
+template<const uword N, const bool do_trans_A, const bool do_trans_B, const bool use_alpha, const bool use_beta, typename eT>
+arma_hot
+inline
+void
+gemm(eT* C, const eT* A, const eT* B, const eT alpha, const eT beta)
+  {
+  eT B_col[N];
+  
+  for(uword j=0; j < N; ++j)
+    {
+    for(uword k=0; k < N; ++k)  { B_col[k] = (do_trans_B) ? B[j + k*N] : B[k + j*N]; }
+    
+    tinymat_helper::gemv<N, do_trans_A, use_alpha, use_beta>( &(C[j*N]), A, B_col, alpha, beta );
+    }
+  }
+
+
+
+//! Gaussian elimination with partial pivoting, in place.
+//! With do_jordan = false, X is reduced to upper triangular form (U of the LU decomposition)
+//! and the diagonal is left untouched.
+//! With do_jordan = true, all off-diagonal elements are eliminated (Gauss-Jordan),
+//! which leaves the inverse of the row-permuted X, with the pivot rows stored in piv.
+//! Each elimination step is one unrolled rank-1 update over the whole matrix.
+//! Returns the number of row swaps, or -1 if a zero pivot was encountered;
+//! the magnitudes of the smallest and largest pivots are stored in min_pivot and max_pivot.
+template<const uword N, const bool do_jordan, typename eT>
+arma_hot
+inline
+int
+eliminate(eT* X, uword* piv, typename get_pod_type<eT>::result& min_pivot, typename get_pod_type<eT>::result& max_pivot)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  int n_swaps = 0;
+  
+  min_pivot = T(0);
+  max_pivot = T(0);
+  
+  eT c[N];
+  eT r[N];
+  
+  for(uword k=0; k < N; ++k)
+    {
+    uword p     = k;
+    T     p_abs = std::abs(X[k + k*N]);
+    
+    for(uword i=k+1; i < N; ++i)
+      {
+      const T val = std::abs(X[i + k*N]);
+      
+      if(val > p_abs)  { p = i; p_abs = val; }
+      }
+    
+    if(p_abs == T(0))  { return -1; }
+    
+    min_pivot = (k == 0) ? p_abs : (std::min)(min_pivot, p_abs);
+    max_pivot = (k == 0) ? p_abs : (std::max)(max_pivot, p_abs);
+    
+    piv[k] = p;
+    
+    if(p != k)
+      {
+      for(uword j=0; j < N; ++j)  { std::swap(X[k + j*N], X[p + j*N]); }
+      
+      ++n_swaps;
+      }
+    
+    const eT pivot = X[k + k*N];
+    
+    if(do_jordan == false)
+      {
+      const eT inv_pivot = eT(1) / pivot;
+      
+      for(uword i=0; i < N; ++i)  { c[i] = (i > k) ? (X[i + k*N] * inv_pivot) : eT(0); }
+      for(uword j=0; j < N; ++j)  { r[j] = (j > k) ?  X[k + j*N]              : eT(0); }
+      
+      for(uword i=k+1; i < N; ++i)  { X[i + k*N] = eT(0); }
+      }
+    else
+      {
+      const eT inv_pivot = eT(1) / pivot;
+      
+      for(uword i=0; i < N; ++i)  { c[i] = (i != k) ? X[i + k*N] : eT(0); X[i + k*N] = eT(0); }
+      
+      X[k + k*N] = eT(1);
+      
+      for(uword j=0; j < N; ++j)  { X[k + j*N] *= inv_pivot; r[j] = X[k + j*N]; }
+      }
+    
+    rank1_worker<N, eT> worker(X, c, r);
+    
+    unroll<0, N*N>::run(worker);
+    }
+  
+  return n_swaps;
+  }
+
+
+
+template<const uword N, typename eT>
+arma_hot
+inline
+eT
+det(const eT* X)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  eT    U[N*N];
+  uword piv[N];
+  
+  for(uword i=0; i < N*N; ++i)  { U[i] = X[i]; }
+  
+  T min_pivot;
+  T max_pivot;
+  
+  const int n_swaps = tinymat_helper::eliminate<N, false>(U, piv, min_pivot, max_pivot);
+  
+  if(n_swaps < 0)  { return eT(0); }
+  
+  eT val = eT(1);
+  
+  for(uword k=0; k < N; ++k)  { val *= U[k + k*N]; }
+  
+  return (n_swaps % 2) ? -val : val;
+  }
+
+
+
+//! inverse via Gauss-Jordan elimination; out can be the same as X;
+//! returns false if the matrix is singular or badly conditioned
+template<const uword N, typename eT>
+arma_hot
+inline
+bool
+inv(eT* out, const eT* X)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  eT    Y[N*N];
+  uword piv[N];
+  
+  for(uword i=0; i < N*N; ++i)  { Y[i] = X[i]; }
+  
+  T min_pivot;
+  T max_pivot;
+  
+  const int n_swaps = tinymat_helper::eliminate<N, true>(Y, piv, min_pivot, max_pivot);
+  
+  if( (n_swaps < 0) || (min_pivot <= (max_pivot * std::numeric_limits<T>::epsilon())) )  { return false; }
+  
+  // undo the row permutation by swapping the corresponding columns in reverse order;
+  // the last pivot row is always the last row
+  for(uword kk=1; kk < N; ++kk)
+    {
+    const uword k = N-1-kk;
+    const uword p = piv[k];
+    
+    if(p != k)
+      {
+      for(uword i=0; i < N; ++i)  { std::swap(Y[i + k*N], Y[i + p*N]); }
+      }
+    }
+  
+  for(uword i=0; i < N*N; ++i)  { out[i] = Y[i]; }
+  
+  return true;
+  }
+
+
+
+//
+// dispatch of run-time sizes
+
+
+
+template<const bool do_trans_A, const bool use_alpha, const bool use_beta, typename eT>
+inline
+bool
+apply_gemv(const uword N, eT* y, const eT* A, const eT* x, const eT alpha, const eT beta)
+  {
+  switch(N)
+    {
+    case 1:  tinymat_helper::gemv<1, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 2:  tinymat_helper::gemv<2, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 3:  tinymat_helper::gemv<3, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 4:  tinymat_helper::gemv<4, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 5:  tinymat_helper::gemv<5, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 6:  tinymat_helper::gemv<6, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 7:  tinymat_helper::gemv<7, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    case 8:  tinymat_helper::gemv<8, do_trans_A, use_alpha, use_beta>(y, A, x, alpha, beta);  return true;
+    default: ;
+    }
+  
+  return false;
+  }
+
+
+
+template<const bool do_trans_A, const bool do_trans_B, const bool use_alpha, const bool use_beta, typename eT>
+inline
+bool
+apply_gemm(const uword N, eT* C, const eT* A, const eT* B, const eT alpha, const eT beta)
+  {
+  switch(N)
+    {
+    case 1:  tinymat_helper::gemm<1, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 2:  tinymat_helper::gemm<2, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 3:  tinymat_helper::gemm<3, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 4:  tinymat_helper::gemm<4, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 5:  tinymat_helper::gemm<5, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 6:  tinymat_helper::gemm<6, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 7:  tinymat_helper::gemm<7, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    case 8:  tinymat_helper::gemm<8, do_trans_A, do_trans_B, use_alpha, use_beta>(C, A, B, alpha, beta);  return true;
+    default: ;
+    }
+  
+  return false;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+apply_det(eT& out_val, const uword N, const eT* X)
+  {
+  switch(N)
+    {
+    case 1:  out_val = tinymat_helper::det<1>(X);  return true;
+    case 2:  out_val = tinymat_helper::det<2>(X);  return true;
+    case 3:  out_val = tinymat_helper::det<3>(X);  return true;
+    case 4:  out_val = tinymat_helper::det<4>(X);  return true;
+    case 5:  out_val = tinymat_helper::det<5>(X);  return true;
+    case 6:  out_val = tinymat_helper::det<6>(X);  return true;
+    case 7:  out_val = tinymat_helper::det<7>(X);  return true;
+    case 8:  out_val = tinymat_helper::det<8>(X);  return true;
+    default: ;
+    }
+  
+  return false;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+apply_inv(eT* out, const uword N, const eT* X)
+  {
+  switch(N)
+    {
+    case 1:  return tinymat_helper::inv<1>(out, X);
+    case 2:  return tinymat_helper::inv<2>(out, X);
+    case 3:  return tinymat_helper::inv<3>(out, X);
+    case 4:  return tinymat_helper::inv<4>(out, X);
+    case 5:  return tinymat_helper::inv<5>(out, X);
+    case 6:  return tinymat_helper::inv<6>(out, X);
+    case 7:  return tinymat_helper::inv<7>(out, X);
+    case 8:  return tinymat_helper::inv<8>(out, X);
+    default: ;
+    }
+  
+  return false;
+  }
+
+
+
+}  // end of namespace tinymat_helper
+
+
+//! @}
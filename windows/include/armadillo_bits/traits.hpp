@@ -228,6 +228,19 @@ struct is_subview_elem1< const subview_elem1<eT, T1> >
   { static constexpr bool value = true; };
 
 
+template<typename T>
+struct is_subview_where
+  { static constexpr bool value = false; };
+
+template<typename eT, typename T1>
+struct is_subview_where< subview_where<eT, T1> >
+  { static constexpr bool value = true; };
+
+template<typename eT, typename T1>
+struct is_subview_where< const subview_where<eT, T1> >
+  { static constexpr bool value = true; };
+
+
 template<typename T>
 struct is_subview_elem2
   { static constexpr bool value = false; };
@@ -560,6 +573,7 @@ struct is_arma_type2
   || is_subview_cols<T1>::value
   || is_subview_elem1<T1>::value
   || is_subview_elem2<T1>::value
+  || is_subview_where<T1>::value
   ;
   };
 